@@ -2,34 +2,126 @@
 
 #pragma once
 
-#include <unordered_map>
-#include <list>
 #include <memory>
+#include <functional>
 #include "core/node.hpp"
 #include "core/edge.hpp"
+#include "cache/eviction_policy.hpp"
+#include "cache/id_table.hpp"
+#include "metrics/metrics.hpp"
 
+// Cache of nodes and edges bounded by approximate resident bytes.
+// Nodes and edges have separate budgets so a burst of one cannot push out the other;
+// which record goes first is up to the pluggable EvictionPolicy.
+//
+// Entries live in a slot-indexed pool found through an open-addressing id
+// table, and freed slots are reused, so a hit allocates nothing and touches
+// one table bucket, one entry and the policy's per-slot state.
 class CacheManager {
 public:
-    explicit CacheManager(size_t capacity);
+    // Invoked when resident bytes rise above the high watermark
+    using WatermarkCallback = std::function<void(size_t residentBytes, size_t budgetBytes)>;
+    // Receive dirty records as they leave the cache so their changes are not lost
+    using NodeWriteBack = std::function<void(std::shared_ptr<Node>)>;
+    using EdgeWriteBack = std::function<void(std::shared_ptr<Edge>)>;
+
+    // Splits the byte budget evenly between nodes and edges
+    explicit CacheManager(size_t capacityBytes, EvictionPolicyType policy = EvictionPolicyType::LRU);
+    CacheManager(size_t nodeBudgetBytes, size_t edgeBudgetBytes,
+                 EvictionPolicyType policy = EvictionPolicyType::LRU);
 
     void cacheNode(int nodeId, std::shared_ptr<Node> node);
     std::shared_ptr<Node> getNode(int nodeId);
+    // Residency check that leaves metrics and eviction order untouched
+    std::shared_ptr<Node> peekNode(int nodeId) const;
     void removeNode(int nodeId);
 
     void cacheEdge(int edgeId, std::shared_ptr<Edge> edge);
     std::shared_ptr<Edge> getEdge(int edgeId);
+    std::shared_ptr<Edge> peekEdge(int edgeId) const;
     void removeEdge(int edgeId);
 
     void clear();
     size_t size() const;
     bool isFull() const;
 
+    size_t residentBytes() const;
+    size_t nodeBytes() const;
+    size_t edgeBytes() const;
+    size_t nodeBudget() const;
+    size_t edgeBudget() const;
+    std::string policyName() const;
+
+    // fraction is relative to the combined node and edge budget
+    void setHighWatermark(double fraction, WatermarkCallback callback);
+
+    // Without write-back handlers dirty victims are dropped like clean ones
+    void setWriteBack(NodeWriteBack nodeHandler, EdgeWriteBack edgeHandler);
+
+    // Resident ids, hottest first according to the eviction policy
+    std::vector<int> hotNodeIds(size_t limit) const;
+    std::vector<int> hotEdgeIds(size_t limit) const;
+
+    void forEachNode(const std::function<void(const std::shared_ptr<Node>&)>& func) const;
+    void forEachEdge(const std::function<void(const std::shared_ptr<Edge>&)>& func) const;
+
+    // Bytes charged for one cached record, including bookkeeping overhead
+    static size_t chargeFor(const Node& node);
+    static size_t chargeFor(const Edge& edge);
+
 private:
-    size_t capacity;
-    std::unordered_map<int, std::pair<std::shared_ptr<Node>, std::list<int>::iterator>> nodeCache;
-    std::unordered_map<int, std::pair<std::shared_ptr<Edge>, std::list<int>::iterator>> edgeCache;
-    std::list<int> lruListNodes;
-    std::list<int> lruListEdges;
+    template<typename T>
+    struct Entry {
+        std::shared_ptr<T> value;  // Null while the slot is free
+        size_t bytes;
+        int id;
+    };
+
+    template<typename T>
+    struct EntryPool {
+        std::vector<Entry<T>> entries;
+        std::vector<uint32_t> freeSlots;
+        IdTable index;
+
+        Entry<T>* find(int id);
+        const Entry<T>* find(int id) const;
+        uint32_t allocate();
+        void release(uint32_t slot);
+        void clear();
+        size_t size() const { return index.size(); }
+    };
+
+    size_t nodeBudgetBytes;
+    size_t edgeBudgetBytes;
+    size_t nodeResidentBytes;
+    size_t edgeResidentBytes;
+    EntryPool<Node> nodeCache;
+    EntryPool<Edge> edgeCache;
+    std::unique_ptr<EvictionPolicy> nodePolicy;
+    std::unique_ptr<EvictionPolicy> edgePolicy;
+
+    double watermarkFraction;
+    WatermarkCallback watermarkCallback;
+    bool aboveWatermark;
+
+    NodeWriteBack nodeWriteBack;
+    EdgeWriteBack edgeWriteBack;
+
+    template<typename T>
+    static void put(EntryPool<T>& pool, EvictionPolicy& policy, size_t& residentBytes,
+                    int id, std::shared_ptr<T> value, size_t bytes);
+    template<typename T>
+    static std::shared_ptr<T> get(EntryPool<T>& pool, EvictionPolicy& policy, int id,
+                                  Counter hits, Counter misses);
+    template<typename T>
+    static void remove(EntryPool<T>& pool, EvictionPolicy& policy, size_t& residentBytes, int id);
+    template<typename T>
+    static void evictFrom(EntryPool<T>& pool, EvictionPolicy& policy, size_t& residentBytes,
+                          size_t budgetBytes, const std::function<void(std::shared_ptr<T>)>& writeBack,
+                          Counter evictions);
+    template<typename T>
+    static std::vector<int> hotIds(const EntryPool<T>& pool, const EvictionPolicy& policy, size_t limit);
 
     void evict();
-};
\ No newline at end of file
+    void checkWatermark();
+};
@@ -0,0 +1,38 @@
+// include/cache/count_min_sketch.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Approximate access-frequency counter for TinyLFU admission.
+// Counters saturate at 15 and are halved once the sample window fills,
+// so stale popularity decays instead of pinning keys forever.
+class CountMinSketch {
+public:
+    explicit CountMinSketch(size_t expectedKeys);
+
+    void increment(int key);
+    uint8_t estimate(int key) const;
+    void clear();
+    // Doubles the width, keeping every key's estimate: a key's column in
+    // the wider row is its old column or that plus the old width, and both
+    // start from the old counter
+    void grow();
+
+    size_t sampleCount() const { return samples; }
+    size_t counterWidth() const { return width; }
+
+private:
+    static constexpr int DEPTH = 4;
+    static constexpr uint8_t MAX_COUNT = 15;
+
+    size_t width;  // Power of two
+    size_t samples;
+    size_t sampleLimit;
+    std::vector<uint8_t> counters;  // DEPTH rows of width counters
+
+    size_t indexOf(int key, int row) const;
+    void age();
+};
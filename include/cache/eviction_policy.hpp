@@ -0,0 +1,139 @@
+// include/cache/eviction_policy.hpp
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "cache/count_min_sketch.hpp"
+#include "cache/slot_list.hpp"
+
+enum class EvictionPolicyType {
+    LRU,
+    CLOCK,
+    W_TINY_LFU
+};
+
+// Decides which resident entry to give up when a cache is over budget.
+// The cache owns the records and the byte accounting; a policy only tracks
+// ordering, so one CacheManager runs separate instances for nodes and edges.
+//
+// Residents are addressed by slot, a small index the cache assigns and reuses,
+// so policies keep their per-entry state in slot-indexed arrays instead of
+// hash maps and the hit path never allocates.
+class EvictionPolicy {
+public:
+    virtual ~EvictionPolicy() = default;
+
+    // slot became resident holding key
+    virtual void onInsert(uint32_t slot, int key) = 0;
+    // Resident slot was read
+    virtual void onAccess(uint32_t slot) = 0;
+    // Lookup for a non-resident key, used by frequency-based policies
+    virtual void onMiss(int) {}
+    // slot is no longer resident, whether evicted or removed explicitly
+    virtual void onRemove(uint32_t slot) = 0;
+
+    // Picks the next slot to evict. Only valid when size() > 0.
+    virtual uint32_t victim() = 0;
+    // Victim was passed over (e.g. because it is dirty); move it away from the eviction end
+    virtual void deferVictim(uint32_t slot) = 0;
+    // Up to limit resident slots, the ones the policy would keep longest first
+    virtual std::vector<uint32_t> hottest(size_t limit) const = 0;
+
+    virtual size_t size() const = 0;
+    virtual void clear() = 0;
+    virtual std::string name() const = 0;
+};
+
+std::unique_ptr<EvictionPolicy> makeEvictionPolicy(EvictionPolicyType type);
+
+class LruPolicy : public EvictionPolicy {
+public:
+    void onInsert(uint32_t slot, int key) override;
+    void onAccess(uint32_t slot) override;
+    void onRemove(uint32_t slot) override;
+    uint32_t victim() override;
+    void deferVictim(uint32_t slot) override;
+    std::vector<uint32_t> hottest(size_t limit) const override;
+    size_t size() const override { return order.size(); }
+    void clear() override;
+    std::string name() const override { return "LRU"; }
+
+private:
+    SlotLinks links;
+    SlotList order;  // Most recent first
+};
+
+// Second-chance approximation of LRU: hits only set a reference bit,
+// so the hit path never reorders anything.
+class ClockPolicy : public EvictionPolicy {
+public:
+    ClockPolicy();
+
+    void onInsert(uint32_t slot, int key) override;
+    void onAccess(uint32_t slot) override;
+    void onRemove(uint32_t slot) override;
+    uint32_t victim() override;
+    void deferVictim(uint32_t slot) override;
+    std::vector<uint32_t> hottest(size_t limit) const override;
+    size_t size() const override { return residentCount; }
+    void clear() override;
+    std::string name() const override { return "CLOCK"; }
+
+private:
+    struct Slot {
+        bool used;
+        bool referenced;
+    };
+
+    std::vector<Slot> ring;  // Indexed by cache slot
+    size_t residentCount;
+    size_t hand;
+};
+
+// W-TinyLFU: a small LRU admission window in front of a segmented LRU main
+// region. Keys leaving the window only enter the main region if the
+// count-min sketch says they are used more often than the main region's
+// victim, which keeps one-off scans from flushing the hot set.
+class TinyLfuPolicy : public EvictionPolicy {
+public:
+    explicit TinyLfuPolicy(size_t expectedKeys = 4096, double windowFraction = 0.01,
+                           double protectedFraction = 0.8);
+
+    void onInsert(uint32_t slot, int key) override;
+    void onAccess(uint32_t slot) override;
+    void onMiss(int key) override;
+    void onRemove(uint32_t slot) override;
+    uint32_t victim() override;
+    void deferVictim(uint32_t slot) override;
+    std::vector<uint32_t> hottest(size_t limit) const override;
+    size_t size() const override { return window.size() + probation.size() + protectedSegment.size(); }
+    void clear() override;
+    std::string name() const override { return "W-TinyLFU"; }
+
+    uint8_t frequency(int key) const { return sketch.estimate(key); }
+
+private:
+    enum class Segment : uint8_t { WINDOW, PROBATION, PROTECTED };
+
+    struct SlotState {
+        int key;
+        Segment segment;
+    };
+
+    double windowFraction;
+    double protectedFraction;
+    CountMinSketch sketch;
+    SlotLinks links;
+    std::vector<SlotState> states;  // Indexed by cache slot
+    SlotList window;  // Most recent first in every segment
+    SlotList probation;
+    SlotList protectedSegment;
+
+    SlotList& listFor(Segment segment);
+    void moveTo(uint32_t slot, Segment segment);
+    // Moves protected tails to probation until protected is within its share
+    void demoteProtectedOverflow();
+};
@@ -0,0 +1,53 @@
+// include/cache/id_table.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Open-addressing map from record id to cache slot. Buckets are 8 bytes in
+// one flat array and collisions probe linearly, so a lookup usually reads a
+// single cache line and never allocates. Erase shifts later buckets back
+// instead of leaving tombstones, keeping probe chains short under churn.
+class IdTable {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    explicit IdTable(size_t initialCapacity = 16);
+
+    // Slot stored for id, or NONE
+    uint32_t find(int id) const {
+        for (size_t i = home(id);; i = (i + 1) & mask) {
+            const Bucket& bucket = buckets[i];
+            if (bucket.slot == NONE || bucket.id == id) {
+                return bucket.slot;
+            }
+        }
+    }
+
+    // Adds id or replaces its slot
+    void insert(int id, uint32_t slot);
+    bool erase(int id);
+    void clear();
+
+    size_t size() const { return count; }
+    size_t capacity() const { return buckets.size(); }
+
+private:
+    struct Bucket {
+        int id;
+        uint32_t slot;  // NONE marks an empty bucket
+    };
+
+    std::vector<Bucket> buckets;
+    size_t mask;
+    unsigned shift;
+    size_t count;
+
+    size_t home(int id) const {
+        // Fibonacci hashing spreads sequential ids across the table
+        return (static_cast<uint64_t>(static_cast<uint32_t>(id)) * 0x9E3779B97F4A7C15ULL) >> shift;
+    }
+    void rehash(size_t newCapacity);
+};
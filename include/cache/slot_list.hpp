@@ -0,0 +1,80 @@
+// include/cache/slot_list.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Prev/next links for every cache slot, stored contiguously by slot index.
+// Several SlotLists can share one SlotLinks as long as each slot is on at
+// most one of them, which is how segmented policies move entries around
+// without allocating.
+struct SlotLinks {
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Link {
+        uint32_t prev;
+        uint32_t next;
+    };
+
+    std::vector<Link> links;
+
+    void ensure(uint32_t slot) {
+        if (slot >= links.size()) {
+            links.resize(slot + 1, Link{NIL, NIL});
+        }
+    }
+};
+
+// Intrusive doubly linked list of slots, most recently pushed at the front
+class SlotList {
+public:
+    uint32_t front() const { return head; }
+    uint32_t back() const { return tail; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    void pushFront(SlotLinks& links, uint32_t slot) {
+        links.links[slot] = {SlotLinks::NIL, head};
+        if (head != SlotLinks::NIL) {
+            links.links[head].prev = slot;
+        } else {
+            tail = slot;
+        }
+        head = slot;
+        ++count;
+    }
+
+    void remove(SlotLinks& links, uint32_t slot) {
+        SlotLinks::Link& link = links.links[slot];
+        if (link.prev != SlotLinks::NIL) {
+            links.links[link.prev].next = link.next;
+        } else {
+            head = link.next;
+        }
+        if (link.next != SlotLinks::NIL) {
+            links.links[link.next].prev = link.prev;
+        } else {
+            tail = link.prev;
+        }
+        --count;
+    }
+
+    void moveToFront(SlotLinks& links, uint32_t slot) {
+        if (head != slot) {
+            remove(links, slot);
+            pushFront(links, slot);
+        }
+    }
+
+    void clear() {
+        head = tail = SlotLinks::NIL;
+        count = 0;
+    }
+
+private:
+    uint32_t head = SlotLinks::NIL;
+    uint32_t tail = SlotLinks::NIL;
+    size_t count = 0;
+};
@@ -0,0 +1,132 @@
+// include/core/adjacency_list.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include "core/edge_types.hpp"
+
+// Set of edge ids incident to a node, kept in ascending order. Up to
+// LARGE_THRESHOLD ids live in one sorted vector; beyond that the ids are split
+// into sorted blocks of at most BLOCK_CAPACITY, so a hub with millions of
+// edges pays a binary search plus a bounded shift per insert or erase rather
+// than a scan of its whole list. Membership is O(log d) either way.
+class AdjacencyList {
+public:
+    static constexpr size_t BLOCK_CAPACITY = 1024;
+    static constexpr size_t LARGE_THRESHOLD = 2 * BLOCK_CAPACITY;
+
+    // Ascending ids, across blocks
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int*;
+        using reference = const int&;
+
+        Iterator() : pos(nullptr), blockEnd(nullptr), block(nullptr), lastBlock(nullptr) {}
+
+        const int& operator*() const { return *pos; }
+        Iterator& operator++() {
+            if (++pos == blockEnd && block != lastBlock) {
+                ++block;
+                pos = block->data();
+                blockEnd = pos + block->size();
+            }
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+        bool operator==(const Iterator& other) const { return pos == other.pos; }
+        bool operator!=(const Iterator& other) const { return pos != other.pos; }
+
+    private:
+        friend class AdjacencyList;
+        using Block = std::vector<int>;
+        Iterator(const int* pos, const Block* block, const Block* lastBlock)
+            : pos(pos), blockEnd(block->data() + block->size()), block(block), lastBlock(lastBlock) {}
+
+        const int* pos;
+        const int* blockEnd;
+        const Block* block;
+        const Block* lastBlock;
+    };
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+    using value_type = int;
+
+    AdjacencyList() : count(0) {}
+
+    // false if id was already present
+    bool insert(int id);
+    // false if id was absent
+    bool erase(int id);
+    bool contains(int id) const {
+        const std::vector<int>& block = blocks.empty() ? ids : blocks[findBlock(id)];
+        return std::binary_search(block.begin(), block.end(), id);
+    }
+    // Replaces the contents; ids may be unsorted and contain duplicates
+    void assign(std::vector<int> newIds);
+    void clear();
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Iterator begin() const {
+        if (blocks.empty()) {
+            return Iterator(ids.data(), &ids, &ids);
+        }
+        return Iterator(blocks.front().data(), &blocks.front(), &blocks.back());
+    }
+    Iterator end() const {
+        if (blocks.empty()) {
+            return Iterator(ids.data() + ids.size(), &ids, &ids);
+        }
+        return Iterator(blocks.back().data() + blocks.back().size(), &blocks.back(), &blocks.back());
+    }
+
+    // The index-th smallest id; constant time below LARGE_THRESHOLD, linear in
+    // the number of blocks above it
+    int operator[](size_t index) const;
+    std::vector<int> toVector() const { return std::vector<int>(begin(), end()); }
+
+    // Heap bytes owned by the list
+    size_t heapUsage() const;
+
+    friend bool operator==(const AdjacencyList& a, const AdjacencyList& b) {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    }
+    friend bool operator==(const AdjacencyList& a, const std::vector<int>& b) {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    }
+    friend bool operator==(const std::vector<int>& a, const AdjacencyList& b) { return b == a; }
+    friend bool operator!=(const AdjacencyList& a, const AdjacencyList& b) { return !(a == b); }
+
+private:
+    size_t count;
+    // All ids while small; empty once split into blocks
+    std::vector<int> ids;
+    // Non-empty sorted blocks, ordered by their first id
+    std::vector<std::vector<int>> blocks;
+
+    // Block whose range covers id, or where id would be inserted
+    size_t findBlock(int id) const {
+        auto it = std::upper_bound(blocks.begin(), blocks.end(), id,
+                                   [](int value, const std::vector<int>& block) { return value < block.front(); });
+        return it == blocks.begin() ? 0 : it - blocks.begin() - 1;
+    }
+    void splitIntoBlocks();
+    void mergeIntoVector();
+};
+
+// A node's edges of one type in one direction
+struct AdjacencyPartition {
+    EdgeType type;
+    AdjacencyList edges;
+};
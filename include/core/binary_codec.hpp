@@ -0,0 +1,170 @@
+// include/core/binary_codec.hpp
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// Building blocks for the on-disk record format: LEB128 varints, zigzag for
+// signed values, raw little-endian IEEE doubles and length-prefixed strings.
+// The writer appends to a caller-owned buffer so a batch of records can be
+// encoded back to back without intermediate strings.
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::string& out) : out(out) {}
+
+    void writeByte(uint8_t value) {
+        out.push_back(static_cast<char>(value));
+    }
+
+    void writeVarint(uint64_t value) {
+        char buffer[10];
+        out.append(buffer, encodeVarint(value, buffer));
+    }
+
+    // For length prefixes only known once the bytes after them are written;
+    // offset is a previous size()
+    void insertVarint(size_t offset, uint64_t value) {
+        char buffer[10];
+        out.insert(offset, buffer, encodeVarint(value, buffer));
+    }
+
+    void writeSigned(int64_t value) {
+        writeVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    void writeDouble(double value) {
+        // Host byte order; every platform we build for is little-endian
+        char buffer[sizeof(double)];
+        std::memcpy(buffer, &value, sizeof(double));
+        out.append(buffer, sizeof(double));
+    }
+
+    void writeString(std::string_view value) {
+        writeVarint(value.size());
+        out.append(value.data(), value.size());
+    }
+
+    // Host byte order, like writeDouble
+    void writeFloats(const float* values, size_t count) {
+        out.append(reinterpret_cast<const char*>(values), count * sizeof(float));
+    }
+
+    // Bytes written to the buffer so far, including what it held before
+    size_t size() const { return out.size(); }
+
+private:
+    std::string& out;
+
+    static size_t encodeVarint(uint64_t value, char* buffer) {
+        size_t length = 0;
+        while (value >= 0x80) {
+            buffer[length++] = static_cast<char>(value | 0x80);
+            value >>= 7;
+        }
+        buffer[length++] = static_cast<char>(value);
+        return length;
+    }
+};
+
+// Reads what BinaryWriter wrote; throws std::runtime_error on truncated input
+class BinaryReader {
+public:
+    BinaryReader(const char* data, size_t size) : pos(data), end(data + size) {}
+
+    bool atEnd() const { return pos == end; }
+    // Next unread byte
+    const char* position() const { return pos; }
+
+    uint8_t readByte() {
+        require(1);
+        return static_cast<uint8_t>(*pos++);
+    }
+
+    uint64_t readVarint() {
+        // Ids, deltas and counts are mostly one or two bytes; decode those
+        // without a data-dependent branch on the length
+        if (end - pos >= 2) {
+            uint32_t first = static_cast<uint8_t>(pos[0]);
+            uint32_t second = static_cast<uint8_t>(pos[1]);
+            if ((first & second & 0x80) == 0) {
+                uint32_t twoBytes = first >> 7;
+                pos += 1 + twoBytes;
+                return (first & 0x7F) | ((second & 0x7F) << 7 & -twoBytes);
+            }
+        }
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = readByte();
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Malformed varint");
+    }
+
+    // A count of entries that take at least a byte each. Anything beyond the
+    // bytes left is damage, rejected before callers reserve() room for it.
+    uint64_t readCount() {
+        uint64_t count = readVarint();
+        require(count);
+        return count;
+    }
+
+    int64_t readSigned() {
+        uint64_t value = readVarint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    double readDouble() {
+        require(sizeof(double));
+        double value;
+        std::memcpy(&value, pos, sizeof(double));
+        pos += sizeof(double);
+        return value;
+    }
+
+    void skipFloats(uint64_t count) {
+        requireFloats(count);
+        pos += count * sizeof(float);
+    }
+
+    // Appends count floats to out
+    template<typename Floats>
+    void readFloats(uint64_t count, Floats& out) {
+        requireFloats(count);
+        size_t offset = out.size();
+        out.resize(offset + count);
+        std::memcpy(out.data() + offset, pos, count * sizeof(float));
+        pos += count * sizeof(float);
+    }
+
+    // The view points into the input buffer
+    std::string_view readString() {
+        uint64_t length = readVarint();
+        require(length);
+        std::string_view value(pos, length);
+        pos += length;
+        return value;
+    }
+
+private:
+    const char* pos;
+    const char* end;
+
+    void require(uint64_t bytes) const {
+        if (bytes > static_cast<uint64_t>(end - pos)) {
+            throw std::runtime_error("Record data truncated");
+        }
+    }
+
+    void requireFloats(uint64_t count) const {
+        if (count > static_cast<uint64_t>(end - pos) / sizeof(float)) {
+            throw std::runtime_error("Record data truncated");
+        }
+    }
+};
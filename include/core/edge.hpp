@@ -1,42 +1,100 @@
 // include/core/edge.hpp
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <variant>
+#include "core/edge_types.hpp"
 #include "core/property.hpp"
+#include "core/property_keys.hpp"
+#include "core/property_map.hpp"
+#include "core/record_names.hpp"
 
 class Edge {
 public:
-    Edge(int id, int sourceNodeId, int targetNodeId, const std::string& type);
-    
+    // Property keys and the type are ids in names, which must outlive the edge
+    Edge(int id, int sourceNodeId, int targetNodeId, const std::string& type,
+         RecordNames& names = RecordNames::detached());
+    Edge(int id, int sourceNodeId, int targetNodeId, EdgeType type, RecordNames& names = RecordNames::detached());
+
     int getId() const;
     void setId(int newId);
+    RecordNames& getNames() const { return *names; }
+    // Moves the edge's property keys and type to the ids of the same names in
+    // target, interning any it lacks
+    void rekey(RecordNames& target);
     int getSourceNodeId() const;
     int getTargetNodeId() const;
-    std::string getType() const;
+    // Name of the type, owned by getNames()
+    const std::string& getType() const;
+    EdgeType getTypeId() const;
+
+    // T is bool, int, double, std::string or std::vector<float>; string
+    // literals and views are stored as std::string. Rvalues are moved in.
+    template<typename T>
+    void setProperty(std::string_view key, T&& value) {
+        setProperty(names->propertyKeys.intern(key), std::forward<T>(value));
+    }
+
+    // The stored value, valid until the property is next set or removed;
+    // getProperty<std::string_view> views a string. Throws std::out_of_range
+    // if key is not set and std::bad_variant_access if it holds another type.
+    template<typename T>
+    PropertyRef<T> getProperty(std::string_view key) const {
+        if (auto handle = names->propertyKeys.find(key)) {
+            return getProperty<T>(*handle);
+        }
+        throw std::out_of_range("Property not found");
+    }
+
+    // nullptr when key is not set or holds another type; never throws
+    template<typename T>
+    const T* tryGetProperty(std::string_view key) const noexcept {
+        auto handle = names->propertyKeys.find(key);
+        return handle ? tryGetProperty<T>(*handle) : nullptr;
+    }
 
+    // Same as above with a key resolved once in getNames()
     template<typename T>
-    void setProperty(const std::string& key, const T& value) {
-        properties[key] = Property<T>(value);
+    void setProperty(PropertyKey key, T&& value) {
+        using Stored = StoredPropertyType<T>;
+        properties.assign<Stored>(key, Stored(std::forward<T>(value)));
         setDirty(true);
     }
 
     template<typename T>
-    T getProperty(const std::string& key) const {
-        auto it = properties.find(key);
-        if (it != properties.end()) {
-            return std::get<Property<T>>(it->second).getValue();
+    PropertyRef<T> getProperty(PropertyKey key) const {
+        if (const auto* value = properties.find<StoredPropertyType<T>>(key)) {
+            return *value;
         }
         throw std::out_of_range("Property not found");
     }
 
-    bool hasProperty(const std::string& key) const;
-    void removeProperty(const std::string& key);
+    template<typename T>
+    const T* tryGetProperty(PropertyKey key) const noexcept {
+        return properties.tryFind<T>(key);
+    }
+
+    bool hasProperty(std::string_view key) const;
+    bool hasProperty(PropertyKey key) const;
+    void removeProperty(std::string_view key);
+    void removeProperty(PropertyKey key);
     std::vector<std::string> getPropertyKeys() const;
+    // Typed lookups without copying values, e.g. getProperties().find<T>(key)
+    const PropertyMap& getProperties() const { return properties; }
 
+    // Binary record format; see core/record_codec.hpp
     std::string serialize() const;
-    static Edge deserialize(const std::string& data);
+    // Appends the encoded record to out
+    void serializeTo(std::string& out) const;
+    // Also accepts records in the older text format. Ids in the record are
+    // read as ids in names.
+    static Edge deserialize(const std::string& data, RecordNames& names = RecordNames::detached());
+    static Edge deserialize(const char* data, size_t size, RecordNames& names = RecordNames::detached());
+
+    // Approximate resident bytes, including properties, adjacency and strings
+    size_t memoryUsage() const;
 
     bool isDirty() const;
     void setDirty(bool dirty);
@@ -45,8 +103,8 @@ private:
     int id;
     int sourceNodeId;
     int targetNodeId;
-    std::string type;
+    EdgeType type;
     bool dirty;
-    using PropertyVariant = std::variant<Property<bool>, Property<int>, Property<double>, Property<std::string>>;
-    std::unordered_map<std::string, PropertyVariant> properties;
+    RecordNames* names;
+    PropertyMap properties;
 };
\ No newline at end of file
@@ -0,0 +1,51 @@
+// include/core/edge_types.hpp
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "core/name_table.hpp"
+
+// Interned edge type name. Edges and edge records carry this id instead of
+// the name, and node adjacency is partitioned by it. EdgeType{} is the empty
+// type name, which is also where untyped adjacency is filed.
+struct EdgeType {
+    uint32_t id;
+
+    bool operator==(EdgeType other) const { return id == other.id; }
+    bool operator!=(EdgeType other) const { return id != other.id; }
+    bool operator<(EdgeType other) const { return id < other.id; }
+};
+
+namespace std {
+template<>
+struct hash<EdgeType> {
+    size_t operator()(EdgeType type) const noexcept { return type.id; }
+};
+}
+
+// Database-wide mapping between edge type names and ids, handed out densely
+// in first-use order like PropertyKeyDictionary. Graphs have few edge types,
+// so the ids stay small. Thread-safe.
+class EdgeTypeRegistry {
+public:
+    // Starts out holding only the empty name, as EdgeType{}
+    EdgeTypeRegistry();
+
+    // Id for name, assigning the next one if the name is new
+    EdgeType intern(std::string_view name);
+    // Id for name if it has been interned
+    std::optional<EdgeType> find(std::string_view name) const;
+    // Throws std::out_of_range for an id that was never assigned
+    const std::string& name(EdgeType type) const;
+    size_t size() const;
+
+    // Same file semantics as PropertyKeyDictionary::save and load
+    void save(const std::string& path) const;
+    size_t load(const std::string& path);
+
+private:
+    NameTable names;
+};
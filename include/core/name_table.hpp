@@ -0,0 +1,43 @@
+// include/core/name_table.hpp
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Thread-safe, append-only mapping between names and dense uint32_t ids, with
+// a small file format for persisting it. Shared by the property key dictionary
+// and the edge type registry; noun names the kind of entry in error messages.
+class NameTable {
+public:
+    NameTable(uint32_t magic, std::string noun) : magic(magic), noun(std::move(noun)) {}
+
+    uint32_t intern(std::string_view name);
+    std::optional<uint32_t> find(std::string_view name) const;
+    // Throws std::out_of_range for an id that was never assigned
+    const std::string& name(uint32_t id) const;
+    // Lock-free, for decoders that bound-check every id they read
+    size_t size() const { return nameCount.load(std::memory_order_acquire); }
+
+    // Writes every name in id order, replacing the file atomically
+    void save(const std::string& path) const;
+    // Interns the names saved at path, which must get the ids they were saved
+    // with: throws if one of them is already taken by another name.
+    // Returns the number of names in the file; a missing file has none.
+    size_t load(const std::string& path);
+
+private:
+    const uint32_t magic;
+    const std::string noun;
+    mutable std::shared_mutex mutex;
+    // Deque keeps name references stable while new names are appended
+    std::deque<std::string> names;
+    std::unordered_map<std::string_view, uint32_t> ids;
+    std::atomic<size_t> nameCount{0};
+};
@@ -1,47 +1,132 @@
 // include/core/node.hpp
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <variant>
 #include <algorithm>
 #include <sstream>
+#include "core/adjacency_list.hpp"
+#include "core/edge.hpp"
+#include "core/edge_types.hpp"
 #include "core/property.hpp"
+#include "core/property_keys.hpp"
+#include "core/property_map.hpp"
+#include "core/record_names.hpp"
 
 class Node {
 public:
+    // Property keys and edge types are ids in names, which must outlive the
+    // node; RecordNames::detached() unless given
     Node();
     explicit Node(int id);
+    Node(int id, RecordNames& names);
 
     int getId() const;
     void setId(int newId);
 
+    RecordNames& getNames() const { return *names; }
+    // Moves the node's property keys and adjacency types to the ids of the
+    // same names in target, interning any it lacks
+    void rekey(RecordNames& target);
+
+    // T is bool, int, double, std::string or std::vector<float>; string
+    // literals and views are stored as std::string. Rvalues are moved in.
+    template<typename T>
+    void setProperty(std::string_view key, T&& value) {
+        setProperty(names->propertyKeys.intern(key), std::forward<T>(value));
+    }
+
+    // The stored value, valid until the property is next set or removed;
+    // getProperty<std::string_view> views a string. Throws std::out_of_range
+    // if key is not set and std::bad_variant_access if it holds another type.
+    template<typename T>
+    PropertyRef<T> getProperty(std::string_view key) const {
+        if (auto handle = names->propertyKeys.find(key)) {
+            return getProperty<T>(*handle);
+        }
+        throw std::out_of_range("Property not found");
+    }
+
+    // nullptr when key is not set or holds another type; never throws
     template<typename T>
-    void setProperty(const std::string& key, const T& value) {
-        properties[key] = Property<T>(value);
+    const T* tryGetProperty(std::string_view key) const noexcept {
+        auto handle = names->propertyKeys.find(key);
+        return handle ? tryGetProperty<T>(*handle) : nullptr;
+    }
+
+    // Same as above with a key resolved once in getNames()
+    template<typename T>
+    void setProperty(PropertyKey key, T&& value) {
+        using Stored = StoredPropertyType<T>;
+        properties.assign<Stored>(key, Stored(std::forward<T>(value)));
         setDirty(true);
     }
 
     template<typename T>
-    T getProperty(const std::string& key) const {
-        auto it = properties.find(key);
-        if (it != properties.end()) {
-            return std::get<Property<T>>(it->second).getValue();
+    PropertyRef<T> getProperty(PropertyKey key) const {
+        if (const auto* value = properties.find<StoredPropertyType<T>>(key)) {
+            return *value;
         }
         throw std::out_of_range("Property not found");
     }
 
-    bool hasProperty(const std::string& key) const;
-    void removeProperty(const std::string& key);
+    template<typename T>
+    const T* tryGetProperty(PropertyKey key) const noexcept {
+        return properties.tryFind<T>(key);
+    }
+
+    bool hasProperty(std::string_view key) const;
+    bool hasProperty(PropertyKey key) const;
+    void removeProperty(std::string_view key);
+    void removeProperty(PropertyKey key);
     std::vector<std::string> getPropertyKeys() const;
+    // Typed lookups without copying values, e.g. getProperties().find<T>(key)
+    const PropertyMap& getProperties() const { return properties; }
 
-    void addEdge(int edgeId, bool isOutgoing);
+    // Adjacency is partitioned by direction and edge type, and each partition
+    // is sorted by edge id; adding an id already in the partition is a no-op.
+    // Edges added without a type go to the EdgeType{} partition.
+    void addEdge(int edgeId, bool isOutgoing, EdgeType type = EdgeType{});
+    // Files edge under its type: outgoing if this node is its source, incoming
+    // if it is its target. The type is matched by name if the edge has other
+    // names.
+    void addEdge(const Edge& edge);
+    // Removes edgeId from whichever partition of that direction holds it
     void removeEdge(int edgeId, bool isOutgoing);
-    const std::vector<int>& getIncomingEdges() const;
-    const std::vector<int>& getOutgoingEdges() const;
+    void removeEdge(int edgeId, bool isOutgoing, EdgeType type);
+    bool hasEdge(int edgeId, bool isOutgoing) const;
+    // Every edge in one direction, grouped by ascending type id and sorted
+    // within each type. The partitions are merged into a new vector on every
+    // call; loops should use the visitors below.
+    std::vector<int> getIncomingEdges() const;
+    std::vector<int> getOutgoingEdges() const;
+    // Calls visit(edgeId) for the same edges in the same order, in place
+    template<typename Visit>
+    void forEachIncomingEdge(Visit&& visit) const { forEachEdge(incomingEdges, visit); }
+    template<typename Visit>
+    void forEachOutgoingEdge(Visit&& visit) const { forEachEdge(outgoingEdges, visit); }
+    // Only the edges of one type; an empty list if the node has none
+    const AdjacencyList& getIncomingEdges(EdgeType type) const;
+    const AdjacencyList& getOutgoingEdges(EdgeType type) const;
+    const AdjacencyList& getIncomingEdges(std::string_view type) const;
+    const AdjacencyList& getOutgoingEdges(std::string_view type) const;
+    // Non-empty partitions in ascending type id order
+    const std::vector<AdjacencyPartition>& getEdgePartitions(bool isOutgoing) const;
+    size_t getEdgeCount(bool isOutgoing) const;
 
+    // Binary record format; see core/record_codec.hpp
     std::string serialize() const;
-    static Node deserialize(const std::string& data);
+    // Appends the encoded record to out
+    void serializeTo(std::string& out) const;
+    // Also accepts records in the older text format. Ids in the record are
+    // read as ids in names.
+    static Node deserialize(const std::string& data, RecordNames& names = RecordNames::detached());
+    static Node deserialize(const char* data, size_t size, RecordNames& names = RecordNames::detached());
+
+    // Approximate resident bytes, including properties, adjacency and strings
+    size_t memoryUsage() const;
 
     bool isDirty() const;
     void setDirty(bool dirty);
@@ -49,8 +134,17 @@ public:
 private:
     int id;
     bool dirty;
-    using PropertyVariant = std::variant<Property<bool>, Property<int>, Property<double>, Property<std::string>>;
-    std::unordered_map<std::string, PropertyVariant> properties;
-    std::vector<int> incomingEdges;
-    std::vector<int> outgoingEdges;
+    RecordNames* names;
+    PropertyMap properties;
+    std::vector<AdjacencyPartition> incomingEdges;
+    std::vector<AdjacencyPartition> outgoingEdges;
+
+    template<typename Visit>
+    static void forEachEdge(const std::vector<AdjacencyPartition>& partitions, Visit& visit) {
+        for (const AdjacencyPartition& partition : partitions) {
+            for (int edgeId : partition.edges) {
+                visit(edgeId);
+            }
+        }
+    }
 };
\ No newline at end of file
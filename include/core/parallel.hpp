@@ -0,0 +1,61 @@
+// include/core/parallel.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Number of threads to split items across: requested, or one per hardware
+// thread when it is 0, capped so each thread gets at least minPerThread items.
+// Always at least 1.
+inline size_t threadCountFor(size_t requested, size_t items, size_t minPerThread) {
+    if (requested == 0) {
+        requested = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return std::max<size_t>(1, std::min(requested, items / std::max<size_t>(1, minPerThread)));
+}
+
+// Runs task(t) for every t in [0, threadCount), task(0) on the calling thread
+// and the rest on their own threads. Waits for all of them, then rethrows the
+// first exception any of them threw.
+template<typename Task>
+void runParallel(size_t threadCount, Task&& task) {
+    if (threadCount <= 1) {
+        task(size_t{0});
+        return;
+    }
+    std::vector<std::exception_ptr> errors(threadCount);
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (size_t t = 1; t < threadCount; ++t) {
+        threads.emplace_back([&task, &errors, t] {
+            try {
+                task(t);
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    try {
+        task(size_t{0});
+    } catch (...) {
+        errors[0] = std::current_exception();
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+// [begin, end) of slice t when items are split into threadCount near-equal slices
+inline std::pair<size_t, size_t> sliceOf(size_t items, size_t threadCount, size_t t) {
+    return {items * t / threadCount, items * (t + 1) / threadCount};
+}
@@ -4,6 +4,18 @@
 #include <sstream>
 #include <stdexcept>
 #include <type_traits>
+#include <vector>
+#include "core/binary_codec.hpp"
+
+// Heap bytes owned by a string, zero when it fits in the small-string buffer
+inline size_t stringHeapUsage(const std::string& str) {
+    const char* begin = reinterpret_cast<const char*>(&str);
+    const char* data = str.data();
+    if (data >= begin && data < begin + sizeof(std::string)) {
+        return 0;
+    }
+    return str.capacity() + 1;
+}
 
 template<typename T>
 class Property {
@@ -13,17 +25,76 @@ public:
 
     T getValue() const { return value_; }
 
+    // Heap bytes owned by the value beyond sizeof(Property<T>)
+    size_t heapUsage() const {
+        if constexpr (std::is_same_v<T, std::string>) {
+            return stringHeapUsage(value_);
+        } else if constexpr (std::is_same_v<T, std::vector<float>>) {
+            return value_.capacity() * sizeof(float);
+        } else {
+            return 0;
+        }
+    }
+
     std::string serialize() const {
         std::ostringstream oss;
         oss << getTypeId() << ":";
         if constexpr (std::is_same_v<T, bool>) {
             oss << (value_ ? "true" : "false");
+        } else if constexpr (std::is_same_v<T, std::vector<float>>) {
+            oss.precision(9);
+            for (size_t i = 0; i < value_.size(); ++i) {
+                oss << (i ? "," : "") << value_[i];
+            }
         } else {
             oss << value_;
         }
         return oss.str();
     }
 
+    // Binary value only; the type tag is written by the enclosing record
+    void encode(BinaryWriter& writer) const {
+        encodeValue(value_, writer);
+    }
+
+    static Property<T> decode(BinaryReader& reader) {
+        return Property<T>(decodeValue(reader));
+    }
+
+    static void encodeValue(const T& value, BinaryWriter& writer) {
+        if constexpr (std::is_same_v<T, bool>) {
+            writer.writeByte(value ? 1 : 0);
+        } else if constexpr (std::is_same_v<T, int>) {
+            writer.writeSigned(value);
+        } else if constexpr (std::is_same_v<T, double>) {
+            writer.writeDouble(value);
+        } else if constexpr (std::is_same_v<T, std::vector<float>>) {
+            // Dimension, then raw floats: no per-element framing
+            writer.writeVarint(value.size());
+            writer.writeFloats(value.data(), value.size());
+        } else {
+            writer.writeString(value);
+        }
+    }
+
+    static T decodeValue(BinaryReader& reader) {
+        if constexpr (std::is_same_v<T, bool>) {
+            return reader.readByte() != 0;
+        } else if constexpr (std::is_same_v<T, int>) {
+            return static_cast<int>(reader.readSigned());
+        } else if constexpr (std::is_same_v<T, double>) {
+            return reader.readDouble();
+        } else if constexpr (std::is_same_v<T, std::vector<float>>) {
+            std::vector<float> value;
+            reader.readFloats(reader.readVarint(), value);
+            return value;
+        } else {
+            return std::string(reader.readString());
+        }
+    }
+
+    static constexpr int typeId() { return getTypeId(); }
+
     static Property<T> deserialize(const std::string& data) {
         std::istringstream iss(data);
         std::string typeStr, valueStr;
@@ -38,6 +109,14 @@ public:
             return Property<T>(valueStr == "true");
         } else if constexpr (std::is_same_v<T, std::string>) {
             return Property<T>(valueStr);
+        } else if constexpr (std::is_same_v<T, std::vector<float>>) {
+            std::vector<float> value;
+            std::istringstream values(valueStr);
+            std::string element;
+            while (std::getline(values, element, ',')) {
+                value.push_back(std::stof(element));
+            }
+            return Property<T>(std::move(value));
         } else {
             return Property<T>(fromString<T>(valueStr));
         }
@@ -51,6 +130,7 @@ private:
         else if constexpr (std::is_same_v<T, int>) return 1;
         else if constexpr (std::is_same_v<T, double>) return 2;
         else if constexpr (std::is_same_v<T, std::string>) return 3;
+        else if constexpr (std::is_same_v<T, std::vector<float>>) return 4;
         else static_assert(always_false<T>::value, "Unsupported type");
     }
 
@@ -71,4 +151,6 @@ private:
 using BoolProperty = Property<bool>;
 using IntProperty = Property<int>;
 using DoubleProperty = Property<double>;
-using StringProperty = Property<std::string>;
\ No newline at end of file
+using StringProperty = Property<std::string>;
+// Embeddings and other fixed-length numeric vectors
+using FloatVectorProperty = Property<std::vector<float>>;
\ No newline at end of file
@@ -0,0 +1,52 @@
+// include/core/property_keys.hpp
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "core/name_table.hpp"
+
+// Pre-resolved property name. Records store these small ids instead of the
+// name itself, and hot loops can resolve a name once and skip string hashing.
+struct PropertyKey {
+    uint32_t id;
+
+    bool operator==(PropertyKey other) const { return id == other.id; }
+    bool operator!=(PropertyKey other) const { return id != other.id; }
+};
+
+namespace std {
+template<>
+struct hash<PropertyKey> {
+    size_t operator()(PropertyKey key) const noexcept { return key.id; }
+};
+}
+
+// Database-wide mapping between property names and key ids; each database
+// owns one through RecordNames. Ids are handed out densely in first-use order
+// and never reused, so a name keeps its id for the life of the database.
+// Interning is thread-safe; id-to-name lookups are too.
+class PropertyKeyDictionary {
+public:
+    PropertyKeyDictionary();
+
+    // Id for name, assigning the next one if the name is new
+    PropertyKey intern(std::string_view name);
+    // Id for name if it has been interned
+    std::optional<PropertyKey> find(std::string_view name) const;
+    // Throws std::out_of_range for an id that was never assigned
+    const std::string& name(PropertyKey key) const;
+    size_t size() const;
+
+    // Writes every name in id order, replacing the file atomically
+    void save(const std::string& path) const;
+    // Interns the names saved at path, which must get the ids they were saved
+    // with: throws if this dictionary already gave one of them to another name.
+    // Returns the number of names in the file; a missing file has none.
+    size_t load(const std::string& path);
+
+private:
+    NameTable names;
+};
@@ -0,0 +1,223 @@
+// include/core/property_map.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+#include "core/property.hpp"
+#include "core/property_keys.hpp"
+
+// The type a value of T is stored as: string literals and views become std::string
+template<typename T>
+using StoredPropertyType = std::conditional_t<std::is_convertible_v<const std::decay_t<T>&, std::string_view>,
+                                              std::string, std::decay_t<T>>;
+
+// What typed reads return: a reference to the stored value, or for
+// std::string_view a view of the stored string
+template<typename T>
+using PropertyRef = std::conditional_t<std::is_same_v<T, std::string_view>, std::string_view, const T&>;
+
+// Property storage for one Node or Edge. Entries live in key-sorted parallel
+// arrays of key ids, one-byte type tags and 8-byte payloads; bools, ints and
+// doubles sit in the payload and strings and float vectors behind an owned
+// pointer, so an entry
+// costs 13 bytes instead of a padded variant. The first INLINE_CAPACITY
+// entries are stored inside the object and typical records own no property
+// allocations besides their strings. Larger records move the arrays to one
+// heap block, and past HASH_THRESHOLD entries the map switches to a hash
+// table for good.
+class PropertyMap {
+public:
+    static constexpr uint32_t INLINE_CAPACITY = 6;
+    static constexpr uint32_t HASH_THRESHOLD = 32;
+
+    PropertyMap();
+    PropertyMap(const PropertyMap& other);
+    PropertyMap(PropertyMap&& other) noexcept;
+    PropertyMap& operator=(const PropertyMap& other);
+    PropertyMap& operator=(PropertyMap&& other) noexcept;
+    ~PropertyMap();
+
+    bool contains(PropertyKey key) const {
+        uint8_t type;
+        return locate(key, type) != nullptr;
+    }
+
+    // Value stored for key, nullptr when key is not set. Like std::get on a
+    // variant, asking for a different type than was stored throws
+    // std::bad_variant_access.
+    template<typename T>
+    const T* find(PropertyKey key) const {
+        uint8_t type;
+        const Payload* payload = locate(key, type);
+        if (!payload) {
+            return nullptr;
+        }
+        if (type != Property<T>::typeId()) {
+            throw std::bad_variant_access();
+        }
+        return &valueOf<T>(*payload);
+    }
+
+    // As find, but also nullptr when the value has another type
+    template<typename T>
+    const T* tryFind(PropertyKey key) const noexcept {
+        uint8_t type;
+        const Payload* payload = locate(key, type);
+        return payload && type == Property<T>::typeId() ? &valueOf<T>(*payload) : nullptr;
+    }
+
+    // Inserts or replaces the value for key; T is one of the Property types.
+    // Replacing a string or vector with one of the same type reuses its storage.
+    template<typename T>
+    void assign(PropertyKey key, T value) {
+        if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::vector<float>>) {
+            uint8_t type;
+            const Payload* existing = locate(key, type);
+            if (existing && type == Property<T>::typeId()) {
+                const_cast<T&>(valueOf<T>(*existing)) = std::move(value);
+                return;
+            }
+        }
+        Payload payload;
+        if constexpr (std::is_same_v<T, bool>) {
+            payload.b = value;
+        } else if constexpr (std::is_same_v<T, int>) {
+            payload.i = value;
+        } else if constexpr (std::is_same_v<T, double>) {
+            payload.d = value;
+        } else if constexpr (std::is_same_v<T, std::vector<float>>) {
+            payload.v = new std::vector<float>(std::move(value));
+        } else {
+            payload.s = new std::string(std::move(value));
+        }
+        assignSlot(key, Property<T>::typeId(), payload);
+    }
+
+    bool erase(PropertyKey key);
+    void reserve(size_t entries);
+    void clear();
+
+    size_t size() const { return table ? table->size() : count; }
+    bool empty() const { return size() == 0; }
+
+    // Calls visit(PropertyKey, const T&) with each entry's stored type, in key
+    // order unless the map has switched to a hash table
+    template<typename Visitor>
+    void forEach(Visitor&& visit) const {
+        if (table) {
+            for (const auto& [key, slot] : *table) {
+                dispatch(key, slot.type, slot.payload, visit);
+            }
+            return;
+        }
+        const PropertyKey* keyArray = keys();
+        const uint8_t* typeArray = types();
+        const Payload* payloadArray = payloads();
+        for (uint32_t i = 0; i < count; ++i) {
+            dispatch(keyArray[i], typeArray[i], payloadArray[i], visit);
+        }
+    }
+
+    // Heap bytes owned by the map, including string values
+    size_t heapUsage() const;
+
+    // Copy whose keys are ids of the same names in to, which interns names it
+    // lacks; keys here are ids in from
+    PropertyMap rekeyed(const PropertyKeyDictionary& from, PropertyKeyDictionary& to) const;
+
+private:
+    union Payload {
+        bool b;
+        int i;
+        double d;
+        std::string* s;  // Owned
+        std::vector<float>* v;  // Owned
+    };
+
+    struct Slot {
+        uint8_t type;
+        Payload payload;
+    };
+
+    static constexpr size_t ENTRY_BYTES = sizeof(Payload) + sizeof(PropertyKey) + sizeof(uint8_t);
+
+    uint32_t count;
+    uint32_t capacity;
+    // Payloads, then keys, then type tags, each array sized for capacity
+    unsigned char* block;
+    std::unique_ptr<std::unordered_map<PropertyKey, Slot>> table;
+    alignas(Payload) unsigned char inlineBlock[INLINE_CAPACITY * ENTRY_BYTES];
+
+    Payload* payloads() const { return reinterpret_cast<Payload*>(block); }
+    PropertyKey* keys() const { return reinterpret_cast<PropertyKey*>(block + capacity * sizeof(Payload)); }
+    uint8_t* types() const { return block + capacity * (sizeof(Payload) + sizeof(PropertyKey)); }
+    bool isInline() const { return block == inlineBlock; }
+
+    uint32_t lowerBound(PropertyKey key) const {
+        const PropertyKey* keyArray = keys();
+        return std::lower_bound(keyArray, keyArray + count, key,
+                                [](PropertyKey a, PropertyKey b) { return a.id < b.id; }) - keyArray;
+    }
+
+    const Payload* locate(PropertyKey key, uint8_t& type) const {
+        if (table) {
+            auto it = table->find(key);
+            if (it == table->end()) {
+                return nullptr;
+            }
+            type = it->second.type;
+            return &it->second.payload;
+        }
+        uint32_t pos = lowerBound(key);
+        if (pos == count || keys()[pos] != key) {
+            return nullptr;
+        }
+        type = types()[pos];
+        return &payloads()[pos];
+    }
+
+    template<typename T>
+    static const T& valueOf(const Payload& payload) {
+        if constexpr (std::is_same_v<T, bool>) {
+            return payload.b;
+        } else if constexpr (std::is_same_v<T, int>) {
+            return payload.i;
+        } else if constexpr (std::is_same_v<T, double>) {
+            return payload.d;
+        } else if constexpr (std::is_same_v<T, std::vector<float>>) {
+            return *payload.v;
+        } else {
+            return *payload.s;
+        }
+    }
+
+    template<typename Visitor>
+    static void dispatch(PropertyKey key, uint8_t type, const Payload& payload, Visitor& visit) {
+        switch (type) {
+            case BoolProperty::typeId(): visit(key, payload.b); break;
+            case IntProperty::typeId(): visit(key, payload.i); break;
+            case DoubleProperty::typeId(): visit(key, payload.d); break;
+            case FloatVectorProperty::typeId(): visit(key, static_cast<const std::vector<float>&>(*payload.v)); break;
+            default: visit(key, static_cast<const std::string&>(*payload.s)); break;
+        }
+    }
+
+    // Takes ownership of payload's string or vector, if any
+    void assignSlot(PropertyKey key, uint8_t type, Payload payload);
+    static Payload copyPayload(uint8_t type, Payload payload);
+    static void releasePayload(uint8_t type, Payload payload);
+    void resetToInline();
+    // Frees strings and any heap arrays; leaves the map needing resetToInline
+    void releaseArrays();
+    void grow(uint32_t newCapacity);
+    void moveToTable();
+};
@@ -0,0 +1,134 @@
+// include/core/record_codec.hpp
+
+#pragma once
+
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "core/adjacency_list.hpp"
+#include "core/binary_codec.hpp"
+#include "core/edge_types.hpp"
+#include "core/property.hpp"
+#include "core/property_keys.hpp"
+#include "core/property_map.hpp"
+
+// First byte of every binary Node or Edge record. Legacy text records start
+// with an ASCII digit or '-', so the formats can share a data file.
+constexpr uint8_t RECORD_FORMAT_VERSION = 0xB3;
+
+inline bool isBinaryRecord(const char* data, size_t size) {
+    return size > 0 && static_cast<uint8_t>(data[0]) == RECORD_FORMAT_VERSION;
+}
+
+// Edge records store the id in the database's EdgeTypeRegistry, which it
+// persists alongside
+inline EdgeType decodeEdgeType(BinaryReader& reader, const EdgeTypeRegistry& registry) {
+    uint64_t typeId = reader.readVarint();
+    if (typeId >= registry.size()) {
+        throw std::runtime_error("Unknown edge type during deserialization");
+    }
+    return EdgeType{static_cast<uint32_t>(typeId)};
+}
+
+// Binary encoding of a record's properties, shared by Node and Edge:
+// a count, then for each entry the key id, a one-byte type tag and the value.
+// Key ids refer to the database's PropertyKeyDictionary, persisted alongside.
+inline void encodeProperties(const PropertyMap& properties, BinaryWriter& writer) {
+    writer.writeVarint(properties.size());
+    properties.forEach([&writer](PropertyKey key, const auto& value) {
+        using T = std::decay_t<decltype(value)>;
+        writer.writeVarint(key.id);
+        writer.writeByte(Property<T>::typeId());
+        Property<T>::encodeValue(value, writer);
+    });
+}
+
+inline void decodeProperties(BinaryReader& reader, const PropertyKeyDictionary& dictionary,
+                             PropertyMap& properties) {
+    uint64_t keyLimit = dictionary.size();
+    uint64_t count = reader.readCount();
+    properties.reserve(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t keyId = reader.readVarint();
+        if (keyId >= keyLimit) {
+            throw std::runtime_error("Unknown property key during deserialization");
+        }
+        PropertyKey key{static_cast<uint32_t>(keyId)};
+        switch (reader.readByte()) {
+            case BoolProperty::typeId():
+                properties.assign(key, BoolProperty::decodeValue(reader));
+                break;
+            case IntProperty::typeId():
+                properties.assign(key, IntProperty::decodeValue(reader));
+                break;
+            case DoubleProperty::typeId():
+                properties.assign(key, DoubleProperty::decodeValue(reader));
+                break;
+            case StringProperty::typeId():
+                properties.assign(key, StringProperty::decodeValue(reader));
+                break;
+            case FloatVectorProperty::typeId():
+                properties.assign(key, FloatVectorProperty::decodeValue(reader));
+                break;
+            default:
+                throw std::runtime_error("Unknown property type during deserialization");
+        }
+    }
+}
+
+// One direction of a node's adjacency: the total edge count and the number of
+// partitions, then for each partition its type id, edge count, and its ids
+// as a length-prefixed byte string of zigzag deltas from the previous id, so
+// runs of nearby edge ids take a byte or two each. The lengths let readers
+// jump to the partition of one type without stepping through the others.
+inline void encodeAdjacency(const std::vector<AdjacencyPartition>& partitions, BinaryWriter& writer) {
+    size_t total = 0;
+    for (const AdjacencyPartition& partition : partitions) {
+        total += partition.edges.size();
+    }
+    writer.writeVarint(total);
+    writer.writeVarint(partitions.size());
+    for (const AdjacencyPartition& partition : partitions) {
+        writer.writeVarint(partition.type.id);
+        writer.writeVarint(partition.edges.size());
+        size_t start = writer.size();
+        int64_t previous = 0;
+        for (int id : partition.edges) {
+            writer.writeSigned(id - previous);
+            previous = id;
+        }
+        writer.insertVarint(start, writer.size() - start);
+    }
+}
+
+inline void decodeAdjacency(BinaryReader& reader, const EdgeTypeRegistry& registry,
+                            std::vector<AdjacencyPartition>& partitions) {
+    partitions.clear();
+    uint64_t typeLimit = registry.size();
+    reader.readVarint();  // Total, for readers that do not decode the lists
+    uint64_t count = reader.readCount();
+    partitions.reserve(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t typeId = reader.readVarint();
+        if (typeId >= typeLimit) {
+            throw std::runtime_error("Unknown edge type during deserialization");
+        }
+        uint64_t size = reader.readVarint();
+        std::string_view deltas = reader.readString();
+        if (size > deltas.size()) {
+            throw std::runtime_error("Record data truncated");
+        }
+        BinaryReader listReader(deltas.data(), deltas.size());
+        std::vector<int> ids;
+        ids.reserve(size);
+        int64_t previous = 0;
+        for (uint64_t j = 0; j < size; ++j) {
+            previous += listReader.readSigned();
+            ids.push_back(static_cast<int>(previous));
+        }
+        partitions.emplace_back();
+        partitions.back().type = EdgeType{static_cast<uint32_t>(typeId)};
+        partitions.back().edges.assign(std::move(ids));
+    }
+}
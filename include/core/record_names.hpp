@@ -0,0 +1,32 @@
+// include/core/record_names.hpp
+
+#pragma once
+
+#include <string_view>
+#include "core/edge_types.hpp"
+#include "core/property_keys.hpp"
+
+// The property key and edge type names a set of records' ids refer to. Each
+// StorageEngine owns the names of its database and loads them from beside its
+// data files, so databases open in the same process hand out ids
+// independently. Records built outside any database use detached(), and a
+// database re-keys them into its own names when they are added.
+struct RecordNames {
+    PropertyKeyDictionary propertyKeys;
+    EdgeTypeRegistry edgeTypes;
+
+    // Names of records that belong to no database
+    static RecordNames& detached();
+};
+
+// Shorthand for RecordNames::detached().propertyKeys.intern(name). A
+// database's records use its own ids; see StorageEngine::propertyKey.
+inline PropertyKey propertyKey(std::string_view name) {
+    return RecordNames::detached().propertyKeys.intern(name);
+}
+
+// Shorthand for RecordNames::detached().edgeTypes.intern(name); see
+// StorageEngine::edgeType for a database's own ids
+inline EdgeType edgeType(std::string_view name) {
+    return RecordNames::detached().edgeTypes.intern(name);
+}
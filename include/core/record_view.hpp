@@ -0,0 +1,299 @@
+// include/core/record_view.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+#include "core/binary_codec.hpp"
+#include "core/edge.hpp"
+#include "core/edge_types.hpp"
+#include "core/node.hpp"
+#include "core/property.hpp"
+#include "core/property_keys.hpp"
+#include "core/property_map.hpp"
+#include "core/record_names.hpp"
+
+// Read-only views over binary Node and Edge records (see core/record_codec.hpp).
+// A view only checks the header when constructed and decodes other fields as
+// they are asked for, so reading one property or walking adjacency never
+// builds a Node. Views do not own their bytes: the buffer, or the mapped file
+// region, must outlive them, as must the RecordNames their ids refer to.
+// Records in the legacy text format cannot be viewed; the constructors throw
+// std::runtime_error for them.
+
+// Ids of a delta-encoded list, decoded one at a time while iterating. A
+// partitioned list spans every type partition of one adjacency direction and
+// steps over the partition headers as it goes.
+class IdListView {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int*;
+        using reference = int;
+
+        int operator*() const { return current; }
+        Iterator& operator++() {
+            if (--remaining > 0) {
+                next();
+            }
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return remaining == other.remaining; }
+        bool operator!=(const Iterator& other) const { return remaining != other.remaining; }
+
+    private:
+        friend class IdListView;
+        Iterator(BinaryReader reader, size_t remaining, size_t inPartition)
+            : reader(reader), remaining(remaining), inPartition(inPartition), current(0) {
+            if (remaining > 0) {
+                next();
+            }
+        }
+
+        void next() {
+            while (inPartition == 0) {
+                // Type id, edge count, byte length; deltas restart at each partition
+                reader.readVarint();
+                inPartition = reader.readVarint();
+                reader.readVarint();
+                current = 0;
+            }
+            --inPartition;
+            current += reader.readSigned();
+        }
+
+        BinaryReader reader;
+        size_t remaining;
+        // Ids left before the next partition header
+        size_t inPartition;
+        int64_t current;
+    };
+
+    IdListView() : data(nullptr), bytes(0), count(0), partitioned(false) {}
+    IdListView(const char* data, size_t bytes, size_t count, bool partitioned = false)
+        : data(data), bytes(bytes), count(count), partitioned(partitioned) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    Iterator begin() const { return Iterator(BinaryReader(data, bytes), count, partitioned ? 0 : count); }
+    Iterator end() const { return Iterator(BinaryReader(data, 0), 0, 0); }
+    std::vector<int> toVector() const { return std::vector<int>(begin(), end()); }
+
+private:
+    const char* data;
+    size_t bytes;
+    size_t count;
+    bool partitioned;
+};
+
+// The property section of a record. Lookups step over the entries before the
+// one asked for without decoding their values.
+class PropertiesView {
+public:
+    PropertiesView() : data(nullptr), bytes(0), count(0) {}
+    PropertiesView(const char* data, size_t bytes);
+
+    size_t size() const { return count; }
+    bool contains(PropertyKey key) const {
+        uint8_t type;
+        return locate(key, type) != nullptr;
+    }
+
+    // nullopt when key is not set. As with Node::getProperty, asking for a
+    // different type than was stored throws std::bad_variant_access.
+    // std::string_view reads a string in place.
+    template<typename T>
+    std::optional<T> find(PropertyKey key) const {
+        uint8_t type;
+        const char* value = locate(key, type);
+        if (value && type != Property<StoredPropertyType<T>>::typeId()) {
+            throw std::bad_variant_access();
+        }
+        return decode<T>(value);
+    }
+
+    // As find, but also nullopt when the value has another type
+    template<typename T>
+    std::optional<T> tryFind(PropertyKey key) const {
+        uint8_t type;
+        const char* value = locate(key, type);
+        return value && type == Property<StoredPropertyType<T>>::typeId() ? decode<T>(value) : std::nullopt;
+    }
+
+    // Copies the float vector stored under key into out, reusing its capacity,
+    // so a scan can read many records without allocating. False when key is
+    // not set; another type throws std::bad_variant_access as find does.
+    bool findFloats(PropertyKey key, std::vector<float>& out) const {
+        uint8_t type;
+        const char* value = locate(key, type);
+        if (!value) {
+            return false;
+        }
+        if (type != FloatVectorProperty::typeId()) {
+            throw std::bad_variant_access();
+        }
+        BinaryReader reader(value, data + bytes - value);
+        out.clear();
+        reader.readFloats(reader.readVarint(), out);
+        return true;
+    }
+
+    std::vector<PropertyKey> keys() const;
+    // First byte after the section
+    const char* end() const;
+
+private:
+    const char* data;  // First entry
+    size_t bytes;      // Up to the end of the record
+    size_t count;
+
+    // Start of the value stored for key, or nullptr
+    const char* locate(PropertyKey key, uint8_t& type) const;
+
+    template<typename T>
+    std::optional<T> decode(const char* value) const {
+        if (!value) {
+            return std::nullopt;
+        }
+        BinaryReader reader(value, data + bytes - value);
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            return reader.readString();
+        } else {
+            return Property<T>::decodeValue(reader);
+        }
+    }
+};
+
+class NodeView {
+public:
+    NodeView(const char* data, size_t size, RecordNames& names = RecordNames::detached());
+    explicit NodeView(std::string_view data, RecordNames& names = RecordNames::detached())
+        : NodeView(data.data(), data.size(), names) {}
+
+    int getId() const { return id; }
+
+    template<typename T>
+    T getProperty(PropertyKey key) const {
+        if (auto value = properties.find<T>(key)) {
+            return *value;
+        }
+        throw std::out_of_range("Property not found");
+    }
+
+    template<typename T>
+    T getProperty(std::string_view key) const {
+        if (auto handle = names->propertyKeys.find(key)) {
+            return getProperty<T>(*handle);
+        }
+        throw std::out_of_range("Property not found");
+    }
+
+    // nullopt when key is not set or holds another type
+    template<typename T>
+    std::optional<T> tryGetProperty(PropertyKey key) const { return properties.tryFind<T>(key); }
+    template<typename T>
+    std::optional<T> tryGetProperty(std::string_view key) const {
+        auto handle = names->propertyKeys.find(key);
+        return handle ? tryGetProperty<T>(*handle) : std::nullopt;
+    }
+
+    bool hasProperty(PropertyKey key) const { return properties.contains(key); }
+    bool hasProperty(std::string_view key) const;
+    const PropertiesView& getProperties() const { return properties; }
+
+    // Every edge in one direction, grouped by type as in Node
+    IdListView getIncomingEdges() const;
+    IdListView getOutgoingEdges() const;
+    // Only the partition of one type; the others are skipped by length
+    IdListView getIncomingEdges(EdgeType type) const;
+    IdListView getOutgoingEdges(EdgeType type) const;
+
+    // Decodes everything into a Node
+    Node toNode() const { return Node::deserialize(data, size, *names); }
+
+private:
+    const char* data;
+    size_t size;
+    RecordNames* names;
+    int id;
+    PropertiesView properties;
+
+    // One direction of adjacency
+    struct Adjacency {
+        IdListView all;
+        const char* partitions;
+        const char* end;
+    };
+    // Located on first adjacency access by stepping over the properties
+    mutable std::optional<Adjacency> incoming;
+    mutable std::optional<Adjacency> outgoing;
+
+    void locateAdjacency() const;
+    static IdListView findPartition(const Adjacency& adjacency, EdgeType type);
+};
+
+class EdgeView {
+public:
+    EdgeView(const char* data, size_t size, RecordNames& names = RecordNames::detached());
+    explicit EdgeView(std::string_view data, RecordNames& names = RecordNames::detached())
+        : EdgeView(data.data(), data.size(), names) {}
+
+    int getId() const { return id; }
+    int getSourceNodeId() const { return sourceNodeId; }
+    int getTargetNodeId() const { return targetNodeId; }
+    std::string_view getType() const { return type; }
+    EdgeType getTypeId() const { return typeId; }
+
+    template<typename T>
+    T getProperty(PropertyKey key) const {
+        if (auto value = properties.find<T>(key)) {
+            return *value;
+        }
+        throw std::out_of_range("Property not found");
+    }
+
+    template<typename T>
+    T getProperty(std::string_view key) const {
+        if (auto handle = names->propertyKeys.find(key)) {
+            return getProperty<T>(*handle);
+        }
+        throw std::out_of_range("Property not found");
+    }
+
+    // nullopt when key is not set or holds another type
+    template<typename T>
+    std::optional<T> tryGetProperty(PropertyKey key) const { return properties.tryFind<T>(key); }
+    template<typename T>
+    std::optional<T> tryGetProperty(std::string_view key) const {
+        auto handle = names->propertyKeys.find(key);
+        return handle ? tryGetProperty<T>(*handle) : std::nullopt;
+    }
+
+    bool hasProperty(PropertyKey key) const { return properties.contains(key); }
+    bool hasProperty(std::string_view key) const;
+    const PropertiesView& getProperties() const { return properties; }
+
+    Edge toEdge() const { return Edge::deserialize(data, size, *names); }
+
+private:
+    const char* data;
+    size_t size;
+    RecordNames* names;
+    int id;
+    int sourceNodeId;
+    int targetNodeId;
+    EdgeType typeId;
+    // Into names
+    std::string_view type;
+    PropertiesView properties;
+};
@@ -0,0 +1,26 @@
+// include/core/set_intersection.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "core/vector_kernels.hpp"
+
+// Intersection kernels over sorted arrays of distinct ids, such as neighbor
+// lists. Lists of similar length are merged block by block, comparing every
+// id of one SIMD block against every id of the other at once; when one list
+// is much longer than the other, each id of the short one is found in the
+// long one by galloping (exponential then binary search), which costs
+// O(m log(n / m)) instead of O(m + n). The SIMD level is picked once at
+// startup, as for the vector kernels.
+
+// |a ∩ b|
+size_t intersectionSize(const int* a, size_t aSize, const int* b, size_t bSize);
+// Appends a ∩ b to out in ascending order
+void intersect(const int* a, size_t aSize, const int* b, size_t bSize, std::vector<int>& out);
+
+// Same, with the merge kernel of a given level and galloping off; levels the
+// CPU lacks fall back to the best it has. For tests and benchmarks.
+size_t intersectionSize(const int* a, size_t aSize, const int* b, size_t bSize, SimdLevel level);
+// Galloping only, whatever the sizes
+size_t gallopingIntersectionSize(const int* a, size_t aSize, const int* b, size_t bSize);
@@ -0,0 +1,40 @@
+// include/core/similarity_search.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "core/node.hpp"
+#include "core/property_keys.hpp"
+#include "core/vector_kernels.hpp"
+
+class StorageEngine;
+
+enum class SimilarityMetric { Dot, Cosine, L2 };
+
+struct SimilarityMatch {
+    int nodeId;
+    // Dot product or cosine similarity, where higher is closer; for L2 the
+    // squared distance, where lower is closer
+    float score;
+};
+
+// Brute-force k nearest nodes to query by the float vector stored under key,
+// closest first, ties broken by node id. Nodes without the property or with
+// a vector of another dimension are skipped, as are those scoring NaN; a
+// value of another type throws std::bad_variant_access as getProperty does.
+// The nodes are split into threadCount slices scanned in parallel, 0 meaning
+// one per hardware thread.
+std::vector<SimilarityMatch> topKSimilar(const std::vector<std::shared_ptr<Node>>& nodes, PropertyKey key,
+                                        const std::vector<float>& query, size_t k,
+                                        SimilarityMetric metric = SimilarityMetric::Cosine,
+                                        size_t threadCount = 0);
+
+// The same search over every node stored in engine, read through
+// StorageEngine::scanNodes: each vector is copied straight out of the mapped
+// record into a per-thread buffer, so no Node is built or cached. Keys come
+// from engine.propertyKey.
+std::vector<SimilarityMatch> topKSimilar(StorageEngine& engine, PropertyKey key, const std::vector<float>& query,
+                                        size_t k, SimilarityMetric metric = SimilarityMetric::Cosine,
+                                        size_t threadCount = 0);
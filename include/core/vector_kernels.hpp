@@ -0,0 +1,28 @@
+// include/core/vector_kernels.hpp
+
+#pragma once
+
+#include <cstddef>
+
+// Distance kernels over float vectors such as embeddings. Each kernel has
+// AVX-512, AVX2+FMA and scalar versions; the best one the CPU supports is
+// picked once at startup, so the binary does not need to be built with any
+// particular -m flags. Summation order differs between levels, so results
+// can differ in the last few bits.
+
+// Instruction sets the kernels can use, in increasing order of width
+enum class SimdLevel { Scalar, Avx2, Avx512 };
+
+SimdLevel detectedSimdLevel();
+const char* simdLevelName(SimdLevel level);
+
+float dotProduct(const float* a, const float* b, size_t size);
+float squaredL2Distance(const float* a, const float* b, size_t size);
+// Zero when either vector is all zeros
+float cosineSimilarity(const float* a, const float* b, size_t size);
+
+// Same, at a given level; levels the CPU lacks fall back to the best it has.
+// For tests and benchmarks.
+float dotProduct(const float* a, const float* b, size_t size, SimdLevel level);
+float squaredL2Distance(const float* a, const float* b, size_t size, SimdLevel level);
+float cosineSimilarity(const float* a, const float* b, size_t size, SimdLevel level);
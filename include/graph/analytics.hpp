@@ -0,0 +1,111 @@
+// include/graph/analytics.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "core/vector_kernels.hpp"
+#include "graph/csr_graph.hpp"
+#include "storage/storage_engine.hpp"
+
+// Whole-graph analytics over CSR snapshots. Every pass splits the node range
+// into chunks that threads take from a shared cursor, so hubs do not hold up
+// a statically assigned slice. Results are indexed by node id over the
+// snapshot's node range and can be stored on the nodes with
+// writeNodeProperty.
+
+struct PageRankOptions {
+    double damping = 0.85;
+    // Stop once the ranks change by less than this in total (L1) in one iteration
+    double tolerance = 1e-6;
+    int maxIterations = 100;
+    // 0 means one per hardware thread
+    size_t threadCount = 0;
+    // Widest instruction set for summing contributions; levels the CPU lacks
+    // fall back to the best it has
+    SimdLevel simdLevel = SimdLevel::Avx512;
+};
+
+struct PageRankResult {
+    // Sum to 1 over the node range
+    std::vector<double> ranks;
+    int iterations = 0;
+    // Total change in the last iteration
+    double delta = 0;
+    bool converged = false;
+};
+
+// Pull-based PageRank: each iteration every node sums rank / out-degree over
+// the rows of an Incoming snapshot, gathering several contributions per
+// instruction. The rank of nodes without outgoing edges is spread evenly
+// over all nodes. Partial sums are combined in a fixed order, so ranks only
+// depend on the SIMD level, not on the thread count. Throws
+// std::invalid_argument for an Outgoing snapshot.
+PageRankResult pageRank(const CsrGraph& incoming, const PageRankOptions& options = {});
+
+struct ComponentOptions {
+    // Afforest samples this many neighbors of every node before looking for
+    // the largest component
+    int neighborRounds = 2;
+    size_t threadCount = 0;
+};
+
+struct ComponentResult {
+    // Smallest node id in each node's component
+    std::vector<int> components;
+    size_t componentCount = 0;
+};
+
+// Weakly connected components by Afforest (Sutton et al.), a sampling
+// refinement of Shiloach-Vishkin over a lock-free union-find. After linking a
+// few neighbors per node, the most common component is identified from a
+// sample and its nodes are skipped in the final pass. Skipping needs each
+// node's edges in both directions, so it only happens with an incoming
+// snapshot of the same graph; without one every edge is still visited.
+// Throws std::invalid_argument for an incoming snapshot of another shape.
+ComponentResult weaklyConnectedComponents(const CsrGraph& graph, const ComponentOptions& options = {},
+                                          const CsrGraph* incoming = nullptr);
+
+struct LabelPropagationOptions {
+    int maxIterations = 20;
+    size_t threadCount = 0;
+};
+
+struct LabelPropagationResult {
+    // Community label per node, the id of a node in the community
+    std::vector<int> labels;
+    size_t communityCount = 0;
+    int iterations = 0;
+    // True when an iteration changed no label
+    bool converged = false;
+};
+
+// Synchronous label propagation: every node starts in its own community, and
+// each iteration takes the most frequent label among its neighbors and
+// itself, the smallest on ties. Counting the node's own label keeps pairs
+// from swapping labels forever. Neighbors are the node's row in graph plus,
+// with an incoming snapshot, its row there, so communities follow edges in
+// both directions. Deterministic for any thread count. Throws
+// std::invalid_argument for an incoming snapshot of another shape.
+LabelPropagationResult labelPropagation(const CsrGraph& graph, const LabelPropagationOptions& options = {},
+                                        const CsrGraph* incoming = nullptr);
+
+// Stores values[v] as property key on every stored node v in the range of
+// values, through one StorageEngine::updateNodes call. T is int or double.
+// Returns the number of nodes written.
+template<typename T>
+size_t writeNodeProperty(StorageEngine& engine, PropertyKey key, const std::vector<T>& values) {
+    static_assert(std::is_same_v<T, int> || std::is_same_v<T, double>, "Analytics results are int or double");
+    std::vector<int> nodeIds(values.size());
+    for (size_t i = 0; i < nodeIds.size(); ++i) {
+        nodeIds[i] = static_cast<int>(i);
+    }
+    return engine.updateNodes(nodeIds, [&](Node& node) { node.setProperty(key, values[node.getId()]); });
+}
+
+template<typename T>
+size_t writeNodeProperty(StorageEngine& engine, std::string_view key, const std::vector<T>& values) {
+    return writeNodeProperty(engine, engine.propertyKey(key), values);
+}
@@ -0,0 +1,146 @@
+// include/graph/csr_graph.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "core/edge_types.hpp"
+#include "storage/mapped_file.hpp"
+#include "storage/storage_engine.hpp"
+
+// Which end of each stored edge a row belongs to
+enum class CsrDirection {
+    // Row v holds the edges leaving v, listing their targets
+    Outgoing,
+    // Row v holds the edges entering v, listing their sources
+    Incoming
+};
+
+struct CsrOptions {
+    CsrDirection direction = CsrDirection::Outgoing;
+    // Keep each edge's type id alongside its target
+    bool edgeTypes = false;
+    // Numeric edge property copied into a weight array; empty for no weights
+    std::string weightProperty;
+    // Weight of edges without the property or with a non-numeric value
+    double defaultWeight = 1.0;
+    // Build threads; 0 means one per hardware thread
+    size_t threadCount = 0;
+};
+
+// Read-only compressed-sparse-row snapshot of the stored graph's adjacency,
+// for analytics that would otherwise pay a cache lookup and possibly a disk
+// read per hop. The edges leaving node v (entering it, for an Incoming
+// snapshot) are positions [offsets[v], offsets[v + 1]) of the per-edge
+// arrays, ordered by the node at their other end and then edge id. Node ids index offsets directly; ids without edges simply
+// have an empty range.
+//
+// A snapshot is either built from an engine or mapped from a file written by
+// save(), in which case the arrays are read in place.
+class CsrGraph {
+public:
+    // Contiguous run of one node's entries in a per-edge array
+    template<typename T>
+    class Range {
+    public:
+        Range(const T* first, const T* last) : first(first), last(last) {}
+        const T* begin() const { return first; }
+        const T* end() const { return last; }
+        size_t size() const { return last - first; }
+        bool empty() const { return first == last; }
+        const T& operator[](size_t index) const { return first[index]; }
+
+    private:
+        const T* first;
+        const T* last;
+    };
+
+    CsrGraph();
+    CsrGraph(CsrGraph&&) = default;
+    CsrGraph& operator=(CsrGraph&&) = default;
+    // The arrays may live in a mapping, so copies are explicit through build or load
+    CsrGraph(const CsrGraph&) = delete;
+    CsrGraph& operator=(const CsrGraph&) = delete;
+
+    // Scans every stored edge in parallel through StorageEngine::scanEdges
+    static CsrGraph build(StorageEngine& engine, const CsrOptions& options = {});
+
+    // Catches up with what the engine's change log recorded since this
+    // snapshot was built or last refreshed: new edges are merged in and the
+    // weights of updated ones are re-read, without reading unchanged edges
+    // again. Rebuilds from scratch when the log no longer reaches back that
+    // far or belongs to another engine, e.g. after load() in a new process.
+    void refresh(StorageEngine& engine);
+
+    size_t nodeCount() const { return nodes; }
+    size_t edgeCount() const { return edges; }
+    bool isIncoming() const { return options.direction == CsrDirection::Incoming; }
+    bool hasEdgeTypes() const { return options.edgeTypes; }
+    bool hasWeights() const { return !options.weightProperty.empty(); }
+    const CsrOptions& getOptions() const { return options; }
+
+    size_t degree(int node) const { return offsetArray[node + 1] - offsetArray[node]; }
+    // Targets of an Outgoing snapshot's rows, sources of an Incoming one's
+    Range<int> neighbors(int node) const { return rangeOf(targetArray, node); }
+    Range<int> edgeIds(int node) const { return rangeOf(edgeIdArray, node); }
+    // Only when built with edgeTypes / a weightProperty
+    Range<EdgeType> edgeTypes(int node) const { return rangeOf(typeArray, node); }
+    Range<double> weights(int node) const { return rangeOf(weightArray, node); }
+
+    // Whole arrays: nodeCount() + 1 offsets, edgeCount() of the others
+    const uint64_t* offsets() const { return offsetArray; }
+    const int* targets() const { return targetArray; }
+    const int* edgeIds() const { return edgeIdArray; }
+    const EdgeType* edgeTypes() const { return typeArray; }
+    const double* weights() const { return weightArray; }
+
+    // Writes the arrays to path in the layout load() maps, replacing the
+    // file atomically. The change-log position is saved too.
+    void save(const std::string& path) const;
+    // Throws std::runtime_error for a file that is not a saved snapshot, or
+    // whose offsets decrease or whose targets fall outside the node range
+    static CsrGraph load(const std::string& path);
+
+private:
+    CsrOptions options;
+    size_t nodes;
+    size_t edges;
+    // Engine state the snapshot reflects
+    uint64_t logId;
+    uint64_t changeSequence;
+    int edgeIdLimit;
+
+    // Owned arrays; empty when the snapshot is mapped
+    std::vector<uint64_t> ownedOffsets;
+    std::vector<int> ownedTargets;
+    std::vector<int> ownedEdgeIds;
+    std::vector<EdgeType> ownedTypes;
+    std::vector<double> ownedWeights;
+    std::unique_ptr<MappedFile> mapping;
+
+    // Into the owned arrays or the mapping
+    const uint64_t* offsetArray;
+    const int* targetArray;
+    const int* edgeIdArray;
+    const EdgeType* typeArray;
+    const double* weightArray;
+
+    // One edge as scanned, before it is placed in its row
+    struct Entry;
+
+    template<typename T>
+    Range<T> rangeOf(const T* array, int node) const {
+        return Range<T>(array + offsetArray[node], array + offsetArray[node + 1]);
+    }
+    // Points the arrays at the owned vectors
+    void attachOwned();
+    // Copies mapped arrays into owned ones so they can be modified
+    void ensureOwned();
+    // Fills the owned arrays from entries scanned by several threads
+    void assemble(std::vector<std::vector<Entry>>& batches, size_t nodeCount);
+    // Adds new edges, sorted by source, and grows the node range to nodeCount
+    void merge(std::vector<Entry>& added, size_t nodeCount);
+};
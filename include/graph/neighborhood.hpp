@@ -0,0 +1,61 @@
+// include/graph/neighborhood.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "graph/csr_graph.hpp"
+
+// Undirected, simple view of a snapshot's adjacency for neighborhood
+// queries: for every node the ascending, distinct ids of its neighbors, with
+// self loops and parallel edges dropped. Common-neighbor and similarity
+// queries and triangle counting are then intersections of two such lists;
+// see core/set_intersection.hpp.
+class NeighborSets {
+public:
+    NeighborSets() = default;
+
+    // Neighbors are the node's row in graph plus, with an incoming snapshot
+    // of the same graph, its row there, so each edge makes its ends
+    // neighbors of each other. Built on threadCount threads (0 means one per
+    // hardware thread). Throws std::invalid_argument for an incoming
+    // snapshot of another shape.
+    static NeighborSets build(const CsrGraph& graph, const CsrGraph* incoming = nullptr, size_t threadCount = 0);
+
+    size_t nodeCount() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    // Sum of the list lengths; twice the undirected edges when built with incoming
+    size_t entryCount() const { return ids.size(); }
+    // Whether every list has its reverse entries, which takes an incoming
+    // snapshot; without one, b may be in a's list while a is not in b's
+    bool isUndirected() const { return undirected; }
+    size_t degree(int node) const { return offsets[node + 1] - offsets[node]; }
+    CsrGraph::Range<int> neighbors(int node) const {
+        return CsrGraph::Range<int>(ids.data() + offsets[node], ids.data() + offsets[node + 1]);
+    }
+
+    // The queries below throw std::invalid_argument for a node outside the
+    // node range
+    size_t commonNeighborCount(int a, int b) const;
+    // Ascending
+    std::vector<int> commonNeighbors(int a, int b) const;
+    // |N(a) ∩ N(b)| / |N(a) ∪ N(b)|; 0 when neither has neighbors
+    double jaccard(int a, int b) const;
+
+private:
+    std::vector<uint64_t> offsets;
+    std::vector<int> ids;
+    // An empty set is trivially symmetric
+    bool undirected = true;
+
+    void checkNode(int node) const;
+};
+
+// Triangles in the undirected graph neighbors describes. Each edge is kept
+// only from its endpoint of lower degree (then lower id), which bounds every
+// kept list by the square root of the edge count, and each triangle is found
+// once, from its lowest node, by intersecting two kept lists. Nodes are taken
+// in chunks from a shared cursor by threadCount threads (0 means one per
+// hardware thread). The filtering assumes symmetric lists, so this throws
+// std::invalid_argument for sets built without an incoming snapshot.
+uint64_t countTriangles(const NeighborSets& neighbors, size_t threadCount = 0);
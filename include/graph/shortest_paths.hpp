@@ -0,0 +1,56 @@
+// include/graph/shortest_paths.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "graph/csr_graph.hpp"
+
+// Weighted shortest paths over a CSR snapshot built with a weight property,
+// so weights come from its contiguous weight array rather than from each
+// edge's property map. Weights must be finite and not negative; a negative,
+// infinite or NaN weight met during a search throws std::invalid_argument, as
+// do a snapshot without weights and a node outside its range.
+
+struct ShortestPath {
+    // Infinity when target cannot be reached from source
+    double distance = std::numeric_limits<double>::infinity();
+    // source, ..., target; empty when unreachable
+    std::vector<int> nodes;
+    // The edge taken out of each node but the last
+    std::vector<int> edgeIds;
+};
+
+// Point-to-point query. With an Incoming snapshot of the same graph as
+// incoming, searches forward from source and backward from target at once,
+// always advancing the side whose next node is closer, and stops once the
+// two frontiers' distances add up to the best path seen; otherwise runs
+// Dijkstra from source until target is settled. Both keep their queue in a
+// 4-ary heap and reuse per-thread distance arrays, clearing only the
+// entries a query touched.
+ShortestPath shortestPath(const CsrGraph& graph, int source, int target, const CsrGraph* incoming = nullptr);
+
+struct ShortestPathOptions {
+    // Bucket width for delta-stepping. Edges up to delta long are relaxed
+    // repeatedly within a bucket, longer ones once the bucket is done. 0 picks
+    // the largest weight over the average degree.
+    double delta = 0;
+    bool recordParents = false;
+    // 0 means one thread per hardware thread
+    size_t threadCount = 0;
+};
+
+struct ShortestPathTree {
+    // Per node id; infinity for nodes source cannot reach
+    std::vector<double> distances;
+    // Only with recordParents: the previous node and edge on a shortest path
+    // to each node, -1 for source and unreachable nodes
+    std::vector<int> parents;
+    std::vector<int> parentEdges;
+};
+
+// Single-source distances by parallel delta-stepping: nodes are settled
+// bucket by bucket in order of distance, and each bucket's relaxations run
+// on several threads with lock-free distance updates.
+ShortestPathTree shortestPathTree(const CsrGraph& graph, int source, const ShortestPathOptions& options = {});
@@ -0,0 +1,60 @@
+// include/graph/spanning_forest.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "graph/csr_graph.hpp"
+#include "storage/storage_engine.hpp"
+
+// One undirected edge as the spanning-forest algorithms see it
+struct WeightedEdge {
+    double weight;
+    int source;
+    int target;
+    int id;
+};
+
+struct SpanningForest {
+    // Ids of the chosen edges, ascending
+    std::vector<int> edgeIds;
+    double totalWeight = 0;
+    // Trees in the forest, counting every node id below the node count that
+    // no edge touches as a tree of its own
+    size_t componentCount = 0;
+};
+
+enum class SpanningForestAlgorithm {
+    // Parallel sort, then a filter-Kruskal pass: batches of the sorted edges
+    // drop those already inside one tree in parallel, and the rest are joined
+    // in order. Fast when the forest fills up early in the sorted order.
+    Kruskal,
+    // Every tree picks its lightest outgoing edge in parallel and all picks
+    // are joined at once; the number of trees at least halves per round.
+    // Needs no global sort, which suits very large edge lists.
+    Boruvka,
+};
+
+// Minimum spanning forest of the undirected graph over node ids
+// [0, nodeCount). Equal weights are ordered by edge id, which makes the
+// forest unique, so both algorithms return the same edges. Self-loops and
+// edges with a NaN weight are ignored. threadCount 0 means one thread per
+// hardware thread. Throws std::invalid_argument for an endpoint outside
+// the node range.
+SpanningForest minimumSpanningForest(size_t nodeCount, std::vector<WeightedEdge> edges,
+                                     SpanningForestAlgorithm algorithm = SpanningForestAlgorithm::Kruskal,
+                                     size_t threadCount = 0);
+
+// Over a snapshot built with a weight property; edge direction is ignored.
+// Throws std::invalid_argument for a snapshot without weights.
+SpanningForest minimumSpanningForest(const CsrGraph& graph,
+                                     SpanningForestAlgorithm algorithm = SpanningForestAlgorithm::Kruskal,
+                                     size_t threadCount = 0);
+
+// Over every stored edge, weighted by the numeric property weightProperty.
+// Records are decoded in place through StorageEngine::scanEdges without
+// building Edge objects; edges without a numeric weight are left out.
+SpanningForest minimumSpanningForest(StorageEngine& engine, const std::string& weightProperty,
+                                     SpanningForestAlgorithm algorithm = SpanningForestAlgorithm::Kruskal,
+                                     size_t threadCount = 0);
@@ -0,0 +1,75 @@
+// include/graph/traversal.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "graph/csr_graph.hpp"
+#include "storage/storage_engine.hpp"
+
+struct TraversalOptions {
+    // Hops to expand from the sources; k for a k-hop neighborhood
+    int maxDepth = std::numeric_limits<int>::max();
+    // Stop once this many nodes were reached, sources included; 0 for no limit
+    size_t limit = 0;
+    // Stop as soon as this node is reached; -1 for none
+    int target = -1;
+    bool recordParents = false;
+    // Threads for snapshot traversals; 0 means one per hardware thread
+    size_t threadCount = 0;
+    // Direction switching (Beamer et al.): a snapshot traversal goes bottom-up
+    // once the frontier's edges exceed 1/alpha of the edges of unreached
+    // nodes, and back top-down once the frontier falls below 1/beta of the
+    // nodes
+    double alpha = 15;
+    double beta = 18;
+};
+
+struct TraversalResult {
+    // Reached nodes level by level, the sources first. Within a level the
+    // order is unspecified when several threads took part.
+    std::vector<int> nodes;
+    // Hops from the nearest source, per entry of nodes
+    std::vector<int> depths;
+    // Per entry of nodes, only with recordParents: a neighbor one level
+    // closer to the sources through which the node was reached, -1 for sources
+    std::vector<int> parents;
+    // Adjacency entries looked at, for throughput in traversed edges per second
+    size_t edgesExamined = 0;
+    // Levels expanded bottom-up rather than top-down
+    size_t bottomUpLevels = 0;
+    // True when limit or target ended the traversal before it ran out of
+    // nodes or levels. With a limit, the last level is cut to fit.
+    bool stoppedEarly = false;
+};
+
+// Level-synchronous breadth-first search over a CSR snapshot. Each level is
+// expanded by several threads that take chunks of work from a shared cursor,
+// either top-down from the frontier's rows or, with an Incoming snapshot of
+// the same graph as incoming, bottom-up by letting every unreached node look
+// for a frontier node among its in-neighbors. Which one runs is chosen per
+// level from the frontier's size. Follows graph's rows, so an Incoming graph
+// walks edges backwards. Throws std::invalid_argument for a source outside
+// the node range or an incoming snapshot of another shape.
+TraversalResult breadthFirstSearch(const CsrGraph& graph, const std::vector<int>& sources,
+                                   const TraversalOptions& options = {}, const CsrGraph* incoming = nullptr);
+
+// The same search over outgoing edges in the store, reading nodes and edges
+// through viewNode and viewEdge so no record is materialised. Runs on the
+// calling thread, as the engine serves one caller at a time; threadCount,
+// alpha and beta are ignored. Throws std::runtime_error for an unknown source.
+TraversalResult breadthFirstSearch(StorageEngine& engine, const std::vector<int>& sources,
+                                   const TraversalOptions& options = {});
+
+// Nodes within hops of source
+inline TraversalResult kHopNeighborhood(const CsrGraph& graph, int source, int hops,
+                                        TraversalOptions options = {}, const CsrGraph* incoming = nullptr) {
+    options.maxDepth = hops;
+    return breadthFirstSearch(graph, {source}, options, incoming);
+}
+
+inline TraversalResult kHopNeighborhood(StorageEngine& engine, int source, int hops, TraversalOptions options = {}) {
+    options.maxDepth = hops;
+    return breadthFirstSearch(engine, {source}, options);
+}
@@ -0,0 +1,79 @@
+// include/graph/union_find.hpp
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Disjoint sets over ids [0, size) that any number of threads may find and
+// unite at once without locks. A union links the root with the larger id
+// under the smaller one with a single compare-and-swap, retrying if another
+// thread moved either root first; finds halve their path with relaxed
+// stores, which only ever point a node at one of its ancestors.
+class ConcurrentUnionFind {
+public:
+    explicit ConcurrentUnionFind(size_t size) : parent(new std::atomic<int>[size]), count(size) {
+        for (size_t i = 0; i < size; ++i) {
+            parent[i].store(static_cast<int>(i), std::memory_order_relaxed);
+        }
+    }
+
+    size_t size() const { return count; }
+
+    int find(int id) {
+        while (true) {
+            int next = parent[id].load(std::memory_order_relaxed);
+            if (next == id) {
+                return id;
+            }
+            int grandparent = parent[next].load(std::memory_order_relaxed);
+            if (grandparent != next) {
+                // A failed swap means another thread moved id up already;
+                // either way the walk goes on from next's current parent
+                int expected = next;
+                parent[id].compare_exchange_weak(expected, grandparent, std::memory_order_relaxed);
+            }
+            id = next;
+        }
+    }
+
+    // false when a and b were already in the same set, including when
+    // another thread joined them first
+    bool unite(int a, int b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) {
+                return false;
+            }
+            if (a > b) {
+                std::swap(a, b);
+            }
+            int expected = b;
+            if (parent[b].compare_exchange_strong(expected, a, std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+    }
+
+    bool sameSet(int a, int b) {
+        // A root seen by the first find can be linked away before the second;
+        // retry until a's root is still a root
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) {
+                return true;
+            }
+            if (parent[a].load(std::memory_order_acquire) == a) {
+                return false;
+            }
+        }
+    }
+
+private:
+    std::unique_ptr<std::atomic<int>[]> parent;
+    size_t count;
+};
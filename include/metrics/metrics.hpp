@@ -0,0 +1,168 @@
+// include/metrics/metrics.hpp
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Process-wide counters and latency histograms for the cache and storage layers.
+// Each thread writes to its own shard with plain relaxed stores, so recording
+// never contends; snapshot() sums the shards.
+
+enum class Counter {
+    CACHE_NODE_HITS,
+    CACHE_NODE_MISSES,
+    CACHE_NODE_EVICTIONS,
+    CACHE_EDGE_HITS,
+    CACHE_EDGE_MISSES,
+    CACHE_EDGE_EVICTIONS,
+    INDEX_LOOKUPS,
+    INDEX_LOOKUP_LEVELS,  // B-tree levels visited, summed over lookups
+    BLOOM_NEGATIVES,  // Index lookups answered by the Bloom filter alone
+    BLOOM_FALSE_POSITIVES,  // Filter said "maybe" but the B-tree had no entry
+    BYTES_READ,
+    BYTES_WRITTEN,
+    WRITE_BACK_RECORDS,
+    WRITE_BACK_STALLS,  // Enqueues that blocked on the dirty-byte threshold
+    PREFETCH_ISSUED,
+    PREFETCH_LOADED,
+    PREFETCH_DROPPED,  // Requests refused because the prefetch queue was full
+    WARM_UP_PLANNED,  // Hot-set records the startup warm-up will load
+    WARM_UP_LOADED,
+    COUNT
+};
+
+enum class Histogram {
+    INDEX_LOOKUP,
+    NODE_DISK_READ,
+    EDGE_DISK_READ,
+    NODE_DESERIALIZE,
+    EDGE_DESERIALIZE,
+    COUNT
+};
+
+constexpr size_t COUNTER_COUNT = static_cast<size_t>(Counter::COUNT);
+constexpr size_t HISTOGRAM_COUNT = static_cast<size_t>(Histogram::COUNT);
+
+const char* counterName(Counter counter);
+const char* histogramName(Histogram histogram);
+
+// Log-linear buckets in the style of HdrHistogram: 16 linear sub-buckets per
+// power of two, so any recorded value is within ~6% of its bucket bound.
+class HistogramBuckets {
+public:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr size_t COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    static size_t indexOf(uint64_t value);
+    // Smallest value that maps to bucket index
+    static uint64_t lowerBound(size_t index);
+};
+
+struct HistogramSnapshot {
+    std::array<uint64_t, HistogramBuckets::COUNT> buckets{};
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t max = 0;
+
+    double mean() const;
+    // Approximate value at quantile q in [0, 1]
+    uint64_t percentile(double q) const;
+};
+
+struct MetricsSnapshot {
+    std::array<uint64_t, COUNTER_COUNT> counters{};
+    std::array<HistogramSnapshot, HISTOGRAM_COUNT> histograms;
+
+    uint64_t counter(Counter c) const { return counters[static_cast<size_t>(c)]; }
+    const HistogramSnapshot& histogram(Histogram h) const { return histograms[static_cast<size_t>(h)]; }
+
+    std::string toJson() const;
+    std::string toPrometheus() const;
+};
+
+class Metrics {
+public:
+    static bool enabled() { return enabledFlag.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enabled) { enabledFlag.store(enabled, std::memory_order_relaxed); }
+
+    // Inline so the hot path is a flag test and one thread-local add
+    static void increment(Counter counter, uint64_t amount = 1) {
+        if (!enabled()) {
+            return;
+        }
+        std::atomic<uint64_t>* counters = threadCounters;
+        if (counters == nullptr) {
+            counters = attachThread();
+        }
+        std::atomic<uint64_t>& value = counters[static_cast<size_t>(counter)];
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    static void record(Histogram histogram, uint64_t nanos);
+
+    static MetricsSnapshot snapshot();
+    static void reset();
+
+private:
+    static std::atomic<bool> enabledFlag;
+    // Counter array of the calling thread's shard, set on first use
+    static thread_local std::atomic<uint64_t>* threadCounters;
+
+    static std::atomic<uint64_t>* attachThread();
+};
+
+// Records the lifetime of the scope into a histogram; skips the clock when disabled
+class ScopedLatency {
+public:
+    explicit ScopedLatency(Histogram histogram)
+        : histogram(histogram), active(Metrics::enabled()) {
+        if (active) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ScopedLatency() {
+        if (active) {
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            Metrics::record(histogram, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+    }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    Histogram histogram;
+    bool active;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Periodically writes a metrics snapshot to a file, replacing it atomically
+class MetricsDumper {
+public:
+    enum class Format { JSON, PROMETHEUS };
+
+    MetricsDumper(const std::string& path, std::chrono::milliseconds interval, Format format);
+    ~MetricsDumper();
+
+    void dumpNow();
+
+private:
+    std::string path;
+    std::chrono::milliseconds interval;
+    Format format;
+    std::mutex mutex;
+    std::condition_variable stopSignal;
+    bool stopping;
+    std::thread worker;
+
+    void run();
+};
@@ -0,0 +1,53 @@
+// include/storage/adjacency_index.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "core/binary_codec.hpp"
+#include "core/edge_types.hpp"
+
+// One edge seen from one of its endpoints
+struct Neighbor {
+    int edgeId;
+    // The endpoint at the other end of the edge
+    int nodeId;
+
+    bool operator==(const Neighbor& other) const { return edgeId == other.edgeId && nodeId == other.nodeId; }
+};
+
+// Composite index from (node id, edge type) to the node's edges of that type
+// in one direction, stored as contiguous (edge id, other endpoint) pairs in
+// ascending edge id order. Typed one-hop expansion is then one hash probe and
+// a sequential read, without loading the node's adjacency or any Edge.
+// Not thread-safe.
+class AdjacencyIndex {
+public:
+    AdjacencyIndex() : entries(0) {}
+
+    // Ignores an edge id already filed under (nodeId, type)
+    void insert(int nodeId, EdgeType type, int edgeId, int otherNodeId);
+    // false if the edge was not filed under (nodeId, type)
+    bool erase(int nodeId, EdgeType type, int edgeId);
+    // Empty when the node has no edges of type
+    const std::vector<Neighbor>& find(int nodeId, EdgeType type) const;
+
+    // Filed (node, edge) pairs
+    size_t size() const { return entries; }
+    // Heap bytes owned by the index, approximately
+    size_t heapUsage() const;
+
+    void serialize(BinaryWriter& writer) const;
+    // Throws std::runtime_error for truncated data
+    static AdjacencyIndex deserialize(BinaryReader& reader);
+
+private:
+    size_t entries;
+    std::unordered_map<uint64_t, std::vector<Neighbor>> lists;
+
+    static uint64_t keyOf(int nodeId, EdgeType type) {
+        return static_cast<uint64_t>(static_cast<uint32_t>(nodeId)) << 32 | type.id;
+    }
+};
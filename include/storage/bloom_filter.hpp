@@ -0,0 +1,42 @@
+// include/storage/bloom_filter.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Split-block Bloom filter over integer ids. Every key maps to one 256-bit
+// block and sets one bit in each of its eight 32-bit words, so a probe touches
+// a single cache line and vectorizes to a handful of AVX2 instructions.
+// There are no deletes: removed keys keep answering "maybe" until a rebuild.
+class BloomFilter {
+public:
+    explicit BloomFilter(size_t expectedKeys = 1024, size_t bitsPerKey = 16);
+
+    void insert(int key);
+    // false means the key was definitely never inserted
+    bool mayContain(int key) const;
+    void clear();
+
+    // Number of keys the filter was sized for, and number inserted so far
+    size_t capacity() const { return expectedKeys; }
+    size_t size() const { return insertedKeys; }
+
+    std::string serialize() const;
+    static BloomFilter deserialize(const std::string& data);
+
+private:
+    struct alignas(32) Block {
+        uint32_t words[8];
+    };
+
+    size_t expectedKeys;
+    size_t bitsPerKey;
+    size_t insertedKeys;
+    std::vector<Block> blocks;
+
+    size_t blockIndex(uint64_t hash) const;
+    static uint64_t hashKey(int key);
+};
@@ -9,6 +9,8 @@
 #include <stdexcept>
 #include <iostream>
 #include <limits>
+#include <functional>
+#include <optional>
 
 class BTreeNode {
 public:
@@ -24,10 +26,24 @@ public:
     BTree(int t);
     ~BTree();
 
+    // Owns its nodes, so it moves but does not copy
+    BTree(const BTree&) = delete;
+    BTree& operator=(const BTree&) = delete;
+    BTree(BTree&& other) noexcept;
+    BTree& operator=(BTree&& other) noexcept;
+
     void insert(int key, long value);
     long search(int key) const;
+    // Also reports how many tree levels the lookup visited
+    long search(int key, int& depth) const;
+    // Non-throwing lookup: nullopt when the key is absent
+    std::optional<long> find(int key) const;
+    std::optional<long> find(int key, int& depth) const;
+    // Visits every key/value pair in ascending key order
+    void forEach(const std::function<void(int, long)>& visit) const;
     void remove(int key);
-    bool isEmpty() const { return root == nullptr; }
+    int maxKey() const;
+    bool isEmpty() const;
     std::string serialize() const;
     static BTree deserialize(const std::string& data);
 
@@ -36,7 +52,7 @@ public:
     void printTree() const;
 
     // Setter for root
-    void setRoot(BTreeNode* newRoot) { root = newRoot; }
+    void setRoot(BTreeNode* newRoot);
 
 private:
     BTreeNode* root;
@@ -44,7 +60,8 @@ private:
 
     void splitChild(BTreeNode* parent, int index, BTreeNode* child);
     void insertNonFull(BTreeNode* node, int key, long value);
-    long searchInternal(BTreeNode* node, int key) const;
+    std::optional<long> searchInternal(BTreeNode* node, int key, int& depth) const;
+    void forEachInternal(BTreeNode* node, const std::function<void(int, long)>& visit) const;
     void removeInternal(BTreeNode* node, int key);
     void deleteTree(BTreeNode* node);
 
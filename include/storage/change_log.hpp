@@ -0,0 +1,45 @@
+// include/storage/change_log.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// Ids of records added or updated through the engine, in order, so that
+// derived copies such as graph snapshots can catch up without rescanning
+// everything. Each change gets the next sequence number; a consumer keeps
+// the sequence() it has caught up to and asks for what came after. Only the
+// last capacity changes are retained, so a consumer that falls further
+// behind has to rebuild from scratch.
+//
+// Sequence numbers start over in every process; getId() is random per log
+// so a consumer can tell that a position it saved belongs to another one.
+class ChangeLog {
+public:
+    enum class Kind : uint8_t { NODE, EDGE };
+
+    struct Change {
+        Kind kind;
+        int id;
+    };
+
+    explicit ChangeLog(size_t capacity = size_t{1} << 20);
+
+    void record(Kind kind, int id);
+    // Sequence number the next change will get
+    uint64_t sequence() const { return firstSequence + entries.size(); }
+    uint64_t getId() const { return logId; }
+
+    // Appends the changes numbered from onwards to out, oldest first. Returns
+    // false, appending nothing, when some of them are no longer retained or
+    // from is past sequence().
+    bool changesSince(uint64_t from, std::vector<Change>& out) const;
+
+private:
+    std::deque<Change> entries;
+    uint64_t firstSequence;
+    size_t capacity;
+    uint64_t logId;
+};
@@ -0,0 +1,140 @@
+// include/storage/column_store.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "core/node.hpp"
+#include "core/property_keys.hpp"
+#include "core/record_view.hpp"
+#include "core/vector_kernels.hpp"
+
+// One bit per node id, as produced by a column filter. Bits at or past size()
+// are always clear, so bitmaps of different sizes combine as if padded with zeros.
+class SelectionBitmap {
+public:
+    SelectionBitmap() : bitCount(0) {}
+    // size bits, all clear
+    explicit SelectionBitmap(size_t size) : bitCount(size), words((size + 63) / 64, 0) {}
+
+    size_t size() const { return bitCount; }
+    bool test(size_t id) const { return id < bitCount && (words[id / 64] >> (id % 64) & 1); }
+    // Grows the bitmap when id is past its end
+    void set(size_t id);
+    // Number of set bits
+    size_t count() const;
+
+    SelectionBitmap& operator&=(const SelectionBitmap& other);
+    SelectionBitmap& operator|=(const SelectionBitmap& other);
+    // Clears the bits set in other
+    SelectionBitmap& subtract(const SelectionBitmap& other);
+
+    // Calls visit(id) for each set bit in ascending order
+    template<typename Visitor>
+    void forEach(Visitor&& visit) const {
+        for (size_t w = 0; w < words.size(); ++w) {
+            for (uint64_t bits = words[w]; bits; bits &= bits - 1) {
+                visit(static_cast<int>(w * 64 + __builtin_ctzll(bits)));
+            }
+        }
+    }
+    std::vector<int> toIds() const;
+
+    // 64 ids per word, id 0 in the lowest bit of the first one
+    const std::vector<uint64_t>& getWords() const { return words; }
+    std::vector<uint64_t>& getWords() { return words; }
+
+private:
+    size_t bitCount;
+    std::vector<uint64_t> words;
+};
+
+inline SelectionBitmap operator&(SelectionBitmap a, const SelectionBitmap& b) { return a &= b; }
+inline SelectionBitmap operator|(SelectionBitmap a, const SelectionBitmap& b) { return a |= b; }
+
+enum class ColumnType { Bool, Int, Double };
+enum class CompareOp { Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual };
+
+// Side copy of selected node properties laid out by column: one dense array
+// per property key, indexed by node id, plus a validity bitmap. A node without
+// the property, or holding it with a type other than the column's, is null
+// there and never matches a filter. Filters compare a whole column against a
+// constant with the widest SIMD level the CPU has and return the matching
+// ids, so a scan touches 4-8 bytes per node instead of decoding its record.
+//
+// The store holds only what update() has been given; StorageEngine keeps its
+// own copy in step with addNode and updateNode. Not thread-safe.
+class ColumnStore {
+public:
+    ColumnStore() : rowCount(0) {}
+
+    // Adds an empty column; re-adding a key with the same type keeps its data.
+    // Throws std::invalid_argument if key already has a column of another type.
+    void addColumn(PropertyKey key, ColumnType type);
+    bool hasColumn(PropertyKey key) const { return columns.count(key) != 0; }
+    std::optional<ColumnType> columnType(PropertyKey key) const;
+    std::vector<PropertyKey> getColumnKeys() const;
+
+    // Copies node's current values into its row, nulling properties it lacks
+    void update(const Node& node);
+    void update(const NodeView& node);
+    // Nulls every column at nodeId
+    void erase(int nodeId);
+
+    // One past the largest node id given to update()
+    size_t size() const { return rowCount; }
+
+    // Stored value; nullopt when null or out of range. Throws
+    // std::invalid_argument for a key without a column of type T.
+    template<typename T>
+    std::optional<T> get(PropertyKey key, int nodeId) const;
+
+    // Ids whose value compares true against value, e.g. Greater selects
+    // value-at-id > value. Comparisons follow C++ semantics, so NaN only
+    // satisfies NotEqual. Throws std::invalid_argument unless key has a column
+    // of the value's type.
+    SelectionBitmap filter(PropertyKey key, CompareOp op, int value) const;
+    SelectionBitmap filter(PropertyKey key, CompareOp op, double value) const;
+    SelectionBitmap filter(PropertyKey key, bool value) const;
+    // Ids with a value in the column
+    SelectionBitmap notNull(PropertyKey key) const;
+
+    // Same, with kernels of a given level; levels the CPU lacks fall back to
+    // the best it has. For tests and benchmarks.
+    SelectionBitmap filter(PropertyKey key, CompareOp op, int value, SimdLevel level) const;
+    SelectionBitmap filter(PropertyKey key, CompareOp op, double value, SimdLevel level) const;
+
+    // Heap bytes owned by the columns
+    size_t heapUsage() const;
+
+private:
+    // Arrays are padded to a multiple of 64 rows so kernels work in whole
+    // bitmap words; padding rows are null
+    struct Column {
+        ColumnType type;
+        std::vector<uint64_t> valid;
+        std::vector<uint64_t> bools;
+        std::vector<int32_t> ints;
+        std::vector<double> doubles;
+    };
+
+    std::unordered_map<PropertyKey, Column> columns;
+    size_t rowCount;
+
+    const Column& column(PropertyKey key, ColumnType type) const;
+    bool isValid(const Column& column, int nodeId) const;
+    // Record is a Node or a NodeView
+    template<typename Record>
+    void updateRow(const Record& node);
+    static void reserveRows(Column& column, size_t rows);
+};
+
+template<>
+std::optional<bool> ColumnStore::get<bool>(PropertyKey key, int nodeId) const;
+template<>
+std::optional<int> ColumnStore::get<int>(PropertyKey key, int nodeId) const;
+template<>
+std::optional<double> ColumnStore::get<double>(PropertyKey key, int nodeId) const;
@@ -0,0 +1,18 @@
+// include/storage/hot_set.hpp
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Resident ids saved at shutdown so the next open can warm the cache.
+// Ids are stored hottest first; a missing or unreadable file loads as empty.
+struct HotSet {
+    std::vector<int> nodeIds;
+    std::vector<int> edgeIds;
+
+    bool empty() const { return nodeIds.empty() && edgeIds.empty(); }
+
+    void save(const std::string& path) const;
+    static HotSet load(const std::string& path);
+};
@@ -5,30 +5,124 @@
 #include <string>
 #include <memory>
 #include <fstream>
+#include <functional>
+#include <optional>
+#include <vector>
+#include "storage/adjacency_index.hpp"
 #include "storage/btree.hpp"
+#include "storage/bloom_filter.hpp"
+#include "storage/property_index.hpp"
 
 class IndexingEngine {
 public:
-    IndexingEngine(const std::string& dbPath, int btreeOrder);
+    // Property indexes are saved by key name, resolved in propertyKeys, which
+    // must outlive the engine
+    IndexingEngine(const std::string& dbPath, int btreeOrder, PropertyKeyDictionary& propertyKeys);
     ~IndexingEngine();
 
     void addNodeIndex(int nodeId, long diskOffset);
     long getNodeDiskOffset(int nodeId);
+    // nullopt when the node is not indexed; definite misses never reach the B-tree
+    std::optional<long> findNodeDiskOffset(int nodeId);
     void removeNodeIndex(int nodeId);
 
     void addEdgeIndex(int edgeId, long diskOffset);
     long getEdgeDiskOffset(int edgeId);
+    std::optional<long> findEdgeDiskOffset(int edgeId);
     void removeEdgeIndex(int edgeId);
 
+    // Visits the id and disk offset of every indexed record in ascending id order
+    void forEachNode(const std::function<void(int, long)>& visit) const { nodeIndex->forEach(visit); }
+    void forEachEdge(const std::function<void(int, long)>& visit) const { edgeIndex->forEach(visit); }
+
+    // Largest indexed id, or -1 when there are none
+    int getMaxNodeId() const;
+    int getMaxEdgeId() const;
+
+    // Secondary indexes on node and edge properties, saved with the id
+    // indexes. Adding returns the new, empty index for the caller to fill, or
+    // nullptr if key already has an index of this type; throws
+    // std::invalid_argument if it has one of another type.
+    PropertyIndex* addNodePropertyIndex(PropertyKey key, IndexType type);
+    PropertyIndex* addEdgePropertyIndex(PropertyKey key, IndexType type);
+    // nullptr when key has no index
+    const PropertyIndex* findNodePropertyIndex(PropertyKey key) const;
+    const PropertyIndex* findEdgePropertyIndex(PropertyKey key) const;
+    // True when the saved property indexes were written along with other id
+    // indexes, as when a crash came between the two. They are loaded empty;
+    // the owner must refill every one of them from the records.
+    bool propertyIndexesNeedRebuild() const { return propertyIndexesStale; }
+    std::vector<PropertyIndex>& getNodePropertyIndexes() { return nodePropertyIndexes; }
+    std::vector<PropertyIndex>& getEdgePropertyIndexes() { return edgePropertyIndexes; }
+    void markPropertyIndexesRebuilt() { propertyIndexesStale = false; }
+
+    // The record's value under each property index of its kind, in a fixed order
+    using PropertyValues = std::vector<std::optional<IndexValue>>;
+    PropertyValues nodePropertyValues(const Node& node) const { return valuesOf(nodePropertyIndexes, node); }
+    PropertyValues edgePropertyValues(const Edge& edge) const { return valuesOf(edgePropertyIndexes, edge); }
+    // Moves id in each index from its value in before to its value in after,
+    // both as returned above; an empty list stands for a record that does not
+    // exist, before it is added or after it is deleted
+    void updateNodeProperties(int nodeId, const PropertyValues& before, const PropertyValues& after);
+    void updateEdgeProperties(int edgeId, const PropertyValues& before, const PropertyValues& after);
+
+    // Typed adjacency of every edge, from both endpoints, saved with the id
+    // indexes
+    void addAdjacency(int edgeId, int sourceNodeId, int targetNodeId, EdgeType type);
+    const AdjacencyIndex& getOutgoingAdjacency() const { return outgoingAdjacency; }
+    const AdjacencyIndex& getIncomingAdjacency() const { return incomingAdjacency; }
+    // True when edges exist but no adjacency index was saved for them, as in
+    // databases written before it existed; the owner must re-add every edge
+    bool adjacencyNeedsRebuild() const { return adjacencyMissing; }
+    void markAdjacencyRebuilt() { adjacencyMissing = false; }
+
     void flush();
 
 private:
     std::unique_ptr<BTree> nodeIndex;
     std::unique_ptr<BTree> edgeIndex;
+    // Removed ids stay in the filters as false positives until the next rebuild
+    BloomFilter nodeFilter;
+    BloomFilter edgeFilter;
     std::fstream nodeIndexFile;
     std::fstream edgeIndexFile;
+    std::vector<PropertyIndex> nodePropertyIndexes;
+    std::vector<PropertyIndex> edgePropertyIndexes;
+    bool propertyIndexesStale;
+    AdjacencyIndex outgoingAdjacency;
+    AdjacencyIndex incomingAdjacency;
+    bool adjacencyMissing;
     std::string dbPath;
+    PropertyKeyDictionary& propertyKeys;
+
+    template<typename Record>
+    static PropertyValues valuesOf(const std::vector<PropertyIndex>& indexes, const Record& record);
+    static PropertyIndex* addPropertyIndex(std::vector<PropertyIndex>& indexes, PropertyKey key, IndexType type);
+    static const PropertyIndex* findPropertyIndex(const std::vector<PropertyIndex>& indexes, PropertyKey key);
+    static void updateProperties(std::vector<PropertyIndex>& indexes, int id, const PropertyValues& before,
+                                 const PropertyValues& after);
+    void loadPropertyIndexes();
+    void savePropertyIndexes() const;
+    void loadAdjacency();
+    void saveAdjacency() const;
 
+    std::optional<long> lookup(const BTree& index, const BloomFilter& filter, int id);
+    static void addToFilter(BloomFilter& filter, const BTree& index, int id);
+    static BloomFilter rebuildFilter(const BTree& index, size_t expectedKeys);
+    static BloomFilter loadFilter(const std::string& path, const BTree& index);
+    static void saveFilter(const std::string& path, const BloomFilter& filter);
+    static void saveIndex(std::fstream& file, const std::string& path, const BTree& index);
     void loadIndexes();
     void saveIndexes();
-};
\ No newline at end of file
+};
+
+template<typename Record>
+IndexingEngine::PropertyValues IndexingEngine::valuesOf(const std::vector<PropertyIndex>& indexes,
+                                                        const Record& record) {
+    PropertyValues values;
+    values.reserve(indexes.size());
+    for (const PropertyIndex& index : indexes) {
+        values.push_back(index.valueOf(record));
+    }
+    return values;
+}
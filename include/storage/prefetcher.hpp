@@ -0,0 +1,108 @@
+// include/storage/prefetcher.hpp
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "core/node.hpp"
+#include "core/edge.hpp"
+
+// What to load ahead of the caller when a node is fetched
+struct PrefetchOptions {
+    bool edges = false;        // The node's outgoing edges
+    bool targetNodes = false;  // The nodes those edges point to; implies edges
+    size_t maxFanOut = 32;     // Edges followed per node, so hubs cannot flood the cache
+    std::optional<EdgeType> edgeType;  // Only follow edges of this type
+};
+
+// The outgoing edges of node that options asks to follow, at most maxFanOut.
+// With an edge type, only that adjacency partition is read.
+std::vector<int> edgesToPrefetch(const Node& node, const PrefetchOptions& options);
+
+// Background loader for records the caller is about to ask for.
+// Workers only read from disk; loaded records wait in a ready set until the
+// owning thread collects them with takeReady() or awaitNode()/awaitEdge(), so
+// the cache itself is never touched off-thread. Requests are advisory and are
+// dropped once maxOutstanding records are queued, loading or ready.
+//
+// A record written while its prefetch is in flight must be invalidated, or the
+// older on-disk version could be handed out afterwards.
+class Prefetcher {
+public:
+    // Return nullptr to skip a record, e.g. one that is not on disk yet
+    using NodeLoader = std::function<std::shared_ptr<Node>(int)>;
+    using EdgeLoader = std::function<std::shared_ptr<Edge>(int)>;
+
+    Prefetcher(NodeLoader nodeLoader, EdgeLoader edgeLoader,
+               size_t workerCount = 2, size_t maxOutstanding = 4096);
+    ~Prefetcher();
+
+    // expand says which neighbors of the node to queue once it has loaded
+    void prefetchNode(int nodeId, const PrefetchOptions& expand = {});
+    void prefetchEdge(int edgeId, bool followTarget);
+
+    // Hands over a prefetched record, waiting if it is being loaded right now.
+    // Returns nullptr when the record was never requested; a request still
+    // queued is cancelled so the caller can load it directly.
+    std::shared_ptr<Node> awaitNode(int nodeId);
+    std::shared_ptr<Edge> awaitEdge(int edgeId);
+
+    // Moves every loaded record out of the ready set
+    void takeReady(std::vector<std::shared_ptr<Node>>& nodes, std::vector<std::shared_ptr<Edge>>& edges);
+    bool hasReady() const { return readyCount.load(std::memory_order_relaxed) > 0; }
+
+    void invalidateNode(int nodeId);
+    void invalidateEdge(int edgeId);
+
+    // Blocks until nothing is queued or loading
+    void waitIdle();
+    size_t outstanding() const;
+
+private:
+    enum class State { QUEUED, LOADING, STALE };
+
+    struct Task {
+        bool isNode;
+        int id;
+        PrefetchOptions options;
+    };
+
+    template<typename T>
+    struct Slots {
+        std::unordered_map<int, State> inFlight;
+        std::unordered_map<int, std::shared_ptr<T>> ready;
+    };
+
+    NodeLoader nodeLoader;
+    EdgeLoader edgeLoader;
+    size_t maxOutstanding;
+
+    mutable std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable loaded;
+    std::deque<Task> tasks;
+    Slots<Node> nodes;
+    Slots<Edge> edges;
+    size_t loading;
+    std::atomic<size_t> readyCount;
+    bool stopping;
+    std::vector<std::thread> workers;
+
+    size_t outstandingLocked() const;
+    template<typename T>
+    void enqueueLocked(Slots<T>& slots, const Task& task);
+    template<typename T>
+    std::shared_ptr<T> await(Slots<T>& slots, int id);
+    template<typename T>
+    void invalidate(Slots<T>& slots, int id);
+    void expandLocked(const Node& node, const PrefetchOptions& options);
+    void run();
+};
@@ -0,0 +1,101 @@
+// include/storage/property_index.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "core/binary_codec.hpp"
+#include "core/edge.hpp"
+#include "core/node.hpp"
+#include "core/property_keys.hpp"
+
+// Property value as an index key
+using IndexValue = std::variant<int, double, std::string>;
+
+// Int and Double indexes are ordered and answer range scans; String indexes
+// are hashed and answer equality only
+enum class IndexType { Int, Double, String };
+
+// Secondary index from the values of one property to the ids of the nodes,
+// or edges, holding them. Only values stored with the index's type are
+// indexed, as in ColumnStore; NaN is never indexed. Point lookups take
+// logarithmic time in ordered indexes and constant time in hashed ones.
+// Not thread-safe.
+class PropertyIndex {
+public:
+    PropertyIndex(PropertyKey key, IndexType type) : key(key), type(type), entries(0) {}
+
+    PropertyKey getKey() const { return key; }
+    IndexType getType() const { return type; }
+    // Indexed (value, id) pairs
+    size_t size() const { return entries; }
+
+    // The record's value of the indexed property, if it has one of the
+    // index's type. Record is a Node, Edge, NodeView or EdgeView.
+    template<typename Record>
+    std::optional<IndexValue> valueOf(const Record& record) const;
+
+    // Values of another type than the index's are ignored, except that an
+    // Int index takes integral doubles and a Double index takes ints
+    void insert(const IndexValue& value, int id);
+    void erase(const IndexValue& value, int id);
+    // Moves id from before to after; either may be nullopt
+    void update(const std::optional<IndexValue>& before, const std::optional<IndexValue>& after, int id);
+
+    // Ids holding value, ascending
+    std::vector<int> find(const IndexValue& value) const;
+    // Ids with a value in [low, high], ordered by value and then id. Throws
+    // std::invalid_argument for a String index.
+    std::vector<int> range(double low, double high) const;
+
+    void serialize(BinaryWriter& writer) const;
+    // Throws std::runtime_error for truncated data
+    static PropertyIndex deserialize(PropertyKey key, IndexType type, BinaryReader& reader);
+
+private:
+    PropertyKey key;
+    IndexType type;
+    size_t entries;
+    std::set<std::pair<int, int>> ints;
+    std::set<std::pair<double, int>> doubles;
+    // Ids per value kept sorted
+    std::unordered_map<std::string, std::vector<int>> strings;
+
+    // value converted to the index's type; nullopt when it cannot be
+    std::optional<IndexValue> normalize(const IndexValue& value) const;
+};
+
+template<typename Record>
+std::optional<IndexValue> PropertyIndex::valueOf(const Record& record) const {
+    // Node and Edge hand out pointers and views optionals; both test and
+    // dereference alike
+    switch (type) {
+        case IndexType::Int:
+            if (auto value = record.template tryGetProperty<int>(key)) {
+                return IndexValue(*value);
+            }
+            break;
+        case IndexType::Double:
+            if (auto value = record.template tryGetProperty<double>(key); value && *value == *value) {
+                return IndexValue(*value);
+            }
+            break;
+        case IndexType::String: {
+            constexpr bool owning = std::is_same_v<Record, Node> || std::is_same_v<Record, Edge>;
+            using Text = std::conditional_t<owning, std::string, std::string_view>;
+            if (auto value = record.template tryGetProperty<Text>(key)) {
+                return IndexValue(std::string(*value));
+            }
+            break;
+        }
+    }
+    return std::nullopt;
+}
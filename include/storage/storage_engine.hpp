@@ -2,48 +2,247 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <fstream>
 #include <string>
 #include <memory>
 #include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
 #include "core/node.hpp"
 #include "core/edge.hpp"
+#include "core/record_view.hpp"
 #include "cache/cache_manager.hpp"
+#include "storage/change_log.hpp"
+#include "storage/column_store.hpp"
 #include "storage/indexing_engine.hpp"
+#include "storage/prefetcher.hpp"
+#include "storage/hot_set.hpp"
+#include "storage/write_back_queue.hpp"
 
 class StorageEngine {
 public:
-    StorageEngine(const std::string& dbPath, size_t cacheCapacity, int btreeOrder);
+    // cacheCapacity is a byte budget shared evenly by cached nodes and edges.
+    // Evicted dirty records are written back in the background; once more than
+    // writeBackThreshold bytes are waiting, evicting callers block until they drain.
+    // If a hot set was saved by a previous run, it is reloaded in the background.
+    // Property key and edge type ids are the database's own (see getNames), so
+    // records read from it must not outlive the engine.
+    StorageEngine(const std::string& dbPath, size_t cacheCapacity, int btreeOrder,
+                  EvictionPolicyType evictionPolicy = EvictionPolicyType::LRU,
+                  size_t writeBackThreshold = 64 * 1024 * 1024);
     ~StorageEngine();
 
+    // Deletes every file of the database at dbPath, which must not be open;
+    // files that do not exist are skipped
+    static void destroy(const std::string& dbPath);
+
     // Node operations
     std::shared_ptr<Node> getNode(int nodeId);
+    // Per-query override of the engine-wide prefetch options
+    std::shared_ptr<Node> getNode(int nodeId, const PrefetchOptions& prefetch);
+    // Like getNode, but returns nullptr for an unknown id instead of throwing
+    std::shared_ptr<Node> tryGetNode(int nodeId);
     void updateNode(int nodeId, const std::function<void(Node&)>& updateFunc);
-    void addNode(const Node& node);
+    // updateNode for many nodes, such as writing back the results of an
+    // analytics pass. Nodes that are not cached are read, updated and appended
+    // to the nodes file in batches without passing through the cache, so a
+    // pass over the whole graph does not evict the working set. Unknown ids
+    // are skipped; a repeated id is updated again, on top of its earlier
+    // update. Returns the number of updates made.
+    size_t updateNodes(const std::vector<int>& nodeIds, const std::function<void(Node&)>& updateFunc);
+    // Returns the id assigned to the new node
+    int addNode(const Node& node);
     void deleteNode(int nodeId);
+    // Read-only access that decodes only the fields visit touches. Uncached
+    // records are viewed straight from the bytes read off disk and are not
+    // added to the cache; cached or queued ones are encoded for the view.
+    // The view is only valid during visit. Returns false for an unknown id.
+    bool viewNode(int nodeId, const std::function<void(const NodeView&)>& visit);
+    // Calls visit for every stored node, read as scanEdges reads edges
+    void scanNodes(const std::function<void(size_t thread, const NodeView&)>& visit, size_t threadCount = 0);
 
     // Edge operations
     std::shared_ptr<Edge> getEdge(int edgeId);
+    std::shared_ptr<Edge> tryGetEdge(int edgeId);
     void updateEdge(int edgeId, const std::function<void(Edge&)>& updateFunc);
-    void addEdge(const Edge& edge);
+    // Returns the id assigned to the new edge
+    int addEdge(const Edge& edge);
     void deleteEdge(int edgeId);
+    bool viewEdge(int edgeId, const std::function<void(const EdgeView&)>& visit);
+    // (edge id, other endpoint) pairs of nodeId's edges of one type, in
+    // ascending edge id order, read from the adjacency index without loading
+    // the node or its edges. Valid until the next addEdge.
+    const std::vector<Neighbor>& getOutgoingNeighbors(int nodeId, EdgeType type) const {
+        return indexingEngine->getOutgoingAdjacency().find(nodeId, type);
+    }
+    const std::vector<Neighbor>& getIncomingNeighbors(int nodeId, EdgeType type) const {
+        return indexingEngine->getIncomingAdjacency().find(nodeId, type);
+    }
+    const std::vector<Neighbor>& getOutgoingNeighbors(int nodeId, std::string_view type) const;
+    const std::vector<Neighbor>& getIncomingNeighbors(int nodeId, std::string_view type) const;
+    // Calls visit for every stored edge, decoding the records straight from a
+    // read-only mapping of the edges file on threadCount threads (0 means one
+    // per hardware thread). Flushes first, so cached and queued changes are
+    // included. visit runs concurrently, with the index of the calling
+    // thread, and each view is only valid during its call.
+    void scanEdges(const std::function<void(size_t thread, const EdgeView&)>& visit, size_t threadCount = 0);
+
+    // The names behind this database's property key and edge type ids. Records
+    // built with other names, such as RecordNames::detached(), are re-keyed
+    // when added; ids used with records read from here must come from these.
+    RecordNames& getNames() { return names; }
+    const RecordNames& getNames() const { return names; }
+    PropertyKey propertyKey(std::string_view name) { return names.propertyKeys.intern(name); }
+    EdgeType edgeType(std::string_view name) { return names.edgeTypes.intern(name); }
+
+    // One past the largest id handed out so far
+    int getNodeIdLimit() const { return nextNodeId; }
+    int getEdgeIdLimit() const { return nextEdgeId; }
+    // Every node and edge added or updated since the engine was opened
+    const ChangeLog& getChangeLog() const { return changeLog; }
+
+    // Columnar copies of node properties for filter scans. Adding a column
+    // fills it from every stored node; from then on addNode and updateNode keep
+    // it current, but changes made through a Node returned by getNode without
+    // updateNode are not seen. Columns are held in memory only, so they are
+    // added again after each open.
+    void addColumn(PropertyKey key, ColumnType type);
+    void addColumn(std::string_view key, ColumnType type) { addColumn(propertyKey(key), type); }
+    const ColumnStore& getColumns() const { return columns; }
+
+    // Secondary indexes from property values to node or edge ids. Adding one
+    // fills it from every stored record; from then on adds and updates keep it
+    // current, with the same caveat as columns. Indexes are saved on flush and
+    // reloaded on open, so they are only added once. Adding an index that
+    // exists with another type throws std::invalid_argument.
+    void addNodePropertyIndex(PropertyKey key, IndexType type);
+    void addNodePropertyIndex(std::string_view key, IndexType type) { addNodePropertyIndex(propertyKey(key), type); }
+    void addEdgePropertyIndex(PropertyKey key, IndexType type);
+    void addEdgePropertyIndex(std::string_view key, IndexType type) { addEdgePropertyIndex(propertyKey(key), type); }
+    // Ids of the records whose value equals value, ascending, and of those
+    // whose value lies in [low, high], in value order. Throw
+    // std::invalid_argument when key is not indexed; ranges also throw for a
+    // String index.
+    std::vector<int> findNodesByProperty(PropertyKey key, const IndexValue& value) const;
+    std::vector<int> findNodesByProperty(std::string_view key, const IndexValue& value) const {
+        return findNodesByProperty(indexedKey(key), value);
+    }
+    std::vector<int> findNodesInRange(PropertyKey key, double low, double high) const;
+    std::vector<int> findNodesInRange(std::string_view key, double low, double high) const {
+        return findNodesInRange(indexedKey(key), low, high);
+    }
+    std::vector<int> findEdgesByProperty(PropertyKey key, const IndexValue& value) const;
+    std::vector<int> findEdgesByProperty(std::string_view key, const IndexValue& value) const {
+        return findEdgesByProperty(indexedKey(key), value);
+    }
+    std::vector<int> findEdgesInRange(PropertyKey key, double low, double high) const;
+    std::vector<int> findEdgesInRange(std::string_view key, double low, double high) const {
+        return findEdgesInRange(indexedKey(key), low, high);
+    }
 
     // General operations
     void flush();
+    void setCacheHighWatermark(double fraction, CacheManager::WatermarkCallback callback);
+
+    // Prefetching is off unless enabled here or requested per query
+    void setPrefetchOptions(const PrefetchOptions& options);
+    // Queues the next frontier of a traversal so its I/O overlaps the current hop
+    void prefetchNodes(const std::vector<int>& nodeIds, const PrefetchOptions& prefetch);
+    void waitForPrefetch();
+
+    // Saves the resident ids for the next open's warm-up; also done on close
+    void saveHotSet();
+    // Additionally save every interval while the engine is in use; zero disables
+    void setHotSetInterval(std::chrono::milliseconds interval);
+    // Fraction of the saved hot set reloaded so far, 1 when there is nothing to load
+    double warmUpProgress() const;
+    void waitForWarmUp();
 
 private:
+    // Declared first so cached and queued records never outlive it
+    RecordNames names;
     std::fstream nodesFile;
     std::fstream edgesFile;
     std::unique_ptr<CacheManager> cacheManager;
     std::unique_ptr<IndexingEngine> indexingEngine;
+    std::unique_ptr<WriteBackQueue> writeBackQueue;
+    std::unique_ptr<Prefetcher> prefetcher;
+    PrefetchOptions defaultPrefetch;
+    ColumnStore columns;
+    ChangeLog changeLog;
+    // Guards the data files and the index, which the write-back thread also appends to
+    std::mutex ioMutex;
+    int nextNodeId;
+    int nextEdgeId;
+    std::string dbPath;
+    // Sizes as of the last save of property_keys.db and edge_types.db
+    size_t savedPropertyKeys;
+    size_t savedEdgeTypes;
+
+    // Warm-up records are read off-thread and handed to the cache by the caller's
+    // thread, along with the offset they were read from to detect newer writes
+    template<typename T>
+    struct WarmedRecord {
+        std::shared_ptr<T> record;
+        long offset;
+    };
+
+    std::thread warmUpThread;
+    std::atomic<bool> warmUpStopping;
+    std::atomic<size_t> warmUpPlanned;
+    std::atomic<size_t> warmUpLoaded;
+    std::atomic<bool> warmedAvailable;
+    std::mutex warmUpMutex;
+    std::vector<WarmedRecord<Node>> warmedNodes;
+    std::vector<WarmedRecord<Edge>> warmedEdges;
+
+    std::chrono::milliseconds hotSetInterval;
+    std::chrono::steady_clock::time_point lastHotSetSave;
+    size_t fetchesSinceHotSetCheck;
+
+    std::shared_ptr<Node> fetchNode(int nodeId, const PrefetchOptions& prefetch);
+    std::shared_ptr<Edge> fetchEdge(int edgeId);
+    // Moves records the prefetcher has finished loading into the cache
+    void installPrefetched();
+    void schedulePrefetch(const Node& node, const PrefetchOptions& prefetch);
+
+    void runWarmUp(HotSet hotSet);
+    template<typename T>
+    void warmUpRecords(std::fstream& file, const std::vector<std::pair<long, int>>& offsets,
+                       std::vector<WarmedRecord<T>>& warmed);
+    // Caches a bounded batch of warmed records per call to keep request latency flat
+    void installWarmedUp();
+    // Visits the records of fileName at offsets for scanNodes and scanEdges
+    template<typename T, typename View>
+    void scanRecords(const std::string& fileName, const std::vector<long>& offsets,
+                     const std::function<void(size_t, const View&)>& visit, size_t threadCount);
+    void maybeSaveHotSet();
+    // Inserts every stored record's value into each of indexes
+    void fillNodePropertyIndexes(const std::vector<PropertyIndex*>& indexes);
+    void fillEdgePropertyIndexes(const std::vector<PropertyIndex*>& indexes);
+    // Key of an indexed property; throws std::invalid_argument for a name no
+    // record here has used
+    PropertyKey indexedKey(std::string_view key) const;
+    // Persists newly interned property keys and edge types ahead of records
+    // that use them; caller holds ioMutex
+    void saveNames();
 
     // Node helper methods
+    // nullopt / nullptr when the id is not indexed
+    std::optional<std::string> readNodeRecord(int nodeId);
     std::shared_ptr<Node> loadNodeFromDisk(int nodeId);
     void saveNodeToDisk(const Node& node);
+    void writeNodes(const std::vector<const Node*>& nodes);
     int getNextNodeId();
 
     // Edge helper methods
+    std::optional<std::string> readEdgeRecord(int edgeId);
     std::shared_ptr<Edge> loadEdgeFromDisk(int edgeId);
     void saveEdgeToDisk(const Edge& edge);
+    void writeEdges(const std::vector<const Edge*>& edges);
     int getNextEdgeId();
 };
\ No newline at end of file
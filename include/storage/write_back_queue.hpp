@@ -0,0 +1,71 @@
+// include/storage/write_back_queue.hpp
+
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "core/node.hpp"
+#include "core/edge.hpp"
+
+// Background writer for dirty records evicted from the cache.
+// Records stay visible through findNode/findEdge until their batch is on disk,
+// so a reader never falls back to a stale on-disk version. Enqueueing blocks
+// while more than maxPendingBytes are waiting, which throttles the foreground
+// instead of letting dirty data pile up without bound.
+//
+// Queued records are serialized on the writer thread, so they are held as
+// const and the caller hands over a record nothing else still mutates (the
+// storage engine enqueues a copy of each evicted record).
+class WriteBackQueue {
+public:
+    using NodeBatchWriter = std::function<void(const std::vector<std::shared_ptr<const Node>>&)>;
+    using EdgeBatchWriter = std::function<void(const std::vector<std::shared_ptr<const Edge>>&)>;
+
+    WriteBackQueue(NodeBatchWriter nodeWriter, EdgeBatchWriter edgeWriter,
+                   size_t maxPendingBytes, size_t maxBatchSize = 256);
+    ~WriteBackQueue();
+
+    void enqueueNode(std::shared_ptr<const Node> node);
+    void enqueueEdge(std::shared_ptr<const Edge> edge);
+
+    std::shared_ptr<const Node> findNode(int nodeId) const;
+    std::shared_ptr<const Edge> findEdge(int edgeId) const;
+
+    // Blocks until everything queued so far is written; rethrows writer failures
+    void drain();
+
+    size_t pendingBytes() const;
+    size_t pendingCount() const;
+
+private:
+    template<typename T>
+    struct Pending {
+        std::shared_ptr<const T> record;
+        size_t bytes;
+    };
+
+    NodeBatchWriter nodeWriter;
+    EdgeBatchWriter edgeWriter;
+    size_t maxPendingBytes;
+    size_t maxBatchSize;
+
+    mutable std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable spaceAvailable;
+    std::unordered_map<int, Pending<Node>> nodes;
+    std::unordered_map<int, Pending<Edge>> edges;
+    size_t queuedBytes;
+    bool writing;
+    bool stopping;
+    std::exception_ptr writerError;
+    std::thread worker;
+
+    void waitForSpace(std::unique_lock<std::mutex>& lock);
+    void run();
+};
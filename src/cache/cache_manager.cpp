@@ -1,40 +1,214 @@
 // src/cache/cache_manager.cpp
 
 #include "cache/cache_manager.hpp"
+#include "metrics/metrics.hpp"
 
-CacheManager::CacheManager(size_t capacity) : capacity(capacity) {}
+namespace {
+// Hash node, policy bookkeeping and shared_ptr control block per cached record
+constexpr size_t ENTRY_OVERHEAD = 96;
+// Dirty victims passed over per eviction pass before one is written back anyway
+constexpr size_t MAX_DIRTY_DEFERRALS = 8;
+}
+
+CacheManager::CacheManager(size_t capacityBytes, EvictionPolicyType policy)
+    : CacheManager(capacityBytes / 2, capacityBytes - capacityBytes / 2, policy) {}
+
+CacheManager::CacheManager(size_t nodeBudgetBytes, size_t edgeBudgetBytes, EvictionPolicyType policy)
+    : nodeBudgetBytes(nodeBudgetBytes), edgeBudgetBytes(edgeBudgetBytes),
+      nodeResidentBytes(0), edgeResidentBytes(0),
+      nodePolicy(makeEvictionPolicy(policy)), edgePolicy(makeEvictionPolicy(policy)),
+      watermarkFraction(1.0), aboveWatermark(false) {}
+
+size_t CacheManager::chargeFor(const Node& node) {
+    return node.memoryUsage() + ENTRY_OVERHEAD;
+}
+
+size_t CacheManager::chargeFor(const Edge& edge) {
+    return edge.memoryUsage() + ENTRY_OVERHEAD;
+}
+
+// EntryPool
+
+template<typename T>
+CacheManager::Entry<T>* CacheManager::EntryPool<T>::find(int id) {
+    uint32_t slot = index.find(id);
+    return slot == IdTable::NONE ? nullptr : &entries[slot];
+}
+
+template<typename T>
+const CacheManager::Entry<T>* CacheManager::EntryPool<T>::find(int id) const {
+    uint32_t slot = index.find(id);
+    return slot == IdTable::NONE ? nullptr : &entries[slot];
+}
+
+template<typename T>
+uint32_t CacheManager::EntryPool<T>::allocate() {
+    if (!freeSlots.empty()) {
+        uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+    entries.emplace_back();
+    return entries.size() - 1;
+}
+
+template<typename T>
+void CacheManager::EntryPool<T>::release(uint32_t slot) {
+    entries[slot].value.reset();
+    freeSlots.push_back(slot);
+}
+
+template<typename T>
+void CacheManager::EntryPool<T>::clear() {
+    entries.clear();
+    freeSlots.clear();
+    index.clear();
+}
+
+// Shared node/edge paths
+
+template<typename T>
+void CacheManager::put(EntryPool<T>& pool, EvictionPolicy& policy, size_t& residentBytes,
+                       int id, std::shared_ptr<T> value, size_t bytes) {
+    uint32_t slot = pool.index.find(id);
+    if (slot != IdTable::NONE) {
+        // Re-caching an updated record refreshes its charge, not its history
+        Entry<T>& entry = pool.entries[slot];
+        residentBytes = residentBytes - entry.bytes + bytes;
+        entry.value = std::move(value);
+        entry.bytes = bytes;
+        policy.onAccess(slot);
+        return;
+    }
+    slot = pool.allocate();
+    pool.entries[slot] = {std::move(value), bytes, id};
+    pool.index.insert(id, slot);
+    residentBytes += bytes;
+    policy.onInsert(slot, id);
+}
+
+template<typename T>
+std::shared_ptr<T> CacheManager::get(EntryPool<T>& pool, EvictionPolicy& policy, int id,
+                                     Counter hits, Counter misses) {
+    uint32_t slot = pool.index.find(id);
+    if (slot == IdTable::NONE) {
+        Metrics::increment(misses);
+        policy.onMiss(id);
+        return nullptr;
+    }
+    Metrics::increment(hits);
+    policy.onAccess(slot);
+    return pool.entries[slot].value;
+}
+
+template<typename T>
+void CacheManager::remove(EntryPool<T>& pool, EvictionPolicy& policy, size_t& residentBytes, int id) {
+    uint32_t slot = pool.index.find(id);
+    if (slot == IdTable::NONE) {
+        return;
+    }
+    residentBytes -= pool.entries[slot].bytes;
+    policy.onRemove(slot);
+    pool.index.erase(id);
+    pool.release(slot);
+}
+
+template<typename T>
+void CacheManager::evictFrom(EntryPool<T>& pool, EvictionPolicy& policy, size_t& residentBytes,
+                             size_t budgetBytes, const std::function<void(std::shared_ptr<T>)>& writeBack,
+                             Counter evictions) {
+    // Clean victims are free to drop, so dirty ones get a bounded second chance
+    size_t deferrals = 0;
+    while (residentBytes > budgetBytes && policy.size() > 0) {
+        uint32_t victim = policy.victim();
+        Entry<T>& entry = pool.entries[victim];
+        if (entry.value->isDirty()) {
+            if (deferrals < MAX_DIRTY_DEFERRALS && deferrals + 1 < policy.size()) {
+                policy.deferVictim(victim);
+                ++deferrals;
+                continue;
+            }
+            if (writeBack) {
+                writeBack(entry.value);
+            }
+        }
+        remove(pool, policy, residentBytes, entry.id);
+        Metrics::increment(evictions);
+    }
+}
+
+template<typename T>
+std::vector<int> CacheManager::hotIds(const EntryPool<T>& pool, const EvictionPolicy& policy, size_t limit) {
+    std::vector<int> ids;
+    for (uint32_t slot : policy.hottest(limit)) {
+        ids.push_back(pool.entries[slot].id);
+    }
+    return ids;
+}
 
 void CacheManager::cacheNode(int nodeId, std::shared_ptr<Node> node) {
-    // NOT_IMPLEMENTED
+    size_t bytes = chargeFor(*node);
+    if (bytes > nodeBudgetBytes) {
+        removeNode(nodeId);
+        // Would evict everything else and still not fit
+        if (node->isDirty() && nodeWriteBack) {
+            nodeWriteBack(std::move(node));
+        }
+        return;
+    }
+    put(nodeCache, *nodePolicy, nodeResidentBytes, nodeId, std::move(node), bytes);
+    evict();
+    checkWatermark();
 }
 
 std::shared_ptr<Node> CacheManager::getNode(int nodeId) {
-    // NOT_IMPLEMENTED
-    return nullptr;
+    return get(nodeCache, *nodePolicy, nodeId, Counter::CACHE_NODE_HITS, Counter::CACHE_NODE_MISSES);
+}
+
+std::shared_ptr<Node> CacheManager::peekNode(int nodeId) const {
+    const Entry<Node>* entry = nodeCache.find(nodeId);
+    return entry ? entry->value : nullptr;
 }
 
 void CacheManager::removeNode(int nodeId) {
-    // NOT_IMPLEMENTED
+    remove(nodeCache, *nodePolicy, nodeResidentBytes, nodeId);
 }
 
 void CacheManager::cacheEdge(int edgeId, std::shared_ptr<Edge> edge) {
-    // NOT_IMPLEMENTED
+    size_t bytes = chargeFor(*edge);
+    if (bytes > edgeBudgetBytes) {
+        removeEdge(edgeId);
+        if (edge->isDirty() && edgeWriteBack) {
+            edgeWriteBack(std::move(edge));
+        }
+        return;
+    }
+    put(edgeCache, *edgePolicy, edgeResidentBytes, edgeId, std::move(edge), bytes);
+    evict();
+    checkWatermark();
 }
 
 std::shared_ptr<Edge> CacheManager::getEdge(int edgeId) {
-    // NOT_IMPLEMENTED
-    return nullptr;
+    return get(edgeCache, *edgePolicy, edgeId, Counter::CACHE_EDGE_HITS, Counter::CACHE_EDGE_MISSES);
+}
+
+std::shared_ptr<Edge> CacheManager::peekEdge(int edgeId) const {
+    const Entry<Edge>* entry = edgeCache.find(edgeId);
+    return entry ? entry->value : nullptr;
 }
 
 void CacheManager::removeEdge(int edgeId) {
-    // NOT_IMPLEMENTED
+    remove(edgeCache, *edgePolicy, edgeResidentBytes, edgeId);
 }
 
 void CacheManager::clear() {
     nodeCache.clear();
     edgeCache.clear();
-    lruListNodes.clear();
-    lruListEdges.clear();
+    nodePolicy->clear();
+    edgePolicy->clear();
+    nodeResidentBytes = 0;
+    edgeResidentBytes = 0;
+    aboveWatermark = false;
 }
 
 size_t CacheManager::size() const {
@@ -42,9 +216,82 @@ size_t CacheManager::size() const {
 }
 
 bool CacheManager::isFull() const {
-    return size() >= capacity;
+    return residentBytes() >= nodeBudgetBytes + edgeBudgetBytes;
+}
+
+size_t CacheManager::residentBytes() const {
+    return nodeResidentBytes + edgeResidentBytes;
+}
+
+size_t CacheManager::nodeBytes() const {
+    return nodeResidentBytes;
+}
+
+size_t CacheManager::edgeBytes() const {
+    return edgeResidentBytes;
+}
+
+size_t CacheManager::nodeBudget() const {
+    return nodeBudgetBytes;
+}
+
+size_t CacheManager::edgeBudget() const {
+    return edgeBudgetBytes;
+}
+
+std::string CacheManager::policyName() const {
+    return nodePolicy->name();
+}
+
+void CacheManager::setHighWatermark(double fraction, WatermarkCallback callback) {
+    watermarkFraction = fraction;
+    watermarkCallback = std::move(callback);
+    aboveWatermark = false;
+    checkWatermark();
+}
+
+void CacheManager::setWriteBack(NodeWriteBack nodeHandler, EdgeWriteBack edgeHandler) {
+    nodeWriteBack = std::move(nodeHandler);
+    edgeWriteBack = std::move(edgeHandler);
+}
+
+std::vector<int> CacheManager::hotNodeIds(size_t limit) const {
+    return hotIds(nodeCache, *nodePolicy, limit);
+}
+
+std::vector<int> CacheManager::hotEdgeIds(size_t limit) const {
+    return hotIds(edgeCache, *edgePolicy, limit);
+}
+
+void CacheManager::forEachNode(const std::function<void(const std::shared_ptr<Node>&)>& func) const {
+    for (const auto& entry : nodeCache.entries) {
+        if (entry.value) {
+            func(entry.value);
+        }
+    }
+}
+
+void CacheManager::forEachEdge(const std::function<void(const std::shared_ptr<Edge>&)>& func) const {
+    for (const auto& entry : edgeCache.entries) {
+        if (entry.value) {
+            func(entry.value);
+        }
+    }
 }
 
 void CacheManager::evict() {
-    // NOT_IMPLEMENTED
-}
\ No newline at end of file
+    evictFrom(nodeCache, *nodePolicy, nodeResidentBytes, nodeBudgetBytes, nodeWriteBack,
+              Counter::CACHE_NODE_EVICTIONS);
+    evictFrom(edgeCache, *edgePolicy, edgeResidentBytes, edgeBudgetBytes, edgeWriteBack,
+              Counter::CACHE_EDGE_EVICTIONS);
+}
+
+void CacheManager::checkWatermark() {
+    size_t budget = nodeBudgetBytes + edgeBudgetBytes;
+    bool above = residentBytes() > static_cast<size_t>(watermarkFraction * budget);
+    // Fire once per crossing rather than on every insert above the mark
+    if (above && !aboveWatermark && watermarkCallback) {
+        watermarkCallback(residentBytes(), budget);
+    }
+    aboveWatermark = above;
+}
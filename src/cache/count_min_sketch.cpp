@@ -0,0 +1,81 @@
+// src/cache/count_min_sketch.cpp
+
+#include "cache/count_min_sketch.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace {
+const uint64_t ROW_SEEDS[] = {
+    0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL, 0xD6E8FEB86659FD93ULL
+};
+
+uint64_t mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+    return x;
+}
+}
+
+CountMinSketch::CountMinSketch(size_t expectedKeys) : width(16), samples(0) {
+    while (width < expectedKeys) {
+        width <<= 1;
+    }
+    sampleLimit = width * 10;
+    counters.assign(DEPTH * width, 0);
+}
+
+size_t CountMinSketch::indexOf(int key, int row) const {
+    uint64_t h = mix(static_cast<uint32_t>(key) ^ ROW_SEEDS[row]);
+    return row * width + (h & (width - 1));
+}
+
+void CountMinSketch::increment(int key) {
+    // Conservative update: only raise the counters that hold the minimum
+    uint8_t current = estimate(key);
+    if (current < MAX_COUNT) {
+        for (int row = 0; row < DEPTH; ++row) {
+            uint8_t& counter = counters[indexOf(key, row)];
+            if (counter == current) {
+                ++counter;
+            }
+        }
+    }
+    if (++samples >= sampleLimit) {
+        age();
+    }
+}
+
+uint8_t CountMinSketch::estimate(int key) const {
+    uint8_t result = MAX_COUNT;
+    for (int row = 0; row < DEPTH; ++row) {
+        result = std::min(result, counters[indexOf(key, row)]);
+    }
+    return result;
+}
+
+void CountMinSketch::clear() {
+    std::fill(counters.begin(), counters.end(), 0);
+    samples = 0;
+}
+
+void CountMinSketch::grow() {
+    std::vector<uint8_t> wider(DEPTH * width * 2);
+    for (int row = 0; row < DEPTH; ++row) {
+        for (size_t column = 0; column < width * 2; ++column) {
+            wider[row * width * 2 + column] = counters[row * width + (column & (width - 1))];
+        }
+    }
+    counters = std::move(wider);
+    width *= 2;
+    sampleLimit = width * 10;
+}
+
+void CountMinSketch::age() {
+    for (uint8_t& counter : counters) {
+        counter >>= 1;
+    }
+    samples /= 2;
+}
@@ -0,0 +1,262 @@
+// src/cache/eviction_policy.cpp
+
+#include "cache/eviction_policy.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+std::unique_ptr<EvictionPolicy> makeEvictionPolicy(EvictionPolicyType type) {
+    switch (type) {
+        case EvictionPolicyType::LRU:
+            return std::make_unique<LruPolicy>();
+        case EvictionPolicyType::CLOCK:
+            return std::make_unique<ClockPolicy>();
+        case EvictionPolicyType::W_TINY_LFU:
+            return std::make_unique<TinyLfuPolicy>();
+    }
+    throw std::invalid_argument("Unknown eviction policy");
+}
+
+// LruPolicy
+
+void LruPolicy::onInsert(uint32_t slot, int) {
+    links.ensure(slot);
+    order.pushFront(links, slot);
+}
+
+void LruPolicy::onAccess(uint32_t slot) {
+    order.moveToFront(links, slot);
+}
+
+void LruPolicy::onRemove(uint32_t slot) {
+    order.remove(links, slot);
+}
+
+uint32_t LruPolicy::victim() {
+    return order.back();
+}
+
+void LruPolicy::deferVictim(uint32_t slot) {
+    order.moveToFront(links, slot);
+}
+
+std::vector<uint32_t> LruPolicy::hottest(size_t limit) const {
+    std::vector<uint32_t> slots;
+    for (uint32_t slot = order.front(); slot != SlotLinks::NIL && slots.size() < limit;
+         slot = links.links[slot].next) {
+        slots.push_back(slot);
+    }
+    return slots;
+}
+
+void LruPolicy::clear() {
+    order.clear();
+    links.links.clear();
+}
+
+// ClockPolicy
+
+ClockPolicy::ClockPolicy() : residentCount(0), hand(0) {}
+
+void ClockPolicy::onInsert(uint32_t slot, int) {
+    if (slot >= ring.size()) {
+        ring.resize(slot + 1, Slot{false, false});
+    }
+    ring[slot] = {true, false};
+    ++residentCount;
+}
+
+void ClockPolicy::onAccess(uint32_t slot) {
+    ring[slot].referenced = true;
+}
+
+void ClockPolicy::onRemove(uint32_t slot) {
+    ring[slot].used = false;
+    --residentCount;
+}
+
+uint32_t ClockPolicy::victim() {
+    // Terminates within two sweeps: the first clears every reference bit
+    while (true) {
+        if (hand >= ring.size()) {
+            hand = 0;
+        }
+        Slot& slot = ring[hand++];
+        if (!slot.used) {
+            continue;
+        }
+        if (slot.referenced) {
+            slot.referenced = false;
+            continue;
+        }
+        return hand - 1;
+    }
+}
+
+void ClockPolicy::deferVictim(uint32_t slot) {
+    ring[slot].referenced = true;
+}
+
+std::vector<uint32_t> ClockPolicy::hottest(size_t limit) const {
+    // Referenced slots first, each group in the order the hand will reach them last
+    std::vector<uint32_t> referenced;
+    std::vector<uint32_t> unreferenced;
+    for (size_t i = 0; i < ring.size(); ++i) {
+        uint32_t slot = (hand + ring.size() - 1 - i) % ring.size();
+        if (ring[slot].used) {
+            (ring[slot].referenced ? referenced : unreferenced).push_back(slot);
+        }
+    }
+    referenced.insert(referenced.end(), unreferenced.begin(), unreferenced.end());
+    if (referenced.size() > limit) {
+        referenced.resize(limit);
+    }
+    return referenced;
+}
+
+void ClockPolicy::clear() {
+    ring.clear();
+    residentCount = 0;
+    hand = 0;
+}
+
+// TinyLfuPolicy
+
+TinyLfuPolicy::TinyLfuPolicy(size_t expectedKeys, double windowFraction, double protectedFraction)
+    : windowFraction(windowFraction), protectedFraction(protectedFraction), sketch(expectedKeys) {}
+
+SlotList& TinyLfuPolicy::listFor(Segment segment) {
+    switch (segment) {
+        case Segment::WINDOW:
+            return window;
+        case Segment::PROBATION:
+            return probation;
+        default:
+            return protectedSegment;
+    }
+}
+
+void TinyLfuPolicy::moveTo(uint32_t slot, Segment segment) {
+    SlotState& state = states[slot];
+    listFor(state.segment).remove(links, slot);
+    listFor(segment).pushFront(links, slot);
+    state.segment = segment;
+}
+
+void TinyLfuPolicy::onInsert(uint32_t slot, int key) {
+    if (size() >= sketch.counterWidth()) {
+        // Resident set outgrew the sketch; a wider one keeps collisions rare,
+        // and growing it in place keeps the history admission relies on
+        sketch.grow();
+    }
+    sketch.increment(key);
+    links.ensure(slot);
+    if (slot >= states.size()) {
+        states.resize(slot + 1);
+    }
+    states[slot] = {key, Segment::WINDOW};
+    window.pushFront(links, slot);
+
+    // Window overflow becomes an admission candidate at the head of probation
+    size_t windowTarget = std::max<size_t>(1, static_cast<size_t>(size() * windowFraction));
+    while (window.size() > windowTarget) {
+        moveTo(window.back(), Segment::PROBATION);
+    }
+}
+
+void TinyLfuPolicy::demoteProtectedOverflow() {
+    size_t mainSize = probation.size() + protectedSegment.size();
+    size_t protectedTarget = std::max<size_t>(1, static_cast<size_t>(mainSize * protectedFraction));
+    while (protectedSegment.size() > protectedTarget) {
+        moveTo(protectedSegment.back(), Segment::PROBATION);
+    }
+}
+
+void TinyLfuPolicy::onAccess(uint32_t slot) {
+    sketch.increment(states[slot].key);
+    switch (states[slot].segment) {
+        case Segment::WINDOW:
+            window.moveToFront(links, slot);
+            break;
+        case Segment::PROBATION:
+            moveTo(slot, Segment::PROTECTED);
+            demoteProtectedOverflow();
+            break;
+        case Segment::PROTECTED:
+            protectedSegment.moveToFront(links, slot);
+            break;
+    }
+}
+
+void TinyLfuPolicy::onMiss(int key) {
+    sketch.increment(key);
+}
+
+void TinyLfuPolicy::onRemove(uint32_t slot) {
+    listFor(states[slot].segment).remove(links, slot);
+}
+
+uint32_t TinyLfuPolicy::victim() {
+    auto estimate = [this](uint32_t slot) { return sketch.estimate(states[slot].key); };
+    if (probation.size() >= 2) {
+        // Newest arrival duels the least recently used probation entry
+        uint32_t candidate = probation.front();
+        uint32_t incumbent = probation.back();
+        return estimate(candidate) > estimate(incumbent) ? incumbent : candidate;
+    }
+    if (!probation.empty()) {
+        return probation.back();
+    }
+    if (!window.empty()) {
+        uint32_t candidate = window.back();
+        if (!protectedSegment.empty() && estimate(candidate) > estimate(protectedSegment.back())) {
+            return protectedSegment.back();
+        }
+        return candidate;
+    }
+    return protectedSegment.back();
+}
+
+void TinyLfuPolicy::deferVictim(uint32_t slot) {
+    // Recency only: a deferral is not a use, so the sketch is left alone.
+    // Victims come from the probation head as well as the tails, so moving
+    // to the front of the slot's own list could leave it where it was; the
+    // protected head is only picked when it is also the protected tail.
+    if (states[slot].segment == Segment::PROTECTED) {
+        protectedSegment.moveToFront(links, slot);
+    } else {
+        moveTo(slot, Segment::PROTECTED);
+        demoteProtectedOverflow();
+    }
+    if (protectedSegment.back() == slot && probation.empty() && !window.empty()) {
+        // The window candidate would win its duel against slot; admit it to
+        // probation, where it is the next victim
+        moveTo(window.back(), Segment::PROBATION);
+    }
+}
+
+std::vector<uint32_t> TinyLfuPolicy::hottest(size_t limit) const {
+    // Frequency first; within a frequency, protected before window before probation, most recent first
+    std::vector<uint32_t> slots;
+    slots.reserve(size());
+    for (const SlotList* segment : {&protectedSegment, &window, &probation}) {
+        for (uint32_t slot = segment->front(); slot != SlotLinks::NIL; slot = links.links[slot].next) {
+            slots.push_back(slot);
+        }
+    }
+    std::stable_sort(slots.begin(), slots.end(), [this](uint32_t a, uint32_t b) {
+        return sketch.estimate(states[a].key) > sketch.estimate(states[b].key);
+    });
+    if (slots.size() > limit) {
+        slots.resize(limit);
+    }
+    return slots;
+}
+
+void TinyLfuPolicy::clear() {
+    window.clear();
+    probation.clear();
+    protectedSegment.clear();
+    links.links.clear();
+    states.clear();
+    sketch.clear();
+}
@@ -0,0 +1,78 @@
+// src/cache/id_table.cpp
+
+#include "cache/id_table.hpp"
+
+namespace {
+// Linear probing degrades quickly past ~70% occupancy
+constexpr size_t MAX_LOAD_PERCENT = 70;
+}
+
+IdTable::IdTable(size_t initialCapacity) : count(0) {
+    size_t capacity = 16;
+    while (capacity < initialCapacity) {
+        capacity *= 2;
+    }
+    rehash(capacity);
+}
+
+void IdTable::rehash(size_t newCapacity) {
+    std::vector<Bucket> old = std::move(buckets);
+    buckets.assign(newCapacity, Bucket{0, NONE});
+    mask = newCapacity - 1;
+    shift = 64;
+    for (size_t c = newCapacity; c > 1; c >>= 1) {
+        --shift;
+    }
+    for (const Bucket& bucket : old) {
+        if (bucket.slot != NONE) {
+            size_t i = home(bucket.id);
+            while (buckets[i].slot != NONE) {
+                i = (i + 1) & mask;
+            }
+            buckets[i] = bucket;
+        }
+    }
+}
+
+void IdTable::insert(int id, uint32_t slot) {
+    if ((count + 1) * 100 > buckets.size() * MAX_LOAD_PERCENT) {
+        rehash(buckets.size() * 2);
+    }
+    size_t i = home(id);
+    while (buckets[i].slot != NONE && buckets[i].id != id) {
+        i = (i + 1) & mask;
+    }
+    if (buckets[i].slot == NONE) {
+        ++count;
+    }
+    buckets[i] = {id, slot};
+}
+
+bool IdTable::erase(int id) {
+    size_t hole = home(id);
+    while (buckets[hole].id != id || buckets[hole].slot == NONE) {
+        if (buckets[hole].slot == NONE) {
+            return false;
+        }
+        hole = (hole + 1) & mask;
+    }
+    // Pull back any later bucket whose home position is not between the hole and itself
+    for (size_t j = (hole + 1) & mask; buckets[j].slot != NONE; j = (j + 1) & mask) {
+        size_t k = home(buckets[j].id);
+        bool reachable = hole <= j ? (hole < k && k <= j) : (hole < k || k <= j);
+        if (!reachable) {
+            buckets[hole] = buckets[j];
+            hole = j;
+        }
+    }
+    buckets[hole].slot = NONE;
+    --count;
+    return true;
+}
+
+void IdTable::clear() {
+    for (Bucket& bucket : buckets) {
+        bucket.slot = NONE;
+    }
+    count = 0;
+}
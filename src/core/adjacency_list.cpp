@@ -0,0 +1,136 @@
+// src/core/adjacency_list.cpp
+
+#include "core/adjacency_list.hpp"
+#include <stdexcept>
+
+bool AdjacencyList::insert(int id) {
+    if (blocks.empty()) {
+        auto pos = std::lower_bound(ids.begin(), ids.end(), id);
+        if (pos != ids.end() && *pos == id) {
+            return false;
+        }
+        ids.insert(pos, id);
+        ++count;
+        if (ids.size() > LARGE_THRESHOLD) {
+            splitIntoBlocks();
+        }
+        return true;
+    }
+
+    size_t index = findBlock(id);
+    auto pos = std::lower_bound(blocks[index].begin(), blocks[index].end(), id);
+    if (pos != blocks[index].end() && *pos == id) {
+        return false;
+    }
+    if (blocks[index].size() == BLOCK_CAPACITY) {
+        if (pos == blocks[index].end() && index + 1 == blocks.size()) {
+            // Edge ids mostly arrive in increasing order: leave the full block
+            // full and start the next one, rather than splitting it in half
+            blocks.emplace_back(1, id);
+            ++count;
+            return true;
+        }
+        size_t offset = pos - blocks[index].begin();
+        size_t half = BLOCK_CAPACITY / 2;
+        std::vector<int> upper(blocks[index].begin() + half, blocks[index].end());
+        blocks[index].resize(half);
+        blocks[index].shrink_to_fit();
+        blocks.insert(blocks.begin() + index + 1, std::move(upper));
+        if (offset > half) {
+            ++index;
+            offset -= half;
+        }
+        pos = blocks[index].begin() + offset;
+    }
+    blocks[index].insert(pos, id);
+    ++count;
+    return true;
+}
+
+bool AdjacencyList::erase(int id) {
+    size_t index = blocks.empty() ? 0 : findBlock(id);
+    std::vector<int>& block = blocks.empty() ? ids : blocks[index];
+    auto pos = std::lower_bound(block.begin(), block.end(), id);
+    if (pos == block.end() || *pos != id) {
+        return false;
+    }
+    block.erase(pos);
+    --count;
+
+    if (blocks.empty()) {
+        return true;
+    }
+    if (count < LARGE_THRESHOLD / 2) {
+        mergeIntoVector();
+    } else if (block.empty()) {
+        blocks.erase(blocks.begin() + index);
+    } else if (index + 1 < blocks.size() && block.size() + blocks[index + 1].size() <= BLOCK_CAPACITY / 2) {
+        // Fold sparse neighbours together so erase-heavy lists do not fragment
+        block.insert(block.end(), blocks[index + 1].begin(), blocks[index + 1].end());
+        blocks.erase(blocks.begin() + index + 1);
+    }
+    return true;
+}
+
+void AdjacencyList::assign(std::vector<int> newIds) {
+    if (!std::is_sorted(newIds.begin(), newIds.end())) {
+        std::sort(newIds.begin(), newIds.end());
+    }
+    newIds.erase(std::unique(newIds.begin(), newIds.end()), newIds.end());
+    blocks.clear();
+    ids = std::move(newIds);
+    count = ids.size();
+    if (count > LARGE_THRESHOLD) {
+        splitIntoBlocks();
+    }
+}
+
+void AdjacencyList::clear() {
+    ids.clear();
+    blocks.clear();
+    count = 0;
+}
+
+int AdjacencyList::operator[](size_t index) const {
+    if (index >= count) {
+        throw std::out_of_range("Adjacency index out of range");
+    }
+    if (blocks.empty()) {
+        return ids[index];
+    }
+    for (const std::vector<int>& block : blocks) {
+        if (index < block.size()) {
+            return block[index];
+        }
+        index -= block.size();
+    }
+    throw std::out_of_range("Adjacency index out of range");
+}
+
+size_t AdjacencyList::heapUsage() const {
+    size_t bytes = ids.capacity() * sizeof(int) + blocks.capacity() * sizeof(std::vector<int>);
+    for (const std::vector<int>& block : blocks) {
+        bytes += block.capacity() * sizeof(int);
+    }
+    return bytes;
+}
+
+void AdjacencyList::splitIntoBlocks() {
+    // Full blocks: new ids usually append past the last one, which never splits
+    blocks.reserve((ids.size() + BLOCK_CAPACITY - 1) / BLOCK_CAPACITY);
+    for (size_t begin = 0; begin < ids.size(); begin += BLOCK_CAPACITY) {
+        size_t end = std::min(begin + BLOCK_CAPACITY, ids.size());
+        blocks.emplace_back(ids.begin() + begin, ids.begin() + end);
+    }
+    ids.clear();
+    ids.shrink_to_fit();
+}
+
+void AdjacencyList::mergeIntoVector() {
+    ids.reserve(count);
+    for (const std::vector<int>& block : blocks) {
+        ids.insert(ids.end(), block.begin(), block.end());
+    }
+    blocks.clear();
+    blocks.shrink_to_fit();
+}
@@ -1,63 +1,13 @@
 // src/core/edge.cpp
 #include "core/edge.hpp"
+#include "core/record_codec.hpp"
+#include <sstream>
 #include <stdexcept>
 #include <algorithm>
 
-Edge::Edge(int id, int sourceNodeId, int targetNodeId, const std::string& type)
-    : id(id), sourceNodeId(sourceNodeId), targetNodeId(targetNodeId), type(type), dirty(false) {}
-
-int Edge::getId() const { return id; }
-
-void Edge::setId(int newId) {
-    id = newId;
-    setDirty(true);
-}
-
-int Edge::getSourceNodeId() const { return sourceNodeId; }
-
-int Edge::getTargetNodeId() const { return targetNodeId; }
-
-std::string Edge::getType() const { return type; }
-
-bool Edge::hasProperty(const std::string& key) const {
-    return properties.find(key) != properties.end();
-}
-
-void Edge::removeProperty(const std::string& key) {
-    properties.erase(key);
-    setDirty(true);
-}
-
-std::vector<std::string> Edge::getPropertyKeys() const {
-    std::vector<std::string> keys;
-    keys.reserve(properties.size());
-    for (const auto& pair : properties) {
-        keys.push_back(pair.first);
-    }
-    return keys;
-}
-
-std::string Edge::serialize() const {
-    std::ostringstream oss;
-    
-    // Serialize ID, source node ID, target node ID, and type
-    oss << id << "|" << sourceNodeId << "|" << targetNodeId << "|" << type << "|";
-    
-    // Serialize properties
-    oss << properties.size() << "|";
-
-    for (const auto& [key, value] : properties) {
-        oss << key << ":";
-        std::visit([&oss](const auto& prop) {
-            oss << prop.serialize();
-        }, value);
-        oss << "|";
-    }
-    
-    return oss.str();
-}
-
-Edge Edge::deserialize(const std::string& data) {
+namespace {
+// Records written before the binary format
+Edge deserializeText(const std::string& data, RecordNames& names) {
     std::istringstream iss(data);
     std::string token;
     
@@ -71,7 +21,7 @@ Edge Edge::deserialize(const std::string& data) {
     std::getline(iss, token, '|');
     std::string type = token;
     
-    Edge edge(id, sourceNodeId, targetNodeId, type);
+    Edge edge(id, sourceNodeId, targetNodeId, type, names);
     
     // Deserialize properties
     std::getline(iss, token, '|');
@@ -105,6 +55,102 @@ Edge Edge::deserialize(const std::string& data) {
     
     return edge;
 }
+}
+
+Edge::Edge(int id, int sourceNodeId, int targetNodeId, const std::string& type, RecordNames& names)
+    : Edge(id, sourceNodeId, targetNodeId, names.edgeTypes.intern(type), names) {}
+
+Edge::Edge(int id, int sourceNodeId, int targetNodeId, EdgeType type, RecordNames& names)
+    : id(id), sourceNodeId(sourceNodeId), targetNodeId(targetNodeId), type(type), dirty(false), names(&names) {}
+
+int Edge::getId() const { return id; }
+
+void Edge::setId(int newId) {
+    id = newId;
+    setDirty(true);
+}
+
+void Edge::rekey(RecordNames& target) {
+    if (&target == names) {
+        return;
+    }
+    properties = properties.rekeyed(names->propertyKeys, target.propertyKeys);
+    type = target.edgeTypes.intern(names->edgeTypes.name(type));
+    names = &target;
+    setDirty(true);
+}
+
+int Edge::getSourceNodeId() const { return sourceNodeId; }
+
+int Edge::getTargetNodeId() const { return targetNodeId; }
+
+const std::string& Edge::getType() const { return names->edgeTypes.name(type); }
+
+EdgeType Edge::getTypeId() const { return type; }
+
+bool Edge::hasProperty(std::string_view key) const {
+    auto handle = names->propertyKeys.find(key);
+    return handle && hasProperty(*handle);
+}
+
+bool Edge::hasProperty(PropertyKey key) const {
+    return properties.contains(key);
+}
+
+void Edge::removeProperty(std::string_view key) {
+    // A name that was never interned cannot be set on any record
+    if (auto handle = names->propertyKeys.find(key)) {
+        removeProperty(*handle);
+    }
+}
+
+void Edge::removeProperty(PropertyKey key) {
+    properties.erase(key);
+    setDirty(true);
+}
+
+std::vector<std::string> Edge::getPropertyKeys() const {
+    const PropertyKeyDictionary& dictionary = names->propertyKeys;
+    std::vector<std::string> keys;
+    keys.reserve(properties.size());
+    properties.forEach([&](PropertyKey key, const auto&) {
+        keys.push_back(dictionary.name(key));
+    });
+    return keys;
+}
+
+std::string Edge::serialize() const {
+    std::string out;
+    serializeTo(out);
+    return out;
+}
+
+void Edge::serializeTo(std::string& out) const {
+    BinaryWriter writer(out);
+    writer.writeByte(RECORD_FORMAT_VERSION);
+    writer.writeSigned(id);
+    writer.writeSigned(sourceNodeId);
+    writer.writeSigned(targetNodeId);
+    writer.writeVarint(type.id);
+    encodeProperties(properties, writer);
+}
+
+Edge Edge::deserialize(const std::string& data, RecordNames& names) {
+    return deserialize(data.data(), data.size(), names);
+}
+
+Edge Edge::deserialize(const char* data, size_t size, RecordNames& names) {
+    if (!isBinaryRecord(data, size)) {
+        return deserializeText(std::string(data, size), names);
+    }
+    BinaryReader reader(data + 1, size - 1);
+    int id = static_cast<int>(reader.readSigned());
+    int sourceNodeId = static_cast<int>(reader.readSigned());
+    int targetNodeId = static_cast<int>(reader.readSigned());
+    Edge edge(id, sourceNodeId, targetNodeId, decodeEdgeType(reader, names.edgeTypes), names);
+    decodeProperties(reader, names.propertyKeys, edge.properties);
+    return edge;
+}
 
 bool Edge::isDirty() const {
     return dirty;
@@ -112,4 +158,8 @@ bool Edge::isDirty() const {
 
 void Edge::setDirty(bool dirty) {
     this->dirty = dirty;
-}
\ No newline at end of file
+}
+
+size_t Edge::memoryUsage() const {
+    return sizeof(Edge) + properties.heapUsage();
+}
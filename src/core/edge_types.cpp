@@ -0,0 +1,38 @@
+// src/core/edge_types.cpp
+
+#include "core/edge_types.hpp"
+
+namespace {
+constexpr uint32_t FORMAT_MAGIC = 0x4B455452;  // "KETR"
+}
+
+EdgeTypeRegistry::EdgeTypeRegistry() : names(FORMAT_MAGIC, "edge type") {
+    names.intern("");
+}
+
+EdgeType EdgeTypeRegistry::intern(std::string_view name) {
+    return EdgeType{names.intern(name)};
+}
+
+std::optional<EdgeType> EdgeTypeRegistry::find(std::string_view name) const {
+    if (auto id = names.find(name)) {
+        return EdgeType{*id};
+    }
+    return std::nullopt;
+}
+
+const std::string& EdgeTypeRegistry::name(EdgeType type) const {
+    return names.name(type.id);
+}
+
+size_t EdgeTypeRegistry::size() const {
+    return names.size();
+}
+
+void EdgeTypeRegistry::save(const std::string& path) const {
+    names.save(path);
+}
+
+size_t EdgeTypeRegistry::load(const std::string& path) {
+    return names.load(path);
+}
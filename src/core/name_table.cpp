@@ -0,0 +1,125 @@
+// src/core/name_table.cpp
+
+#include "core/name_table.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+bool readUint32(const std::string& data, size_t& pos, uint32_t& value) {
+    if (data.size() - pos < sizeof(value)) {
+        return false;
+    }
+    std::copy_n(data.data() + pos, sizeof(value), reinterpret_cast<char*>(&value));
+    pos += sizeof(value);
+    return true;
+}
+}
+
+uint32_t NameTable::intern(std::string_view name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = ids.find(name);
+        if (it != ids.end()) {
+            return it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto it = ids.find(name);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    uint32_t id = names.size();
+    names.emplace_back(name);
+    ids.emplace(names.back(), id);
+    nameCount.store(names.size(), std::memory_order_release);
+    return id;
+}
+
+std::optional<uint32_t> NameTable::find(std::string_view name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto it = ids.find(name);
+    if (it == ids.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+const std::string& NameTable::name(uint32_t id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    if (id >= names.size()) {
+        throw std::out_of_range("Unknown " + noun);
+    }
+    return names[id];
+}
+
+void NameTable::save(const std::string& path) const {
+    std::string data(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        uint32_t count = names.size();
+        data.append(reinterpret_cast<const char*>(&count), sizeof(count));
+        for (const std::string& name : names) {
+            uint32_t length = name.size();
+            data.append(reinterpret_cast<const char*>(&length), sizeof(length));
+            data.append(name);
+        }
+    }
+
+    // Replace atomically so a crash mid-write leaves the previous names intact
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size());
+        if (!file) {
+            throw std::runtime_error("Failed to write " + noun + " names");
+        }
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Failed to replace " + noun + " names");
+    }
+}
+
+size_t NameTable::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return 0;
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    // Records refer to these ids, so an unreadable file is an error rather than empty
+    size_t pos = 0;
+    uint32_t savedMagic;
+    uint32_t count;
+    if (!readUint32(data, pos, savedMagic) || savedMagic != magic || !readUint32(data, pos, count)) {
+        throw std::runtime_error("Saved " + noun + " names are corrupt");
+    }
+    std::vector<std::string_view> saved;
+    saved.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t length;
+        if (!readUint32(data, pos, length) || data.size() - pos < length) {
+            throw std::runtime_error("Saved " + noun + " names are corrupt");
+        }
+        saved.emplace_back(data.data() + pos, length);
+        pos += length;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    for (uint32_t id = 0; id < saved.size(); ++id) {
+        auto it = ids.find(saved[id]);
+        if (it != ids.end() ? it->second != id : id != names.size()) {
+            throw std::runtime_error("Saved " + noun + " names conflict with ids already in use");
+        }
+        if (it == ids.end()) {
+            names.emplace_back(saved[id]);
+            ids.emplace(names.back(), id);
+            nameCount.store(names.size(), std::memory_order_release);
+        }
+    }
+    return saved.size();
+}
@@ -1,103 +1,41 @@
 // src/core/node.cpp
 #include "core/node.hpp"
+#include "core/record_codec.hpp"
 
-Node::Node() : id(0), dirty(false) {}
+namespace {
+const AdjacencyList emptyPartition;
 
-Node::Node(int id) : id(id), dirty(false) {}
-
-int Node::getId() const {
-    return id;
+// First partition whose type is not below type
+template<typename Partitions>
+auto partitionFor(Partitions& partitions, EdgeType type) {
+    return std::lower_bound(partitions.begin(), partitions.end(), type,
+                            [](const AdjacencyPartition& partition, EdgeType t) { return partition.type < t; });
 }
 
-void Node::setId(int newId) {
-    id = newId;
-    setDirty(true);
-}
-
-bool Node::hasProperty(const std::string& key) const {
-    return properties.find(key) != properties.end();
+const AdjacencyList& findPartition(const std::vector<AdjacencyPartition>& partitions, EdgeType type) {
+    auto it = partitionFor(partitions, type);
+    return it != partitions.end() && it->type == type ? it->edges : emptyPartition;
 }
 
-void Node::removeProperty(const std::string& key) {
-    properties.erase(key);
-    setDirty(true);
-}
-
-std::vector<std::string> Node::getPropertyKeys() const {
-    std::vector<std::string> keys;
-    keys.reserve(properties.size());
-    for (const auto& pair : properties) {
-        keys.push_back(pair.first);
+std::vector<int> flattenPartitions(const std::vector<AdjacencyPartition>& partitions) {
+    if (partitions.size() == 1) {
+        return partitions.front().edges.toVector();
     }
-    return keys;
-}
-
-void Node::addEdge(int edgeId, bool isOutgoing) {
-    auto& edges = isOutgoing ? outgoingEdges : incomingEdges;
-    if (std::find(edges.begin(), edges.end(), edgeId) == edges.end()) {
-        edges.push_back(edgeId);
-        setDirty(true);
+    std::vector<int> ids;
+    for (const AdjacencyPartition& partition : partitions) {
+        ids.insert(ids.end(), partition.edges.begin(), partition.edges.end());
     }
+    return ids;
 }
 
-void Node::removeEdge(int edgeId, bool isOutgoing) {
-    auto& edges = isOutgoing ? outgoingEdges : incomingEdges;
-    edges.erase(std::remove(edges.begin(), edges.end(), edgeId), edges.end());
-    setDirty(true);
-}
-
-const std::vector<int>& Node::getIncomingEdges() const {
-    return incomingEdges;
-}
-
-const std::vector<int>& Node::getOutgoingEdges() const {
-    return outgoingEdges;
-}
-
-std::string Node::serialize() const {
-    std::ostringstream oss;
-    
-    // Serialize ID
-    oss << id << "|";
-    
-    // Serialize properties
-    oss << properties.size() << "|";
-
-    std::vector<std::pair<std::string, std::string>> sortedProperties;
-    for (const auto& [key, value] : properties) {
-        std::string serializedValue = std::visit([](const auto& prop) { return prop.serialize(); }, value);
-        sortedProperties.emplace_back(key, serializedValue);
-    }
-    std::sort(sortedProperties.begin(), sortedProperties.end());
-
-    for (const auto& [key, value] : sortedProperties) {
-        oss << key << ":" << value << "|";
-    }
-    
-    // Serialize incoming edges
-    oss << incomingEdges.size() << "|";
-    for (int edgeId : incomingEdges) {
-        oss << edgeId << ",";
-    }
-    oss << "|";
-    
-    // Serialize outgoing edges
-    oss << outgoingEdges.size() << "|";
-    for (int edgeId : outgoingEdges) {
-        oss << edgeId << ",";
-    }
-    oss << "|";
-    
-    return oss.str();
-}
-
-Node Node::deserialize(const std::string& data) {
+// Records written before the binary format
+Node deserializeText(const std::string& data, RecordNames& names) {
     std::istringstream iss(data);
     std::string token;
     
     // Deserialize ID
     std::getline(iss, token, '|');
-    Node node(std::stoi(token));
+    Node node(std::stoi(token), names);
     
     // Deserialize properties
     std::getline(iss, token, '|');
@@ -150,6 +88,190 @@ Node Node::deserialize(const std::string& data) {
     
     return node;
 }
+}
+
+Node::Node() : id(0), dirty(false), names(&RecordNames::detached()) {}
+
+Node::Node(int id) : id(id), dirty(false), names(&RecordNames::detached()) {}
+
+Node::Node(int id, RecordNames& names) : id(id), dirty(false), names(&names) {}
+
+int Node::getId() const {
+    return id;
+}
+
+void Node::setId(int newId) {
+    id = newId;
+    setDirty(true);
+}
+
+void Node::rekey(RecordNames& target) {
+    if (&target == names) {
+        return;
+    }
+    properties = properties.rekeyed(names->propertyKeys, target.propertyKeys);
+    for (auto* partitions : {&incomingEdges, &outgoingEdges}) {
+        for (AdjacencyPartition& partition : *partitions) {
+            partition.type = target.edgeTypes.intern(names->edgeTypes.name(partition.type));
+        }
+        std::sort(partitions->begin(), partitions->end(),
+                  [](const AdjacencyPartition& a, const AdjacencyPartition& b) { return a.type < b.type; });
+    }
+    names = &target;
+    setDirty(true);
+}
+
+bool Node::hasProperty(std::string_view key) const {
+    auto handle = names->propertyKeys.find(key);
+    return handle && hasProperty(*handle);
+}
+
+bool Node::hasProperty(PropertyKey key) const {
+    return properties.contains(key);
+}
+
+void Node::removeProperty(std::string_view key) {
+    // A name that was never interned cannot be set on any record
+    if (auto handle = names->propertyKeys.find(key)) {
+        removeProperty(*handle);
+    }
+}
+
+void Node::removeProperty(PropertyKey key) {
+    properties.erase(key);
+    setDirty(true);
+}
+
+std::vector<std::string> Node::getPropertyKeys() const {
+    const PropertyKeyDictionary& dictionary = names->propertyKeys;
+    std::vector<std::string> keys;
+    keys.reserve(properties.size());
+    properties.forEach([&](PropertyKey key, const auto&) {
+        keys.push_back(dictionary.name(key));
+    });
+    return keys;
+}
+
+void Node::addEdge(int edgeId, bool isOutgoing, EdgeType type) {
+    auto& partitions = isOutgoing ? outgoingEdges : incomingEdges;
+    auto it = partitionFor(partitions, type);
+    if (it == partitions.end() || it->type != type) {
+        it = partitions.insert(it, AdjacencyPartition{type, AdjacencyList()});
+    }
+    if (it->edges.insert(edgeId)) {
+        setDirty(true);
+    }
+}
+
+void Node::addEdge(const Edge& edge) {
+    EdgeType type = &edge.getNames() == names ? edge.getTypeId() : names->edgeTypes.intern(edge.getType());
+    if (edge.getSourceNodeId() == id) {
+        addEdge(edge.getId(), true, type);
+    }
+    if (edge.getTargetNodeId() == id) {
+        addEdge(edge.getId(), false, type);
+    }
+}
+
+void Node::removeEdge(int edgeId, bool isOutgoing) {
+    auto& partitions = isOutgoing ? outgoingEdges : incomingEdges;
+    for (auto it = partitions.begin(); it != partitions.end(); ++it) {
+        if (it->edges.erase(edgeId)) {
+            if (it->edges.empty()) {
+                partitions.erase(it);
+            }
+            break;
+        }
+    }
+    setDirty(true);
+}
+
+void Node::removeEdge(int edgeId, bool isOutgoing, EdgeType type) {
+    auto& partitions = isOutgoing ? outgoingEdges : incomingEdges;
+    auto it = partitionFor(partitions, type);
+    if (it != partitions.end() && it->type == type && it->edges.erase(edgeId) && it->edges.empty()) {
+        partitions.erase(it);
+    }
+    setDirty(true);
+}
+
+bool Node::hasEdge(int edgeId, bool isOutgoing) const {
+    for (const AdjacencyPartition& partition : isOutgoing ? outgoingEdges : incomingEdges) {
+        if (partition.edges.contains(edgeId)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<int> Node::getIncomingEdges() const {
+    return flattenPartitions(incomingEdges);
+}
+
+std::vector<int> Node::getOutgoingEdges() const {
+    return flattenPartitions(outgoingEdges);
+}
+
+const AdjacencyList& Node::getIncomingEdges(EdgeType type) const {
+    return findPartition(incomingEdges, type);
+}
+
+const AdjacencyList& Node::getOutgoingEdges(EdgeType type) const {
+    return findPartition(outgoingEdges, type);
+}
+
+const AdjacencyList& Node::getIncomingEdges(std::string_view type) const {
+    auto handle = names->edgeTypes.find(type);
+    return handle ? getIncomingEdges(*handle) : emptyPartition;
+}
+
+const AdjacencyList& Node::getOutgoingEdges(std::string_view type) const {
+    auto handle = names->edgeTypes.find(type);
+    return handle ? getOutgoingEdges(*handle) : emptyPartition;
+}
+
+const std::vector<AdjacencyPartition>& Node::getEdgePartitions(bool isOutgoing) const {
+    return isOutgoing ? outgoingEdges : incomingEdges;
+}
+
+size_t Node::getEdgeCount(bool isOutgoing) const {
+    size_t count = 0;
+    for (const AdjacencyPartition& partition : isOutgoing ? outgoingEdges : incomingEdges) {
+        count += partition.edges.size();
+    }
+    return count;
+}
+
+std::string Node::serialize() const {
+    std::string out;
+    serializeTo(out);
+    return out;
+}
+
+void Node::serializeTo(std::string& out) const {
+    BinaryWriter writer(out);
+    writer.writeByte(RECORD_FORMAT_VERSION);
+    writer.writeSigned(id);
+    encodeProperties(properties, writer);
+    encodeAdjacency(incomingEdges, writer);
+    encodeAdjacency(outgoingEdges, writer);
+}
+
+Node Node::deserialize(const std::string& data, RecordNames& names) {
+    return deserialize(data.data(), data.size(), names);
+}
+
+Node Node::deserialize(const char* data, size_t size, RecordNames& names) {
+    if (!isBinaryRecord(data, size)) {
+        return deserializeText(std::string(data, size), names);
+    }
+    BinaryReader reader(data + 1, size - 1);
+    Node node(static_cast<int>(reader.readSigned()), names);
+    decodeProperties(reader, names.propertyKeys, node.properties);
+    decodeAdjacency(reader, names.edgeTypes, node.incomingEdges);
+    decodeAdjacency(reader, names.edgeTypes, node.outgoingEdges);
+    return node;
+}
 
 bool Node::isDirty() const {
     return dirty;
@@ -157,4 +279,16 @@ bool Node::isDirty() const {
 
 void Node::setDirty(bool dirty) {
     this->dirty = dirty;
-}
\ No newline at end of file
+}
+
+size_t Node::memoryUsage() const {
+    size_t bytes = sizeof(Node);
+    bytes += properties.heapUsage();
+    for (const auto* partitions : {&incomingEdges, &outgoingEdges}) {
+        bytes += partitions->capacity() * sizeof(AdjacencyPartition);
+        for (const AdjacencyPartition& partition : *partitions) {
+            bytes += partition.edges.heapUsage();
+        }
+    }
+    return bytes;
+}
@@ -0,0 +1,36 @@
+// src/core/property_keys.cpp
+
+#include "core/property_keys.hpp"
+
+namespace {
+constexpr uint32_t FORMAT_MAGIC = 0x4B504B44;  // "KPKD"
+}
+
+PropertyKeyDictionary::PropertyKeyDictionary() : names(FORMAT_MAGIC, "property key") {}
+
+PropertyKey PropertyKeyDictionary::intern(std::string_view name) {
+    return PropertyKey{names.intern(name)};
+}
+
+std::optional<PropertyKey> PropertyKeyDictionary::find(std::string_view name) const {
+    if (auto id = names.find(name)) {
+        return PropertyKey{*id};
+    }
+    return std::nullopt;
+}
+
+const std::string& PropertyKeyDictionary::name(PropertyKey key) const {
+    return names.name(key.id);
+}
+
+size_t PropertyKeyDictionary::size() const {
+    return names.size();
+}
+
+void PropertyKeyDictionary::save(const std::string& path) const {
+    names.save(path);
+}
+
+size_t PropertyKeyDictionary::load(const std::string& path) {
+    return names.load(path);
+}
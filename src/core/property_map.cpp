@@ -0,0 +1,236 @@
+// src/core/property_map.cpp
+
+#include "core/property_map.hpp"
+#include <cstring>
+#include <utility>
+
+PropertyMap::PropertyMap() {
+    resetToInline();
+}
+
+PropertyMap::PropertyMap(const PropertyMap& other) {
+    resetToInline();
+    if (other.table) {
+        table = std::make_unique<std::unordered_map<PropertyKey, Slot>>();
+        table->reserve(other.table->size());
+        for (const auto& [key, slot] : *other.table) {
+            table->emplace(key, Slot{slot.type, copyPayload(slot.type, slot.payload)});
+        }
+        return;
+    }
+    reserve(other.count);
+    for (uint32_t i = 0; i < other.count; ++i) {
+        payloads()[i] = copyPayload(other.types()[i], other.payloads()[i]);
+        keys()[i] = other.keys()[i];
+        types()[i] = other.types()[i];
+        ++count;
+    }
+}
+
+PropertyMap::PropertyMap(PropertyMap&& other) noexcept {
+    resetToInline();
+    *this = std::move(other);
+}
+
+PropertyMap& PropertyMap::operator=(const PropertyMap& other) {
+    if (this != &other) {
+        *this = PropertyMap(other);
+    }
+    return *this;
+}
+
+PropertyMap& PropertyMap::operator=(PropertyMap&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    clear();
+    table = std::move(other.table);
+    if (!other.isInline()) {
+        block = other.block;
+        count = other.count;
+        capacity = other.capacity;
+    } else {
+        // Payloads and keys are plain bytes; string ownership moves with the pointer
+        std::memcpy(payloads(), other.payloads(), other.count * sizeof(Payload));
+        std::memcpy(keys(), other.keys(), other.count * sizeof(PropertyKey));
+        std::memcpy(types(), other.types(), other.count);
+        count = other.count;
+    }
+    other.resetToInline();
+    return *this;
+}
+
+PropertyMap::~PropertyMap() {
+    if (table) {
+        for (const auto& [key, slot] : *table) {
+            releasePayload(slot.type, slot.payload);
+        }
+    }
+    releaseArrays();
+}
+
+bool PropertyMap::erase(PropertyKey key) {
+    if (table) {
+        auto it = table->find(key);
+        if (it == table->end()) {
+            return false;
+        }
+        releasePayload(it->second.type, it->second.payload);
+        table->erase(it);
+        return true;
+    }
+    uint32_t pos = lowerBound(key);
+    if (pos == count || keys()[pos] != key) {
+        return false;
+    }
+    releasePayload(types()[pos], payloads()[pos]);
+    uint32_t tail = count - pos - 1;
+    std::memmove(payloads() + pos, payloads() + pos + 1, tail * sizeof(Payload));
+    std::memmove(keys() + pos, keys() + pos + 1, tail * sizeof(PropertyKey));
+    std::memmove(types() + pos, types() + pos + 1, tail);
+    --count;
+    return true;
+}
+
+PropertyMap PropertyMap::rekeyed(const PropertyKeyDictionary& from, PropertyKeyDictionary& to) const {
+    PropertyMap result;
+    result.reserve(size());
+    forEach([&](PropertyKey key, const auto& value) { result.assign(to.intern(from.name(key)), value); });
+    return result;
+}
+
+void PropertyMap::reserve(size_t entries) {
+    if (table) {
+        table->reserve(entries);
+    } else if (entries > HASH_THRESHOLD) {
+        moveToTable();
+        table->reserve(entries);
+    } else if (entries > capacity) {
+        grow(static_cast<uint32_t>(entries));
+    }
+}
+
+void PropertyMap::clear() {
+    if (table) {
+        for (const auto& [key, slot] : *table) {
+            releasePayload(slot.type, slot.payload);
+        }
+        table.reset();
+    }
+    releaseArrays();
+    resetToInline();
+}
+
+size_t PropertyMap::heapUsage() const {
+    size_t bytes = 0;
+    if (table) {
+        bytes += sizeof(*table) + table->bucket_count() * sizeof(void*);
+        // Hash node: value_type plus next pointer
+        bytes += table->size() * (sizeof(std::pair<const PropertyKey, Slot>) + sizeof(void*));
+    } else if (!isInline()) {
+        bytes += capacity * ENTRY_BYTES;
+    }
+    forEach([&bytes](PropertyKey, const auto& value) {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (std::is_same_v<T, std::string>) {
+            bytes += sizeof(std::string) + stringHeapUsage(value);
+        } else if constexpr (std::is_same_v<T, std::vector<float>>) {
+            bytes += sizeof(std::vector<float>) + value.capacity() * sizeof(float);
+        }
+    });
+    return bytes;
+}
+
+void PropertyMap::assignSlot(PropertyKey key, uint8_t type, Payload payload) {
+    if (table) {
+        auto [it, inserted] = table->try_emplace(key, Slot{type, payload});
+        if (!inserted) {
+            releasePayload(it->second.type, it->second.payload);
+            it->second = Slot{type, payload};
+        }
+        return;
+    }
+    uint32_t pos = lowerBound(key);
+    if (pos < count && keys()[pos] == key) {
+        releasePayload(types()[pos], payloads()[pos]);
+        payloads()[pos] = payload;
+        types()[pos] = type;
+        return;
+    }
+    if (count == HASH_THRESHOLD) {
+        moveToTable();
+        table->emplace(key, Slot{type, payload});
+        return;
+    }
+    if (count == capacity) {
+        grow(std::min(capacity * 2, HASH_THRESHOLD));
+    }
+    uint32_t tail = count - pos;
+    std::memmove(payloads() + pos + 1, payloads() + pos, tail * sizeof(Payload));
+    std::memmove(keys() + pos + 1, keys() + pos, tail * sizeof(PropertyKey));
+    std::memmove(types() + pos + 1, types() + pos, tail);
+    payloads()[pos] = payload;
+    keys()[pos] = key;
+    types()[pos] = type;
+    ++count;
+}
+
+PropertyMap::Payload PropertyMap::copyPayload(uint8_t type, Payload payload) {
+    if (type == StringProperty::typeId()) {
+        payload.s = new std::string(*payload.s);
+    } else if (type == FloatVectorProperty::typeId()) {
+        payload.v = new std::vector<float>(*payload.v);
+    }
+    return payload;
+}
+
+void PropertyMap::releasePayload(uint8_t type, Payload payload) {
+    if (type == StringProperty::typeId()) {
+        delete payload.s;
+    } else if (type == FloatVectorProperty::typeId()) {
+        delete payload.v;
+    }
+}
+
+void PropertyMap::resetToInline() {
+    count = 0;
+    capacity = INLINE_CAPACITY;
+    block = inlineBlock;
+}
+
+void PropertyMap::releaseArrays() {
+    for (uint32_t i = 0; i < count; ++i) {
+        releasePayload(types()[i], payloads()[i]);
+    }
+    if (!isInline()) {
+        delete[] block;
+    }
+    count = 0;
+}
+
+void PropertyMap::grow(uint32_t newCapacity) {
+    // new[] of unsigned char is aligned for any fundamental type, including Payload
+    unsigned char* newBlock = new unsigned char[newCapacity * ENTRY_BYTES];
+    std::memcpy(newBlock, payloads(), count * sizeof(Payload));
+    std::memcpy(newBlock + newCapacity * sizeof(Payload), keys(), count * sizeof(PropertyKey));
+    std::memcpy(newBlock + newCapacity * (sizeof(Payload) + sizeof(PropertyKey)), types(), count);
+    if (!isInline()) {
+        delete[] block;
+    }
+    block = newBlock;
+    capacity = newCapacity;
+}
+
+void PropertyMap::moveToTable() {
+    auto newTable = std::make_unique<std::unordered_map<PropertyKey, Slot>>();
+    newTable->reserve(count + 1);
+    for (uint32_t i = 0; i < count; ++i) {
+        newTable->emplace(keys()[i], Slot{types()[i], payloads()[i]});
+    }
+    // The table owns the strings now
+    if (!isInline()) {
+        delete[] block;
+    }
+    resetToInline();
+    table = std::move(newTable);
+}
@@ -0,0 +1,8 @@
+// src/core/record_names.cpp
+
+#include "core/record_names.hpp"
+
+RecordNames& RecordNames::detached() {
+    static RecordNames names;
+    return names;
+}
@@ -0,0 +1,162 @@
+// src/core/record_view.cpp
+
+#include "core/record_view.hpp"
+#include "core/record_codec.hpp"
+
+namespace {
+void requireBinary(const char* data, size_t size) {
+    if (!isBinaryRecord(data, size)) {
+        throw std::runtime_error("Record is not in a binary format");
+    }
+}
+
+void skipValue(BinaryReader& reader, uint8_t type) {
+    switch (type) {
+        case BoolProperty::typeId():
+            reader.readByte();
+            break;
+        case IntProperty::typeId():
+            reader.readVarint();
+            break;
+        case DoubleProperty::typeId():
+            reader.readDouble();
+            break;
+        case StringProperty::typeId():
+            reader.readString();
+            break;
+        case FloatVectorProperty::typeId():
+            reader.skipFloats(reader.readVarint());
+            break;
+        default:
+            throw std::runtime_error("Unknown property type during deserialization");
+    }
+}
+}
+
+PropertiesView::PropertiesView(const char* section, size_t sectionBytes) {
+    BinaryReader reader(section, sectionBytes);
+    count = reader.readCount();
+    data = reader.position();
+    bytes = sectionBytes - (data - section);
+}
+
+const char* PropertiesView::locate(PropertyKey key, uint8_t& type) const {
+    BinaryReader reader(data, bytes);
+    for (size_t i = 0; i < count; ++i) {
+        bool match = reader.readVarint() == key.id;
+        type = reader.readByte();
+        if (match) {
+            return reader.position();
+        }
+        skipValue(reader, type);
+    }
+    return nullptr;
+}
+
+std::vector<PropertyKey> PropertiesView::keys() const {
+    std::vector<PropertyKey> result;
+    result.reserve(count);
+    BinaryReader reader(data, bytes);
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back(PropertyKey{static_cast<uint32_t>(reader.readVarint())});
+        skipValue(reader, reader.readByte());
+    }
+    return result;
+}
+
+const char* PropertiesView::end() const {
+    BinaryReader reader(data, bytes);
+    for (size_t i = 0; i < count; ++i) {
+        reader.readVarint();
+        skipValue(reader, reader.readByte());
+    }
+    return reader.position();
+}
+
+NodeView::NodeView(const char* data, size_t size, RecordNames& names) : data(data), size(size), names(&names) {
+    requireBinary(data, size);
+    BinaryReader reader(data + 1, size - 1);
+    id = static_cast<int>(reader.readSigned());
+    properties = PropertiesView(reader.position(), data + size - reader.position());
+}
+
+bool NodeView::hasProperty(std::string_view key) const {
+    auto handle = names->propertyKeys.find(key);
+    return handle && hasProperty(*handle);
+}
+
+IdListView NodeView::getIncomingEdges() const {
+    locateAdjacency();
+    return incoming->all;
+}
+
+IdListView NodeView::getOutgoingEdges() const {
+    locateAdjacency();
+    return outgoing->all;
+}
+
+IdListView NodeView::getIncomingEdges(EdgeType type) const {
+    locateAdjacency();
+    return findPartition(*incoming, type);
+}
+
+IdListView NodeView::getOutgoingEdges(EdgeType type) const {
+    locateAdjacency();
+    return findPartition(*outgoing, type);
+}
+
+void NodeView::locateAdjacency() const {
+    if (incoming) {
+        return;
+    }
+    const char* begin = properties.end();
+    BinaryReader reader(begin, data + size - begin);
+    auto readAdjacency = [&]() {
+        uint64_t total = reader.readVarint();
+        uint64_t count = reader.readVarint();
+        const char* partitions = reader.position();
+        for (uint64_t i = 0; i < count; ++i) {
+            reader.readVarint();
+            reader.readVarint();
+            reader.readString();
+        }
+        const char* end = reader.position();
+        return Adjacency{IdListView(partitions, end - partitions, total, true), partitions, end};
+    };
+    Adjacency in = readAdjacency();
+    outgoing = readAdjacency();
+    incoming = in;
+}
+
+IdListView NodeView::findPartition(const Adjacency& adjacency, EdgeType type) {
+    BinaryReader reader(adjacency.partitions, adjacency.end - adjacency.partitions);
+    while (!reader.atEnd()) {
+        uint64_t typeId = reader.readVarint();
+        uint64_t count = reader.readVarint();
+        std::string_view deltas = reader.readString();
+        if (typeId == type.id) {
+            return IdListView(deltas.data(), deltas.size(), count);
+        }
+        // Partitions are in ascending type order
+        if (typeId > type.id) {
+            break;
+        }
+    }
+    return IdListView();
+}
+
+EdgeView::EdgeView(const char* data, size_t size, RecordNames& names) : data(data), size(size), names(&names) {
+    requireBinary(data, size);
+    BinaryReader reader(data + 1, size - 1);
+    id = static_cast<int>(reader.readSigned());
+    sourceNodeId = static_cast<int>(reader.readSigned());
+    targetNodeId = static_cast<int>(reader.readSigned());
+    typeId = decodeEdgeType(reader, names.edgeTypes);
+    type = names.edgeTypes.name(typeId);
+    properties = PropertiesView(reader.position(), data + size - reader.position());
+}
+
+bool EdgeView::hasProperty(std::string_view key) const {
+    auto handle = names->propertyKeys.find(key);
+    return handle && hasProperty(*handle);
+}
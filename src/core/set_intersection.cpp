@@ -0,0 +1,177 @@
+// src/core/set_intersection.cpp
+
+#include "core/set_intersection.hpp"
+#include <algorithm>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define KRUSKAL_X86_KERNELS 1
+#endif
+
+namespace {
+// Galloping wins once the longer list is this many times the shorter
+constexpr size_t GALLOP_RATIO = 32;
+
+using CountKernel = size_t (*)(const int*, size_t, const int*, size_t);
+
+// First position in [from, size) whose id is not below value: doubles the
+// step until it passes value, then binary searches the last step
+size_t gallop(const int* ids, size_t size, size_t from, int value) {
+    size_t step = 1;
+    size_t low = from;
+    size_t high = from;
+    while (high < size && ids[high] < value) {
+        low = high + 1;
+        high = from + step;
+        step *= 2;
+    }
+    return std::lower_bound(ids + low, ids + std::min(high, size), value) - ids;
+}
+
+// Counts by default; appends to out when it is given
+size_t mergeScalar(const int* a, size_t aSize, const int* b, size_t bSize, std::vector<int>* out) {
+    size_t count = 0;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < aSize && j < bSize) {
+        if (a[i] < b[j]) {
+            ++i;
+        } else if (b[j] < a[i]) {
+            ++j;
+        } else {
+            if (out) {
+                out->push_back(a[i]);
+            }
+            ++count;
+            ++i;
+            ++j;
+        }
+    }
+    return count;
+}
+
+size_t gallopScalar(const int* small, size_t smallSize, const int* large, size_t largeSize, std::vector<int>* out) {
+    size_t count = 0;
+    size_t position = 0;
+    for (size_t i = 0; i < smallSize && position < largeSize; ++i) {
+        position = gallop(large, largeSize, position, small[i]);
+        if (position < largeSize && large[position] == small[i]) {
+            if (out) {
+                out->push_back(small[i]);
+            }
+            ++count;
+            ++position;
+        }
+    }
+    return count;
+}
+
+size_t countScalar(const int* a, size_t aSize, const int* b, size_t bSize) {
+    return mergeScalar(a, aSize, b, bSize, nullptr);
+}
+
+#ifdef KRUSKAL_X86_KERNELS
+// Each id of an 8-id block of a is compared with all 8 of b's block by
+// rotating b's block through every lane. The block with the smaller last id
+// cannot match anything further on, so it is the one that advances (both on
+// a tie). Ids are distinct, so no pair is counted twice.
+__attribute__((target("avx2,popcnt"))) size_t countAvx2(const int* a, size_t aSize, const int* b, size_t bSize) {
+    size_t count = 0;
+    size_t i = 0;
+    size_t j = 0;
+    const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    while (i + 8 <= aSize && j + 8 <= bSize) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        __m256i matches = _mm256_cmpeq_epi32(va, vb);
+        for (int r = 1; r < 8; ++r) {
+            vb = _mm256_permutevar8x32_epi32(vb, rotate);
+            matches = _mm256_or_si256(matches, _mm256_cmpeq_epi32(va, vb));
+        }
+        count += _mm_popcnt_u32(_mm256_movemask_ps(_mm256_castsi256_ps(matches)));
+        int aLast = a[i + 7];
+        int bLast = b[j + 7];
+        i += aLast <= bLast ? 8 : 0;
+        j += bLast <= aLast ? 8 : 0;
+    }
+    return count + mergeScalar(a + i, aSize - i, b + j, bSize - j, nullptr);
+}
+
+__attribute__((target("avx512f,popcnt"))) size_t countAvx512(const int* a, size_t aSize, const int* b,
+                                                              size_t bSize) {
+    size_t count = 0;
+    size_t i = 0;
+    size_t j = 0;
+    const __m512i rotate = _mm512_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0);
+    while (i + 16 <= aSize && j + 16 <= bSize) {
+        __m512i va = _mm512_loadu_si512(a + i);
+        __m512i vb = _mm512_loadu_si512(b + j);
+        __mmask16 matches = _mm512_cmpeq_epi32_mask(va, vb);
+        for (int r = 1; r < 16; ++r) {
+            vb = _mm512_permutexvar_epi32(rotate, vb);
+            matches |= _mm512_cmpeq_epi32_mask(va, vb);
+        }
+        count += _mm_popcnt_u32(matches);
+        int aLast = a[i + 15];
+        int bLast = b[j + 15];
+        i += aLast <= bLast ? 16 : 0;
+        j += bLast <= aLast ? 16 : 0;
+    }
+    // The 8-wide kernel finishes what no longer fills a 16-id block
+    return count + countAvx2(a + i, aSize - i, b + j, bSize - j);
+}
+#endif
+
+CountKernel countKernel(SimdLevel level) {
+#ifdef KRUSKAL_X86_KERNELS
+    switch (std::min(level, detectedSimdLevel())) {
+        case SimdLevel::Avx512: return countAvx512;
+        case SimdLevel::Avx2: return countAvx2;
+        default: return countScalar;
+    }
+#else
+    (void)level;
+    return countScalar;
+#endif
+}
+
+CountKernel bestCountKernel() {
+    static const CountKernel kernel = countKernel(SimdLevel::Avx512);
+    return kernel;
+}
+
+bool skewed(size_t aSize, size_t bSize) {
+    return aSize * GALLOP_RATIO < bSize || bSize * GALLOP_RATIO < aSize;
+}
+}
+
+size_t intersectionSize(const int* a, size_t aSize, const int* b, size_t bSize) {
+    if (skewed(aSize, bSize)) {
+        return gallopingIntersectionSize(a, aSize, b, bSize);
+    }
+    return bestCountKernel()(a, aSize, b, bSize);
+}
+
+void intersect(const int* a, size_t aSize, const int* b, size_t bSize, std::vector<int>& out) {
+    if (aSize > bSize) {
+        std::swap(a, b);
+        std::swap(aSize, bSize);
+    }
+    if (aSize * GALLOP_RATIO < bSize) {
+        gallopScalar(a, aSize, b, bSize, &out);
+    } else {
+        mergeScalar(a, aSize, b, bSize, &out);
+    }
+}
+
+size_t intersectionSize(const int* a, size_t aSize, const int* b, size_t bSize, SimdLevel level) {
+    return countKernel(level)(a, aSize, b, bSize);
+}
+
+size_t gallopingIntersectionSize(const int* a, size_t aSize, const int* b, size_t bSize) {
+    if (aSize > bSize) {
+        return gallopScalar(b, bSize, a, aSize, nullptr);
+    }
+    return gallopScalar(a, aSize, b, bSize, nullptr);
+}
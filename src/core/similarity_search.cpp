@@ -0,0 +1,119 @@
+// src/core/similarity_search.cpp
+
+#include "core/similarity_search.hpp"
+#include "core/parallel.hpp"
+#include "storage/storage_engine.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace {
+// Slices smaller than this are not worth a thread
+constexpr size_t MIN_NODES_PER_THREAD = 1024;
+
+struct Closer {
+    SimilarityMetric metric;
+
+    bool operator()(const SimilarityMatch& a, const SimilarityMatch& b) const {
+        if (a.score != b.score) {
+            return metric == SimilarityMetric::L2 ? a.score < b.score : a.score > b.score;
+        }
+        return a.nodeId < b.nodeId;
+    }
+};
+
+float scoreOf(const std::vector<float>& query, const float* vector, SimilarityMetric metric) {
+    switch (metric) {
+        case SimilarityMetric::Dot:
+            return dotProduct(query.data(), vector, query.size());
+        case SimilarityMetric::Cosine:
+            return cosineSimilarity(query.data(), vector, query.size());
+        default:
+            return squaredL2Distance(query.data(), vector, query.size());
+    }
+}
+
+// Keeps the k closest matches offered in a heap whose top is the farthest of
+// them, so most candidates cost one comparison
+void offer(SimilarityMatch match, size_t k, const Closer& closer, std::vector<SimilarityMatch>& heap) {
+    // NaN compares unequal to every score, which would break the heap order
+    if (std::isnan(match.score)) {
+        return;
+    }
+    if (heap.size() == k) {
+        if (!closer(match, heap.front())) {
+            return;
+        }
+        std::pop_heap(heap.begin(), heap.end(), closer);
+        heap.back() = match;
+    } else {
+        heap.push_back(match);
+    }
+    std::push_heap(heap.begin(), heap.end(), closer);
+}
+
+void scanSlice(const std::vector<std::shared_ptr<Node>>& nodes, size_t begin, size_t end, PropertyKey key,
+               const std::vector<float>& query, size_t k, SimilarityMetric metric,
+               std::vector<SimilarityMatch>& heap) {
+    Closer closer{metric};
+    heap.reserve(k + 1);
+    for (size_t i = begin; i < end; ++i) {
+        const Node* node = nodes[i].get();
+        const std::vector<float>* vector = node ? node->getProperties().find<std::vector<float>>(key) : nullptr;
+        if (!vector || vector->size() != query.size()) {
+            continue;
+        }
+        offer({node->getId(), scoreOf(query, vector->data(), metric)}, k, closer, heap);
+    }
+}
+
+// The k closest of the per-thread heaps, closest first
+std::vector<SimilarityMatch> mergeHeaps(const std::vector<std::vector<SimilarityMatch>>& heaps, size_t k,
+                                        SimilarityMetric metric) {
+    std::vector<SimilarityMatch> matches;
+    for (const auto& heap : heaps) {
+        matches.insert(matches.end(), heap.begin(), heap.end());
+    }
+    Closer closer{metric};
+    size_t keep = std::min(k, matches.size());
+    std::partial_sort(matches.begin(), matches.begin() + keep, matches.end(), closer);
+    matches.resize(keep);
+    return matches;
+}
+}
+
+std::vector<SimilarityMatch> topKSimilar(const std::vector<std::shared_ptr<Node>>& nodes, PropertyKey key,
+                                        const std::vector<float>& query, size_t k, SimilarityMetric metric,
+                                        size_t threadCount) {
+    if (k == 0 || nodes.empty()) {
+        return {};
+    }
+    threadCount = threadCountFor(threadCount, nodes.size(), MIN_NODES_PER_THREAD);
+    std::vector<std::vector<SimilarityMatch>> heaps(threadCount);
+    runParallel(threadCount, [&](size_t t) {
+        auto [begin, end] = sliceOf(nodes.size(), threadCount, t);
+        scanSlice(nodes, begin, end, key, query, k, metric, heaps[t]);
+    });
+    return mergeHeaps(heaps, k, metric);
+}
+
+std::vector<SimilarityMatch> topKSimilar(StorageEngine& engine, PropertyKey key, const std::vector<float>& query,
+                                        size_t k, SimilarityMetric metric, size_t threadCount) {
+    if (k == 0) {
+        return {};
+    }
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::vector<std::vector<SimilarityMatch>> heaps(threadCount);
+    std::vector<std::vector<float>> buffers(threadCount);
+    Closer closer{metric};
+    engine.scanNodes([&](size_t thread, const NodeView& view) {
+        std::vector<float>& vector = buffers[thread];
+        if (!view.getProperties().findFloats(key, vector) || vector.size() != query.size()) {
+            return;
+        }
+        offer({view.getId(), scoreOf(query, vector.data(), metric)}, k, closer, heaps[thread]);
+    }, threadCount);
+    return mergeHeaps(heaps, k, metric);
+}
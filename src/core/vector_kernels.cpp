@@ -0,0 +1,268 @@
+// src/core/vector_kernels.cpp
+
+#include "core/vector_kernels.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define KRUSKAL_X86_KERNELS 1
+#endif
+
+namespace {
+using Kernel = float (*)(const float*, const float*, size_t);
+
+struct KernelSet {
+    Kernel dot;
+    Kernel l2;
+    Kernel cosine;
+};
+
+float cosineFromParts(float dot, float normA, float normB) {
+    float denominator = std::sqrt(normA) * std::sqrt(normB);
+    return denominator > 0 ? dot / denominator : 0.0f;
+}
+
+// Four accumulators so the scalar loop is not bound by add latency
+float dotScalar(const float* a, const float* b, size_t size) {
+    float sum[4] = {0, 0, 0, 0};
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        for (size_t lane = 0; lane < 4; ++lane) {
+            sum[lane] += a[i + lane] * b[i + lane];
+        }
+    }
+    for (; i < size; ++i) {
+        sum[0] += a[i] * b[i];
+    }
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+float l2Scalar(const float* a, const float* b, size_t size) {
+    float sum[4] = {0, 0, 0, 0};
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        for (size_t lane = 0; lane < 4; ++lane) {
+            float diff = a[i + lane] - b[i + lane];
+            sum[lane] += diff * diff;
+        }
+    }
+    for (; i < size; ++i) {
+        float diff = a[i] - b[i];
+        sum[0] += diff * diff;
+    }
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+float cosineScalar(const float* a, const float* b, size_t size) {
+    float dot = 0;
+    float normA = 0;
+    float normB = 0;
+    for (size_t i = 0; i < size; ++i) {
+        dot += a[i] * b[i];
+        normA += a[i] * a[i];
+        normB += b[i] * b[i];
+    }
+    return cosineFromParts(dot, normA, normB);
+}
+
+#ifdef KRUSKAL_X86_KERNELS
+__attribute__((target("avx2,fma"))) float sum256(__m256 v) {
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+// Two accumulators per sum hide FMA latency; the tail is finished in scalar
+__attribute__((target("avx2,fma"))) float dotAvx2(const float* a, const float* b, size_t size) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    if (i + 8 <= size) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        i += 8;
+    }
+    float sum = sum256(_mm256_add_ps(acc0, acc1));
+    for (; i < size; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+__attribute__((target("avx2,fma"))) float l2Avx2(const float* a, const float* b, size_t size) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m256 diff0 = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        __m256 diff1 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+        acc0 = _mm256_fmadd_ps(diff0, diff0, acc0);
+        acc1 = _mm256_fmadd_ps(diff1, diff1, acc1);
+    }
+    if (i + 8 <= size) {
+        __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        acc0 = _mm256_fmadd_ps(diff, diff, acc0);
+        i += 8;
+    }
+    float sum = sum256(_mm256_add_ps(acc0, acc1));
+    for (; i < size; ++i) {
+        float diff = a[i] - b[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+__attribute__((target("avx2,fma"))) float cosineAvx2(const float* a, const float* b, size_t size) {
+    __m256 dot = _mm256_setzero_ps();
+    __m256 normA = _mm256_setzero_ps();
+    __m256 normB = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        __m256 va = _mm256_loadu_ps(a + i);
+        __m256 vb = _mm256_loadu_ps(b + i);
+        dot = _mm256_fmadd_ps(va, vb, dot);
+        normA = _mm256_fmadd_ps(va, va, normA);
+        normB = _mm256_fmadd_ps(vb, vb, normB);
+    }
+    float dotSum = sum256(dot);
+    float normASum = sum256(normA);
+    float normBSum = sum256(normB);
+    for (; i < size; ++i) {
+        dotSum += a[i] * b[i];
+        normASum += a[i] * a[i];
+        normBSum += b[i] * b[i];
+    }
+    return cosineFromParts(dotSum, normASum, normBSum);
+}
+
+// Masked loads cover the tail, so there is no scalar remainder loop
+__attribute__((target("avx512f"))) __mmask16 tailMask(size_t remaining) {
+    return remaining >= 16 ? static_cast<__mmask16>(0xFFFF) : static_cast<__mmask16>((1u << remaining) - 1);
+}
+
+__attribute__((target("avx512f"))) float dotAvx512(const float* a, const float* b, size_t size) {
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+        acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), acc1);
+    }
+    for (; i < size; i += 16) {
+        __mmask16 mask = tailMask(size - i);
+        acc0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i), acc0);
+    }
+    return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+}
+
+__attribute__((target("avx512f"))) float l2Avx512(const float* a, const float* b, size_t size) {
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m512 diff0 = _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+        __m512 diff1 = _mm512_sub_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16));
+        acc0 = _mm512_fmadd_ps(diff0, diff0, acc0);
+        acc1 = _mm512_fmadd_ps(diff1, diff1, acc1);
+    }
+    for (; i < size; i += 16) {
+        __mmask16 mask = tailMask(size - i);
+        __m512 diff = _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i));
+        acc0 = _mm512_fmadd_ps(diff, diff, acc0);
+    }
+    return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+}
+
+__attribute__((target("avx512f"))) float cosineAvx512(const float* a, const float* b, size_t size) {
+    __m512 dot = _mm512_setzero_ps();
+    __m512 normA = _mm512_setzero_ps();
+    __m512 normB = _mm512_setzero_ps();
+    for (size_t i = 0; i < size; i += 16) {
+        __mmask16 mask = tailMask(size - i);
+        __m512 va = _mm512_maskz_loadu_ps(mask, a + i);
+        __m512 vb = _mm512_maskz_loadu_ps(mask, b + i);
+        dot = _mm512_fmadd_ps(va, vb, dot);
+        normA = _mm512_fmadd_ps(va, va, normA);
+        normB = _mm512_fmadd_ps(vb, vb, normB);
+    }
+    return cosineFromParts(_mm512_reduce_add_ps(dot), _mm512_reduce_add_ps(normA), _mm512_reduce_add_ps(normB));
+}
+#endif
+
+SimdLevel detect() {
+#ifdef KRUSKAL_X86_KERNELS
+    // Also checks that the OS saves the wider registers
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimdLevel::Avx2;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+const KernelSet& kernels(SimdLevel level) {
+    static const KernelSet scalar{dotScalar, l2Scalar, cosineScalar};
+#ifdef KRUSKAL_X86_KERNELS
+    static const KernelSet avx2{dotAvx2, l2Avx2, cosineAvx2};
+    static const KernelSet avx512{dotAvx512, l2Avx512, cosineAvx512};
+    switch (std::min(level, detectedSimdLevel())) {
+        case SimdLevel::Avx512: return avx512;
+        case SimdLevel::Avx2: return avx2;
+        default: return scalar;
+    }
+#else
+    (void)level;
+    return scalar;
+#endif
+}
+
+const KernelSet& best() {
+    static const KernelSet& set = kernels(SimdLevel::Avx512);
+    return set;
+}
+}
+
+SimdLevel detectedSimdLevel() {
+    static const SimdLevel level = detect();
+    return level;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Avx512: return "avx512";
+        case SimdLevel::Avx2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+float dotProduct(const float* a, const float* b, size_t size) {
+    return best().dot(a, b, size);
+}
+
+float squaredL2Distance(const float* a, const float* b, size_t size) {
+    return best().l2(a, b, size);
+}
+
+float cosineSimilarity(const float* a, const float* b, size_t size) {
+    return best().cosine(a, b, size);
+}
+
+float dotProduct(const float* a, const float* b, size_t size, SimdLevel level) {
+    return kernels(level).dot(a, b, size);
+}
+
+float squaredL2Distance(const float* a, const float* b, size_t size, SimdLevel level) {
+    return kernels(level).l2(a, b, size);
+}
+
+float cosineSimilarity(const float* a, const float* b, size_t size, SimdLevel level) {
+    return kernels(level).cosine(a, b, size);
+}
@@ -0,0 +1,342 @@
+// src/graph/analytics.cpp
+
+#include "graph/analytics.hpp"
+#include "core/parallel.hpp"
+#include "graph/union_find.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define KRUSKAL_X86_KERNELS 1
+#endif
+
+namespace {
+// Nodes a thread takes per grab from the shared cursor
+constexpr size_t CHUNK_NODES = 256;
+// Passes with fewer nodes than this per thread run on fewer threads
+constexpr size_t MIN_NODES_PER_THREAD = 4096;
+// PageRank sums per block of this many nodes and then over the blocks in
+// order, so the totals do not depend on which thread took which chunk
+constexpr size_t SUM_BLOCK_NODES = 4096;
+// Nodes Afforest samples to find the largest component
+constexpr size_t COMPONENT_SAMPLES = 1024;
+
+// Runs visit(begin, end, t) over [0, items) in chunks taken from a shared
+// cursor by threadCount threads
+template<typename Visit>
+void forEachChunk(size_t items, size_t threadCount, size_t chunk, Visit&& visit) {
+    std::atomic<size_t> cursor(0);
+    runParallel(threadCount, [&](size_t t) {
+        while (true) {
+            size_t first = cursor.fetch_add(chunk, std::memory_order_relaxed);
+            if (first >= items) {
+                break;
+            }
+            visit(first, std::min(items, first + chunk), t);
+        }
+    });
+}
+
+// Sum of values[indices[i]] for i in [0, count)
+using GatherSum = double (*)(const double* values, const int* indices, size_t count);
+
+// Four accumulators so the loop is not bound by add latency
+double gatherSumScalar(const double* values, const int* indices, size_t count) {
+    double sum[4] = {0, 0, 0, 0};
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        for (size_t lane = 0; lane < 4; ++lane) {
+            sum[lane] += values[indices[i + lane]];
+        }
+    }
+    for (; i < count; ++i) {
+        sum[0] += values[indices[i]];
+    }
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+#ifdef KRUSKAL_X86_KERNELS
+// Two gathers in flight per iteration; the tail is finished in scalar
+__attribute__((target("avx2"))) double gatherSumAvx2(const double* values, const int* indices, size_t count) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i));
+        __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i + 4));
+        acc0 = _mm256_add_pd(acc0, _mm256_i32gather_pd(values, first, 8));
+        acc1 = _mm256_add_pd(acc1, _mm256_i32gather_pd(values, second, 8));
+    }
+    __m256d acc = _mm256_add_pd(acc0, acc1);
+    __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+    double total = _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+    for (; i < count; ++i) {
+        total += values[indices[i]];
+    }
+    return total;
+}
+
+__attribute__((target("avx512f"))) double gatherSumAvx512(const double* values, const int* indices, size_t count) {
+    __m512d acc0 = _mm512_setzero_pd();
+    __m512d acc1 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+        __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i + 8));
+        acc0 = _mm512_add_pd(acc0, _mm512_i32gather_pd(first, values, 8));
+        acc1 = _mm512_add_pd(acc1, _mm512_i32gather_pd(second, values, 8));
+    }
+    double total = _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+    for (; i < count; ++i) {
+        total += values[indices[i]];
+    }
+    return total;
+}
+#endif
+
+GatherSum gatherSumFor(SimdLevel requested) {
+    SimdLevel level = std::min(requested, detectedSimdLevel());
+#ifdef KRUSKAL_X86_KERNELS
+    if (level == SimdLevel::Avx512) {
+        return gatherSumAvx512;
+    }
+    if (level == SimdLevel::Avx2) {
+        return gatherSumAvx2;
+    }
+#endif
+    (void)level;
+    return gatherSumScalar;
+}
+
+void checkIncoming(const CsrGraph& graph, const CsrGraph* incoming) {
+    if (incoming && (incoming->isIncoming() == graph.isIncoming() || incoming->nodeCount() != graph.nodeCount() ||
+                     incoming->edgeCount() != graph.edgeCount())) {
+        throw std::invalid_argument("Incoming snapshot does not match the graph");
+    }
+}
+
+// Sums of per-block partials, in block order
+double sumBlocks(const std::vector<double>& partials) {
+    double total = 0;
+    for (double partial : partials) {
+        total += partial;
+    }
+    return total;
+}
+}
+
+PageRankResult pageRank(const CsrGraph& incoming, const PageRankOptions& options) {
+    if (!incoming.isIncoming()) {
+        throw std::invalid_argument("PageRank pulls along an Incoming snapshot");
+    }
+    PageRankResult result;
+    size_t nodeCount = incoming.nodeCount();
+    if (nodeCount == 0) {
+        result.converged = true;
+        return result;
+    }
+    size_t threadCount = threadCountFor(options.threadCount, nodeCount, MIN_NODES_PER_THREAD);
+    GatherSum gatherSum = gatherSumFor(options.simdLevel);
+    const uint64_t* offsets = incoming.offsets();
+    const int* sources = incoming.targets();
+
+    // Each in-row entry is one outgoing edge of its source
+    std::vector<std::atomic<int>> outDegree(nodeCount);
+    forEachChunk(incoming.edgeCount(), threadCount, CHUNK_NODES * 64, [&](size_t first, size_t last, size_t) {
+        for (size_t i = first; i < last; ++i) {
+            outDegree[sources[i]].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    std::vector<double> inverseDegree(nodeCount);
+    for (size_t v = 0; v < nodeCount; ++v) {
+        int degree = outDegree[v].load(std::memory_order_relaxed);
+        inverseDegree[v] = degree == 0 ? 0 : 1.0 / degree;
+    }
+
+    size_t blocks = (nodeCount + SUM_BLOCK_NODES - 1) / SUM_BLOCK_NODES;
+    std::vector<double> ranks(nodeCount, 1.0 / nodeCount);
+    std::vector<double> next(nodeCount);
+    std::vector<double> contributions(nodeCount);
+    std::vector<double> partials(blocks);
+    while (result.iterations < options.maxIterations) {
+        // Rank sent along each outgoing edge, and the rank of nodes with none
+        forEachChunk(nodeCount, threadCount, SUM_BLOCK_NODES, [&](size_t first, size_t last, size_t) {
+            double dangling = 0;
+            for (size_t v = first; v < last; ++v) {
+                contributions[v] = ranks[v] * inverseDegree[v];
+                dangling += inverseDegree[v] == 0 ? ranks[v] : 0;
+            }
+            partials[first / SUM_BLOCK_NODES] = dangling;
+        });
+        double base = (1 - options.damping + options.damping * sumBlocks(partials)) / nodeCount;
+
+        forEachChunk(nodeCount, threadCount, SUM_BLOCK_NODES, [&](size_t first, size_t last, size_t) {
+            double delta = 0;
+            for (size_t v = first; v < last; ++v) {
+                double pulled = gatherSum(contributions.data(), sources + offsets[v], offsets[v + 1] - offsets[v]);
+                next[v] = base + options.damping * pulled;
+                delta += std::abs(next[v] - ranks[v]);
+            }
+            partials[first / SUM_BLOCK_NODES] = delta;
+        });
+        ranks.swap(next);
+        ++result.iterations;
+        result.delta = sumBlocks(partials);
+        if (result.delta < options.tolerance) {
+            result.converged = true;
+            break;
+        }
+    }
+    result.ranks = std::move(ranks);
+    return result;
+}
+
+ComponentResult weaklyConnectedComponents(const CsrGraph& graph, const ComponentOptions& options,
+                                          const CsrGraph* incoming) {
+    checkIncoming(graph, incoming);
+    ComponentResult result;
+    size_t nodeCount = graph.nodeCount();
+    if (nodeCount == 0) {
+        return result;
+    }
+    size_t threadCount = threadCountFor(options.threadCount, nodeCount, MIN_NODES_PER_THREAD);
+    ConcurrentUnionFind sets(nodeCount);
+
+    // Link each node to its first few neighbors, one round at a time so the
+    // early rounds already merge most of a large component
+    size_t rounds = std::max(0, options.neighborRounds);
+    for (size_t round = 0; round < rounds; ++round) {
+        forEachChunk(nodeCount, threadCount, CHUNK_NODES, [&](size_t first, size_t last, size_t) {
+            for (size_t v = first; v < last; ++v) {
+                CsrGraph::Range<int> neighbors = graph.neighbors(static_cast<int>(v));
+                if (round < neighbors.size()) {
+                    sets.unite(static_cast<int>(v), neighbors[round]);
+                }
+            }
+        });
+    }
+
+    // Nodes already in the most common component have nothing left to add
+    // when every edge is seen from its other end too
+    int largest = -1;
+    if (incoming && rounds > 0) {
+        std::mt19937 rng(static_cast<unsigned>(nodeCount));
+        std::uniform_int_distribution<int> node(0, static_cast<int>(nodeCount) - 1);
+        std::unordered_map<int, size_t> counts;
+        size_t best = 0;
+        for (size_t i = 0; i < COMPONENT_SAMPLES; ++i) {
+            int root = sets.find(node(rng));
+            size_t count = ++counts[root];
+            if (count > best) {
+                best = count;
+                largest = root;
+            }
+        }
+    }
+
+    forEachChunk(nodeCount, threadCount, CHUNK_NODES, [&](size_t first, size_t last, size_t) {
+        for (size_t v = first; v < last; ++v) {
+            int node = static_cast<int>(v);
+            if (largest >= 0 && sets.find(node) == largest) {
+                continue;
+            }
+            CsrGraph::Range<int> neighbors = graph.neighbors(node);
+            for (size_t i = std::min(rounds, neighbors.size()); i < neighbors.size(); ++i) {
+                sets.unite(node, neighbors[i]);
+            }
+            if (largest >= 0) {
+                for (int neighbor : incoming->neighbors(node)) {
+                    sets.unite(node, neighbor);
+                }
+            }
+        }
+    });
+
+    // Unions link the larger root under the smaller, so roots are the
+    // smallest ids of their components
+    result.components.resize(nodeCount);
+    std::vector<size_t> roots(threadCount);
+    forEachChunk(nodeCount, threadCount, CHUNK_NODES, [&](size_t first, size_t last, size_t t) {
+        for (size_t v = first; v < last; ++v) {
+            result.components[v] = sets.find(static_cast<int>(v));
+            roots[t] += result.components[v] == static_cast<int>(v);
+        }
+    });
+    for (size_t count : roots) {
+        result.componentCount += count;
+    }
+    return result;
+}
+
+LabelPropagationResult labelPropagation(const CsrGraph& graph, const LabelPropagationOptions& options,
+                                        const CsrGraph* incoming) {
+    checkIncoming(graph, incoming);
+    LabelPropagationResult result;
+    size_t nodeCount = graph.nodeCount();
+    size_t threadCount = threadCountFor(options.threadCount, nodeCount, MIN_NODES_PER_THREAD);
+    std::vector<int> labels(nodeCount);
+    for (size_t v = 0; v < nodeCount; ++v) {
+        labels[v] = static_cast<int>(v);
+    }
+    std::vector<int> next(nodeCount);
+    std::vector<std::vector<int>> scratch(threadCount);
+    std::vector<size_t> changes(threadCount);
+
+    while (result.iterations < options.maxIterations) {
+        std::fill(changes.begin(), changes.end(), 0);
+        forEachChunk(nodeCount, threadCount, CHUNK_NODES, [&](size_t first, size_t last, size_t t) {
+            std::vector<int>& seen = scratch[t];
+            for (size_t v = first; v < last; ++v) {
+                int node = static_cast<int>(v);
+                seen.assign(1, labels[v]);
+                for (int neighbor : graph.neighbors(node)) {
+                    seen.push_back(labels[neighbor]);
+                }
+                if (incoming) {
+                    for (int neighbor : incoming->neighbors(node)) {
+                        seen.push_back(labels[neighbor]);
+                    }
+                }
+                // Runs of equal labels after sorting; the first longest run
+                // holds the smallest of the most frequent labels
+                std::sort(seen.begin(), seen.end());
+                int best = seen[0];
+                size_t bestCount = 0;
+                for (size_t i = 0; i < seen.size();) {
+                    size_t j = i + 1;
+                    while (j < seen.size() && seen[j] == seen[i]) {
+                        ++j;
+                    }
+                    if (j - i > bestCount) {
+                        bestCount = j - i;
+                        best = seen[i];
+                    }
+                    i = j;
+                }
+                next[v] = best;
+                changes[t] += best != labels[v];
+            }
+        });
+        labels.swap(next);
+        ++result.iterations;
+        size_t changed = 0;
+        for (size_t count : changes) {
+            changed += count;
+        }
+        if (changed == 0) {
+            result.converged = true;
+            break;
+        }
+    }
+
+    std::vector<int> distinct(labels);
+    std::sort(distinct.begin(), distinct.end());
+    result.communityCount = std::unique(distinct.begin(), distinct.end()) - distinct.begin();
+    result.labels = std::move(labels);
+    return result;
+}
@@ -0,0 +1,447 @@
+// src/graph/csr_graph.cpp
+
+#include "graph/csr_graph.hpp"
+#include "core/parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+struct CsrGraph::Entry {
+    int source;
+    int target;
+    int id;
+    EdgeType type;
+    double weight;
+};
+
+namespace {
+constexpr uint32_t FORMAT_MAGIC = 0x4B435352;  // "KCSR"
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr uint32_t HAS_TYPES = 1;
+constexpr uint32_t HAS_WEIGHTS = 2;
+constexpr uint32_t INCOMING = 4;
+// Rows sorted and unpacked per thread at least
+constexpr size_t MIN_NODES_PER_THREAD = 4096;
+
+bool rowOrder(int targetA, int idA, int targetB, int idB) {
+    return targetA != targetB ? targetA < targetB : idA < idB;
+}
+
+std::optional<PropertyKey> weightKeyFor(const StorageEngine& engine, const CsrOptions& options) {
+    if (options.weightProperty.empty()) {
+        return std::nullopt;
+    }
+    // A name nobody has used yet cannot be on any edge; no need to intern it
+    return engine.getNames().propertyKeys.find(options.weightProperty);
+}
+
+// Int values are widened; anything else counts as missing
+double weightOf(const EdgeView& view, std::optional<PropertyKey> key, double fallback) {
+    if (key) {
+        if (auto value = view.tryGetProperty<double>(*key)) {
+            return *value;
+        }
+        if (auto value = view.tryGetProperty<int>(*key)) {
+            return *value;
+        }
+    }
+    return fallback;
+}
+
+// An Incoming snapshot files each edge under its target
+void orient(const CsrOptions& options, int& source, int& target) {
+    if (options.direction == CsrDirection::Incoming) {
+        std::swap(source, target);
+    }
+}
+
+// Arrays start on 8-byte boundaries so a mapping can be read in place
+void pad(std::string& out) {
+    out.append((8 - out.size() % 8) % 8, '\0');
+}
+
+template<typename T>
+void appendRaw(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+void appendArray(std::string& out, const T* values, size_t count) {
+    out.append(reinterpret_cast<const char*>(values), count * sizeof(T));
+    pad(out);
+}
+
+// Bounds-checked reads over a mapped snapshot
+class MappedReader {
+public:
+    MappedReader(const char* data, size_t size) : data(data), size(size), pos(0) {}
+
+    template<typename T>
+    T read() {
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, data + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::string readString(size_t length) {
+        require(length);
+        std::string value(data + pos, length);
+        pos += length;
+        skipPadding();
+        return value;
+    }
+
+    template<typename T>
+    const T* array(uint64_t count) {
+        if (count > (size - pos) / sizeof(T)) {
+            throw std::runtime_error("Graph snapshot truncated");
+        }
+        const T* values = reinterpret_cast<const T*>(data + pos);
+        pos += count * sizeof(T);
+        skipPadding();
+        return values;
+    }
+
+private:
+    const char* data;
+    size_t size;
+    size_t pos;
+
+    void require(size_t bytes) const {
+        if (bytes > size - pos) {
+            throw std::runtime_error("Graph snapshot truncated");
+        }
+    }
+
+    void skipPadding() {
+        pos = std::min(size, pos + (8 - pos % 8) % 8);
+    }
+};
+}
+
+CsrGraph::CsrGraph()
+    : nodes(0), edges(0), logId(0), changeSequence(0), edgeIdLimit(0), ownedOffsets(1, 0) {
+    attachOwned();
+}
+
+CsrGraph CsrGraph::build(StorageEngine& engine, const CsrOptions& options) {
+    CsrGraph graph;
+    graph.options = options;
+    // Nothing changes while the scan runs, so the log position taken now
+    // matches what the scan sees
+    graph.logId = engine.getChangeLog().getId();
+    graph.changeSequence = engine.getChangeLog().sequence();
+    graph.edgeIdLimit = engine.getEdgeIdLimit();
+
+    std::optional<PropertyKey> weightKey = weightKeyFor(engine, options);
+    size_t threadCount = threadCountFor(options.threadCount, std::numeric_limits<size_t>::max(), 1);
+    std::vector<std::vector<Entry>> batches(threadCount);
+    std::vector<int> maxNode(threadCount, -1);
+    engine.scanEdges([&](size_t thread, const EdgeView& view) {
+        Entry entry{view.getSourceNodeId(), view.getTargetNodeId(), view.getId(), view.getTypeId(),
+                    weightOf(view, weightKey, options.defaultWeight)};
+        orient(options, entry.source, entry.target);
+        batches[thread].push_back(entry);
+        maxNode[thread] = std::max({maxNode[thread], view.getSourceNodeId(), view.getTargetNodeId()});
+    }, threadCount);
+
+    size_t nodeCount = engine.getNodeIdLimit();
+    for (int node : maxNode) {
+        nodeCount = std::max(nodeCount, static_cast<size_t>(node + 1));
+    }
+    graph.assemble(batches, nodeCount);
+    return graph;
+}
+
+void CsrGraph::assemble(std::vector<std::vector<Entry>>& batches, size_t nodeCount) {
+    for (const auto& batch : batches) {
+        for (const Entry& entry : batch) {
+            if (entry.source < 0 || entry.target < 0) {
+                throw std::runtime_error("Edge has a negative node id");
+            }
+        }
+    }
+
+    // Count degrees, turn them into row starts, then scatter every entry to
+    // the next free slot of its row
+    std::vector<std::atomic<uint64_t>> cursor(nodeCount + 1);
+    runParallel(batches.size(), [&](size_t t) {
+        for (const Entry& entry : batches[t]) {
+            cursor[entry.source + 1].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    ownedOffsets.assign(nodeCount + 1, 0);
+    for (size_t node = 0; node < nodeCount; ++node) {
+        ownedOffsets[node + 1] = ownedOffsets[node] + cursor[node + 1].load(std::memory_order_relaxed);
+        cursor[node].store(ownedOffsets[node], std::memory_order_relaxed);
+    }
+    nodes = nodeCount;
+    edges = ownedOffsets[nodeCount];
+
+    std::vector<Entry> placed(edges);
+    runParallel(batches.size(), [&](size_t t) {
+        for (const Entry& entry : batches[t]) {
+            placed[cursor[entry.source].fetch_add(1, std::memory_order_relaxed)] = entry;
+        }
+        std::vector<Entry>().swap(batches[t]);
+    });
+
+    // Scatter order depends on thread timing; sorting rows makes it deterministic
+    ownedTargets.resize(edges);
+    ownedEdgeIds.resize(edges);
+    ownedTypes.resize(options.edgeTypes ? edges : 0);
+    ownedWeights.resize(hasWeights() ? edges : 0);
+    size_t threadCount = threadCountFor(options.threadCount, nodeCount, MIN_NODES_PER_THREAD);
+    runParallel(threadCount, [&](size_t t) {
+        auto [first, last] = sliceOf(nodeCount, threadCount, t);
+        for (size_t node = first; node < last; ++node) {
+            std::sort(placed.begin() + ownedOffsets[node], placed.begin() + ownedOffsets[node + 1],
+                      [](const Entry& a, const Entry& b) { return rowOrder(a.target, a.id, b.target, b.id); });
+        }
+        for (size_t i = ownedOffsets[first]; i < ownedOffsets[last]; ++i) {
+            ownedTargets[i] = placed[i].target;
+            ownedEdgeIds[i] = placed[i].id;
+            if (options.edgeTypes) {
+                ownedTypes[i] = placed[i].type;
+            }
+            if (hasWeights()) {
+                ownedWeights[i] = placed[i].weight;
+            }
+        }
+    });
+    attachOwned();
+}
+
+void CsrGraph::refresh(StorageEngine& engine) {
+    const ChangeLog& log = engine.getChangeLog();
+    std::vector<ChangeLog::Change> changes;
+    if (log.getId() != logId || !log.changesSince(changeSequence, changes)) {
+        *this = build(engine, options);
+        return;
+    }
+
+    std::vector<int> changedEdges;
+    for (const ChangeLog::Change& change : changes) {
+        if (change.kind == ChangeLog::Kind::EDGE) {
+            changedEdges.push_back(change.id);
+        }
+    }
+    std::sort(changedEdges.begin(), changedEdges.end());
+    changedEdges.erase(std::unique(changedEdges.begin(), changedEdges.end()), changedEdges.end());
+
+    std::optional<PropertyKey> weightKey = weightKeyFor(engine, options);
+    size_t nodeCount = std::max(nodes, static_cast<size_t>(engine.getNodeIdLimit()));
+    std::vector<Entry> added;
+    std::vector<Entry> updated;
+    for (int edgeId : changedEdges) {
+        engine.viewEdge(edgeId, [&](const EdgeView& view) {
+            Entry entry{view.getSourceNodeId(), view.getTargetNodeId(), edgeId, view.getTypeId(),
+                        weightOf(view, weightKey, options.defaultWeight)};
+            orient(options, entry.source, entry.target);
+            // Ids are handed out in increasing order, so anything below the
+            // limit was already in the snapshot; only its properties can differ
+            (edgeId < edgeIdLimit ? updated : added).push_back(entry);
+            nodeCount = std::max(nodeCount, static_cast<size_t>(std::max(entry.source, entry.target)) + 1);
+        });
+    }
+
+    if (hasWeights() && !updated.empty()) {
+        ensureOwned();
+        for (const Entry& entry : updated) {
+            if (static_cast<size_t>(entry.source) >= nodes) {
+                continue;
+            }
+            for (uint64_t i = ownedOffsets[entry.source]; i < ownedOffsets[entry.source + 1]; ++i) {
+                if (ownedEdgeIds[i] == entry.id) {
+                    ownedWeights[i] = entry.weight;
+                    break;
+                }
+            }
+        }
+    }
+    if (!added.empty() || nodeCount > nodes) {
+        ensureOwned();
+        merge(added, nodeCount);
+    }
+    changeSequence = log.sequence();
+    edgeIdLimit = engine.getEdgeIdLimit();
+}
+
+void CsrGraph::merge(std::vector<Entry>& added, size_t nodeCount) {
+    std::sort(added.begin(), added.end(), [](const Entry& a, const Entry& b) {
+        return a.source != b.source ? a.source < b.source : rowOrder(a.target, a.id, b.target, b.id);
+    });
+
+    size_t total = edges + added.size();
+    std::vector<uint64_t> offsets(nodeCount + 1, 0);
+    std::vector<int> targets(total);
+    std::vector<int> edgeIds(total);
+    std::vector<EdgeType> types(options.edgeTypes ? total : 0);
+    std::vector<double> weights(hasWeights() ? total : 0);
+
+    // Each row is the merge of its old edges and its new ones, both already
+    // in row order
+    size_t out = 0;
+    auto next = added.begin();
+    for (size_t node = 0; node < nodeCount; ++node) {
+        uint64_t i = node < nodes ? ownedOffsets[node] : 0;
+        uint64_t rowEnd = node < nodes ? ownedOffsets[node + 1] : 0;
+        while (i < rowEnd || (next != added.end() && static_cast<size_t>(next->source) == node)) {
+            bool takeOld = next == added.end() || static_cast<size_t>(next->source) != node ||
+                           (i < rowEnd && rowOrder(ownedTargets[i], ownedEdgeIds[i], next->target, next->id));
+            if (takeOld) {
+                targets[out] = ownedTargets[i];
+                edgeIds[out] = ownedEdgeIds[i];
+                if (options.edgeTypes) {
+                    types[out] = ownedTypes[i];
+                }
+                if (hasWeights()) {
+                    weights[out] = ownedWeights[i];
+                }
+                ++i;
+            } else {
+                targets[out] = next->target;
+                edgeIds[out] = next->id;
+                if (options.edgeTypes) {
+                    types[out] = next->type;
+                }
+                if (hasWeights()) {
+                    weights[out] = next->weight;
+                }
+                ++next;
+            }
+            ++out;
+        }
+        offsets[node + 1] = out;
+    }
+
+    ownedOffsets = std::move(offsets);
+    ownedTargets = std::move(targets);
+    ownedEdgeIds = std::move(edgeIds);
+    ownedTypes = std::move(types);
+    ownedWeights = std::move(weights);
+    nodes = nodeCount;
+    edges = total;
+    attachOwned();
+}
+
+void CsrGraph::save(const std::string& path) const {
+    std::string data;
+    appendRaw(data, FORMAT_MAGIC);
+    appendRaw(data, FORMAT_VERSION);
+    appendRaw(data, (options.edgeTypes ? HAS_TYPES : 0) | (hasWeights() ? HAS_WEIGHTS : 0) |
+                        (isIncoming() ? INCOMING : 0));
+    appendRaw(data, uint32_t{0});
+    appendRaw(data, static_cast<uint64_t>(nodes));
+    appendRaw(data, static_cast<uint64_t>(edges));
+    appendRaw(data, logId);
+    appendRaw(data, changeSequence);
+    appendRaw(data, static_cast<int64_t>(edgeIdLimit));
+    appendRaw(data, options.defaultWeight);
+    appendRaw(data, static_cast<uint64_t>(options.weightProperty.size()));
+    data.append(options.weightProperty);
+    pad(data);
+    appendArray(data, offsetArray, nodes + 1);
+    appendArray(data, targetArray, edges);
+    appendArray(data, edgeIdArray, edges);
+    if (options.edgeTypes) {
+        appendArray(data, typeArray, edges);
+    }
+    if (hasWeights()) {
+        appendArray(data, weightArray, edges);
+    }
+
+    // Replace atomically so a crash mid-write leaves the previous snapshot intact
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size());
+        if (!file) {
+            throw std::runtime_error("Failed to write graph snapshot");
+        }
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Failed to replace graph snapshot");
+    }
+}
+
+CsrGraph CsrGraph::load(const std::string& path) {
+    auto mapping = std::make_unique<MappedFile>(path);
+    MappedReader reader(mapping->data(), mapping->size());
+    if (reader.read<uint32_t>() != FORMAT_MAGIC || reader.read<uint32_t>() != FORMAT_VERSION) {
+        throw std::runtime_error("Not a graph snapshot: " + path);
+    }
+    uint32_t flags = reader.read<uint32_t>();
+    reader.read<uint32_t>();
+
+    CsrGraph graph;
+    graph.nodes = reader.read<uint64_t>();
+    graph.edges = reader.read<uint64_t>();
+    graph.logId = reader.read<uint64_t>();
+    graph.changeSequence = reader.read<uint64_t>();
+    graph.edgeIdLimit = static_cast<int>(reader.read<int64_t>());
+    graph.options.edgeTypes = (flags & HAS_TYPES) != 0;
+    graph.options.direction = (flags & INCOMING) != 0 ? CsrDirection::Incoming : CsrDirection::Outgoing;
+    graph.options.defaultWeight = reader.read<double>();
+    graph.options.weightProperty = reader.readString(reader.read<uint64_t>());
+    if (((flags & HAS_WEIGHTS) != 0) != graph.hasWeights() || graph.nodes == std::numeric_limits<uint64_t>::max()) {
+        throw std::runtime_error("Corrupt graph snapshot: " + path);
+    }
+
+    graph.offsetArray = reader.array<uint64_t>(graph.nodes + 1);
+    graph.targetArray = reader.array<int>(graph.edges);
+    graph.edgeIdArray = reader.array<int>(graph.edges);
+    graph.typeArray = graph.options.edgeTypes ? reader.array<EdgeType>(graph.edges) : nullptr;
+    graph.weightArray = graph.hasWeights() ? reader.array<double>(graph.edges) : nullptr;
+    if (graph.offsetArray[0] != 0 || graph.offsetArray[graph.nodes] != graph.edges) {
+        throw std::runtime_error("Corrupt graph snapshot: " + path);
+    }
+    // Readers index by offsets and targets unchecked, so both are validated
+    // here, at the cost of touching the two arrays once
+    for (uint64_t v = 0; v < graph.nodes; ++v) {
+        if (graph.offsetArray[v] > graph.offsetArray[v + 1]) {
+            throw std::runtime_error("Corrupt graph snapshot: " + path);
+        }
+    }
+    for (uint64_t i = 0; i < graph.edges; ++i) {
+        if (graph.targetArray[i] < 0 || static_cast<uint64_t>(graph.targetArray[i]) >= graph.nodes) {
+            throw std::runtime_error("Corrupt graph snapshot: " + path);
+        }
+    }
+    graph.ownedOffsets.clear();
+    graph.mapping = std::move(mapping);
+    return graph;
+}
+
+void CsrGraph::attachOwned() {
+    offsetArray = ownedOffsets.data();
+    targetArray = ownedTargets.data();
+    edgeIdArray = ownedEdgeIds.data();
+    typeArray = options.edgeTypes ? ownedTypes.data() : nullptr;
+    weightArray = hasWeights() ? ownedWeights.data() : nullptr;
+}
+
+void CsrGraph::ensureOwned() {
+    if (!mapping) {
+        return;
+    }
+    ownedOffsets.assign(offsetArray, offsetArray + nodes + 1);
+    ownedTargets.assign(targetArray, targetArray + edges);
+    ownedEdgeIds.assign(edgeIdArray, edgeIdArray + edges);
+    if (options.edgeTypes) {
+        ownedTypes.assign(typeArray, typeArray + edges);
+    }
+    if (hasWeights()) {
+        ownedWeights.assign(weightArray, weightArray + edges);
+    }
+    mapping.reset();
+    attachOwned();
+}
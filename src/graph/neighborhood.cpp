@@ -0,0 +1,176 @@
+// src/graph/neighborhood.cpp
+
+#include "graph/neighborhood.hpp"
+#include "core/parallel.hpp"
+#include "core/set_intersection.hpp"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+namespace {
+// Nodes a thread takes per grab from the shared cursor
+constexpr size_t CHUNK_NODES = 256;
+constexpr size_t MIN_NODES_PER_THREAD = 4096;
+
+template<typename Visit>
+void forEachChunk(size_t items, size_t threadCount, Visit&& visit) {
+    std::atomic<size_t> cursor(0);
+    runParallel(threadCount, [&](size_t t) {
+        while (true) {
+            size_t first = cursor.fetch_add(CHUNK_NODES, std::memory_order_relaxed);
+            if (first >= items) {
+                break;
+            }
+            visit(first, std::min(items, first + CHUNK_NODES), t);
+        }
+    });
+}
+
+// Writes the distinct ids of two ascending rows other than self to out,
+// ascending; returns how many. out may be null to only count.
+size_t mergeRows(CsrGraph::Range<int> first, CsrGraph::Range<int> second, int self, int* out) {
+    size_t count = 0;
+    const int* a = first.begin();
+    const int* b = second.begin();
+    int previous = -1;
+    while (a != first.end() || b != second.end()) {
+        int next;
+        if (b == second.end() || (a != first.end() && *a <= *b)) {
+            next = *a++;
+        } else {
+            next = *b++;
+        }
+        if (next != self && next != previous) {
+            if (out) {
+                out[count] = next;
+            }
+            ++count;
+        }
+        previous = next;
+    }
+    return count;
+}
+}
+
+NeighborSets NeighborSets::build(const CsrGraph& graph, const CsrGraph* incoming, size_t threadCount) {
+    if (incoming && (incoming->isIncoming() == graph.isIncoming() || incoming->nodeCount() != graph.nodeCount() ||
+                     incoming->edgeCount() != graph.edgeCount())) {
+        throw std::invalid_argument("Incoming snapshot does not match the graph");
+    }
+    size_t nodeCount = graph.nodeCount();
+    threadCount = threadCountFor(threadCount, nodeCount, MIN_NODES_PER_THREAD);
+    CsrGraph::Range<int> none(nullptr, nullptr);
+    auto rowsOf = [&](int node) {
+        return std::make_pair(graph.neighbors(node), incoming ? incoming->neighbors(node) : none);
+    };
+
+    // Sized by one merge pass and filled by a second, so the lists land
+    // contiguously without per-node vectors
+    NeighborSets sets;
+    sets.undirected = incoming != nullptr;
+    sets.offsets.assign(nodeCount + 1, 0);
+    forEachChunk(nodeCount, threadCount, [&](size_t first, size_t last, size_t) {
+        for (size_t v = first; v < last; ++v) {
+            auto [out, in] = rowsOf(static_cast<int>(v));
+            sets.offsets[v + 1] = mergeRows(out, in, static_cast<int>(v), nullptr);
+        }
+    });
+    for (size_t v = 0; v < nodeCount; ++v) {
+        sets.offsets[v + 1] += sets.offsets[v];
+    }
+    sets.ids.resize(nodeCount == 0 ? 0 : sets.offsets[nodeCount]);
+    forEachChunk(nodeCount, threadCount, [&](size_t first, size_t last, size_t) {
+        for (size_t v = first; v < last; ++v) {
+            auto [out, in] = rowsOf(static_cast<int>(v));
+            mergeRows(out, in, static_cast<int>(v), sets.ids.data() + sets.offsets[v]);
+        }
+    });
+    return sets;
+}
+
+void NeighborSets::checkNode(int node) const {
+    if (node < 0 || static_cast<size_t>(node) >= nodeCount()) {
+        throw std::invalid_argument("Node outside the node range");
+    }
+}
+
+size_t NeighborSets::commonNeighborCount(int a, int b) const {
+    checkNode(a);
+    checkNode(b);
+    CsrGraph::Range<int> first = neighbors(a);
+    CsrGraph::Range<int> second = neighbors(b);
+    return intersectionSize(first.begin(), first.size(), second.begin(), second.size());
+}
+
+std::vector<int> NeighborSets::commonNeighbors(int a, int b) const {
+    checkNode(a);
+    checkNode(b);
+    CsrGraph::Range<int> first = neighbors(a);
+    CsrGraph::Range<int> second = neighbors(b);
+    std::vector<int> common;
+    intersect(first.begin(), first.size(), second.begin(), second.size(), common);
+    return common;
+}
+
+double NeighborSets::jaccard(int a, int b) const {
+    size_t common = commonNeighborCount(a, b);
+    size_t together = degree(a) + degree(b) - common;
+    return together == 0 ? 0.0 : static_cast<double>(common) / together;
+}
+
+uint64_t countTriangles(const NeighborSets& neighbors, size_t threadCount) {
+    if (!neighbors.isUndirected()) {
+        throw std::invalid_argument("Triangle counting needs neighbor sets built with an incoming snapshot");
+    }
+    size_t nodeCount = neighbors.nodeCount();
+    threadCount = threadCountFor(threadCount, nodeCount, MIN_NODES_PER_THREAD);
+    auto before = [&](int a, int b) {
+        size_t degreeA = neighbors.degree(a);
+        size_t degreeB = neighbors.degree(b);
+        return degreeA < degreeB || (degreeA == degreeB && a < b);
+    };
+
+    // Each node keeps its neighbors that come after it; filtering an
+    // ascending list leaves it ascending
+    std::vector<uint64_t> offsets(nodeCount + 1, 0);
+    forEachChunk(nodeCount, threadCount, [&](size_t first, size_t last, size_t) {
+        for (size_t v = first; v < last; ++v) {
+            for (int neighbor : neighbors.neighbors(static_cast<int>(v))) {
+                offsets[v + 1] += before(static_cast<int>(v), neighbor);
+            }
+        }
+    });
+    for (size_t v = 0; v < nodeCount; ++v) {
+        offsets[v + 1] += offsets[v];
+    }
+    std::vector<int> later(nodeCount == 0 ? 0 : offsets[nodeCount]);
+    forEachChunk(nodeCount, threadCount, [&](size_t first, size_t last, size_t) {
+        for (size_t v = first; v < last; ++v) {
+            int* out = later.data() + offsets[v];
+            for (int neighbor : neighbors.neighbors(static_cast<int>(v))) {
+                if (before(static_cast<int>(v), neighbor)) {
+                    *out++ = neighbor;
+                }
+            }
+        }
+    });
+
+    std::vector<uint64_t> counts(threadCount);
+    forEachChunk(nodeCount, threadCount, [&](size_t first, size_t last, size_t t) {
+        uint64_t count = 0;
+        for (size_t u = first; u < last; ++u) {
+            const int* uList = later.data() + offsets[u];
+            size_t uSize = offsets[u + 1] - offsets[u];
+            for (size_t i = 0; i < uSize; ++i) {
+                int v = uList[i];
+                count += intersectionSize(uList, uSize, later.data() + offsets[v], offsets[v + 1] - offsets[v]);
+            }
+        }
+        counts[t] += count;
+    });
+    uint64_t triangles = 0;
+    for (uint64_t count : counts) {
+        triangles += count;
+    }
+    return triangles;
+}
@@ -0,0 +1,396 @@
+// src/graph/shortest_paths.cpp
+
+#include "graph/shortest_paths.hpp"
+#include "core/parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+constexpr double INF = std::numeric_limits<double>::infinity();
+// Relaxations per thread below which a delta-stepping phase runs on fewer threads
+constexpr size_t MIN_EDGES_PER_THREAD = 16384;
+// Frontier nodes a thread takes per grab
+constexpr size_t CHUNK_NODES = 256;
+// Widest ring of delta-stepping buckets; a smaller delta is raised to fit
+constexpr double MAX_BUCKETS = 1 << 20;
+
+// Min-heap of (distance, node) with four children per entry, which halves
+// the depth of a binary heap and keeps each sift-down step's comparisons in
+// adjacent memory. Entries are never updated in place: a shorter distance is
+// pushed again and the stale entry skipped when it is popped.
+class DaryHeap {
+public:
+    bool empty() const { return entries.empty(); }
+    double topKey() const { return entries.empty() ? INF : entries.front().key; }
+    void clear() { entries.clear(); }
+
+    void push(double key, int node) {
+        size_t index = entries.size();
+        entries.push_back({key, node});
+        while (index > 0) {
+            size_t parent = (index - 1) / ARITY;
+            if (entries[parent].key <= key) {
+                break;
+            }
+            entries[index] = entries[parent];
+            index = parent;
+        }
+        entries[index] = {key, node};
+    }
+
+    std::pair<double, int> pop() {
+        Entry top = entries.front();
+        Entry last = entries.back();
+        entries.pop_back();
+        size_t size = entries.size();
+        size_t index = 0;
+        while (size > 0) {
+            size_t first = ARITY * index + 1;
+            if (first >= size) {
+                break;
+            }
+            size_t best = first;
+            for (size_t child = first + 1; child < std::min(first + ARITY, size); ++child) {
+                if (entries[child].key < entries[best].key) {
+                    best = child;
+                }
+            }
+            if (entries[best].key >= last.key) {
+                break;
+            }
+            entries[index] = entries[best];
+            index = best;
+        }
+        if (size > 0) {
+            entries[index] = last;
+        }
+        return {top.key, top.node};
+    }
+
+private:
+    static constexpr size_t ARITY = 4;
+    struct Entry {
+        double key;
+        int node;
+    };
+    std::vector<Entry> entries;
+};
+
+// One direction of a point-to-point search. The arrays are kept between
+// queries on the same thread and only the entries a query touched are
+// cleared, so a short query does not pay for the whole node range.
+struct SearchSide {
+    std::vector<double> distance;
+    std::vector<int> parent;
+    std::vector<int> parentEdge;
+    std::vector<int> touched;
+    DaryHeap heap;
+
+    void reset(size_t nodeCount) {
+        for (int node : touched) {
+            distance[node] = INF;
+        }
+        touched.clear();
+        heap.clear();
+        if (distance.size() < nodeCount) {
+            distance.resize(nodeCount, INF);
+            parent.resize(nodeCount);
+            parentEdge.resize(nodeCount);
+        }
+    }
+
+    bool improve(int node, double value, int from, int edgeId) {
+        if (value >= distance[node]) {
+            return false;
+        }
+        if (distance[node] == INF) {
+            touched.push_back(node);
+        }
+        distance[node] = value;
+        parent[node] = from;
+        parentEdge[node] = edgeId;
+        heap.push(value, node);
+        return true;
+    }
+};
+
+thread_local SearchSide forwardSide;
+thread_local SearchSide backwardSide;
+
+void checkWeight(double weight) {
+    // An infinite weight would make a reachable node look unreachable
+    if (!std::isfinite(weight) || weight < 0) {
+        throw std::invalid_argument("Negative or non-finite edge weight");
+    }
+}
+
+void checkGraph(const CsrGraph& graph, std::initializer_list<int> nodes) {
+    if (!graph.hasWeights()) {
+        throw std::invalid_argument("Graph snapshot has no weights");
+    }
+    for (int node : nodes) {
+        if (node < 0 || static_cast<size_t>(node) >= graph.nodeCount()) {
+            throw std::invalid_argument("Node outside the node range");
+        }
+    }
+}
+
+// Pops the side's closest node and relaxes its row; -1 for a stale entry
+template<typename OnEdge>
+int settleNext(const CsrGraph& rows, SearchSide& side, OnEdge&& onEdge) {
+    auto [distance, node] = side.heap.pop();
+    if (distance > side.distance[node]) {
+        return -1;
+    }
+    for (uint64_t i = rows.offsets()[node]; i < rows.offsets()[node + 1]; ++i) {
+        double weight = rows.weights()[i];
+        checkWeight(weight);
+        int next = rows.targets()[i];
+        side.improve(next, distance + weight, node, rows.edgeIds()[i]);
+        onEdge(next, distance + weight);
+    }
+    return node;
+}
+
+// Joins the forward path to meet with the backward one from meet, if any
+ShortestPath buildPath(const SearchSide& forward, const SearchSide* backward, int source, int target, int meet) {
+    ShortestPath path;
+    if (meet < 0) {
+        return path;
+    }
+    path.distance = forward.distance[meet] + (backward ? backward->distance[meet] : 0);
+    for (int node = meet; node != source; node = forward.parent[node]) {
+        path.nodes.push_back(node);
+        path.edgeIds.push_back(forward.parentEdge[node]);
+    }
+    path.nodes.push_back(source);
+    std::reverse(path.nodes.begin(), path.nodes.end());
+    std::reverse(path.edgeIds.begin(), path.edgeIds.end());
+    if (backward) {
+        for (int node = meet; node != target; node = backward->parent[node]) {
+            path.edgeIds.push_back(backward->parentEdge[node]);
+            path.nodes.push_back(backward->parent[node]);
+        }
+    }
+    return path;
+}
+
+bool lowerTo(std::atomic<double>& slot, double value) {
+    double current = slot.load(std::memory_order_relaxed);
+    while (value < current) {
+        if (slot.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+}
+
+ShortestPath shortestPath(const CsrGraph& graph, int source, int target, const CsrGraph* incoming) {
+    checkGraph(graph, {source, target});
+    if (incoming && (incoming->isIncoming() == graph.isIncoming() || incoming->nodeCount() != graph.nodeCount() ||
+                     incoming->edgeCount() != graph.edgeCount() || !incoming->hasWeights())) {
+        throw std::invalid_argument("Incoming snapshot does not match the graph");
+    }
+
+    SearchSide& forward = forwardSide;
+    forward.reset(graph.nodeCount());
+    forward.improve(source, 0, -1, -1);
+    if (!incoming) {
+        while (!forward.heap.empty()) {
+            if (settleNext(graph, forward, [](int, double) {}) == target) {
+                return buildPath(forward, nullptr, source, target, target);
+            }
+        }
+        return ShortestPath();
+    }
+
+    SearchSide& backward = backwardSide;
+    backward.reset(graph.nodeCount());
+    backward.improve(target, 0, -1, -1);
+    double best = source == target ? 0 : INF;
+    int meet = source == target ? source : -1;
+    // Any path still to be found is at least as long as the two closest
+    // unsettled nodes' distances together
+    while (forward.heap.topKey() + backward.heap.topKey() < best) {
+        bool goForward = forward.heap.topKey() <= backward.heap.topKey();
+        SearchSide& side = goForward ? forward : backward;
+        const SearchSide& other = goForward ? backward : forward;
+        settleNext(goForward ? graph : *incoming, side, [&](int next, double distance) {
+            if (distance + other.distance[next] < best) {
+                best = distance + other.distance[next];
+                meet = next;
+            }
+        });
+    }
+    return buildPath(forward, &backward, source, target, meet);
+}
+
+ShortestPathTree shortestPathTree(const CsrGraph& graph, int source, const ShortestPathOptions& options) {
+    checkGraph(graph, {source});
+    size_t nodeCount = graph.nodeCount();
+    const uint64_t* offsets = graph.offsets();
+    const int* targets = graph.targets();
+    const double* weights = graph.weights();
+
+    // Validates every weight up front so relaxations need not
+    size_t threadCount = threadCountFor(options.threadCount, graph.edgeCount(), MIN_EDGES_PER_THREAD);
+    std::vector<double> maxWeights(threadCount, 0);
+    runParallel(threadCount, [&](size_t t) {
+        auto [first, last] = sliceOf(graph.edgeCount(), threadCount, t);
+        for (size_t i = first; i < last; ++i) {
+            checkWeight(weights[i]);
+            maxWeights[t] = std::max(maxWeights[t], weights[i]);
+        }
+    });
+    double maxWeight = *std::max_element(maxWeights.begin(), maxWeights.end());
+    double delta = options.delta;
+    if (!(delta > 0)) {
+        double averageDegree = std::max(1.0, static_cast<double>(graph.edgeCount()) / std::max<size_t>(1, nodeCount));
+        delta = maxWeight / averageDegree;
+    }
+    // Every weight is 0, or delta is so small the ring would not fit
+    delta = std::max(delta, maxWeight / MAX_BUCKETS);
+    if (!(delta > 0)) {
+        delta = 1;
+    }
+    auto bucketOf = [delta](double distance) { return static_cast<size_t>(distance / delta); };
+
+    std::vector<std::atomic<double>> distance(nodeCount);
+    for (std::atomic<double>& slot : distance) {
+        slot.store(INF, std::memory_order_relaxed);
+    }
+    distance[source].store(0, std::memory_order_relaxed);
+
+    // Relaxes the light or heavy edges of nodes on several threads, leaving
+    // the nodes whose distance went down in improved, one list per thread
+    std::vector<std::vector<int>> improved;
+    auto relax = [&](const std::vector<int>& nodes, bool light) {
+        uint64_t edges = 0;
+        for (int node : nodes) {
+            edges += offsets[node + 1] - offsets[node];
+        }
+        size_t threads = threadCountFor(options.threadCount, edges, MIN_EDGES_PER_THREAD);
+        improved.resize(std::max(improved.size(), threads));
+        for (std::vector<int>& slice : improved) {
+            slice.clear();
+        }
+        std::atomic<size_t> cursor(0);
+        runParallel(threads, [&](size_t t) {
+            while (true) {
+                size_t first = cursor.fetch_add(CHUNK_NODES, std::memory_order_relaxed);
+                if (first >= nodes.size()) {
+                    break;
+                }
+                for (size_t k = first; k < std::min(nodes.size(), first + CHUNK_NODES); ++k) {
+                    int node = nodes[k];
+                    double base = distance[node].load(std::memory_order_relaxed);
+                    for (uint64_t i = offsets[node]; i < offsets[node + 1]; ++i) {
+                        if ((weights[i] <= delta) == light && lowerTo(distance[targets[i]], base + weights[i])) {
+                            improved[t].push_back(targets[i]);
+                        }
+                    }
+                }
+            }
+        });
+    };
+
+    // A relaxation lands at most one largest weight past the bucket being
+    // settled, so pending buckets fit in a ring that many buckets wide
+    std::vector<std::vector<int>> buckets(bucketOf(maxWeight) + 2);
+    auto slotOf = [&](size_t bucket) -> std::vector<int>& { return buckets[bucket % buckets.size()]; };
+    size_t pendingCount = 1;
+    slotOf(0).push_back(source);
+    // Phase in which a node was last queued, and bucket in which it was
+    // last settled, to keep duplicates out of frontiers and settled lists
+    std::vector<uint64_t> queuedIn(nodeCount, 0);
+    std::vector<size_t> settledIn(nodeCount, std::numeric_limits<size_t>::max());
+    uint64_t phase = 0;
+    std::vector<int> frontier;
+    std::vector<int> settled;
+    for (size_t current = 0; pendingCount > 0; ++current) {
+        std::vector<int>& pending = slotOf(current);
+        pendingCount -= pending.size();
+        frontier.clear();
+        ++phase;
+        for (int node : pending) {
+            // Entries left behind when a node moved to a lower bucket
+            if (bucketOf(distance[node].load(std::memory_order_relaxed)) == current && queuedIn[node] != phase) {
+                queuedIn[node] = phase;
+                frontier.push_back(node);
+            }
+        }
+        pending.clear();
+
+        // Light edges can land back in this bucket, so they are relaxed
+        // until it stops refilling
+        settled.clear();
+        while (!frontier.empty()) {
+            for (int node : frontier) {
+                if (settledIn[node] != current) {
+                    settledIn[node] = current;
+                    settled.push_back(node);
+                }
+            }
+            relax(frontier, true);
+            frontier.clear();
+            ++phase;
+            for (const auto& slice : improved) {
+                for (int node : slice) {
+                    size_t bucket = bucketOf(distance[node].load(std::memory_order_relaxed));
+                    if (bucket != current) {
+                        slotOf(bucket).push_back(node);
+                        ++pendingCount;
+                    } else if (queuedIn[node] != phase) {
+                        queuedIn[node] = phase;
+                        frontier.push_back(node);
+                    }
+                }
+            }
+        }
+
+        // Heavy edges reach past this bucket, so once is enough
+        relax(settled, false);
+        for (const auto& slice : improved) {
+            for (int node : slice) {
+                slotOf(bucketOf(distance[node].load(std::memory_order_relaxed))).push_back(node);
+            }
+            pendingCount += slice.size();
+        }
+    }
+
+    ShortestPathTree tree;
+    tree.distances.resize(nodeCount);
+    for (size_t node = 0; node < nodeCount; ++node) {
+        tree.distances[node] = distance[node].load(std::memory_order_relaxed);
+    }
+    if (options.recordParents) {
+        // Concurrent relaxations make the last writer of a distance
+        // arbitrary, so parents come from a search over the tight edges,
+        // those whose length is exactly the difference of their ends'
+        // distances; searching from source keeps zero-weight cycles out
+        tree.parents.assign(nodeCount, -1);
+        tree.parentEdges.assign(nodeCount, -1);
+        std::vector<char> reached(nodeCount, 0);
+        std::vector<int> order = {source};
+        reached[source] = 1;
+        for (size_t k = 0; k < order.size(); ++k) {
+            int node = order[k];
+            for (uint64_t i = offsets[node]; i < offsets[node + 1]; ++i) {
+                int next = targets[i];
+                if (!reached[next] && tree.distances[node] + weights[i] == tree.distances[next]) {
+                    reached[next] = 1;
+                    tree.parents[next] = node;
+                    tree.parentEdges[next] = graph.edgeIds()[i];
+                    order.push_back(next);
+                }
+            }
+        }
+    }
+    return tree;
+}
@@ -0,0 +1,238 @@
+// src/graph/spanning_forest.cpp
+
+#include "graph/spanning_forest.hpp"
+#include "core/parallel.hpp"
+#include "graph/union_find.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+// Slices smaller than this are not worth a thread
+constexpr size_t MIN_EDGES_PER_THREAD = 16384;
+constexpr size_t MIN_NODES_PER_THREAD = 16384;
+// Sorted edges filtered per parallel step of Kruskal
+constexpr size_t KRUSKAL_BATCH = 1 << 16;
+constexpr uint64_t NO_EDGE = std::numeric_limits<uint64_t>::max();
+
+// The order both algorithms agree on; ids break weight ties so the forest is unique
+bool lighter(const WeightedEdge& a, const WeightedEdge& b) {
+    return a.weight != b.weight ? a.weight < b.weight : a.id < b.id;
+}
+
+// Drops edges no forest can use and rejects endpoints outside the node range
+void prepare(size_t nodeCount, std::vector<WeightedEdge>& edges) {
+    auto unusable = [nodeCount](const WeightedEdge& edge) {
+        if (edge.source < 0 || edge.target < 0 || static_cast<size_t>(edge.source) >= nodeCount ||
+            static_cast<size_t>(edge.target) >= nodeCount) {
+            throw std::invalid_argument("Edge endpoint outside the node range");
+        }
+        return edge.source == edge.target || std::isnan(edge.weight);
+    };
+    edges.erase(std::remove_if(edges.begin(), edges.end(), unusable), edges.end());
+}
+
+// Sorts slices in parallel, then merges neighbouring runs pairwise
+void parallelSort(std::vector<WeightedEdge>& edges, size_t threadCount) {
+    threadCount = threadCountFor(threadCount, edges.size(), MIN_EDGES_PER_THREAD);
+    std::vector<size_t> bounds(threadCount + 1);
+    for (size_t t = 0; t < threadCount; ++t) {
+        bounds[t] = sliceOf(edges.size(), threadCount, t).first;
+    }
+    bounds[threadCount] = edges.size();
+
+    runParallel(threadCount, [&](size_t t) {
+        std::sort(edges.begin() + bounds[t], edges.begin() + bounds[t + 1], lighter);
+    });
+    for (size_t width = 1; width < threadCount; width *= 2) {
+        size_t pairs = (threadCount + 2 * width - 1) / (2 * width);
+        runParallel(pairs, [&](size_t pair) {
+            size_t first = bounds[2 * pair * width];
+            size_t middle = bounds[std::min(threadCount, (2 * pair + 1) * width)];
+            size_t last = bounds[std::min(threadCount, (2 * pair + 2) * width)];
+            std::inplace_merge(edges.begin() + first, edges.begin() + middle, edges.begin() + last, lighter);
+        });
+    }
+}
+
+SpanningForest finish(size_t nodeCount, std::vector<WeightedEdge>& chosen) {
+    // Summed in id order so both algorithms report the same total to the bit
+    std::sort(chosen.begin(), chosen.end(), [](const WeightedEdge& a, const WeightedEdge& b) { return a.id < b.id; });
+    SpanningForest forest;
+    forest.edgeIds.reserve(chosen.size());
+    for (const WeightedEdge& edge : chosen) {
+        forest.edgeIds.push_back(edge.id);
+        forest.totalWeight += edge.weight;
+    }
+    forest.componentCount = nodeCount - chosen.size();
+    return forest;
+}
+
+SpanningForest kruskal(size_t nodeCount, std::vector<WeightedEdge>& edges, size_t threadCount) {
+    parallelSort(edges, threadCount);
+    ConcurrentUnionFind sets(nodeCount);
+    std::vector<WeightedEdge> chosen;
+    std::vector<char> crossing;
+
+    // Once the forest spans everything, the remaining edges cannot add to it
+    for (size_t begin = 0; begin < edges.size() && chosen.size() + 1 < nodeCount; begin += KRUSKAL_BATCH) {
+        size_t count = std::min(KRUSKAL_BATCH, edges.size() - begin);
+        crossing.assign(count, 0);
+        size_t batchThreads = threadCountFor(threadCount, count, MIN_EDGES_PER_THREAD);
+        runParallel(batchThreads, [&](size_t t) {
+            auto [first, last] = sliceOf(count, batchThreads, t);
+            for (size_t i = first; i < last; ++i) {
+                const WeightedEdge& edge = edges[begin + i];
+                crossing[i] = !sets.sameSet(edge.source, edge.target);
+            }
+        });
+        for (size_t i = 0; i < count; ++i) {
+            const WeightedEdge& edge = edges[begin + i];
+            if (crossing[i] && sets.unite(edge.source, edge.target)) {
+                chosen.push_back(edge);
+            }
+        }
+    }
+    return finish(nodeCount, chosen);
+}
+
+// edges is consumed: after each round the edges still joining two trees are
+// kept with their endpoints replaced by the roots of those trees, so later
+// rounds scan fewer, shorter-path edges
+SpanningForest boruvka(size_t nodeCount, std::vector<WeightedEdge>& edges, size_t threadCount) {
+    ConcurrentUnionFind sets(nodeCount);
+    std::vector<std::atomic<uint64_t>> lightest(nodeCount);
+    for (std::atomic<uint64_t>& index : lightest) {
+        index.store(NO_EDGE, std::memory_order_relaxed);
+    }
+    std::vector<WeightedEdge> chosen;
+
+    size_t nodeThreads = threadCountFor(threadCount, nodeCount, MIN_NODES_PER_THREAD);
+    while (!edges.empty()) {
+        // Each tree, named by its root, keeps the lightest edge leaving it.
+        // Endpoints are roots at the start of the round.
+        auto offer = [&](int root, uint64_t index) {
+            uint64_t current = lightest[root].load(std::memory_order_relaxed);
+            while (current == NO_EDGE || lighter(edges[index], edges[current])) {
+                if (lightest[root].compare_exchange_weak(current, index, std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+        };
+        size_t edgeThreads = threadCountFor(threadCount, edges.size(), MIN_EDGES_PER_THREAD);
+        runParallel(edgeThreads, [&](size_t t) {
+            auto [first, last] = sliceOf(edges.size(), edgeThreads, t);
+            for (size_t i = first; i < last; ++i) {
+                offer(edges[i].source, i);
+                offer(edges[i].target, i);
+            }
+        });
+
+        // With a strict order the picks form a forest: every union succeeds
+        // except the second of two trees that picked the same edge
+        std::vector<std::vector<WeightedEdge>> picked(nodeThreads);
+        runParallel(nodeThreads, [&](size_t t) {
+            auto [first, last] = sliceOf(nodeCount, nodeThreads, t);
+            for (size_t node = first; node < last; ++node) {
+                uint64_t index = lightest[node].load(std::memory_order_relaxed);
+                if (index == NO_EDGE) {
+                    continue;
+                }
+                lightest[node].store(NO_EDGE, std::memory_order_relaxed);
+                if (sets.unite(edges[index].source, edges[index].target)) {
+                    picked[t].push_back(edges[index]);
+                }
+            }
+        });
+        size_t before = chosen.size();
+        for (const auto& slice : picked) {
+            chosen.insert(chosen.end(), slice.begin(), slice.end());
+        }
+        if (chosen.size() == before) {
+            break;
+        }
+
+        std::vector<std::vector<WeightedEdge>> survivors(edgeThreads);
+        runParallel(edgeThreads, [&](size_t t) {
+            auto [first, last] = sliceOf(edges.size(), edgeThreads, t);
+            for (size_t i = first; i < last; ++i) {
+                int sourceRoot = sets.find(edges[i].source);
+                int targetRoot = sets.find(edges[i].target);
+                if (sourceRoot != targetRoot) {
+                    survivors[t].push_back({edges[i].weight, sourceRoot, targetRoot, edges[i].id});
+                }
+            }
+        });
+        edges.clear();
+        for (const auto& slice : survivors) {
+            edges.insert(edges.end(), slice.begin(), slice.end());
+        }
+    }
+    return finish(nodeCount, chosen);
+}
+}
+
+SpanningForest minimumSpanningForest(size_t nodeCount, std::vector<WeightedEdge> edges,
+                                     SpanningForestAlgorithm algorithm, size_t threadCount) {
+    if (nodeCount > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        throw std::invalid_argument("Too many nodes");
+    }
+    prepare(nodeCount, edges);
+    if (algorithm == SpanningForestAlgorithm::Boruvka) {
+        return boruvka(nodeCount, edges, threadCount);
+    }
+    return kruskal(nodeCount, edges, threadCount);
+}
+
+SpanningForest minimumSpanningForest(const CsrGraph& graph, SpanningForestAlgorithm algorithm,
+                                     size_t threadCount) {
+    if (!graph.hasWeights()) {
+        throw std::invalid_argument("Graph snapshot has no weights");
+    }
+    std::vector<WeightedEdge> edges(graph.edgeCount());
+    size_t threads = threadCountFor(threadCount, graph.nodeCount(), MIN_NODES_PER_THREAD);
+    runParallel(threads, [&](size_t t) {
+        auto [first, last] = sliceOf(graph.nodeCount(), threads, t);
+        for (size_t node = first; node < last; ++node) {
+            for (uint64_t i = graph.offsets()[node]; i < graph.offsets()[node + 1]; ++i) {
+                edges[i] = {graph.weights()[i], static_cast<int>(node), graph.targets()[i], graph.edgeIds()[i]};
+            }
+        }
+    });
+    return minimumSpanningForest(graph.nodeCount(), std::move(edges), algorithm, threadCount);
+}
+
+SpanningForest minimumSpanningForest(StorageEngine& engine, const std::string& weightProperty,
+                                     SpanningForestAlgorithm algorithm, size_t threadCount) {
+    // Not interning the name: if it is unknown, no edge can carry it
+    std::optional<PropertyKey> key = engine.getNames().propertyKeys.find(weightProperty);
+    size_t threads = threadCountFor(threadCount, std::numeric_limits<size_t>::max(), 1);
+    std::vector<std::vector<WeightedEdge>> batches(threads);
+    std::vector<int> maxNode(threads, -1);
+    if (key) {
+        engine.scanEdges([&](size_t thread, const EdgeView& view) {
+            std::optional<double> weight = view.tryGetProperty<double>(*key);
+            if (!weight) {
+                if (auto value = view.tryGetProperty<int>(*key)) {
+                    weight = *value;
+                }
+            }
+            if (weight) {
+                batches[thread].push_back({*weight, view.getSourceNodeId(), view.getTargetNodeId(), view.getId()});
+                maxNode[thread] = std::max({maxNode[thread], view.getSourceNodeId(), view.getTargetNodeId()});
+            }
+        }, threads);
+    }
+
+    size_t nodeCount = engine.getNodeIdLimit();
+    std::vector<WeightedEdge> edges;
+    for (size_t t = 0; t < threads; ++t) {
+        nodeCount = std::max(nodeCount, static_cast<size_t>(maxNode[t] + 1));
+        edges.insert(edges.end(), batches[t].begin(), batches[t].end());
+        std::vector<WeightedEdge>().swap(batches[t]);
+    }
+    return minimumSpanningForest(nodeCount, std::move(edges), algorithm, threadCount);
+}
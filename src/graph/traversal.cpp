@@ -0,0 +1,273 @@
+// src/graph/traversal.cpp
+
+#include "graph/traversal.hpp"
+#include "core/parallel.hpp"
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+namespace {
+// Frontier nodes, or node ids for a bottom-up level, a thread takes per grab
+constexpr size_t CHUNK_NODES = 256;
+// Levels with less work than this per thread run on fewer threads
+constexpr size_t MIN_EDGES_PER_THREAD = 16384;
+constexpr size_t MIN_NODES_PER_THREAD = 16384;
+
+// Reached nodes, shared by the threads expanding a level
+class VisitedSet {
+public:
+    explicit VisitedSet(size_t size) : words((size + 63) / 64) {
+        for (std::atomic<uint64_t>& word : words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    bool contains(int id) const {
+        return (words[id >> 6].load(std::memory_order_relaxed) >> (id & 63)) & 1;
+    }
+
+    // true for the one caller that added id
+    bool claim(int id) {
+        uint64_t mask = uint64_t{1} << (id & 63);
+        return !(words[id >> 6].fetch_or(mask, std::memory_order_relaxed) & mask);
+    }
+
+private:
+    std::vector<std::atomic<uint64_t>> words;
+};
+
+struct Reached {
+    int node;
+    int parent;
+};
+
+// Appends reached nodes to the result, up to the limit; false once a stop
+// condition is met
+bool record(TraversalResult& result, const TraversalOptions& options, const std::vector<Reached>& reached,
+            int depth, std::vector<int>& next) {
+    bool stop = false;
+    for (const Reached& entry : reached) {
+        if (options.limit != 0 && result.nodes.size() >= options.limit) {
+            stop = true;
+            break;
+        }
+        result.nodes.push_back(entry.node);
+        result.depths.push_back(depth);
+        if (options.recordParents) {
+            result.parents.push_back(entry.parent);
+        }
+        next.push_back(entry.node);
+        stop = stop || entry.node == options.target;
+    }
+    if (options.limit != 0 && result.nodes.size() >= options.limit) {
+        stop = true;
+    }
+    result.stoppedEarly = result.stoppedEarly || stop;
+    return !stop;
+}
+
+// Per-thread output of one level
+struct LevelSlice {
+    std::vector<Reached> reached;
+    size_t examined = 0;
+    // Sum of the reached nodes' degrees
+    uint64_t reachedEdges = 0;
+};
+}
+
+TraversalResult breadthFirstSearch(const CsrGraph& graph, const std::vector<int>& sources,
+                                   const TraversalOptions& options, const CsrGraph* incoming) {
+    size_t nodeCount = graph.nodeCount();
+    if (incoming && (incoming->isIncoming() == graph.isIncoming() || incoming->nodeCount() != nodeCount ||
+                     incoming->edgeCount() != graph.edgeCount())) {
+        throw std::invalid_argument("Incoming snapshot does not match the graph");
+    }
+
+    TraversalResult result;
+    VisitedSet visited(nodeCount);
+    std::vector<Reached> roots;
+    uint64_t unexploredEdges = graph.edgeCount();
+    for (int source : sources) {
+        if (source < 0 || static_cast<size_t>(source) >= nodeCount) {
+            throw std::invalid_argument("Source outside the node range");
+        }
+        if (visited.claim(source)) {
+            roots.push_back({source, -1});
+            unexploredEdges -= graph.degree(source);
+        }
+    }
+    std::vector<int> frontier;
+    if (!record(result, options, roots, 0, frontier)) {
+        return result;
+    }
+
+    // Stop requests from inside a level: the target was found or the limit reached
+    std::atomic<bool> stop(false);
+    std::atomic<size_t> reachedCount(result.nodes.size());
+    auto onReached = [&](int node) {
+        size_t count = reachedCount.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (node == options.target || (options.limit != 0 && count >= options.limit)) {
+            stop.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<uint64_t> inFrontier(incoming ? (nodeCount + 63) / 64 : 0);
+    bool bottomUp = false;
+    size_t previousFrontier = 0;
+    for (int depth = 0; !frontier.empty() && depth < options.maxDepth; ++depth) {
+        uint64_t frontierEdges = 0;
+        for (int node : frontier) {
+            frontierEdges += graph.degree(node);
+        }
+        if (incoming) {
+            if (!bottomUp) {
+                bottomUp = frontierEdges > unexploredEdges / options.alpha;
+            } else {
+                bool shrinking = frontier.size() < previousFrontier;
+                bottomUp = !(shrinking && frontier.size() < nodeCount / options.beta);
+            }
+        }
+        previousFrontier = frontier.size();
+
+        std::atomic<size_t> cursor(0);
+        std::vector<LevelSlice> slices;
+        if (bottomUp) {
+            ++result.bottomUpLevels;
+            for (int node : frontier) {
+                inFrontier[node >> 6] |= uint64_t{1} << (node & 63);
+            }
+            size_t threadCount = threadCountFor(options.threadCount, nodeCount, MIN_NODES_PER_THREAD);
+            slices.resize(threadCount);
+            runParallel(threadCount, [&](size_t t) {
+                LevelSlice& slice = slices[t];
+                while (!stop.load(std::memory_order_relaxed)) {
+                    size_t first = cursor.fetch_add(CHUNK_NODES, std::memory_order_relaxed);
+                    if (first >= nodeCount) {
+                        break;
+                    }
+                    size_t last = std::min(nodeCount, first + CHUNK_NODES);
+                    for (size_t node = first; node < last; ++node) {
+                        int id = static_cast<int>(node);
+                        if (visited.contains(id)) {
+                            continue;
+                        }
+                        for (int parent : incoming->neighbors(id)) {
+                            ++slice.examined;
+                            if ((inFrontier[parent >> 6] >> (parent & 63)) & 1) {
+                                visited.claim(id);
+                                slice.reached.push_back({id, parent});
+                                slice.reachedEdges += graph.degree(id);
+                                onReached(id);
+                                break;
+                            }
+                        }
+                    }
+                }
+            });
+            for (int node : frontier) {
+                inFrontier[node >> 6] = 0;
+            }
+        } else {
+            size_t threadCount = threadCountFor(options.threadCount, frontierEdges, MIN_EDGES_PER_THREAD);
+            slices.resize(threadCount);
+            runParallel(threadCount, [&](size_t t) {
+                LevelSlice& slice = slices[t];
+                while (!stop.load(std::memory_order_relaxed)) {
+                    size_t first = cursor.fetch_add(CHUNK_NODES, std::memory_order_relaxed);
+                    if (first >= frontier.size()) {
+                        break;
+                    }
+                    size_t last = std::min(frontier.size(), first + CHUNK_NODES);
+                    for (size_t i = first; i < last; ++i) {
+                        int parent = frontier[i];
+                        for (int node : graph.neighbors(parent)) {
+                            ++slice.examined;
+                            // Testing first keeps already-reached targets from
+                            // bouncing their cache line between threads
+                            if (!visited.contains(node) && visited.claim(node)) {
+                                slice.reached.push_back({node, parent});
+                                slice.reachedEdges += graph.degree(node);
+                                onReached(node);
+                            }
+                        }
+                    }
+                }
+            });
+        }
+
+        std::vector<int> next;
+        bool more = true;
+        for (const LevelSlice& slice : slices) {
+            result.edgesExamined += slice.examined;
+            unexploredEdges -= slice.reachedEdges;
+            more = more && record(result, options, slice.reached, depth + 1, next);
+        }
+        if (!more) {
+            break;
+        }
+        frontier.swap(next);
+    }
+    return result;
+}
+
+TraversalResult breadthFirstSearch(StorageEngine& engine, const std::vector<int>& sources,
+                                   const TraversalOptions& options) {
+    // Grows when an edge points past the ids handed out, e.g. at a node
+    // that was never added
+    std::vector<uint64_t> visited((engine.getNodeIdLimit() + 63) / 64);
+    auto claim = [&visited](int id) {
+        if (static_cast<size_t>(id >> 6) >= visited.size()) {
+            visited.resize((id >> 6) + 1);
+        }
+        uint64_t mask = uint64_t{1} << (id & 63);
+        bool added = !(visited[id >> 6] & mask);
+        visited[id >> 6] |= mask;
+        return added;
+    };
+
+    TraversalResult result;
+    std::vector<Reached> reached;
+    for (int source : sources) {
+        if (source < 0 || !engine.viewNode(source, [](const NodeView&) {})) {
+            throw std::runtime_error("Node not found");
+        }
+        if (claim(source)) {
+            reached.push_back({source, -1});
+        }
+    }
+    std::vector<int> frontier;
+    if (!record(result, options, reached, 0, frontier)) {
+        return result;
+    }
+
+    for (int depth = 0; !frontier.empty() && depth < options.maxDepth; ++depth) {
+        reached.clear();
+        bool stop = false;
+        for (size_t i = 0; i < frontier.size() && !stop; ++i) {
+            int parent = frontier[i];
+            engine.viewNode(parent, [&](const NodeView& view) {
+                for (int edgeId : view.getOutgoingEdges()) {
+                    ++result.edgesExamined;
+                    int node = -1;
+                    engine.viewEdge(edgeId, [&node](const EdgeView& edge) { node = edge.getTargetNodeId(); });
+                    if (node >= 0 && claim(node)) {
+                        reached.push_back({node, parent});
+                        // Stopping mid-row: everything after this point is
+                        // dropped anyway
+                        if (node == options.target ||
+                            (options.limit != 0 && result.nodes.size() + reached.size() >= options.limit)) {
+                            stop = true;
+                            break;
+                        }
+                    }
+                }
+            });
+        }
+        std::vector<int> next;
+        if (!record(result, options, reached, depth + 1, next)) {
+            break;
+        }
+        frontier.swap(next);
+    }
+    return result;
+}
@@ -0,0 +1,292 @@
+// src/metrics/metrics.cpp
+
+#include "metrics/metrics.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+std::atomic<bool> Metrics::enabledFlag{true};
+thread_local std::atomic<uint64_t>* Metrics::threadCounters = nullptr;
+
+namespace {
+
+struct HistogramShard {
+    std::array<std::atomic<uint64_t>, HistogramBuckets::COUNT> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> max{0};
+};
+
+// Only the owning thread writes a shard, so updates are load+store rather than
+// locked read-modify-writes; other threads only read it for snapshots.
+struct Shard {
+    std::array<std::atomic<uint64_t>, COUNTER_COUNT> counters{};
+    std::array<HistogramShard, HISTOGRAM_COUNT> histograms;
+    bool inUse = false;
+};
+
+void bump(std::atomic<uint64_t>& value, uint64_t amount) {
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+class ShardRegistry {
+public:
+    Shard* acquire() {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Reuse shards of exited threads; their totals stay in the sums
+        for (auto& shard : shards) {
+            if (!shard->inUse) {
+                shard->inUse = true;
+                return shard.get();
+            }
+        }
+        shards.push_back(std::make_unique<Shard>());
+        shards.back()->inUse = true;
+        return shards.back().get();
+    }
+
+    void release(Shard* shard) {
+        std::lock_guard<std::mutex> lock(mutex);
+        shard->inUse = false;
+    }
+
+    template<typename Func>
+    void forEach(Func&& func) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& shard : shards) {
+            func(*shard);
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Shard>> shards;
+};
+
+// Never destroyed, so thread_local handles can release into it during exit
+ShardRegistry& registry() {
+    static ShardRegistry* instance = new ShardRegistry();
+    return *instance;
+}
+
+struct ShardHandle {
+    Shard* shard;
+    ShardHandle() : shard(registry().acquire()) {}
+    ~ShardHandle() { registry().release(shard); }
+};
+
+Shard& localShard() {
+    thread_local ShardHandle handle;
+    return *handle.shard;
+}
+
+}  // namespace
+
+const char* counterName(Counter counter) {
+    switch (counter) {
+        case Counter::CACHE_NODE_HITS: return "cache_node_hits";
+        case Counter::CACHE_NODE_MISSES: return "cache_node_misses";
+        case Counter::CACHE_NODE_EVICTIONS: return "cache_node_evictions";
+        case Counter::CACHE_EDGE_HITS: return "cache_edge_hits";
+        case Counter::CACHE_EDGE_MISSES: return "cache_edge_misses";
+        case Counter::CACHE_EDGE_EVICTIONS: return "cache_edge_evictions";
+        case Counter::INDEX_LOOKUPS: return "index_lookups";
+        case Counter::INDEX_LOOKUP_LEVELS: return "index_lookup_levels";
+        case Counter::BLOOM_NEGATIVES: return "bloom_negatives";
+        case Counter::BLOOM_FALSE_POSITIVES: return "bloom_false_positives";
+        case Counter::BYTES_READ: return "bytes_read";
+        case Counter::BYTES_WRITTEN: return "bytes_written";
+        case Counter::WRITE_BACK_RECORDS: return "write_back_records";
+        case Counter::WRITE_BACK_STALLS: return "write_back_stalls";
+        case Counter::PREFETCH_ISSUED: return "prefetch_issued";
+        case Counter::PREFETCH_LOADED: return "prefetch_loaded";
+        case Counter::PREFETCH_DROPPED: return "prefetch_dropped";
+        case Counter::WARM_UP_PLANNED: return "warm_up_planned";
+        case Counter::WARM_UP_LOADED: return "warm_up_loaded";
+        default: return "unknown";
+    }
+}
+
+const char* histogramName(Histogram histogram) {
+    switch (histogram) {
+        case Histogram::INDEX_LOOKUP: return "index_lookup";
+        case Histogram::NODE_DISK_READ: return "node_disk_read";
+        case Histogram::EDGE_DISK_READ: return "edge_disk_read";
+        case Histogram::NODE_DESERIALIZE: return "node_deserialize";
+        case Histogram::EDGE_DESERIALIZE: return "edge_deserialize";
+        default: return "unknown";
+    }
+}
+
+size_t HistogramBuckets::indexOf(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return value;
+    }
+    int msb = 63 - __builtin_clzll(value);
+    int shift = msb - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + ((value >> shift) & (SUB_BUCKETS - 1));
+}
+
+uint64_t HistogramBuckets::lowerBound(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    size_t shift = index / SUB_BUCKETS - 1;
+    uint64_t sub = index % SUB_BUCKETS;
+    return (SUB_BUCKETS + sub) << shift;
+}
+
+double HistogramSnapshot::mean() const {
+    return count == 0 ? 0.0 : static_cast<double>(sum) / count;
+}
+
+uint64_t HistogramSnapshot::percentile(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(q * count);
+    if (rank >= count) {
+        rank = count - 1;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen > rank) {
+            return std::min(HistogramBuckets::lowerBound(i), max);
+        }
+    }
+    return max;
+}
+
+std::atomic<uint64_t>* Metrics::attachThread() {
+    threadCounters = localShard().counters.data();
+    return threadCounters;
+}
+
+void Metrics::record(Histogram histogram, uint64_t nanos) {
+    if (!enabled()) {
+        return;
+    }
+    HistogramShard& shard = localShard().histograms[static_cast<size_t>(histogram)];
+    bump(shard.buckets[HistogramBuckets::indexOf(nanos)], 1);
+    bump(shard.count, 1);
+    bump(shard.sum, nanos);
+    if (nanos > shard.max.load(std::memory_order_relaxed)) {
+        shard.max.store(nanos, std::memory_order_relaxed);
+    }
+}
+
+MetricsSnapshot Metrics::snapshot() {
+    MetricsSnapshot result;
+    registry().forEach([&](Shard& shard) {
+        for (size_t c = 0; c < COUNTER_COUNT; ++c) {
+            result.counters[c] += shard.counters[c].load(std::memory_order_relaxed);
+        }
+        for (size_t h = 0; h < HISTOGRAM_COUNT; ++h) {
+            const HistogramShard& source = shard.histograms[h];
+            HistogramSnapshot& target = result.histograms[h];
+            for (size_t b = 0; b < HistogramBuckets::COUNT; ++b) {
+                target.buckets[b] += source.buckets[b].load(std::memory_order_relaxed);
+            }
+            target.count += source.count.load(std::memory_order_relaxed);
+            target.sum += source.sum.load(std::memory_order_relaxed);
+            target.max = std::max(target.max, source.max.load(std::memory_order_relaxed));
+        }
+    });
+    return result;
+}
+
+void Metrics::reset() {
+    registry().forEach([](Shard& shard) {
+        for (auto& counter : shard.counters) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        for (auto& histogram : shard.histograms) {
+            for (auto& bucket : histogram.buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            histogram.count.store(0, std::memory_order_relaxed);
+            histogram.sum.store(0, std::memory_order_relaxed);
+            histogram.max.store(0, std::memory_order_relaxed);
+        }
+    });
+}
+
+std::string MetricsSnapshot::toJson() const {
+    std::ostringstream oss;
+    oss << "{\"counters\":{";
+    for (size_t c = 0; c < COUNTER_COUNT; ++c) {
+        oss << (c ? "," : "") << "\"" << counterName(static_cast<Counter>(c)) << "\":" << counters[c];
+    }
+    oss << "},\"histograms\":{";
+    for (size_t h = 0; h < HISTOGRAM_COUNT; ++h) {
+        const HistogramSnapshot& hist = histograms[h];
+        oss << (h ? "," : "") << "\"" << histogramName(static_cast<Histogram>(h)) << "_ns\":{"
+            << "\"count\":" << hist.count
+            << ",\"sum\":" << hist.sum
+            << ",\"mean\":" << hist.mean()
+            << ",\"p50\":" << hist.percentile(0.5)
+            << ",\"p99\":" << hist.percentile(0.99)
+            << ",\"p999\":" << hist.percentile(0.999)
+            << ",\"max\":" << hist.max << "}";
+    }
+    oss << "}}\n";
+    return oss.str();
+}
+
+std::string MetricsSnapshot::toPrometheus() const {
+    std::ostringstream oss;
+    for (size_t c = 0; c < COUNTER_COUNT; ++c) {
+        std::string name = std::string("kruskaldb_") + counterName(static_cast<Counter>(c)) + "_total";
+        oss << "# TYPE " << name << " counter\n" << name << " " << counters[c] << "\n";
+    }
+    for (size_t h = 0; h < HISTOGRAM_COUNT; ++h) {
+        const HistogramSnapshot& hist = histograms[h];
+        std::string name = std::string("kruskaldb_") + histogramName(static_cast<Histogram>(h)) + "_seconds";
+        oss << "# TYPE " << name << " summary\n";
+        for (double q : {0.5, 0.99, 0.999}) {
+            oss << name << "{quantile=\"" << q << "\"} " << hist.percentile(q) / 1e9 << "\n";
+        }
+        oss << name << "_sum " << hist.sum / 1e9 << "\n";
+        oss << name << "_count " << hist.count << "\n";
+    }
+    return oss.str();
+}
+
+MetricsDumper::MetricsDumper(const std::string& path, std::chrono::milliseconds interval, Format format)
+    : path(path), interval(interval), format(format), stopping(false) {
+    worker = std::thread(&MetricsDumper::run, this);
+}
+
+MetricsDumper::~MetricsDumper() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    stopSignal.notify_all();
+    worker.join();
+    dumpNow();
+}
+
+void MetricsDumper::dumpNow() {
+    MetricsSnapshot snap = Metrics::snapshot();
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::trunc);
+        out << (format == Format::JSON ? snap.toJson() : snap.toPrometheus());
+    }
+    // Readers never see a half-written file
+    std::rename(tmpPath.c_str(), path.c_str());
+}
+
+void MetricsDumper::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopSignal.wait_for(lock, interval, [this] { return stopping; })) {
+        lock.unlock();
+        dumpNow();
+        lock.lock();
+    }
+}
@@ -0,0 +1,98 @@
+// src/storage/adjacency_index.cpp
+
+#include "storage/adjacency_index.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+bool byEdgeId(const Neighbor& neighbor, int edgeId) {
+    return neighbor.edgeId < edgeId;
+}
+}
+
+void AdjacencyIndex::insert(int nodeId, EdgeType type, int edgeId, int otherNodeId) {
+    std::vector<Neighbor>& list = lists[keyOf(nodeId, type)];
+    // Edge ids are handed out in ascending order, so new edges append
+    if (list.empty() || list.back().edgeId < edgeId) {
+        list.push_back({edgeId, otherNodeId});
+        ++entries;
+        return;
+    }
+    auto position = std::lower_bound(list.begin(), list.end(), edgeId, byEdgeId);
+    if (position->edgeId != edgeId) {
+        list.insert(position, {edgeId, otherNodeId});
+        ++entries;
+    }
+}
+
+bool AdjacencyIndex::erase(int nodeId, EdgeType type, int edgeId) {
+    auto found = lists.find(keyOf(nodeId, type));
+    if (found == lists.end()) {
+        return false;
+    }
+    std::vector<Neighbor>& list = found->second;
+    auto position = std::lower_bound(list.begin(), list.end(), edgeId, byEdgeId);
+    if (position == list.end() || position->edgeId != edgeId) {
+        return false;
+    }
+    list.erase(position);
+    if (list.empty()) {
+        lists.erase(found);
+    }
+    --entries;
+    return true;
+}
+
+const std::vector<Neighbor>& AdjacencyIndex::find(int nodeId, EdgeType type) const {
+    static const std::vector<Neighbor> none;
+    auto found = lists.find(keyOf(nodeId, type));
+    return found == lists.end() ? none : found->second;
+}
+
+size_t AdjacencyIndex::heapUsage() const {
+    size_t bytes = lists.bucket_count() * sizeof(void*);
+    for (const auto& [key, list] : lists) {
+        // Hash node: next pointer, key, vector header
+        bytes += sizeof(void*) + sizeof(key) + sizeof(list) + list.capacity() * sizeof(Neighbor);
+    }
+    return bytes;
+}
+
+void AdjacencyIndex::serialize(BinaryWriter& writer) const {
+    writer.writeVarint(lists.size());
+    for (const auto& [key, list] : lists) {
+        writer.writeVarint(key);
+        writer.writeVarint(list.size());
+        // Ascending edge ids delta-encode to a byte or two each
+        int previous = 0;
+        for (const Neighbor& neighbor : list) {
+            writer.writeVarint(static_cast<uint32_t>(neighbor.edgeId - previous));
+            writer.writeVarint(static_cast<uint32_t>(neighbor.nodeId));
+            previous = neighbor.edgeId;
+        }
+    }
+}
+
+AdjacencyIndex AdjacencyIndex::deserialize(BinaryReader& reader) {
+    AdjacencyIndex index;
+    uint64_t keys = reader.readVarint();
+    index.lists.reserve(std::min<uint64_t>(keys, 1 << 20));
+    for (uint64_t i = 0; i < keys; ++i) {
+        uint64_t key = reader.readVarint();
+        uint64_t count = reader.readVarint();
+        std::vector<Neighbor>& list = index.lists[key];
+        if (!list.empty()) {
+            throw std::runtime_error("Corrupt adjacency index");
+        }
+        // Capped so a damaged count cannot trigger a huge allocation
+        list.reserve(std::min<uint64_t>(count, 1 << 20));
+        int previous = 0;
+        for (uint64_t j = 0; j < count; ++j) {
+            int edgeId = previous + static_cast<int>(reader.readVarint());
+            list.push_back({edgeId, static_cast<int>(reader.readVarint())});
+            previous = edgeId;
+        }
+        index.entries += count;
+    }
+    return index;
+}
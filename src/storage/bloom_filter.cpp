@@ -0,0 +1,130 @@
+// src/storage/bloom_filter.cpp
+
+#include "storage/bloom_filter.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define KRUSKALDB_BLOOM_AVX2 1
+#endif
+
+namespace {
+// Odd multipliers from the Parquet split-block Bloom filter spec
+constexpr uint32_t SALT[8] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+
+constexpr uint32_t FORMAT_MAGIC = 0x4B424C46;  // "KBLF"
+
+bool probeScalar(const uint32_t* words, uint32_t key) {
+    for (int i = 0; i < 8; ++i) {
+        uint32_t mask = 1U << ((key * SALT[i]) >> 27);
+        if ((words[i] & mask) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#ifdef KRUSKALDB_BLOOM_AVX2
+__attribute__((target("avx2")))
+bool probeAvx2(const uint32_t* words, uint32_t key) {
+    const __m256i salt = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(SALT));
+    __m256i bits = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(key), salt), 27);
+    __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), bits);
+    __m256i block = _mm256_load_si256(reinterpret_cast<const __m256i*>(words));
+    // testc: every bit of mask is also set in block
+    return _mm256_testc_si256(block, mask);
+}
+
+bool cpuHasAvx2() {
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    return hasAvx2;
+}
+#endif
+}
+
+BloomFilter::BloomFilter(size_t expectedKeys, size_t bitsPerKey)
+    : expectedKeys(expectedKeys == 0 ? 1 : expectedKeys), bitsPerKey(bitsPerKey), insertedKeys(0) {
+    size_t blockCount = (this->expectedKeys * bitsPerKey + 255) / 256;
+    blocks.assign(blockCount == 0 ? 1 : blockCount, Block{});
+}
+
+uint64_t BloomFilter::hashKey(int key) {
+    uint64_t x = static_cast<uint32_t>(key);
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+size_t BloomFilter::blockIndex(uint64_t hash) const {
+    // Multiply-shift maps the high half onto [0, blocks) without a modulo
+    return ((hash >> 32) * blocks.size()) >> 32;
+}
+
+void BloomFilter::insert(int key) {
+    uint64_t hash = hashKey(key);
+    Block& block = blocks[blockIndex(hash)];
+    uint32_t lowHash = static_cast<uint32_t>(hash);
+    for (int i = 0; i < 8; ++i) {
+        block.words[i] |= 1U << ((lowHash * SALT[i]) >> 27);
+    }
+    ++insertedKeys;
+}
+
+bool BloomFilter::mayContain(int key) const {
+    uint64_t hash = hashKey(key);
+    const Block& block = blocks[blockIndex(hash)];
+#ifdef KRUSKALDB_BLOOM_AVX2
+    if (cpuHasAvx2()) {
+        return probeAvx2(block.words, static_cast<uint32_t>(hash));
+    }
+#endif
+    return probeScalar(block.words, static_cast<uint32_t>(hash));
+}
+
+void BloomFilter::clear() {
+    std::fill(blocks.begin(), blocks.end(), Block{});
+    insertedKeys = 0;
+}
+
+std::string BloomFilter::serialize() const {
+    // magic, expected keys, bits per key, inserted keys, block count, raw blocks
+    uint64_t header[4] = {expectedKeys, bitsPerKey, insertedKeys, blocks.size()};
+    std::string data(sizeof(FORMAT_MAGIC) + sizeof(header) + blocks.size() * sizeof(Block), '\0');
+    char* out = &data[0];
+    std::memcpy(out, &FORMAT_MAGIC, sizeof(FORMAT_MAGIC));
+    std::memcpy(out + sizeof(FORMAT_MAGIC), header, sizeof(header));
+    std::memcpy(out + sizeof(FORMAT_MAGIC) + sizeof(header), blocks.data(), blocks.size() * sizeof(Block));
+    return data;
+}
+
+BloomFilter BloomFilter::deserialize(const std::string& data) {
+    uint32_t magic;
+    uint64_t header[4];
+    if (data.size() < sizeof(magic) + sizeof(header)) {
+        throw std::runtime_error("Bloom filter data truncated");
+    }
+    std::memcpy(&magic, data.data(), sizeof(magic));
+    std::memcpy(header, data.data() + sizeof(magic), sizeof(header));
+    if (magic != FORMAT_MAGIC) {
+        throw std::runtime_error("Bad Bloom filter magic");
+    }
+    if (data.size() != sizeof(magic) + sizeof(header) + header[3] * sizeof(Block)) {
+        throw std::runtime_error("Bloom filter data truncated");
+    }
+
+    BloomFilter filter(header[0], header[1]);
+    if (filter.blocks.size() != header[3]) {
+        throw std::runtime_error("Bloom filter geometry mismatch");
+    }
+    filter.insertedKeys = header[2];
+    std::memcpy(filter.blocks.data(), data.data() + sizeof(magic) + sizeof(header), header[3] * sizeof(Block));
+    return filter;
+}
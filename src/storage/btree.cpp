@@ -9,6 +9,20 @@ BTree::~BTree() {
     deleteTree(root);
 }
 
+BTree::BTree(BTree&& other) noexcept : root(other.root), t(other.t) {
+    other.root = nullptr;
+}
+
+BTree& BTree::operator=(BTree&& other) noexcept {
+    if (this != &other) {
+        deleteTree(root);
+        root = other.root;
+        t = other.t;
+        other.root = nullptr;
+    }
+    return *this;
+}
+
 void BTree::insert(int key, long value) {
     if (root == nullptr) {
         root = new BTreeNode(true);
@@ -24,11 +38,50 @@ void BTree::insert(int key, long value) {
             insertNonFull(root, key, value);
         }
     }
+#ifndef NDEBUG
     validateTree();
+#endif
 }
 
 long BTree::search(int key) const {
-    return searchInternal(root, key);
+    int depth = 0;
+    return search(key, depth);
+}
+
+long BTree::search(int key, int& depth) const {
+    std::optional<long> value = find(key, depth);
+    if (!value) {
+        throw std::runtime_error("Key not found");
+    }
+    return *value;
+}
+
+std::optional<long> BTree::find(int key) const {
+    int depth = 0;
+    return find(key, depth);
+}
+
+std::optional<long> BTree::find(int key, int& depth) const {
+    depth = 0;
+    if (root == nullptr) {
+        return std::nullopt;
+    }
+    return searchInternal(root, key, depth);
+}
+
+void BTree::forEach(const std::function<void(int, long)>& visit) const {
+    forEachInternal(root, visit);
+}
+
+int BTree::maxKey() const {
+    if (root == nullptr) {
+        throw std::runtime_error("Tree is empty");
+    }
+    BTreeNode* node = root;
+    while (!node->isLeaf) {
+        node = node->children.back();
+    }
+    return node->keys.back().first;
 }
 
 void BTree::remove(int key) {
@@ -41,7 +94,9 @@ void BTree::remove(int key) {
         root = root->isLeaf ? nullptr : root->children[0];
         delete oldRoot;
     }
+#ifndef NDEBUG
     validateTree();
+#endif
 }
 
 void BTree::splitChild(BTreeNode* parent, int index, BTreeNode* child) {
@@ -96,7 +151,8 @@ void BTree::insertNonFull(BTreeNode* node, int key, long value) {
     }
 }
 
-long BTree::searchInternal(BTreeNode* node, int key) const {
+std::optional<long> BTree::searchInternal(BTreeNode* node, int key, int& depth) const {
+    ++depth;
     int i = 0;
     while (i < node->keys.size() && key > node->keys[i].first) {
         i++;
@@ -105,9 +161,24 @@ long BTree::searchInternal(BTreeNode* node, int key) const {
         return node->keys[i].second;
     }
     if (node->isLeaf) {
-        throw std::runtime_error("Key not found");
+        return std::nullopt;
+    }
+    return searchInternal(node->children[i], key, depth);
+}
+
+void BTree::forEachInternal(BTreeNode* node, const std::function<void(int, long)>& visit) const {
+    if (node == nullptr) {
+        return;
+    }
+    for (size_t i = 0; i < node->keys.size(); ++i) {
+        if (!node->isLeaf) {
+            forEachInternal(node->children[i], visit);
+        }
+        visit(node->keys[i].first, node->keys[i].second);
+    }
+    if (!node->isLeaf) {
+        forEachInternal(node->children.back(), visit);
     }
-    return searchInternal(node->children[i], key);
 }
 
 void BTree::removeInternal(BTreeNode* node, int key) {
@@ -259,55 +330,43 @@ BTree BTree::deserialize(const std::string& data) {
 
     BTree tree(t);
 
-    std::getline(iss, token, '|');
-    bool isLeaf = (token == "1");
+    // Nodes appear in breadth-first order, each followed by its child count,
+    // exactly as serialize() writes them
+    auto readNode = [&](int& childCount) {
+        std::getline(iss, token, '|');
+        BTreeNode* node = new BTreeNode(token == "1");
 
-    std::getline(iss, token, '|');
-    int keyCount = std::stoi(token);
-    
-    BTreeNode* root = new BTreeNode(isLeaf);
+        std::getline(iss, token, '|');
+        int keyCount = std::stoi(token);
+        for (int i = 0; i < keyCount; ++i) {
+            std::getline(iss, token, '|');
+            size_t colonPos = token.find(':');
+            int key = std::stoi(token.substr(0, colonPos));
+            long value = std::stol(token.substr(colonPos + 1));
+            node->keys.push_back({key, value});
+        }
 
-    for (int i = 0; i < keyCount; ++i) {
         std::getline(iss, token, '|');
-        size_t colonPos = token.find(':');
-        int key = std::stoi(token.substr(0, colonPos));
-        long value = std::stol(token.substr(colonPos + 1));
-        root->keys.push_back({key, value});
-    }
+        childCount = std::stoi(token);
+        return node;
+    };
 
+    int rootChildCount = 0;
+    BTreeNode* root = readNode(rootChildCount);
     tree.setRoot(root);
 
-    std::queue<BTreeNode*> q;
-    q.push(root);
+    std::queue<std::pair<BTreeNode*, int>> q;
+    q.push({root, rootChildCount});
 
     while (!q.empty()) {
-        BTreeNode* parent = q.front();
+        auto [parent, childCount] = q.front();
         q.pop();
 
-        std::getline(iss, token, '|');
-        int childCount = std::stoi(token);
-
         for (int i = 0; i < childCount; ++i) {
-            std::getline(iss, token, '|');
-            bool childIsLeaf = (token == "1");
-            std::getline(iss, token, '|');
-            int childKeyCount = std::stoi(token);
-
-            BTreeNode* child = new BTreeNode(childIsLeaf);
-
-            for (int j = 0; j < childKeyCount; ++j) {
-                std::getline(iss, token, '|');
-                size_t colonPos = token.find(':');
-                int key = std::stoi(token.substr(0, colonPos));
-                long value = std::stol(token.substr(colonPos + 1));
-                child->keys.push_back({key, value});
-            }
-
+            int grandchildCount = 0;
+            BTreeNode* child = readNode(grandchildCount);
             parent->children.push_back(child);
-
-            if (!childIsLeaf) {
-                q.push(child);
-            }
+            q.push({child, grandchildCount});
         }
     }
 
@@ -0,0 +1,26 @@
+// src/storage/change_log.cpp
+
+#include "storage/change_log.hpp"
+#include <algorithm>
+#include <random>
+
+ChangeLog::ChangeLog(size_t capacity) : firstSequence(0), capacity(std::max<size_t>(1, capacity)) {
+    std::random_device random;
+    logId = (static_cast<uint64_t>(random()) << 32) ^ random();
+}
+
+void ChangeLog::record(Kind kind, int id) {
+    if (entries.size() == capacity) {
+        entries.pop_front();
+        ++firstSequence;
+    }
+    entries.push_back({kind, id});
+}
+
+bool ChangeLog::changesSince(uint64_t from, std::vector<Change>& out) const {
+    if (from < firstSequence || from > sequence()) {
+        return false;
+    }
+    out.insert(out.end(), entries.begin() + (from - firstSequence), entries.end());
+    return true;
+}
@@ -0,0 +1,423 @@
+// src/storage/column_store.cpp
+
+#include "storage/column_store.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define KRUSKAL_X86_KERNELS 1
+#endif
+
+namespace {
+// Each kernel writes one selection word per 64 values, already masked by the
+// validity word for those rows
+template<typename T>
+using CompareKernel = void (*)(const T* values, const uint64_t* valid, size_t words, T value, uint64_t* out);
+
+template<CompareOp Op, typename T>
+bool compare(T a, T b) {
+    if constexpr (Op == CompareOp::Equal) return a == b;
+    else if constexpr (Op == CompareOp::NotEqual) return a != b;
+    else if constexpr (Op == CompareOp::Less) return a < b;
+    else if constexpr (Op == CompareOp::LessEqual) return a <= b;
+    else if constexpr (Op == CompareOp::Greater) return a > b;
+    else return a >= b;
+}
+
+// Branch-free, so the compiler can vectorize it for the baseline target
+template<CompareOp Op, typename T>
+void compareScalar(const T* values, const uint64_t* valid, size_t words, T value, uint64_t* out) {
+    for (size_t w = 0; w < words; ++w) {
+        const T* block = values + w * 64;
+        uint64_t bits = 0;
+        for (unsigned lane = 0; lane < 64; ++lane) {
+            bits |= static_cast<uint64_t>(compare<Op>(block[lane], value)) << lane;
+        }
+        out[w] = bits & valid[w];
+    }
+}
+
+#ifdef KRUSKAL_X86_KERNELS
+// AVX2 has only equal and greater-than for integers; the other four are
+// their complements or have the operands swapped
+template<CompareOp Op>
+__attribute__((target("avx2"))) void compareIntAvx2(const int32_t* values, const uint64_t* valid, size_t words,
+                                                    int32_t value, uint64_t* out) {
+    constexpr bool equality = Op == CompareOp::Equal || Op == CompareOp::NotEqual;
+    constexpr bool swapped = Op == CompareOp::Less || Op == CompareOp::GreaterEqual;
+    constexpr bool negated = Op == CompareOp::NotEqual || Op == CompareOp::LessEqual || Op == CompareOp::GreaterEqual;
+    __m256i constant = _mm256_set1_epi32(value);
+    for (size_t w = 0; w < words; ++w) {
+        const int32_t* block = values + w * 64;
+        uint64_t bits = 0;
+        for (unsigned lane = 0; lane < 64; lane += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + lane));
+            __m256i mask;
+            if constexpr (equality) {
+                mask = _mm256_cmpeq_epi32(v, constant);
+            } else if constexpr (swapped) {
+                mask = _mm256_cmpgt_epi32(constant, v);
+            } else {
+                mask = _mm256_cmpgt_epi32(v, constant);
+            }
+            bits |= static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(mask))))
+                    << lane;
+        }
+        out[w] = (negated ? ~bits : bits) & valid[w];
+    }
+}
+
+// Ordered predicates except NotEqual, matching the C++ operators on NaN
+template<CompareOp Op>
+constexpr int doublePredicate() {
+    if constexpr (Op == CompareOp::Equal) return _CMP_EQ_OQ;
+    else if constexpr (Op == CompareOp::NotEqual) return _CMP_NEQ_UQ;
+    else if constexpr (Op == CompareOp::Less) return _CMP_LT_OQ;
+    else if constexpr (Op == CompareOp::LessEqual) return _CMP_LE_OQ;
+    else if constexpr (Op == CompareOp::Greater) return _CMP_GT_OQ;
+    else return _CMP_GE_OQ;
+}
+
+template<CompareOp Op>
+__attribute__((target("avx2"))) void compareDoubleAvx2(const double* values, const uint64_t* valid, size_t words,
+                                                       double value, uint64_t* out) {
+    constexpr int predicate = doublePredicate<Op>();
+    __m256d constant = _mm256_set1_pd(value);
+    for (size_t w = 0; w < words; ++w) {
+        const double* block = values + w * 64;
+        uint64_t bits = 0;
+        for (unsigned lane = 0; lane < 64; lane += 4) {
+            __m256d mask = _mm256_cmp_pd(_mm256_loadu_pd(block + lane), constant, predicate);
+            bits |= static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_pd(mask))) << lane;
+        }
+        out[w] = bits & valid[w];
+    }
+}
+
+template<CompareOp Op>
+constexpr int intPredicate() {
+    if constexpr (Op == CompareOp::Equal) return _MM_CMPINT_EQ;
+    else if constexpr (Op == CompareOp::NotEqual) return _MM_CMPINT_NE;
+    else if constexpr (Op == CompareOp::Less) return _MM_CMPINT_LT;
+    else if constexpr (Op == CompareOp::LessEqual) return _MM_CMPINT_LE;
+    else if constexpr (Op == CompareOp::Greater) return _MM_CMPINT_NLE;
+    else return _MM_CMPINT_NLT;
+}
+
+// Mask registers hold the comparison bits directly; no movemask needed
+template<CompareOp Op>
+__attribute__((target("avx512f"))) void compareIntAvx512(const int32_t* values, const uint64_t* valid, size_t words,
+                                                        int32_t value, uint64_t* out) {
+    constexpr int predicate = intPredicate<Op>();
+    __m512i constant = _mm512_set1_epi32(value);
+    for (size_t w = 0; w < words; ++w) {
+        const int32_t* block = values + w * 64;
+        uint64_t bits = 0;
+        for (unsigned lane = 0; lane < 64; lane += 16) {
+            __mmask16 mask = _mm512_cmp_epi32_mask(_mm512_loadu_si512(block + lane), constant, predicate);
+            bits |= static_cast<uint64_t>(mask) << lane;
+        }
+        out[w] = bits & valid[w];
+    }
+}
+
+template<CompareOp Op>
+__attribute__((target("avx512f"))) void compareDoubleAvx512(const double* values, const uint64_t* valid,
+                                                           size_t words, double value, uint64_t* out) {
+    constexpr int predicate = doublePredicate<Op>();
+    __m512d constant = _mm512_set1_pd(value);
+    for (size_t w = 0; w < words; ++w) {
+        const double* block = values + w * 64;
+        uint64_t bits = 0;
+        for (unsigned lane = 0; lane < 64; lane += 8) {
+            __mmask8 mask = _mm512_cmp_pd_mask(_mm512_loadu_pd(block + lane), constant, predicate);
+            bits |= static_cast<uint64_t>(mask) << lane;
+        }
+        out[w] = bits & valid[w];
+    }
+}
+#endif
+
+template<CompareOp Op, typename T>
+CompareKernel<T> kernelFor(SimdLevel level) {
+#ifdef KRUSKAL_X86_KERNELS
+    switch (std::min(level, detectedSimdLevel())) {
+        case SimdLevel::Avx512:
+            if constexpr (std::is_same_v<T, int32_t>) return compareIntAvx512<Op>;
+            else return compareDoubleAvx512<Op>;
+        case SimdLevel::Avx2:
+            if constexpr (std::is_same_v<T, int32_t>) return compareIntAvx2<Op>;
+            else return compareDoubleAvx2<Op>;
+        default:
+            break;
+    }
+#else
+    (void)level;
+#endif
+    return compareScalar<Op, T>;
+}
+
+template<typename T>
+CompareKernel<T> kernelFor(CompareOp op, SimdLevel level) {
+    switch (op) {
+        case CompareOp::Equal: return kernelFor<CompareOp::Equal, T>(level);
+        case CompareOp::NotEqual: return kernelFor<CompareOp::NotEqual, T>(level);
+        case CompareOp::Less: return kernelFor<CompareOp::Less, T>(level);
+        case CompareOp::LessEqual: return kernelFor<CompareOp::LessEqual, T>(level);
+        case CompareOp::Greater: return kernelFor<CompareOp::Greater, T>(level);
+        default: return kernelFor<CompareOp::GreaterEqual, T>(level);
+    }
+}
+
+void setBit(std::vector<uint64_t>& words, size_t id, bool value) {
+    uint64_t bit = uint64_t{1} << (id % 64);
+    words[id / 64] = value ? words[id / 64] | bit : words[id / 64] & ~bit;
+}
+}
+
+void SelectionBitmap::set(size_t id) {
+    if (id >= bitCount) {
+        bitCount = id + 1;
+        words.resize((bitCount + 63) / 64, 0);
+    }
+    words[id / 64] |= uint64_t{1} << (id % 64);
+}
+
+size_t SelectionBitmap::count() const {
+    size_t total = 0;
+    for (uint64_t word : words) {
+        total += __builtin_popcountll(word);
+    }
+    return total;
+}
+
+SelectionBitmap& SelectionBitmap::operator&=(const SelectionBitmap& other) {
+    size_t shared = std::min(words.size(), other.words.size());
+    for (size_t w = 0; w < shared; ++w) {
+        words[w] &= other.words[w];
+    }
+    std::fill(words.begin() + shared, words.end(), 0);
+    return *this;
+}
+
+SelectionBitmap& SelectionBitmap::operator|=(const SelectionBitmap& other) {
+    if (other.bitCount > bitCount) {
+        bitCount = other.bitCount;
+        words.resize(other.words.size(), 0);
+    }
+    for (size_t w = 0; w < other.words.size(); ++w) {
+        words[w] |= other.words[w];
+    }
+    return *this;
+}
+
+SelectionBitmap& SelectionBitmap::subtract(const SelectionBitmap& other) {
+    size_t shared = std::min(words.size(), other.words.size());
+    for (size_t w = 0; w < shared; ++w) {
+        words[w] &= ~other.words[w];
+    }
+    return *this;
+}
+
+std::vector<int> SelectionBitmap::toIds() const {
+    std::vector<int> ids;
+    ids.reserve(count());
+    forEach([&](int id) { ids.push_back(id); });
+    return ids;
+}
+
+void ColumnStore::addColumn(PropertyKey key, ColumnType type) {
+    auto [it, inserted] = columns.try_emplace(key);
+    if (!inserted) {
+        if (it->second.type != type) {
+            throw std::invalid_argument("Property already has a column of another type");
+        }
+        return;
+    }
+    it->second.type = type;
+    reserveRows(it->second, rowCount);
+}
+
+std::optional<ColumnType> ColumnStore::columnType(PropertyKey key) const {
+    auto it = columns.find(key);
+    if (it == columns.end()) {
+        return std::nullopt;
+    }
+    return it->second.type;
+}
+
+std::vector<PropertyKey> ColumnStore::getColumnKeys() const {
+    std::vector<PropertyKey> keys;
+    keys.reserve(columns.size());
+    for (const auto& [key, column] : columns) {
+        keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end(), [](PropertyKey a, PropertyKey b) { return a.id < b.id; });
+    return keys;
+}
+
+template<typename Record>
+void ColumnStore::updateRow(const Record& node) {
+    if (node.getId() < 0) {
+        throw std::invalid_argument("Node id must not be negative");
+    }
+    size_t row = node.getId();
+    if (row >= rowCount) {
+        rowCount = row + 1;
+    }
+    // Node hands out pointers and NodeView optionals; both test and dereference alike
+    for (auto& [key, column] : columns) {
+        reserveRows(column, rowCount);
+        bool present = false;
+        switch (column.type) {
+            case ColumnType::Bool: {
+                auto value = node.template tryGetProperty<bool>(key);
+                present = static_cast<bool>(value);
+                setBit(column.bools, row, present && *value);
+                break;
+            }
+            case ColumnType::Int: {
+                auto value = node.template tryGetProperty<int>(key);
+                present = static_cast<bool>(value);
+                column.ints[row] = present ? *value : 0;
+                break;
+            }
+            case ColumnType::Double: {
+                auto value = node.template tryGetProperty<double>(key);
+                present = static_cast<bool>(value);
+                column.doubles[row] = present ? *value : 0.0;
+                break;
+            }
+        }
+        setBit(column.valid, row, present);
+    }
+}
+
+void ColumnStore::update(const Node& node) {
+    updateRow(node);
+}
+
+void ColumnStore::update(const NodeView& node) {
+    updateRow(node);
+}
+
+void ColumnStore::erase(int nodeId) {
+    if (nodeId < 0 || static_cast<size_t>(nodeId) >= rowCount) {
+        return;
+    }
+    for (auto& [key, column] : columns) {
+        setBit(column.valid, nodeId, false);
+    }
+}
+
+template<>
+std::optional<bool> ColumnStore::get<bool>(PropertyKey key, int nodeId) const {
+    const Column& values = column(key, ColumnType::Bool);
+    if (!isValid(values, nodeId)) {
+        return std::nullopt;
+    }
+    return (values.bools[nodeId / 64] >> (nodeId % 64) & 1) != 0;
+}
+
+template<>
+std::optional<int> ColumnStore::get<int>(PropertyKey key, int nodeId) const {
+    const Column& values = column(key, ColumnType::Int);
+    if (!isValid(values, nodeId)) {
+        return std::nullopt;
+    }
+    return values.ints[nodeId];
+}
+
+template<>
+std::optional<double> ColumnStore::get<double>(PropertyKey key, int nodeId) const {
+    const Column& values = column(key, ColumnType::Double);
+    if (!isValid(values, nodeId)) {
+        return std::nullopt;
+    }
+    return values.doubles[nodeId];
+}
+
+SelectionBitmap ColumnStore::filter(PropertyKey key, CompareOp op, int value) const {
+    return filter(key, op, value, SimdLevel::Avx512);
+}
+
+SelectionBitmap ColumnStore::filter(PropertyKey key, CompareOp op, double value) const {
+    return filter(key, op, value, SimdLevel::Avx512);
+}
+
+SelectionBitmap ColumnStore::filter(PropertyKey key, CompareOp op, int value, SimdLevel level) const {
+    const Column& values = column(key, ColumnType::Int);
+    SelectionBitmap result(rowCount);
+    std::vector<uint64_t>& out = result.getWords();
+    kernelFor<int32_t>(op, level)(values.ints.data(), values.valid.data(), out.size(), value, out.data());
+    return result;
+}
+
+SelectionBitmap ColumnStore::filter(PropertyKey key, CompareOp op, double value, SimdLevel level) const {
+    const Column& values = column(key, ColumnType::Double);
+    SelectionBitmap result(rowCount);
+    std::vector<uint64_t>& out = result.getWords();
+    kernelFor<double>(op, level)(values.doubles.data(), values.valid.data(), out.size(), value, out.data());
+    return result;
+}
+
+SelectionBitmap ColumnStore::filter(PropertyKey key, bool value) const {
+    const Column& values = column(key, ColumnType::Bool);
+    SelectionBitmap result(rowCount);
+    std::vector<uint64_t>& out = result.getWords();
+    uint64_t flip = value ? 0 : ~uint64_t{0};
+    for (size_t w = 0; w < out.size(); ++w) {
+        out[w] = (values.bools[w] ^ flip) & values.valid[w];
+    }
+    return result;
+}
+
+SelectionBitmap ColumnStore::notNull(PropertyKey key) const {
+    auto it = columns.find(key);
+    if (it == columns.end()) {
+        throw std::invalid_argument("Property has no column");
+    }
+    SelectionBitmap result(rowCount);
+    std::copy_n(it->second.valid.begin(), result.getWords().size(), result.getWords().begin());
+    return result;
+}
+
+size_t ColumnStore::heapUsage() const {
+    size_t bytes = 0;
+    for (const auto& [key, column] : columns) {
+        bytes += (column.valid.capacity() + column.bools.capacity()) * sizeof(uint64_t) +
+                 column.ints.capacity() * sizeof(int32_t) + column.doubles.capacity() * sizeof(double);
+    }
+    return bytes;
+}
+
+const ColumnStore::Column& ColumnStore::column(PropertyKey key, ColumnType type) const {
+    auto it = columns.find(key);
+    if (it == columns.end()) {
+        throw std::invalid_argument("Property has no column");
+    }
+    if (it->second.type != type) {
+        throw std::invalid_argument("Column has another type");
+    }
+    return it->second;
+}
+
+bool ColumnStore::isValid(const Column& column, int nodeId) const {
+    return nodeId >= 0 && static_cast<size_t>(nodeId) < rowCount && (column.valid[nodeId / 64] >> (nodeId % 64) & 1);
+}
+
+void ColumnStore::reserveRows(Column& column, size_t rows) {
+    size_t words = (rows + 63) / 64;
+    if (column.valid.size() >= words) {
+        return;
+    }
+    // resize grows geometrically, so appending ids one by one stays amortized O(1)
+    column.valid.resize(words, 0);
+    switch (column.type) {
+        case ColumnType::Bool: column.bools.resize(words, 0); break;
+        case ColumnType::Int: column.ints.resize(words * 64, 0); break;
+        case ColumnType::Double: column.doubles.resize(words * 64, 0.0); break;
+    }
+}
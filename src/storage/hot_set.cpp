@@ -0,0 +1,65 @@
+// src/storage/hot_set.cpp
+
+#include "storage/hot_set.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+namespace {
+constexpr uint32_t FORMAT_MAGIC = 0x4B484F54;  // "KHOT"
+
+void appendIds(std::string& out, const std::vector<int>& ids) {
+    uint32_t count = ids.size();
+    out.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    out.append(reinterpret_cast<const char*>(ids.data()), ids.size() * sizeof(int));
+}
+
+bool readIds(const std::string& data, size_t& pos, std::vector<int>& ids) {
+    uint32_t count;
+    if (data.size() - pos < sizeof(count)) {
+        return false;
+    }
+    std::copy_n(data.data() + pos, sizeof(count), reinterpret_cast<char*>(&count));
+    pos += sizeof(count);
+    if ((data.size() - pos) / sizeof(int) < count) {
+        return false;
+    }
+    ids.resize(count);
+    std::copy_n(data.data() + pos, count * sizeof(int), reinterpret_cast<char*>(ids.data()));
+    pos += count * sizeof(int);
+    return true;
+}
+}
+
+void HotSet::save(const std::string& path) const {
+    std::string data(reinterpret_cast<const char*>(&FORMAT_MAGIC), sizeof(FORMAT_MAGIC));
+    appendIds(data, nodeIds);
+    appendIds(data, edgeIds);
+
+    // Replace atomically so a crash mid-write leaves the previous hot set intact
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size());
+    }
+    std::rename(tmpPath.c_str(), path.c_str());
+}
+
+HotSet HotSet::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    HotSet hotSet;
+    uint32_t magic;
+    if (data.size() < sizeof(magic)) {
+        return hotSet;
+    }
+    std::copy_n(data.data(), sizeof(magic), reinterpret_cast<char*>(&magic));
+    size_t pos = sizeof(magic);
+    if (magic != FORMAT_MAGIC || !readIds(data, pos, hotSet.nodeIds) || !readIds(data, pos, hotSet.edgeIds)) {
+        return HotSet();
+    }
+    return hotSet;
+}
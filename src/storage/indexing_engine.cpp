@@ -1,12 +1,71 @@
 // src/storage/indexing_engine.cpp
 
-#include "include/storage/indexing_engine.hpp"
+#include "storage/indexing_engine.hpp"
+#include "metrics/metrics.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
 #include <stdexcept>
 
-IndexingEngine::IndexingEngine(const std::string& dbPath, int btreeOrder)
-    : dbPath(dbPath) {
-    nodeIndexFile.open(dbPath + "node_index.db", std::ios::in | std::ios::out | std::ios::binary | std::ios::app);
-    edgeIndexFile.open(dbPath + "edge_index.db", std::ios::in | std::ios::out | std::ios::binary | std::ios::app);
+namespace {
+const std::ios::openmode INDEX_FILE_MODE = std::ios::in | std::ios::out | std::ios::binary | std::ios::app;
+// Files with the first magic predate the record counts
+constexpr uint32_t UNCOUNTED_PROPERTY_INDEX_MAGIC = 0x4B504958;  // "KPIX"
+constexpr uint32_t PROPERTY_INDEX_MAGIC = 0x4B504932;            // "KPI2"
+constexpr uint32_t ADJACENCY_INDEX_MAGIC = 0x4B41444A;  // "KADJ"
+
+void writePropertyIndexes(BinaryWriter& writer, const std::vector<PropertyIndex>& indexes,
+                          const PropertyKeyDictionary& dictionary) {
+    writer.writeVarint(indexes.size());
+    for (const PropertyIndex& index : indexes) {
+        // Names rather than key ids, which are only stable as long as property_keys.db is
+        writer.writeString(dictionary.name(index.getKey()));
+        writer.writeByte(static_cast<uint8_t>(index.getType()));
+        index.serialize(writer);
+    }
+}
+
+std::vector<PropertyIndex> readPropertyIndexes(BinaryReader& reader, PropertyKeyDictionary& dictionary) {
+    std::vector<PropertyIndex> indexes;
+    uint64_t count = reader.readVarint();
+    for (uint64_t i = 0; i < count; ++i) {
+        PropertyKey key = dictionary.intern(reader.readString());
+        uint8_t type = reader.readByte();
+        if (type > static_cast<uint8_t>(IndexType::String)) {
+            throw std::runtime_error("Corrupt property index");
+        }
+        indexes.push_back(PropertyIndex::deserialize(key, static_cast<IndexType>(type), reader));
+    }
+    return indexes;
+}
+
+size_t countIds(const BTree& index) {
+    size_t count = 0;
+    index.forEach([&](int, long) { ++count; });
+    return count;
+}
+
+// Writes data beside path and renames it over path, so a crash mid-write
+// leaves the previous file intact
+void replaceFile(const std::string& path, const std::string& data, const std::string& what) {
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size());
+        if (!file) {
+            throw std::runtime_error("Failed to write " + what);
+        }
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Failed to replace " + what);
+    }
+}
+}
+
+IndexingEngine::IndexingEngine(const std::string& dbPath, int btreeOrder, PropertyKeyDictionary& propertyKeys)
+    : propertyIndexesStale(false), adjacencyMissing(false), dbPath(dbPath), propertyKeys(propertyKeys) {
+    nodeIndexFile.open(dbPath + "node_index.db", INDEX_FILE_MODE);
+    edgeIndexFile.open(dbPath + "edge_index.db", INDEX_FILE_MODE);
 
     if (!nodeIndexFile.is_open() || !edgeIndexFile.is_open()) {
         throw std::runtime_error("Failed to open index files");
@@ -26,10 +85,19 @@ IndexingEngine::~IndexingEngine() {
 
 void IndexingEngine::addNodeIndex(int nodeId, long diskOffset) {
     nodeIndex->insert(nodeId, diskOffset);
+    addToFilter(nodeFilter, *nodeIndex, nodeId);
 }
 
 long IndexingEngine::getNodeDiskOffset(int nodeId) {
-    return nodeIndex->search(nodeId);
+    std::optional<long> offset = findNodeDiskOffset(nodeId);
+    if (!offset) {
+        throw std::runtime_error("Key not found");
+    }
+    return *offset;
+}
+
+std::optional<long> IndexingEngine::findNodeDiskOffset(int nodeId) {
+    return lookup(*nodeIndex, nodeFilter, nodeId);
 }
 
 void IndexingEngine::removeNodeIndex(int nodeId) {
@@ -38,16 +106,250 @@ void IndexingEngine::removeNodeIndex(int nodeId) {
 
 void IndexingEngine::addEdgeIndex(int edgeId, long diskOffset) {
     edgeIndex->insert(edgeId, diskOffset);
+    addToFilter(edgeFilter, *edgeIndex, edgeId);
 }
 
 long IndexingEngine::getEdgeDiskOffset(int edgeId) {
-    return edgeIndex->search(edgeId);
+    std::optional<long> offset = findEdgeDiskOffset(edgeId);
+    if (!offset) {
+        throw std::runtime_error("Key not found");
+    }
+    return *offset;
+}
+
+std::optional<long> IndexingEngine::findEdgeDiskOffset(int edgeId) {
+    return lookup(*edgeIndex, edgeFilter, edgeId);
 }
 
 void IndexingEngine::removeEdgeIndex(int edgeId) {
     edgeIndex->remove(edgeId);
 }
 
+int IndexingEngine::getMaxNodeId() const {
+    return nodeIndex->isEmpty() ? -1 : nodeIndex->maxKey();
+}
+
+int IndexingEngine::getMaxEdgeId() const {
+    return edgeIndex->isEmpty() ? -1 : edgeIndex->maxKey();
+}
+
+std::optional<long> IndexingEngine::lookup(const BTree& index, const BloomFilter& filter, int id) {
+    ScopedLatency latency(Histogram::INDEX_LOOKUP);
+    Metrics::increment(Counter::INDEX_LOOKUPS);
+    if (!filter.mayContain(id)) {
+        Metrics::increment(Counter::BLOOM_NEGATIVES);
+        return std::nullopt;
+    }
+    int depth = 0;
+    std::optional<long> offset = index.find(id, depth);
+    Metrics::increment(Counter::INDEX_LOOKUP_LEVELS, depth);
+    if (!offset) {
+        Metrics::increment(Counter::BLOOM_FALSE_POSITIVES);
+    }
+    return offset;
+}
+
+void IndexingEngine::addToFilter(BloomFilter& filter, const BTree& index, int id) {
+    // Rewrites of an existing record re-add its id; skipping keys whose bits
+    // are already set keeps size() close to the number of distinct ids
+    if (filter.mayContain(id)) {
+        return;
+    }
+    if (filter.size() >= filter.capacity()) {
+        // Past its sizing the false-positive rate climbs quickly; double and
+        // refill from the tree, which already holds id
+        filter = rebuildFilter(index, filter.capacity() * 2);
+        return;
+    }
+    filter.insert(id);
+}
+
+BloomFilter IndexingEngine::rebuildFilter(const BTree& index, size_t expectedKeys) {
+    BloomFilter filter(expectedKeys);
+    index.forEach([&](int key, long) {
+        filter.insert(key);
+    });
+    return filter;
+}
+
+BloomFilter IndexingEngine::loadFilter(const std::string& path, const BTree& index) {
+    std::ifstream file(path, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!data.empty()) {
+        try {
+            BloomFilter filter = BloomFilter::deserialize(data);
+            if (filter.size() <= filter.capacity()) {
+                return filter;
+            }
+        } catch (const std::runtime_error&) {
+            // Fall through and rebuild from the index
+        }
+    }
+    size_t keys = 0;
+    index.forEach([&](int, long) { ++keys; });
+    return rebuildFilter(index, std::max<size_t>(1024, keys * 2));
+}
+
+void IndexingEngine::saveFilter(const std::string& path, const BloomFilter& filter) {
+    std::string data = filter.serialize();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), data.size());
+}
+
+void IndexingEngine::saveIndex(std::fstream& file, const std::string& path, const BTree& index) {
+    // Reopen truncated: the file is opened in append mode, where seekp(0) has no effect
+    std::string data = index.serialize();
+    file.close();
+    file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(data.c_str(), data.size());
+    file.close();
+    file.open(path, INDEX_FILE_MODE);
+}
+
+PropertyIndex* IndexingEngine::addNodePropertyIndex(PropertyKey key, IndexType type) {
+    return addPropertyIndex(nodePropertyIndexes, key, type);
+}
+
+PropertyIndex* IndexingEngine::addEdgePropertyIndex(PropertyKey key, IndexType type) {
+    return addPropertyIndex(edgePropertyIndexes, key, type);
+}
+
+const PropertyIndex* IndexingEngine::findNodePropertyIndex(PropertyKey key) const {
+    return findPropertyIndex(nodePropertyIndexes, key);
+}
+
+const PropertyIndex* IndexingEngine::findEdgePropertyIndex(PropertyKey key) const {
+    return findPropertyIndex(edgePropertyIndexes, key);
+}
+
+void IndexingEngine::updateNodeProperties(int nodeId, const PropertyValues& before, const PropertyValues& after) {
+    updateProperties(nodePropertyIndexes, nodeId, before, after);
+}
+
+void IndexingEngine::updateEdgeProperties(int edgeId, const PropertyValues& before, const PropertyValues& after) {
+    updateProperties(edgePropertyIndexes, edgeId, before, after);
+}
+
+PropertyIndex* IndexingEngine::addPropertyIndex(std::vector<PropertyIndex>& indexes, PropertyKey key, IndexType type) {
+    if (const PropertyIndex* existing = findPropertyIndex(indexes, key)) {
+        if (existing->getType() != type) {
+            throw std::invalid_argument("Property already indexed with another type");
+        }
+        return nullptr;
+    }
+    return &indexes.emplace_back(key, type);
+}
+
+const PropertyIndex* IndexingEngine::findPropertyIndex(const std::vector<PropertyIndex>& indexes, PropertyKey key) {
+    // A handful of indexes at most, so a linear search beats hashing
+    auto found = std::find_if(indexes.begin(), indexes.end(),
+                              [key](const PropertyIndex& index) { return index.getKey() == key; });
+    return found == indexes.end() ? nullptr : &*found;
+}
+
+void IndexingEngine::updateProperties(std::vector<PropertyIndex>& indexes, int id, const PropertyValues& before,
+                                      const PropertyValues& after) {
+    static const std::optional<IndexValue> none;
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        indexes[i].update(i < before.size() ? before[i] : none, i < after.size() ? after[i] : none, id);
+    }
+}
+
+void IndexingEngine::loadPropertyIndexes() {
+    std::ifstream file(dbPath + "property_indexes.db", std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.empty()) {
+        return;
+    }
+    // Unlike the filters these cannot be rebuilt without knowing which
+    // properties were indexed, so a damaged file is an error
+    bool current;
+    try {
+        BinaryReader reader(data.data(), data.size());
+        uint64_t magic = reader.readVarint();
+        if (magic != PROPERTY_INDEX_MAGIC && magic != UNCOUNTED_PROPERTY_INDEX_MAGIC) {
+            throw std::runtime_error("Corrupt property index");
+        }
+        // Saved with other id indexes, as when a crash came between the
+        // writes: the entries are stale, though which properties are indexed
+        // still holds
+        current = magic == PROPERTY_INDEX_MAGIC;
+        if (current) {
+            uint64_t nodes = reader.readVarint();
+            uint64_t edges = reader.readVarint();
+            current = nodes == countIds(*nodeIndex) && edges == countIds(*edgeIndex);
+        }
+        nodePropertyIndexes = readPropertyIndexes(reader, propertyKeys);
+        edgePropertyIndexes = readPropertyIndexes(reader, propertyKeys);
+    } catch (const std::runtime_error&) {
+        throw std::runtime_error("Failed to load property indexes");
+    }
+    if (!current) {
+        for (auto* indexes : {&nodePropertyIndexes, &edgePropertyIndexes}) {
+            for (PropertyIndex& index : *indexes) {
+                index = PropertyIndex(index.getKey(), index.getType());
+            }
+        }
+        propertyIndexesStale = true;
+    }
+}
+
+void IndexingEngine::savePropertyIndexes() const {
+    std::string path = dbPath + "property_indexes.db";
+    if (nodePropertyIndexes.empty() && edgePropertyIndexes.empty()) {
+        // Indexes cannot be dropped, so none now means none were ever saved
+        return;
+    }
+    std::string data;
+    BinaryWriter writer(data);
+    writer.writeVarint(PROPERTY_INDEX_MAGIC);
+    writer.writeVarint(countIds(*nodeIndex));
+    writer.writeVarint(countIds(*edgeIndex));
+    writePropertyIndexes(writer, nodePropertyIndexes, propertyKeys);
+    writePropertyIndexes(writer, edgePropertyIndexes, propertyKeys);
+    replaceFile(path, data, "property indexes");
+}
+
+void IndexingEngine::addAdjacency(int edgeId, int sourceNodeId, int targetNodeId, EdgeType type) {
+    outgoingAdjacency.insert(sourceNodeId, type, edgeId, targetNodeId);
+    incomingAdjacency.insert(targetNodeId, type, edgeId, sourceNodeId);
+}
+
+void IndexingEngine::loadAdjacency() {
+    std::ifstream file(dbPath + "adjacency_index.db", std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!data.empty()) {
+        try {
+            BinaryReader reader(data.data(), data.size());
+            if (reader.readVarint() == ADJACENCY_INDEX_MAGIC) {
+                outgoingAdjacency = AdjacencyIndex::deserialize(reader);
+                incomingAdjacency = AdjacencyIndex::deserialize(reader);
+                // Every edge is filed once per direction; anything else means
+                // the file belongs to other data files
+                size_t edges = countIds(*edgeIndex);
+                if (outgoingAdjacency.size() == edges && incomingAdjacency.size() == edges) {
+                    return;
+                }
+            }
+        } catch (const std::runtime_error&) {
+            // Fall through; like the filters it can be rebuilt from the records
+        }
+        outgoingAdjacency = AdjacencyIndex();
+        incomingAdjacency = AdjacencyIndex();
+    }
+    adjacencyMissing = !edgeIndex->isEmpty();
+}
+
+void IndexingEngine::saveAdjacency() const {
+    std::string path = dbPath + "adjacency_index.db";
+    std::string data;
+    BinaryWriter writer(data);
+    writer.writeVarint(ADJACENCY_INDEX_MAGIC);
+    outgoingAdjacency.serialize(writer);
+    incomingAdjacency.serialize(writer);
+    replaceFile(path, data, "adjacency index");
+}
+
 void IndexingEngine::flush() {
     saveIndexes();
 }
@@ -65,18 +367,21 @@ void IndexingEngine::loadIndexes() {
     if (!edgeIndexData.empty()) {
         *edgeIndex = BTree::deserialize(edgeIndexData);
     }
+
+    nodeFilter = loadFilter(dbPath + "node_bloom.db", *nodeIndex);
+    edgeFilter = loadFilter(dbPath + "edge_bloom.db", *edgeIndex);
+    loadPropertyIndexes();
+    loadAdjacency();
 }
 
 void IndexingEngine::saveIndexes() {
-    // Serialize B-trees and write to files
-    std::string nodeIndexData = nodeIndex->serialize();
-    std::string edgeIndexData = edgeIndex->serialize();
-
-    nodeIndexFile.seekp(0);
-    nodeIndexFile.write(nodeIndexData.c_str(), nodeIndexData.size());
-    nodeIndexFile.flush();
-
-    edgeIndexFile.seekp(0);
-    edgeIndexFile.write(edgeIndexData.c_str(), edgeIndexData.size());
-    edgeIndexFile.flush();
-}
\ No newline at end of file
+    // Filters go first: if we stop between the two writes, the persisted filter
+    // is still a superset of the persisted tree, which only costs false positives
+    saveFilter(dbPath + "node_bloom.db", nodeFilter);
+    saveFilter(dbPath + "edge_bloom.db", edgeFilter);
+
+    saveIndex(nodeIndexFile, dbPath + "node_index.db", *nodeIndex);
+    saveIndex(edgeIndexFile, dbPath + "edge_index.db", *edgeIndex);
+    savePropertyIndexes();
+    saveAdjacency();
+}
@@ -0,0 +1,230 @@
+// src/storage/prefetcher.cpp
+
+#include "storage/prefetcher.hpp"
+#include "metrics/metrics.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+// Upper bound on how long an idle worker or a waiting caller sleeps unchecked
+constexpr std::chrono::milliseconds POLL_INTERVAL(50);
+}
+
+Prefetcher::Prefetcher(NodeLoader nodeLoader, EdgeLoader edgeLoader,
+                       size_t workerCount, size_t maxOutstanding)
+    : nodeLoader(std::move(nodeLoader)), edgeLoader(std::move(edgeLoader)),
+      maxOutstanding(maxOutstanding), loading(0), readyCount(0), stopping(false) {
+    for (size_t i = 0; i < std::max<size_t>(1, workerCount); ++i) {
+        workers.emplace_back(&Prefetcher::run, this);
+    }
+}
+
+Prefetcher::~Prefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    loaded.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+size_t Prefetcher::outstandingLocked() const {
+    return tasks.size() + loading + nodes.ready.size() + edges.ready.size();
+}
+
+template<typename T>
+void Prefetcher::enqueueLocked(Slots<T>& slots, const Task& task) {
+    if (slots.inFlight.count(task.id) || slots.ready.count(task.id)) {
+        return;
+    }
+    if (outstandingLocked() >= maxOutstanding) {
+        Metrics::increment(Counter::PREFETCH_DROPPED);
+        return;
+    }
+    slots.inFlight[task.id] = State::QUEUED;
+    tasks.push_back(task);
+    Metrics::increment(Counter::PREFETCH_ISSUED);
+    workAvailable.notify_one();
+}
+
+void Prefetcher::prefetchNode(int nodeId, const PrefetchOptions& expand) {
+    std::lock_guard<std::mutex> lock(mutex);
+    enqueueLocked(nodes, {true, nodeId, expand});
+}
+
+void Prefetcher::prefetchEdge(int edgeId, bool followTarget) {
+    PrefetchOptions options;
+    options.targetNodes = followTarget;
+    std::lock_guard<std::mutex> lock(mutex);
+    enqueueLocked(edges, {false, edgeId, options});
+}
+
+std::vector<int> edgesToPrefetch(const Node& node, const PrefetchOptions& options) {
+    std::vector<int> edgeIds;
+    if (options.edgeType) {
+        const AdjacencyList& edges = node.getOutgoingEdges(*options.edgeType);
+        edgeIds.assign(edges.begin(), std::next(edges.begin(), std::min(edges.size(), options.maxFanOut)));
+        return edgeIds;
+    }
+    for (const AdjacencyPartition& partition : node.getEdgePartitions(true)) {
+        for (int edgeId : partition.edges) {
+            if (edgeIds.size() == options.maxFanOut) {
+                return edgeIds;
+            }
+            edgeIds.push_back(edgeId);
+        }
+    }
+    return edgeIds;
+}
+
+void Prefetcher::expandLocked(const Node& node, const PrefetchOptions& options) {
+    if (!options.edges && !options.targetNodes) {
+        return;
+    }
+    for (int edgeId : edgesToPrefetch(node, options)) {
+        PrefetchOptions edgeOptions;
+        edgeOptions.targetNodes = options.targetNodes;
+        enqueueLocked(edges, {false, edgeId, edgeOptions});
+    }
+}
+
+template<typename T>
+std::shared_ptr<T> Prefetcher::await(Slots<T>& slots, int id) {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        auto ready = slots.ready.find(id);
+        if (ready != slots.ready.end()) {
+            std::shared_ptr<T> record = std::move(ready->second);
+            slots.ready.erase(ready);
+            readyCount.fetch_sub(1, std::memory_order_relaxed);
+            return record;
+        }
+        auto it = slots.inFlight.find(id);
+        if (it == slots.inFlight.end() || stopping) {
+            return nullptr;
+        }
+        if (it->second == State::QUEUED) {
+            // Not started; the worker skips tasks whose slot is gone
+            slots.inFlight.erase(it);
+            return nullptr;
+        }
+        loaded.wait_for(lock, POLL_INTERVAL);
+    }
+}
+
+std::shared_ptr<Node> Prefetcher::awaitNode(int nodeId) {
+    return await(nodes, nodeId);
+}
+
+std::shared_ptr<Edge> Prefetcher::awaitEdge(int edgeId) {
+    return await(edges, edgeId);
+}
+
+void Prefetcher::takeReady(std::vector<std::shared_ptr<Node>>& readyNodes,
+                           std::vector<std::shared_ptr<Edge>>& readyEdges) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& [id, node] : nodes.ready) {
+        readyNodes.push_back(std::move(node));
+    }
+    for (auto& [id, edge] : edges.ready) {
+        readyEdges.push_back(std::move(edge));
+    }
+    nodes.ready.clear();
+    edges.ready.clear();
+    readyCount.store(0, std::memory_order_relaxed);
+}
+
+template<typename T>
+void Prefetcher::invalidate(Slots<T>& slots, int id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (slots.ready.erase(id)) {
+        readyCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+    auto it = slots.inFlight.find(id);
+    if (it != slots.inFlight.end() && it->second == State::LOADING) {
+        it->second = State::STALE;
+    }
+}
+
+void Prefetcher::invalidateNode(int nodeId) {
+    invalidate(nodes, nodeId);
+}
+
+void Prefetcher::invalidateEdge(int edgeId) {
+    invalidate(edges, edgeId);
+}
+
+void Prefetcher::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!loaded.wait_for(lock, POLL_INTERVAL, [this] {
+        return (tasks.empty() && loading == 0) || stopping;
+    })) {}
+}
+
+size_t Prefetcher::outstanding() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return outstandingLocked();
+}
+
+void Prefetcher::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        workAvailable.wait_for(lock, POLL_INTERVAL, [this] {
+            return !tasks.empty() || stopping;
+        });
+        if (stopping) {
+            return;
+        }
+        if (tasks.empty()) {
+            continue;
+        }
+
+        Task task = tasks.front();
+        tasks.pop_front();
+        std::unordered_map<int, State>& inFlight = task.isNode ? nodes.inFlight : edges.inFlight;
+        auto it = inFlight.find(task.id);
+        if (it == inFlight.end() || it->second != State::QUEUED) {
+            continue;  // Cancelled by a caller that loaded it directly
+        }
+        it->second = State::LOADING;
+        ++loading;
+        lock.unlock();
+
+        // Prefetching is best effort: a failed load just leaves the miss to the caller
+        std::shared_ptr<Node> node;
+        std::shared_ptr<Edge> edge;
+        try {
+            if (task.isNode) {
+                node = nodeLoader(task.id);
+            } else {
+                edge = edgeLoader(task.id);
+            }
+        } catch (...) {
+        }
+
+        lock.lock();
+        --loading;
+        it = inFlight.find(task.id);
+        bool stale = it == inFlight.end() || it->second == State::STALE;
+        if (it != inFlight.end()) {
+            inFlight.erase(it);
+        }
+        if (!stale && node) {
+            nodes.ready[task.id] = node;
+            readyCount.fetch_add(1, std::memory_order_relaxed);
+            Metrics::increment(Counter::PREFETCH_LOADED);
+            expandLocked(*node, task.options);
+        } else if (!stale && edge) {
+            edges.ready[task.id] = edge;
+            readyCount.fetch_add(1, std::memory_order_relaxed);
+            Metrics::increment(Counter::PREFETCH_LOADED);
+            if (task.options.targetNodes) {
+                enqueueLocked(nodes, {true, edge->getTargetNodeId(), {}});
+            }
+        }
+        loaded.notify_all();
+    }
+}
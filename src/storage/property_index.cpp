@@ -0,0 +1,235 @@
+// src/storage/property_index.cpp
+
+#include "storage/property_index.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+std::optional<IndexValue> PropertyIndex::normalize(const IndexValue& value) const {
+    switch (type) {
+        case IndexType::Int:
+            if (std::holds_alternative<int>(value)) {
+                return value;
+            }
+            if (const double* number = std::get_if<double>(&value)) {
+                if (*number == std::trunc(*number) && *number >= std::numeric_limits<int>::min() &&
+                    *number <= std::numeric_limits<int>::max()) {
+                    return IndexValue(static_cast<int>(*number));
+                }
+            }
+            return std::nullopt;
+        case IndexType::Double:
+            if (const double* number = std::get_if<double>(&value)) {
+                return std::isnan(*number) ? std::nullopt : std::optional<IndexValue>(value);
+            }
+            if (const int* number = std::get_if<int>(&value)) {
+                return IndexValue(static_cast<double>(*number));
+            }
+            return std::nullopt;
+        case IndexType::String:
+            return std::holds_alternative<std::string>(value) ? std::optional<IndexValue>(value) : std::nullopt;
+    }
+    return std::nullopt;
+}
+
+void PropertyIndex::insert(const IndexValue& value, int id) {
+    std::optional<IndexValue> normal = normalize(value);
+    if (!normal) {
+        return;
+    }
+    bool added = false;
+    switch (type) {
+        case IndexType::Int:
+            added = ints.emplace(std::get<int>(*normal), id).second;
+            break;
+        case IndexType::Double:
+            added = doubles.emplace(std::get<double>(*normal), id).second;
+            break;
+        case IndexType::String: {
+            std::vector<int>& ids = strings[std::get<std::string>(*normal)];
+            auto position = std::lower_bound(ids.begin(), ids.end(), id);
+            added = position == ids.end() || *position != id;
+            if (added) {
+                ids.insert(position, id);
+            }
+            break;
+        }
+    }
+    entries += added;
+}
+
+void PropertyIndex::erase(const IndexValue& value, int id) {
+    std::optional<IndexValue> normal = normalize(value);
+    if (!normal) {
+        return;
+    }
+    bool removed = false;
+    switch (type) {
+        case IndexType::Int:
+            removed = ints.erase({std::get<int>(*normal), id}) != 0;
+            break;
+        case IndexType::Double:
+            removed = doubles.erase({std::get<double>(*normal), id}) != 0;
+            break;
+        case IndexType::String: {
+            auto found = strings.find(std::get<std::string>(*normal));
+            if (found == strings.end()) {
+                break;
+            }
+            std::vector<int>& ids = found->second;
+            auto position = std::lower_bound(ids.begin(), ids.end(), id);
+            removed = position != ids.end() && *position == id;
+            if (removed) {
+                ids.erase(position);
+            }
+            if (ids.empty()) {
+                strings.erase(found);
+            }
+            break;
+        }
+    }
+    entries -= removed;
+}
+
+void PropertyIndex::update(const std::optional<IndexValue>& before, const std::optional<IndexValue>& after, int id) {
+    if (before == after) {
+        return;
+    }
+    if (before) {
+        erase(*before, id);
+    }
+    if (after) {
+        insert(*after, id);
+    }
+}
+
+std::vector<int> PropertyIndex::find(const IndexValue& value) const {
+    std::vector<int> ids;
+    std::optional<IndexValue> normal = normalize(value);
+    if (!normal) {
+        return ids;
+    }
+    switch (type) {
+        case IndexType::Int: {
+            int number = std::get<int>(*normal);
+            for (auto it = ints.lower_bound({number, std::numeric_limits<int>::min()});
+                 it != ints.end() && it->first == number; ++it) {
+                ids.push_back(it->second);
+            }
+            break;
+        }
+        case IndexType::Double: {
+            double number = std::get<double>(*normal);
+            for (auto it = doubles.lower_bound({number, std::numeric_limits<int>::min()});
+                 it != doubles.end() && it->first == number; ++it) {
+                ids.push_back(it->second);
+            }
+            break;
+        }
+        case IndexType::String: {
+            auto found = strings.find(std::get<std::string>(*normal));
+            if (found != strings.end()) {
+                ids = found->second;
+            }
+            break;
+        }
+    }
+    return ids;
+}
+
+std::vector<int> PropertyIndex::range(double low, double high) const {
+    std::vector<int> ids;
+    if (type == IndexType::String) {
+        throw std::invalid_argument("String indexes do not support range scans");
+    }
+    if (!(low <= high)) {
+        return ids;
+    }
+    if (type == IndexType::Int) {
+        // Bounds outside the int range clamp to it
+        double first = std::ceil(std::max(low, static_cast<double>(std::numeric_limits<int>::min())));
+        double last = std::floor(std::min(high, static_cast<double>(std::numeric_limits<int>::max())));
+        if (first > last) {
+            return ids;
+        }
+        auto end = ints.upper_bound({static_cast<int>(last), std::numeric_limits<int>::max()});
+        for (auto it = ints.lower_bound({static_cast<int>(first), std::numeric_limits<int>::min()}); it != end; ++it) {
+            ids.push_back(it->second);
+        }
+        return ids;
+    }
+    auto end = doubles.upper_bound({high, std::numeric_limits<int>::max()});
+    for (auto it = doubles.lower_bound({low, std::numeric_limits<int>::min()}); it != end; ++it) {
+        ids.push_back(it->second);
+    }
+    return ids;
+}
+
+void PropertyIndex::serialize(BinaryWriter& writer) const {
+    writer.writeVarint(entries);
+    switch (type) {
+        case IndexType::Int:
+            for (const auto& [value, id] : ints) {
+                writer.writeSigned(value);
+                writer.writeVarint(id);
+            }
+            break;
+        case IndexType::Double:
+            for (const auto& [value, id] : doubles) {
+                writer.writeDouble(value);
+                writer.writeVarint(id);
+            }
+            break;
+        case IndexType::String:
+            writer.writeVarint(strings.size());
+            for (const auto& [value, ids] : strings) {
+                writer.writeString(value);
+                writer.writeVarint(ids.size());
+                for (int id : ids) {
+                    writer.writeVarint(id);
+                }
+            }
+            break;
+    }
+}
+
+PropertyIndex PropertyIndex::deserialize(PropertyKey key, IndexType type, BinaryReader& reader) {
+    PropertyIndex index(key, type);
+    uint64_t count = reader.readVarint();
+    // Entries were written in index order, so each insert lands at the end
+    switch (type) {
+        case IndexType::Int:
+            for (uint64_t i = 0; i < count; ++i) {
+                int value = static_cast<int>(reader.readSigned());
+                index.ints.emplace_hint(index.ints.end(), value, static_cast<int>(reader.readVarint()));
+            }
+            break;
+        case IndexType::Double:
+            for (uint64_t i = 0; i < count; ++i) {
+                double value = reader.readDouble();
+                index.doubles.emplace_hint(index.doubles.end(), value, static_cast<int>(reader.readVarint()));
+            }
+            break;
+        case IndexType::String: {
+            uint64_t values = reader.readVarint();
+            index.strings.reserve(values);
+            for (uint64_t i = 0; i < values; ++i) {
+                std::vector<int>& ids = index.strings[std::string(reader.readString())];
+                uint64_t idCount = reader.readVarint();
+                for (uint64_t j = 0; j < idCount; ++j) {
+                    ids.push_back(static_cast<int>(reader.readVarint()));
+                }
+            }
+            break;
+        }
+    }
+    index.entries = index.ints.size() + index.doubles.size();
+    for (const auto& [value, ids] : index.strings) {
+        index.entries += ids.size();
+    }
+    if (index.entries != count) {
+        throw std::runtime_error("Corrupt property index");
+    }
+    return index;
+}
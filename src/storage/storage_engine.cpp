@@ -1,140 +1,610 @@
 // src/storage/storage_engine.cpp
 
-#include "include/storage/storage_engine.hpp"
+#include "storage/storage_engine.hpp"
+#include "core/parallel.hpp"
+#include "core/record_codec.hpp"
+#include "storage/mapped_file.hpp"
+#include "metrics/metrics.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
 #include <stdexcept>
+#include <unordered_map>
 
-StorageEngine::StorageEngine(const std::string& dbPath, size_t cacheCapacity, int btreeOrder) {
+namespace {
+// Every file a database keeps beside its path prefix
+const char* const DATABASE_FILES[] = {"nodes.db", "edges.db", "node_index.db", "edge_index.db",
+                                      "property_keys.db", "edge_types.db", "node_bloom.db", "edge_bloom.db",
+                                      "hot_set.db", "property_indexes.db", "adjacency_index.db"};
+
+// Records read per ioMutex hold during warm-up, and cached per request afterwards
+constexpr size_t WARM_UP_BATCH = 64;
+constexpr size_t WARM_UP_INSTALL_BATCH = 256;
+// Fetches between clock reads when a hot-set interval is set
+constexpr size_t HOT_SET_CHECK_PERIOD = 1024;
+// Uncached nodes updateNodes appends per write
+constexpr size_t UPDATE_BATCH_NODES = 4096;
+// Edge records decoded per thread at least during a scan
+constexpr size_t MIN_RECORDS_PER_SCAN_THREAD = 4096;
+
+// Caller holds ioMutex
+std::string readRecord(std::fstream& file, long offset) {
+    file.seekg(offset);
+    int dataLength;
+    file.read(reinterpret_cast<char*>(&dataLength), sizeof(int));
+    std::string data(dataLength, '\0');
+    file.read(&data[0], dataLength);
+    return data;
+}
+
+// Length prefix, then the record encoded in place
+template<typename T>
+void appendRecord(std::string& buffer, const T& record) {
+    size_t lengthPos = buffer.size();
+    buffer.append(sizeof(int), '\0');
+    record.serializeTo(buffer);
+    int dataLength = buffer.size() - lengthPos - sizeof(int);
+    std::memcpy(&buffer[lengthPos], &dataLength, sizeof(int));
+}
+
+template<typename T>
+std::vector<const T*> rawPointers(const std::vector<std::shared_ptr<T>>& records) {
+    std::vector<const T*> pointers;
+    pointers.reserve(records.size());
+    for (const auto& record : records) {
+        pointers.push_back(record.get());
+    }
+    return pointers;
+}
+}
+
+StorageEngine::StorageEngine(const std::string& dbPath, size_t cacheCapacity, int btreeOrder,
+                             EvictionPolicyType evictionPolicy, size_t writeBackThreshold)
+    : dbPath(dbPath), warmUpStopping(false), warmUpPlanned(0), warmUpLoaded(0), warmedAvailable(false),
+      hotSetInterval(0), fetchesSinceHotSetCheck(0) {
     nodesFile.open(dbPath + "nodes.db", std::ios::in | std::ios::out | std::ios::binary | std::ios::app);
     edgesFile.open(dbPath + "edges.db", std::ios::in | std::ios::out | std::ios::binary | std::ios::app);
 
     if (!nodesFile.is_open() || !edgesFile.is_open()) {
         throw std::runtime_error("Failed to open database files");
     }
+    savedPropertyKeys = names.propertyKeys.load(dbPath + "property_keys.db");
+    savedEdgeTypes = names.edgeTypes.load(dbPath + "edge_types.db");
+
+    cacheManager = std::make_unique<CacheManager>(cacheCapacity, evictionPolicy);
+    indexingEngine = std::make_unique<IndexingEngine>(dbPath, btreeOrder, names.propertyKeys);
+    nextNodeId = indexingEngine->getMaxNodeId() + 1;
+    nextEdgeId = indexingEngine->getMaxEdgeId() + 1;
+
+    // Only records absent from the write-back queue are current on disk
+    prefetcher = std::make_unique<Prefetcher>(
+        [this](int nodeId) {
+            return writeBackQueue->findNode(nodeId) ? nullptr : loadNodeFromDisk(nodeId);
+        },
+        [this](int edgeId) {
+            return writeBackQueue->findEdge(edgeId) ? nullptr : loadEdgeFromDisk(edgeId);
+        });
+    writeBackQueue = std::make_unique<WriteBackQueue>(
+        [this](const std::vector<std::shared_ptr<const Node>>& nodes) {
+            writeNodes(rawPointers(nodes));
+        },
+        [this](const std::vector<std::shared_ptr<const Edge>>& edges) {
+            writeEdges(rawPointers(edges));
+        },
+        writeBackThreshold);
+    // Callers may still hold an evicted record and change it while the writer
+    // thread serializes, so the queue gets a copy of its own
+    cacheManager->setWriteBack(
+        [this](std::shared_ptr<Node> node) { writeBackQueue->enqueueNode(std::make_shared<const Node>(*node)); },
+        [this](std::shared_ptr<Edge> edge) { writeBackQueue->enqueueEdge(std::make_shared<const Edge>(*edge)); });
 
-    cacheManager = std::make_unique<CacheManager>(cacheCapacity);
-    indexingEngine = std::make_unique<IndexingEngine>(dbPath, btreeOrder);
+    if (indexingEngine->adjacencyNeedsRebuild()) {
+        for (int edgeId = 0; edgeId < nextEdgeId; ++edgeId) {
+            viewEdge(edgeId, [this](const EdgeView& edge) {
+                indexingEngine->addAdjacency(edge.getId(), edge.getSourceNodeId(), edge.getTargetNodeId(),
+                                             edge.getTypeId());
+            });
+        }
+        indexingEngine->markAdjacencyRebuilt();
+    }
+    if (indexingEngine->propertyIndexesNeedRebuild()) {
+        std::vector<PropertyIndex*> nodeIndexes;
+        for (PropertyIndex& index : indexingEngine->getNodePropertyIndexes()) {
+            nodeIndexes.push_back(&index);
+        }
+        std::vector<PropertyIndex*> edgeIndexes;
+        for (PropertyIndex& index : indexingEngine->getEdgePropertyIndexes()) {
+            edgeIndexes.push_back(&index);
+        }
+        fillNodePropertyIndexes(nodeIndexes);
+        fillEdgePropertyIndexes(edgeIndexes);
+        indexingEngine->markPropertyIndexesRebuilt();
+    }
+
+    HotSet hotSet = HotSet::load(dbPath + "hot_set.db");
+    if (!hotSet.empty()) {
+        warmUpPlanned = hotSet.nodeIds.size() + hotSet.edgeIds.size();
+        Metrics::increment(Counter::WARM_UP_PLANNED, warmUpPlanned);
+        warmUpThread = std::thread(&StorageEngine::runWarmUp, this, std::move(hotSet));
+    }
 }
 
 StorageEngine::~StorageEngine() {
+    warmUpStopping = true;
+    if (warmUpThread.joinable()) {
+        warmUpThread.join();
+    }
+    saveHotSet();
     flush();
+    // Prefetch workers consult the write-back queue, which is idle once flushed
+    prefetcher.reset();
+    writeBackQueue.reset();
     nodesFile.close();
     edgesFile.close();
 }
 
+void StorageEngine::destroy(const std::string& dbPath) {
+    for (const char* name : DATABASE_FILES) {
+        std::remove((dbPath + name).c_str());
+    }
+}
+
 std::shared_ptr<Node> StorageEngine::getNode(int nodeId) {
-    auto cachedNode = cacheManager->getNode(nodeId);
-    if (cachedNode) {
-        return cachedNode;
+    return getNode(nodeId, defaultPrefetch);
+}
+
+std::shared_ptr<Node> StorageEngine::getNode(int nodeId, const PrefetchOptions& prefetch) {
+    auto node = fetchNode(nodeId, prefetch);
+    if (!node) {
+        throw std::runtime_error("Node not found");
     }
-    return loadNodeFromDisk(nodeId);
+    return node;
+}
+
+std::shared_ptr<Node> StorageEngine::tryGetNode(int nodeId) {
+    return fetchNode(nodeId, defaultPrefetch);
+}
+
+std::shared_ptr<Node> StorageEngine::fetchNode(int nodeId, const PrefetchOptions& prefetch) {
+    installPrefetched();
+    installWarmedUp();
+    maybeSaveHotSet();
+    auto node = cacheManager->getNode(nodeId);
+    if (!node) {
+        // Evicted but not yet written back: the queued version is newer than the disk one.
+        // Copy it so the writer thread keeps exclusive use of the queued object.
+        if (auto pending = writeBackQueue->findNode(nodeId)) {
+            node = std::make_shared<Node>(*pending);
+            node->setDirty(false);
+        } else if (!(node = prefetcher->awaitNode(nodeId))) {
+            node = loadNodeFromDisk(nodeId);
+            if (!node) {
+                return nullptr;
+            }
+        }
+        cacheManager->cacheNode(nodeId, node);
+    }
+    schedulePrefetch(*node, prefetch);
+    return node;
 }
 
 void StorageEngine::updateNode(int nodeId, const std::function<void(Node&)>& updateFunc) {
     auto node = getNode(nodeId);
+    IndexingEngine::PropertyValues before = indexingEngine->nodePropertyValues(*node);
     updateFunc(*node);
+    node->setDirty(true);
+    columns.update(*node);
+    indexingEngine->updateNodeProperties(nodeId, before, indexingEngine->nodePropertyValues(*node));
+    changeLog.record(ChangeLog::Kind::NODE, nodeId);
     cacheManager->cacheNode(nodeId, node);
-    // Write to disk during flush
+    // Written back on eviction or during flush
+}
+
+size_t StorageEngine::updateNodes(const std::vector<int>& nodeIds, const std::function<void(Node&)>& updateFunc) {
+    installPrefetched();
+    size_t updated = 0;
+    std::vector<std::shared_ptr<Node>> batch;
+    // Position in batch of each node in it, which is newer than its disk copy
+    std::unordered_map<int, size_t> batched;
+    for (int nodeId : nodeIds) {
+        // Cached and queued nodes are the current copies, so they go through
+        // the cache like any update; the peek leaves the rest untouched
+        if (cacheManager->peekNode(nodeId) || writeBackQueue->findNode(nodeId)) {
+            updateNode(nodeId, updateFunc);
+            ++updated;
+            continue;
+        }
+        auto pending = batched.find(nodeId);
+        std::shared_ptr<Node> node = pending != batched.end() ? batch[pending->second] : loadNodeFromDisk(nodeId);
+        if (!node) {
+            continue;
+        }
+        IndexingEngine::PropertyValues before = indexingEngine->nodePropertyValues(*node);
+        updateFunc(*node);
+        columns.update(*node);
+        indexingEngine->updateNodeProperties(nodeId, before, indexingEngine->nodePropertyValues(*node));
+        changeLog.record(ChangeLog::Kind::NODE, nodeId);
+        if (pending == batched.end()) {
+            batched.emplace(nodeId, batch.size());
+            batch.push_back(std::move(node));
+        }
+        ++updated;
+        if (batch.size() == UPDATE_BATCH_NODES) {
+            writeNodes(rawPointers(batch));
+            batch.clear();
+            batched.clear();
+        }
+    }
+    if (!batch.empty()) {
+        writeNodes(rawPointers(batch));
+    }
+    return updated;
 }
 
-void StorageEngine::addNode(const Node& node) {
+int StorageEngine::addNode(const Node& node) {
     int nodeId = getNextNodeId();
     auto newNode = std::make_shared<Node>(node);
+    newNode->rekey(names);
     newNode->setId(nodeId);
     saveNodeToDisk(*newNode);
+    newNode->setDirty(false);
+    columns.update(*newNode);
+    indexingEngine->updateNodeProperties(nodeId, {}, indexingEngine->nodePropertyValues(*newNode));
+    changeLog.record(ChangeLog::Kind::NODE, nodeId);
     cacheManager->cacheNode(nodeId, newNode);
+    return nodeId;
 }
 
 void StorageEngine::deleteNode(int nodeId) {
     // NOT_IMPLEMENTED
 }
 
+void StorageEngine::addColumn(PropertyKey key, ColumnType type) {
+    bool existing = columns.hasColumn(key);
+    columns.addColumn(key, type);
+    if (existing) {
+        return;
+    }
+    // Views skip decoding the properties no column asks for
+    for (int nodeId = 0; nodeId < nextNodeId; ++nodeId) {
+        viewNode(nodeId, [this](const NodeView& view) { columns.update(view); });
+    }
+}
+
+void StorageEngine::addNodePropertyIndex(PropertyKey key, IndexType type) {
+    if (PropertyIndex* index = indexingEngine->addNodePropertyIndex(key, type)) {
+        fillNodePropertyIndexes({index});
+    }
+}
+
+void StorageEngine::addEdgePropertyIndex(PropertyKey key, IndexType type) {
+    if (PropertyIndex* index = indexingEngine->addEdgePropertyIndex(key, type)) {
+        fillEdgePropertyIndexes({index});
+    }
+}
+
+void StorageEngine::fillNodePropertyIndexes(const std::vector<PropertyIndex*>& indexes) {
+    for (int nodeId = 0; nodeId < nextNodeId; ++nodeId) {
+        viewNode(nodeId, [&](const NodeView& view) {
+            for (PropertyIndex* index : indexes) {
+                if (auto value = index->valueOf(view)) {
+                    index->insert(*value, nodeId);
+                }
+            }
+        });
+    }
+}
+
+void StorageEngine::fillEdgePropertyIndexes(const std::vector<PropertyIndex*>& indexes) {
+    for (int edgeId = 0; edgeId < nextEdgeId; ++edgeId) {
+        viewEdge(edgeId, [&](const EdgeView& view) {
+            for (PropertyIndex* index : indexes) {
+                if (auto value = index->valueOf(view)) {
+                    index->insert(*value, edgeId);
+                }
+            }
+        });
+    }
+}
+
+PropertyKey StorageEngine::indexedKey(std::string_view key) const {
+    std::optional<PropertyKey> handle = names.propertyKeys.find(key);
+    if (!handle) {
+        throw std::invalid_argument("Property is not indexed");
+    }
+    return *handle;
+}
+
+std::vector<int> StorageEngine::findNodesByProperty(PropertyKey key, const IndexValue& value) const {
+    const PropertyIndex* index = indexingEngine->findNodePropertyIndex(key);
+    if (!index) {
+        throw std::invalid_argument("Property is not indexed");
+    }
+    return index->find(value);
+}
+
+std::vector<int> StorageEngine::findNodesInRange(PropertyKey key, double low, double high) const {
+    const PropertyIndex* index = indexingEngine->findNodePropertyIndex(key);
+    if (!index) {
+        throw std::invalid_argument("Property is not indexed");
+    }
+    return index->range(low, high);
+}
+
+std::vector<int> StorageEngine::findEdgesByProperty(PropertyKey key, const IndexValue& value) const {
+    const PropertyIndex* index = indexingEngine->findEdgePropertyIndex(key);
+    if (!index) {
+        throw std::invalid_argument("Property is not indexed");
+    }
+    return index->find(value);
+}
+
+std::vector<int> StorageEngine::findEdgesInRange(PropertyKey key, double low, double high) const {
+    const PropertyIndex* index = indexingEngine->findEdgePropertyIndex(key);
+    if (!index) {
+        throw std::invalid_argument("Property is not indexed");
+    }
+    return index->range(low, high);
+}
+
+bool StorageEngine::viewNode(int nodeId, const std::function<void(const NodeView&)>& visit) {
+    std::string buffer;
+    std::shared_ptr<const Node> node = cacheManager->getNode(nodeId);
+    if (!node) {
+        node = writeBackQueue->findNode(nodeId);
+    }
+    if (node) {
+        node->serializeTo(buffer);
+    } else if (auto record = readNodeRecord(nodeId)) {
+        buffer = std::move(*record);
+        if (!isBinaryRecord(buffer.data(), buffer.size())) {
+            buffer = Node::deserialize(buffer, names).serialize();
+        }
+    } else {
+        return false;
+    }
+    visit(NodeView(buffer, names));
+    return true;
+}
+
+void StorageEngine::scanNodes(const std::function<void(size_t, const NodeView&)>& visit, size_t threadCount) {
+    flush();
+    std::vector<long> offsets;
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        indexingEngine->forEachNode([&](int, long offset) { offsets.push_back(offset); });
+    }
+    scanRecords<Node>("nodes.db", offsets, visit, threadCount);
+}
+
+std::optional<std::string> StorageEngine::readNodeRecord(int nodeId) {
+    std::string serializedData;
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        std::optional<long> offset = indexingEngine->findNodeDiskOffset(nodeId);
+        if (!offset) {
+            return std::nullopt;
+        }
+
+        ScopedLatency latency(Histogram::NODE_DISK_READ);
+        serializedData = readRecord(nodesFile, *offset);
+    }
+    Metrics::increment(Counter::BYTES_READ, sizeof(int) + serializedData.size());
+    return serializedData;
+}
+
 std::shared_ptr<Node> StorageEngine::loadNodeFromDisk(int nodeId) {
-    long offset = indexingEngine->getNodeDiskOffset(nodeId);
-    if (offset == -1) {
-        throw std::runtime_error("Node not found");
+    std::optional<std::string> serializedData = readNodeRecord(nodeId);
+    if (!serializedData) {
+        return nullptr;
     }
-    
-    nodesFile.seekg(offset);
-    
-    // Read the serialized data length
-    int dataLength;
-    nodesFile.read(reinterpret_cast<char*>(&dataLength), sizeof(int));
-    
-    // Read the serialized node data
-    std::string serializedData(dataLength, '\0');
-    nodesFile.read(&serializedData[0], dataLength);
-    
+
     // Deserialize node data
-    Node deserializedNode = Node::deserialize(serializedData);
-    
+    ScopedLatency latency(Histogram::NODE_DESERIALIZE);
+    Node deserializedNode = Node::deserialize(*serializedData, names);
+
     // Create and return a shared pointer to the deserialized node
-    return std::make_shared<Node>(std::move(deserializedNode));
+    auto node = std::make_shared<Node>(std::move(deserializedNode));
+    node->setDirty(false);  // The node just loaded from disk is not dirty
+    return node;
 }
 
 void StorageEngine::saveNodeToDisk(const Node& node) {
+    writeNodes({&node});
+}
+
+void StorageEngine::writeNodes(const std::vector<const Node*>& nodes) {
+    // Serialize outside the lock, then append the whole batch with one write
+    std::string buffer;
+    std::vector<std::pair<int, long>> relativeOffsets;
+    relativeOffsets.reserve(nodes.size());
+    for (const Node* node : nodes) {
+        relativeOffsets.emplace_back(node->getId(), buffer.size());
+        appendRecord(buffer, *node);
+    }
+
+    std::lock_guard<std::mutex> lock(ioMutex);
+    saveNames();
     nodesFile.seekp(0, std::ios::end);
-    long offset = nodesFile.tellp();
-    
-    // Serialize node data
-    std::string serializedData = node.serialize();
-    
-    // Write the length of the serialized data
-    int dataLength = serializedData.length();
-    nodesFile.write(reinterpret_cast<const char*>(&dataLength), sizeof(int));
-    
-    // Write the serialized node data to disk
-    nodesFile.write(serializedData.c_str(), serializedData.length());
-    
-    // Update the index
-    indexingEngine->addNodeIndex(node.getId(), offset);
+    long base = nodesFile.tellp();
+    nodesFile.write(buffer.data(), buffer.size());
+    Metrics::increment(Counter::BYTES_WRITTEN, buffer.size());
+
+    // Update the index; an in-flight prefetch may have read the old version
+    for (const auto& [nodeId, offset] : relativeOffsets) {
+        indexingEngine->addNodeIndex(nodeId, base + offset);
+        prefetcher->invalidateNode(nodeId);
+    }
 }
 
 std::shared_ptr<Edge> StorageEngine::getEdge(int edgeId) {
+    auto edge = fetchEdge(edgeId);
+    if (!edge) {
+        throw std::runtime_error("Edge not found");
+    }
+    return edge;
+}
+
+std::shared_ptr<Edge> StorageEngine::tryGetEdge(int edgeId) {
+    return fetchEdge(edgeId);
+}
+
+std::shared_ptr<Edge> StorageEngine::fetchEdge(int edgeId) {
+    installPrefetched();
+    installWarmedUp();
+    maybeSaveHotSet();
     auto cachedEdge = cacheManager->getEdge(edgeId);
     if (cachedEdge) {
         return cachedEdge;
     }
-    return loadEdgeFromDisk(edgeId);
+    std::shared_ptr<Edge> edge;
+    if (auto pending = writeBackQueue->findEdge(edgeId)) {
+        edge = std::make_shared<Edge>(*pending);
+        edge->setDirty(false);
+    } else if (!(edge = prefetcher->awaitEdge(edgeId))) {
+        edge = loadEdgeFromDisk(edgeId);
+        if (!edge) {
+            return nullptr;
+        }
+    }
+    cacheManager->cacheEdge(edgeId, edge);
+    return edge;
 }
 
 void StorageEngine::updateEdge(int edgeId, const std::function<void(Edge&)>& updateFunc) {
     auto edge = getEdge(edgeId);
+    IndexingEngine::PropertyValues before = indexingEngine->edgePropertyValues(*edge);
     updateFunc(*edge);
+    edge->setDirty(true);
+    indexingEngine->updateEdgeProperties(edgeId, before, indexingEngine->edgePropertyValues(*edge));
+    changeLog.record(ChangeLog::Kind::EDGE, edgeId);
     cacheManager->cacheEdge(edgeId, edge);
-    // Write to disk during flush
+    // Written back on eviction or during flush
 }
 
-void StorageEngine::addEdge(const Edge& edge) {
+int StorageEngine::addEdge(const Edge& edge) {
     int edgeId = getNextEdgeId();
     auto newEdge = std::make_shared<Edge>(edge);
+    newEdge->rekey(names);
     newEdge->setId(edgeId);
     saveEdgeToDisk(*newEdge);
+    indexingEngine->addAdjacency(edgeId, newEdge->getSourceNodeId(), newEdge->getTargetNodeId(),
+                                 newEdge->getTypeId());
+    indexingEngine->updateEdgeProperties(edgeId, {}, indexingEngine->edgePropertyValues(*newEdge));
+    changeLog.record(ChangeLog::Kind::EDGE, edgeId);
     cacheManager->cacheEdge(edgeId, newEdge);
+    return edgeId;
+}
+
+const std::vector<Neighbor>& StorageEngine::getOutgoingNeighbors(int nodeId, std::string_view type) const {
+    static const std::vector<Neighbor> none;
+    std::optional<EdgeType> typeId = names.edgeTypes.find(type);
+    return typeId ? getOutgoingNeighbors(nodeId, *typeId) : none;
+}
+
+const std::vector<Neighbor>& StorageEngine::getIncomingNeighbors(int nodeId, std::string_view type) const {
+    static const std::vector<Neighbor> none;
+    std::optional<EdgeType> typeId = names.edgeTypes.find(type);
+    return typeId ? getIncomingNeighbors(nodeId, *typeId) : none;
 }
 
 void StorageEngine::deleteEdge(int edgeId) {
     // NOT_IMPLEMENTED
 }
 
+bool StorageEngine::viewEdge(int edgeId, const std::function<void(const EdgeView&)>& visit) {
+    std::string buffer;
+    std::shared_ptr<const Edge> edge = cacheManager->getEdge(edgeId);
+    if (!edge) {
+        edge = writeBackQueue->findEdge(edgeId);
+    }
+    if (edge) {
+        edge->serializeTo(buffer);
+    } else if (auto record = readEdgeRecord(edgeId)) {
+        buffer = std::move(*record);
+        if (!isBinaryRecord(buffer.data(), buffer.size())) {
+            buffer = Edge::deserialize(buffer, names).serialize();
+        }
+    } else {
+        return false;
+    }
+    visit(EdgeView(buffer, names));
+    return true;
+}
+
+void StorageEngine::scanEdges(const std::function<void(size_t, const EdgeView&)>& visit, size_t threadCount) {
+    flush();
+    std::vector<long> offsets;
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        indexingEngine->forEachEdge([&](int, long offset) { offsets.push_back(offset); });
+    }
+    scanRecords<Edge>("edges.db", offsets, visit, threadCount);
+}
+
+template<typename T, typename View>
+void StorageEngine::scanRecords(const std::string& fileName, const std::vector<long>& offsets,
+                                const std::function<void(size_t, const View&)>& visit, size_t threadCount) {
+    if (offsets.empty()) {
+        return;
+    }
+
+    // Nothing appends to the file until the scan returns: the caller's thread
+    // is here and the write-back queue was drained by flush
+    MappedFile file(dbPath + fileName);
+    threadCount = threadCountFor(threadCount, offsets.size(), MIN_RECORDS_PER_SCAN_THREAD);
+    runParallel(threadCount, [&](size_t thread) {
+        auto [begin, end] = sliceOf(offsets.size(), threadCount, thread);
+        std::string converted;
+        for (size_t i = begin; i < end; ++i) {
+            size_t available = static_cast<size_t>(offsets[i]) < file.size() ? file.size() - offsets[i] : 0;
+            int dataLength = -1;
+            if (available >= sizeof(int)) {
+                std::memcpy(&dataLength, file.data() + offsets[i], sizeof(int));
+            }
+            if (dataLength < 0 || static_cast<size_t>(dataLength) > available - sizeof(int)) {
+                throw std::runtime_error("Record truncated in " + fileName);
+            }
+            const char* data = file.data() + offsets[i] + sizeof(int);
+            if (isBinaryRecord(data, dataLength)) {
+                visit(thread, View(data, dataLength, names));
+            } else {
+                converted.clear();
+                T::deserialize(data, dataLength, names).serializeTo(converted);
+                visit(thread, View(converted, names));
+            }
+        }
+    });
+}
+
+std::optional<std::string> StorageEngine::readEdgeRecord(int edgeId) {
+    std::string serializedData;
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        std::optional<long> offset = indexingEngine->findEdgeDiskOffset(edgeId);
+        if (!offset) {
+            return std::nullopt;
+        }
+
+        ScopedLatency latency(Histogram::EDGE_DISK_READ);
+        serializedData = readRecord(edgesFile, *offset);
+    }
+    Metrics::increment(Counter::BYTES_READ, sizeof(int) + serializedData.size());
+    return serializedData;
+}
+
 std::shared_ptr<Edge> StorageEngine::loadEdgeFromDisk(int edgeId) {
-    long offset = indexingEngine->getEdgeDiskOffset(edgeId);
-    if (offset == -1) {
-        throw std::runtime_error("Edge not found");
+    std::optional<std::string> serializedData = readEdgeRecord(edgeId);
+    if (!serializedData) {
+        return nullptr;
     }
-    
-    edgesFile.seekg(offset);
-    
-    // Read the serialized data length
-    int dataLength;
-    edgesFile.read(reinterpret_cast<char*>(&dataLength), sizeof(int));
-    
-    // Read the serialized edge data
-    std::string serializedData(dataLength, '\0');
-    edgesFile.read(&serializedData[0], dataLength);
-    
+
     // Deserialize edge data
-    Edge deserializedEdge = Edge::deserialize(serializedData);
-    
+    ScopedLatency latency(Histogram::EDGE_DESERIALIZE);
+    Edge deserializedEdge = Edge::deserialize(*serializedData, names);
+
     // Create and return a shared pointer to the deserialized edge
     auto edge = std::make_shared<Edge>(std::move(deserializedEdge));
     edge->setDirty(false);  // The edge just loaded from disk is not dirty
@@ -142,38 +612,300 @@ std::shared_ptr<Edge> StorageEngine::loadEdgeFromDisk(int edgeId) {
 }
 
 void StorageEngine::saveEdgeToDisk(const Edge& edge) {
-    edgesFile.seekp(0, std::ios::end);
-    long offset = edgesFile.tellp();
-    
-    // Serialize edge data
-    std::string serializedData = edge.serialize();
-    
-    // Write the length of the serialized data
-    int dataLength = serializedData.length();
-    edgesFile.write(reinterpret_cast<const char*>(&dataLength), sizeof(int));
-    
-    // Write the serialized edge data to disk
-    edgesFile.write(serializedData.c_str(), serializedData.length());
-    
-    // Update the index
-    indexingEngine->addEdgeIndex(edge.getId(), offset);
-    
+    writeEdges({&edge});
+
     // After saving, the edge is no longer dirty
     const_cast<Edge&>(edge).setDirty(false);
 }
 
+void StorageEngine::writeEdges(const std::vector<const Edge*>& edges) {
+    std::string buffer;
+    std::vector<std::pair<int, long>> relativeOffsets;
+    relativeOffsets.reserve(edges.size());
+    for (const Edge* edge : edges) {
+        relativeOffsets.emplace_back(edge->getId(), buffer.size());
+        appendRecord(buffer, *edge);
+    }
+
+    std::lock_guard<std::mutex> lock(ioMutex);
+    saveNames();
+    edgesFile.seekp(0, std::ios::end);
+    long base = edgesFile.tellp();
+    edgesFile.write(buffer.data(), buffer.size());
+    Metrics::increment(Counter::BYTES_WRITTEN, buffer.size());
+
+    // Update the index
+    for (const auto& [edgeId, offset] : relativeOffsets) {
+        indexingEngine->addEdgeIndex(edgeId, base + offset);
+        prefetcher->invalidateEdge(edgeId);
+    }
+}
+
+void StorageEngine::saveNames() {
+    // Names are only ever appended, so a larger table means new names
+    const PropertyKeyDictionary& dictionary = names.propertyKeys;
+    size_t keyCount = dictionary.size();
+    if (keyCount != savedPropertyKeys) {
+        dictionary.save(dbPath + "property_keys.db");
+        savedPropertyKeys = keyCount;
+    }
+    const EdgeTypeRegistry& registry = names.edgeTypes;
+    size_t typeCount = registry.size();
+    if (typeCount != savedEdgeTypes) {
+        registry.save(dbPath + "edge_types.db");
+        savedEdgeTypes = typeCount;
+    }
+}
+
 void StorageEngine::flush() {
-    // Flush cached nodes and edges to disk
+    // Wait for evicted records still queued, then write dirty cached ones. A
+    // cached record is never older than a queued one with the same id (it was
+    // copied from the queue or written after), so the cached version has to be
+    // appended last to stay the indexed one.
+    writeBackQueue->drain();
+    std::vector<std::shared_ptr<Node>> dirtyNodes;
+    cacheManager->forEachNode([&](const std::shared_ptr<Node>& node) {
+        if (node->isDirty()) {
+            dirtyNodes.push_back(node);
+        }
+    });
+    std::vector<std::shared_ptr<Edge>> dirtyEdges;
+    cacheManager->forEachEdge([&](const std::shared_ptr<Edge>& edge) {
+        if (edge->isDirty()) {
+            dirtyEdges.push_back(edge);
+        }
+    });
+    if (!dirtyNodes.empty()) {
+        writeNodes(rawPointers(dirtyNodes));
+    }
+    if (!dirtyEdges.empty()) {
+        writeEdges(rawPointers(dirtyEdges));
+    }
+    for (const auto& node : dirtyNodes) {
+        node->setDirty(false);
+    }
+    for (const auto& edge : dirtyEdges) {
+        edge->setDirty(false);
+    }
+
     // Update indexes
+    std::lock_guard<std::mutex> lock(ioMutex);
+    nodesFile.flush();
+    edgesFile.flush();
     indexingEngine->flush();
 }
 
+void StorageEngine::setCacheHighWatermark(double fraction, CacheManager::WatermarkCallback callback) {
+    cacheManager->setHighWatermark(fraction, std::move(callback));
+}
+
+void StorageEngine::setPrefetchOptions(const PrefetchOptions& options) {
+    defaultPrefetch = options;
+}
+
+void StorageEngine::prefetchNodes(const std::vector<int>& nodeIds, const PrefetchOptions& prefetch) {
+    for (int nodeId : nodeIds) {
+        if (auto cached = cacheManager->peekNode(nodeId)) {
+            schedulePrefetch(*cached, prefetch);
+        } else {
+            prefetcher->prefetchNode(nodeId, prefetch);
+        }
+    }
+}
+
+void StorageEngine::waitForPrefetch() {
+    prefetcher->waitIdle();
+    installPrefetched();
+}
+
+void StorageEngine::installPrefetched() {
+    if (!prefetcher->hasReady()) {
+        return;
+    }
+    std::vector<std::shared_ptr<Node>> nodes;
+    std::vector<std::shared_ptr<Edge>> edges;
+    prefetcher->takeReady(nodes, edges);
+    // Never replace a resident or queued record: it may be newer than the disk copy
+    for (auto& node : nodes) {
+        int nodeId = node->getId();
+        if (!cacheManager->peekNode(nodeId) && !writeBackQueue->findNode(nodeId)) {
+            cacheManager->cacheNode(nodeId, std::move(node));
+        }
+    }
+    for (auto& edge : edges) {
+        int edgeId = edge->getId();
+        if (!cacheManager->peekEdge(edgeId) && !writeBackQueue->findEdge(edgeId)) {
+            cacheManager->cacheEdge(edgeId, std::move(edge));
+        }
+    }
+}
+
+void StorageEngine::schedulePrefetch(const Node& node, const PrefetchOptions& prefetch) {
+    if (!prefetch.edges && !prefetch.targetNodes) {
+        return;
+    }
+    for (int edgeId : edgesToPrefetch(node, prefetch)) {
+        auto cachedEdge = cacheManager->peekEdge(edgeId);
+        if (!cachedEdge) {
+            prefetcher->prefetchEdge(edgeId, prefetch.targetNodes);
+        } else if (prefetch.targetNodes && !cacheManager->peekNode(cachedEdge->getTargetNodeId())) {
+            prefetcher->prefetchNode(cachedEdge->getTargetNodeId());
+        }
+    }
+}
+
+void StorageEngine::saveHotSet() {
+    HotSet hotSet;
+    hotSet.nodeIds = cacheManager->hotNodeIds(SIZE_MAX);
+    hotSet.edgeIds = cacheManager->hotEdgeIds(SIZE_MAX);
+    hotSet.save(dbPath + "hot_set.db");
+    lastHotSetSave = std::chrono::steady_clock::now();
+}
+
+void StorageEngine::setHotSetInterval(std::chrono::milliseconds interval) {
+    hotSetInterval = interval;
+    lastHotSetSave = std::chrono::steady_clock::now();
+}
+
+void StorageEngine::maybeSaveHotSet() {
+    if (hotSetInterval.count() == 0 || ++fetchesSinceHotSetCheck < HOT_SET_CHECK_PERIOD) {
+        return;
+    }
+    fetchesSinceHotSetCheck = 0;
+    if (std::chrono::steady_clock::now() - lastHotSetSave >= hotSetInterval) {
+        saveHotSet();
+    }
+}
+
+double StorageEngine::warmUpProgress() const {
+    size_t planned = warmUpPlanned.load();
+    return planned == 0 ? 1.0 : static_cast<double>(warmUpLoaded.load()) / planned;
+}
+
+void StorageEngine::waitForWarmUp() {
+    if (warmUpThread.joinable()) {
+        warmUpThread.join();
+    }
+    while (warmedAvailable) {
+        installWarmedUp();
+    }
+}
+
+void StorageEngine::runWarmUp(HotSet hotSet) {
+    // Resolve every offset first so each batch is a forward sweep through the file
+    std::vector<std::pair<long, int>> nodeOffsets;
+    std::vector<std::pair<long, int>> edgeOffsets;
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        for (int nodeId : hotSet.nodeIds) {
+            if (auto offset = indexingEngine->findNodeDiskOffset(nodeId)) {
+                nodeOffsets.emplace_back(*offset, nodeId);
+            }
+        }
+        for (int edgeId : hotSet.edgeIds) {
+            if (auto offset = indexingEngine->findEdgeDiskOffset(edgeId)) {
+                edgeOffsets.emplace_back(*offset, edgeId);
+            }
+        }
+    }
+    // Ids that no longer exist count as done
+    size_t missing = warmUpPlanned - nodeOffsets.size() - edgeOffsets.size();
+    warmUpLoaded += missing;
+    Metrics::increment(Counter::WARM_UP_LOADED, missing);
+
+    std::sort(nodeOffsets.begin(), nodeOffsets.end());
+    std::sort(edgeOffsets.begin(), edgeOffsets.end());
+    warmUpRecords(nodesFile, nodeOffsets, warmedNodes);
+    warmUpRecords(edgesFile, edgeOffsets, warmedEdges);
+}
+
+template<typename T>
+void StorageEngine::warmUpRecords(std::fstream& file, const std::vector<std::pair<long, int>>& offsets,
+                                  std::vector<WarmedRecord<T>>& warmed) {
+    for (size_t start = 0; start < offsets.size() && !warmUpStopping; start += WARM_UP_BATCH) {
+        size_t end = std::min(offsets.size(), start + WARM_UP_BATCH);
+        std::vector<std::string> serialized;
+        serialized.reserve(end - start);
+        {
+            std::lock_guard<std::mutex> lock(ioMutex);
+            for (size_t i = start; i < end; ++i) {
+                serialized.push_back(readRecord(file, offsets[i].first));
+            }
+        }
+
+        std::vector<WarmedRecord<T>> batch;
+        batch.reserve(serialized.size());
+        size_t bytes = 0;
+        for (size_t i = 0; i < serialized.size(); ++i) {
+            bytes += sizeof(int) + serialized[i].size();
+            auto record = std::make_shared<T>(T::deserialize(serialized[i], names));
+            record->setDirty(false);
+            batch.push_back({std::move(record), offsets[start + i].first});
+        }
+        Metrics::increment(Counter::BYTES_READ, bytes);
+
+        {
+            std::lock_guard<std::mutex> lock(warmUpMutex);
+            std::move(batch.begin(), batch.end(), std::back_inserter(warmed));
+            warmedAvailable = true;
+        }
+        warmUpLoaded += end - start;
+        Metrics::increment(Counter::WARM_UP_LOADED, end - start);
+    }
+}
+
+void StorageEngine::installWarmedUp() {
+    if (!warmedAvailable.load(std::memory_order_relaxed)) {
+        return;
+    }
+    std::vector<WarmedRecord<Node>> nodes;
+    std::vector<WarmedRecord<Edge>> edges;
+    {
+        std::lock_guard<std::mutex> lock(warmUpMutex);
+        size_t nodeCount = std::min(warmedNodes.size(), WARM_UP_INSTALL_BATCH);
+        nodes.assign(std::make_move_iterator(warmedNodes.end() - nodeCount),
+                     std::make_move_iterator(warmedNodes.end()));
+        warmedNodes.resize(warmedNodes.size() - nodeCount);
+        size_t edgeCount = std::min(warmedEdges.size(), WARM_UP_INSTALL_BATCH - nodeCount);
+        edges.assign(std::make_move_iterator(warmedEdges.end() - edgeCount),
+                     std::make_move_iterator(warmedEdges.end()));
+        warmedEdges.resize(warmedEdges.size() - edgeCount);
+        warmedAvailable = !warmedNodes.empty() || !warmedEdges.empty();
+    }
+
+    // A resident or queued version is newer. Otherwise disk holds the latest
+    // version, and it is ours only if the index still points where we read.
+    nodes.erase(std::remove_if(nodes.begin(), nodes.end(), [&](const WarmedRecord<Node>& warmed) {
+        int nodeId = warmed.record->getId();
+        return cacheManager->peekNode(nodeId) || writeBackQueue->findNode(nodeId);
+    }), nodes.end());
+    edges.erase(std::remove_if(edges.begin(), edges.end(), [&](const WarmedRecord<Edge>& warmed) {
+        int edgeId = warmed.record->getId();
+        return cacheManager->peekEdge(edgeId) || writeBackQueue->findEdge(edgeId);
+    }), edges.end());
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        nodes.erase(std::remove_if(nodes.begin(), nodes.end(), [&](const WarmedRecord<Node>& warmed) {
+            return indexingEngine->findNodeDiskOffset(warmed.record->getId()) != warmed.offset;
+        }), nodes.end());
+        edges.erase(std::remove_if(edges.begin(), edges.end(), [&](const WarmedRecord<Edge>& warmed) {
+            return indexingEngine->findEdgeDiskOffset(warmed.record->getId()) != warmed.offset;
+        }), edges.end());
+    }
+    for (auto& warmed : nodes) {
+        int nodeId = warmed.record->getId();
+        cacheManager->cacheNode(nodeId, std::move(warmed.record));
+    }
+    for (auto& warmed : edges) {
+        int edgeId = warmed.record->getId();
+        cacheManager->cacheEdge(edgeId, std::move(warmed.record));
+    }
+}
+
 int StorageEngine::getNextNodeId() {
-    // NOT_IMPLEMENTED
-    return 0;
+    return nextNodeId++;
 }
 
 int StorageEngine::getNextEdgeId() {
-    // NOT_IMPLEMENTED
-    return 0;
-}
\ No newline at end of file
+    return nextEdgeId++;
+}
@@ -0,0 +1,168 @@
+// src/storage/write_back_queue.cpp
+
+#include "storage/write_back_queue.hpp"
+#include "metrics/metrics.hpp"
+
+namespace {
+// Upper bound on how long a queued record or a waiting caller sleeps unchecked
+constexpr std::chrono::milliseconds POLL_INTERVAL(50);
+}
+
+WriteBackQueue::WriteBackQueue(NodeBatchWriter nodeWriter, EdgeBatchWriter edgeWriter,
+                               size_t maxPendingBytes, size_t maxBatchSize)
+    : nodeWriter(std::move(nodeWriter)), edgeWriter(std::move(edgeWriter)),
+      maxPendingBytes(maxPendingBytes), maxBatchSize(maxBatchSize),
+      queuedBytes(0), writing(false), stopping(false) {
+    worker = std::thread(&WriteBackQueue::run, this);
+}
+
+WriteBackQueue::~WriteBackQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    spaceAvailable.notify_all();
+    worker.join();
+}
+
+void WriteBackQueue::waitForSpace(std::unique_lock<std::mutex>& lock) {
+    if (queuedBytes > maxPendingBytes && !stopping) {
+        Metrics::increment(Counter::WRITE_BACK_STALLS);
+        while (!spaceAvailable.wait_for(lock, POLL_INTERVAL, [this] {
+            return queuedBytes <= maxPendingBytes || writerError || stopping;
+        })) {}
+    }
+}
+
+void WriteBackQueue::enqueueNode(std::shared_ptr<const Node> node) {
+    int nodeId = node->getId();
+    size_t bytes = node->memoryUsage();
+    std::unique_lock<std::mutex> lock(mutex);
+    waitForSpace(lock);
+    auto it = nodes.find(nodeId);
+    if (it != nodes.end()) {
+        queuedBytes -= it->second.bytes;
+    }
+    nodes[nodeId] = {std::move(node), bytes};
+    queuedBytes += bytes;
+    workAvailable.notify_one();
+}
+
+void WriteBackQueue::enqueueEdge(std::shared_ptr<const Edge> edge) {
+    int edgeId = edge->getId();
+    size_t bytes = edge->memoryUsage();
+    std::unique_lock<std::mutex> lock(mutex);
+    waitForSpace(lock);
+    auto it = edges.find(edgeId);
+    if (it != edges.end()) {
+        queuedBytes -= it->second.bytes;
+    }
+    edges[edgeId] = {std::move(edge), bytes};
+    queuedBytes += bytes;
+    workAvailable.notify_one();
+}
+
+std::shared_ptr<const Node> WriteBackQueue::findNode(int nodeId) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = nodes.find(nodeId);
+    return it != nodes.end() ? it->second.record : nullptr;
+}
+
+std::shared_ptr<const Edge> WriteBackQueue::findEdge(int edgeId) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = edges.find(edgeId);
+    return it != edges.end() ? it->second.record : nullptr;
+}
+
+void WriteBackQueue::drain() {
+    std::unique_lock<std::mutex> lock(mutex);
+    workAvailable.notify_one();
+    while (!spaceAvailable.wait_for(lock, POLL_INTERVAL, [this] {
+        return (nodes.empty() && edges.empty() && !writing) || writerError || stopping;
+    })) {}
+    if (writerError) {
+        std::exception_ptr error = writerError;
+        writerError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+size_t WriteBackQueue::pendingBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queuedBytes;
+}
+
+size_t WriteBackQueue::pendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return nodes.size() + edges.size();
+}
+
+void WriteBackQueue::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        workAvailable.wait_for(lock, POLL_INTERVAL, [this] {
+            return ((!nodes.empty() || !edges.empty()) && !writerError) || stopping;
+        });
+        if (nodes.empty() && edges.empty()) {
+            if (stopping) {
+                return;
+            }
+            continue;
+        }
+        if (writerError) {
+            if (stopping) {
+                return;  // Give up on records we already failed to write
+            }
+            continue;
+        }
+
+        // Records stay queued (and findable) while the batch is written
+        std::vector<std::shared_ptr<const Node>> nodeBatch;
+        std::vector<std::shared_ptr<const Edge>> edgeBatch;
+        for (auto it = nodes.begin(); it != nodes.end() && nodeBatch.size() < maxBatchSize; ++it) {
+            nodeBatch.push_back(it->second.record);
+        }
+        for (auto it = edges.begin(); it != edges.end() && edgeBatch.size() < maxBatchSize; ++it) {
+            edgeBatch.push_back(it->second.record);
+        }
+        writing = true;
+        lock.unlock();
+
+        std::exception_ptr error;
+        try {
+            if (!nodeBatch.empty()) {
+                nodeWriter(nodeBatch);
+            }
+            if (!edgeBatch.empty()) {
+                edgeWriter(edgeBatch);
+            }
+            Metrics::increment(Counter::WRITE_BACK_RECORDS, nodeBatch.size() + edgeBatch.size());
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        writing = false;
+        if (error) {
+            writerError = error;
+        } else {
+            // A newer version re-queued during the write stays for the next batch
+            for (const auto& node : nodeBatch) {
+                auto it = nodes.find(node->getId());
+                if (it != nodes.end() && it->second.record == node) {
+                    queuedBytes -= it->second.bytes;
+                    nodes.erase(it);
+                }
+            }
+            for (const auto& edge : edgeBatch) {
+                auto it = edges.find(edge->getId());
+                if (it != edges.end() && it->second.record == edge) {
+                    queuedBytes -= it->second.bytes;
+                    edges.erase(it);
+                }
+            }
+        }
+        spaceAvailable.notify_all();
+    }
+}
@@ -0,0 +1,160 @@
+// tests/cache/test_cache_manager.cpp
+#include <gtest/gtest.h>
+#include "cache/cache_manager.hpp"
+
+class CacheManagerTest : public ::testing::Test {
+protected:
+    static std::shared_ptr<Node> makeNode(int id, int edgeCount = 0) {
+        auto node = std::make_shared<Node>(id);
+        for (int i = 0; i < edgeCount; ++i) {
+            node->addEdge(i, true);
+        }
+        return node;
+    }
+};
+
+TEST_F(CacheManagerTest, CacheAndGet) {
+    CacheManager cache(1 << 20);
+    cache.cacheNode(1, makeNode(1));
+    cache.cacheEdge(2, std::make_shared<Edge>(2, 1, 3, "KNOWS"));
+
+    ASSERT_NE(cache.getNode(1), nullptr);
+    EXPECT_EQ(cache.getNode(1)->getId(), 1);
+    ASSERT_NE(cache.getEdge(2), nullptr);
+    EXPECT_EQ(cache.getEdge(2)->getType(), "KNOWS");
+    EXPECT_EQ(cache.getNode(2), nullptr);
+    EXPECT_EQ(cache.size(), 2);
+
+    cache.removeNode(1);
+    cache.removeEdge(2);
+    EXPECT_EQ(cache.getNode(1), nullptr);
+    EXPECT_EQ(cache.getEdge(2), nullptr);
+    EXPECT_EQ(cache.residentBytes(), 0);
+}
+
+TEST_F(CacheManagerTest, ChargesAdjacencyAndStrings) {
+    auto leaf = makeNode(1);
+    auto hub = makeNode(2, 10000);
+    EXPECT_GE(CacheManager::chargeFor(*hub), CacheManager::chargeFor(*leaf) + 10000 * sizeof(int));
+
+    // Type names are interned, so edges do not pay for them
+    Edge shortType(1, 1, 2, "A");
+    Edge longType(2, 1, 2, std::string(256, 'x'));
+    EXPECT_EQ(CacheManager::chargeFor(longType), CacheManager::chargeFor(shortType));
+
+    auto withProperty = makeNode(3);
+    withProperty->setProperty("bio", std::string(1000, 'b'));
+    EXPECT_GE(CacheManager::chargeFor(*withProperty), CacheManager::chargeFor(*leaf) + 1000);
+}
+
+TEST_F(CacheManagerTest, EvictsLeastRecentlyUsedWithinBudget) {
+    size_t perNode = CacheManager::chargeFor(*makeNode(0));
+    CacheManager cache(3 * perNode, 1 << 20);
+
+    cache.cacheNode(1, makeNode(1));
+    cache.cacheNode(2, makeNode(2));
+    cache.cacheNode(3, makeNode(3));
+    cache.getNode(1);  // 2 is now least recently used
+    cache.cacheNode(4, makeNode(4));
+
+    EXPECT_NE(cache.getNode(1), nullptr);
+    EXPECT_EQ(cache.getNode(2), nullptr);
+    EXPECT_NE(cache.getNode(3), nullptr);
+    EXPECT_NE(cache.getNode(4), nullptr);
+    EXPECT_LE(cache.nodeBytes(), cache.nodeBudget());
+}
+
+TEST_F(CacheManagerTest, HubNodeDisplacesManyLeaves) {
+    size_t perNode = CacheManager::chargeFor(*makeNode(0));
+    CacheManager cache(8 * perNode + 4096 * sizeof(int), 1 << 20);
+    for (int i = 0; i < 8; ++i) {
+        cache.cacheNode(i, makeNode(i));
+    }
+    cache.cacheNode(100, makeNode(100, 4096));
+
+    EXPECT_NE(cache.getNode(100), nullptr);
+    EXPECT_LT(cache.size(), 9);
+    EXPECT_LE(cache.nodeBytes(), cache.nodeBudget());
+}
+
+TEST_F(CacheManagerTest, OversizedRecordIsNotCached) {
+    CacheManager cache(1024, 1024);
+    cache.cacheNode(1, makeNode(1));
+    cache.cacheNode(2, makeNode(2, 1000));
+    EXPECT_NE(cache.getNode(1), nullptr);
+    EXPECT_EQ(cache.getNode(2), nullptr);
+}
+
+TEST_F(CacheManagerTest, NodeAndEdgeBudgetsAreSeparate) {
+    size_t perEdge = CacheManager::chargeFor(Edge(0, 0, 0, "T"));
+    CacheManager cache(1 << 20, 2 * perEdge);
+    cache.cacheNode(1, makeNode(1));
+    for (int i = 0; i < 10; ++i) {
+        cache.cacheEdge(i, std::make_shared<Edge>(i, 0, 0, "T"));
+    }
+    EXPECT_NE(cache.getNode(1), nullptr);
+    EXPECT_LE(cache.edgeBytes(), cache.edgeBudget());
+    EXPECT_NE(cache.getEdge(9), nullptr);
+    EXPECT_EQ(cache.getEdge(0), nullptr);
+}
+
+TEST_F(CacheManagerTest, RecachingUpdatesCharge) {
+    CacheManager cache(1 << 20);
+    auto node = makeNode(1);
+    cache.cacheNode(1, node);
+    size_t before = cache.nodeBytes();
+    for (int i = 0; i < 1000; ++i) {
+        node->addEdge(i, false);
+    }
+    cache.cacheNode(1, node);
+    EXPECT_GE(cache.nodeBytes(), before + 1000 * sizeof(int));
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST_F(CacheManagerTest, HighWatermarkFiresOncePerCrossing) {
+    size_t perNode = CacheManager::chargeFor(*makeNode(0));
+    CacheManager cache(4 * perNode, 4 * perNode);
+    int calls = 0;
+    cache.setHighWatermark(0.25, [&](size_t resident, size_t budget) {
+        EXPECT_GT(resident, budget / 4);
+        ++calls;
+    });
+
+    cache.cacheNode(1, makeNode(1));
+    cache.cacheNode(2, makeNode(2));
+    EXPECT_EQ(calls, 0);
+    cache.cacheNode(3, makeNode(3));
+    cache.cacheNode(4, makeNode(4));
+    EXPECT_EQ(calls, 1);
+
+    cache.clear();
+    cache.cacheNode(1, makeNode(1));
+    cache.cacheNode(2, makeNode(2));
+    cache.cacheNode(3, makeNode(3));
+    EXPECT_EQ(calls, 2);
+}
+
+TEST_F(CacheManagerTest, DirtyEntryOutlastsCleanOnesUnderEveryPolicy) {
+    size_t perNode = CacheManager::chargeFor(*makeNode(0));
+    for (EvictionPolicyType type : {EvictionPolicyType::LRU, EvictionPolicyType::CLOCK,
+                                    EvictionPolicyType::W_TINY_LFU}) {
+        CacheManager cache(4 * perNode, 1 << 20, type);
+        size_t writeBacks = 0;
+        cache.setWriteBack([&](std::shared_ptr<Node>) { ++writeBacks; }, nullptr);
+
+        // Arriving at a full cache puts the dirty node where W-TinyLFU picks
+        // its next victim from
+        for (int id = 1; id <= 4; ++id) {
+            cache.cacheNode(id, makeNode(id));
+        }
+        auto dirty = makeNode(0);
+        dirty->setDirty(true);
+        cache.cacheNode(0, dirty);
+        for (int id = 5; id <= 40; ++id) {
+            cache.cacheNode(id, makeNode(id));
+        }
+        EXPECT_EQ(writeBacks, 0u) << cache.policyName();
+        EXPECT_EQ(cache.peekNode(0), dirty) << cache.policyName();
+        EXPECT_LE(cache.nodeBytes(), cache.nodeBudget()) << cache.policyName();
+    }
+}
@@ -0,0 +1,145 @@
+// tests/cache/test_eviction_policy.cpp
+#include <gtest/gtest.h>
+#include "cache/cache_manager.hpp"
+#include "cache/eviction_policy.hpp"
+
+TEST(CountMinSketchTest, EstimatesFrequency) {
+    CountMinSketch sketch(1024);
+    for (int i = 0; i < 5; ++i) {
+        sketch.increment(7);
+    }
+    sketch.increment(8);
+    EXPECT_GE(sketch.estimate(7), 5);
+    EXPECT_GE(sketch.estimate(8), 1);
+    EXPECT_LT(sketch.estimate(8), sketch.estimate(7));
+}
+
+TEST(CountMinSketchTest, SaturatesAndAges) {
+    CountMinSketch sketch(16);
+    for (int i = 0; i < 100; ++i) {
+        sketch.increment(1);
+    }
+    EXPECT_EQ(sketch.estimate(1), 15);
+
+    // Filling the sample window halves every counter
+    for (size_t i = 0; i < sketch.counterWidth() * 10; ++i) {
+        sketch.increment(1000 + static_cast<int>(i));
+    }
+    EXPECT_LT(sketch.estimate(1), 15);
+}
+
+TEST(EvictionPolicyTest, LruEvictsOldest) {
+    LruPolicy policy;
+    policy.onInsert(1, 1);
+    policy.onInsert(2, 2);
+    policy.onInsert(3, 3);
+    policy.onAccess(1);
+    EXPECT_EQ(policy.victim(), 2);
+    policy.onRemove(2);
+    EXPECT_EQ(policy.victim(), 3);
+    EXPECT_EQ(policy.size(), 2);
+}
+
+TEST(EvictionPolicyTest, ClockGivesSecondChance) {
+    ClockPolicy policy;
+    policy.onInsert(1, 1);
+    policy.onInsert(2, 2);
+    policy.onInsert(3, 3);
+    policy.onAccess(1);
+    EXPECT_EQ(policy.victim(), 2);
+    policy.onRemove(2);
+    policy.onInsert(2, 4);  // Reuses the freed slot
+    EXPECT_EQ(policy.size(), 3);
+    EXPECT_EQ(policy.victim(), 3);
+}
+
+TEST(EvictionPolicyTest, ClockTerminatesWhenAllReferenced) {
+    ClockPolicy policy;
+    for (int i = 0; i < 4; ++i) {
+        policy.onInsert(i, i);
+        policy.onAccess(i);
+    }
+    uint32_t victim = policy.victim();
+    EXPECT_GE(victim, 0);
+    EXPECT_LT(victim, 4);
+}
+
+TEST(EvictionPolicyTest, TinyLfuRejectsColdCandidate) {
+    TinyLfuPolicy policy(1024);
+    for (int i = 0; i < 100; ++i) {
+        policy.onInsert(i, i);
+        for (int j = 0; j < 3; ++j) {
+            policy.onAccess(i);
+        }
+    }
+    policy.onInsert(1000, 1000);  // Seen once
+    policy.onInsert(1001, 1001);
+    uint32_t victim = policy.victim();
+    EXPECT_GE(victim, 1000);
+}
+
+TEST(EvictionPolicyTest, TinyLfuKeepsFrequenciesWhenSketchGrows) {
+    TinyLfuPolicy policy(16);
+    for (int j = 0; j < 5; ++j) {
+        policy.onMiss(7);
+    }
+    ASSERT_EQ(policy.frequency(7), 5);
+    // Filling the cache past the sketch width grows the sketch several times
+    for (int i = 0; i < 200; ++i) {
+        policy.onInsert(i, 1000 + i);
+    }
+    EXPECT_GE(policy.frequency(7), 5);
+}
+
+TEST(EvictionPolicyTest, FactoryNamesPolicies) {
+    EXPECT_EQ(makeEvictionPolicy(EvictionPolicyType::LRU)->name(), "LRU");
+    EXPECT_EQ(makeEvictionPolicy(EvictionPolicyType::CLOCK)->name(), "CLOCK");
+    EXPECT_EQ(makeEvictionPolicy(EvictionPolicyType::W_TINY_LFU)->name(), "W-TinyLFU");
+}
+
+class PolicyScanTest : public ::testing::TestWithParam<EvictionPolicyType> {};
+
+// A hot set re-read between cold scans; reports hits on the hot set afterwards
+static int hotHitsAfterScan(EvictionPolicyType type) {
+    const int capacity = 100;
+    const int hotKeys = 50;
+    CacheManager cache(capacity * CacheManager::chargeFor(Node(0)), 1 << 20, type);
+    auto touch = [&](int id) {
+        if (!cache.getNode(id)) {
+            cache.cacheNode(id, std::make_shared<Node>(id));
+        }
+    };
+    for (int round = 0; round < 10; ++round) {
+        for (int id = 0; id < hotKeys; ++id) {
+            touch(id);
+        }
+    }
+    for (int id = 10000; id < 10000 + 5 * capacity; ++id) {
+        touch(id);
+    }
+    int hits = 0;
+    for (int id = 0; id < hotKeys; ++id) {
+        hits += cache.getNode(id) != nullptr;
+    }
+    return hits;
+}
+
+TEST_P(PolicyScanTest, BudgetHolds) {
+    CacheManager cache(20 * CacheManager::chargeFor(Node(0)), 1 << 20, GetParam());
+    for (int id = 0; id < 1000; ++id) {
+        if (!cache.getNode(id % 37)) {
+            cache.cacheNode(id % 37, std::make_shared<Node>(id % 37));
+        }
+        cache.cacheNode(id, std::make_shared<Node>(id));
+        EXPECT_LE(cache.nodeBytes(), cache.nodeBudget());
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllPolicies, PolicyScanTest,
+                         ::testing::Values(EvictionPolicyType::LRU, EvictionPolicyType::CLOCK,
+                                           EvictionPolicyType::W_TINY_LFU));
+
+TEST(EvictionPolicyTest, TinyLfuSurvivesScan) {
+    EXPECT_EQ(hotHitsAfterScan(EvictionPolicyType::LRU), 0);
+    EXPECT_GT(hotHitsAfterScan(EvictionPolicyType::W_TINY_LFU), 40);
+}
@@ -0,0 +1,45 @@
+// tests/cache/test_id_table.cpp
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+#include "cache/id_table.hpp"
+
+TEST(IdTableTest, InsertFindErase) {
+    IdTable table;
+    table.insert(5, 50);
+    table.insert(-7, 70);
+    EXPECT_EQ(table.find(5), 50);
+    EXPECT_EQ(table.find(-7), 70);
+    EXPECT_EQ(table.find(6), IdTable::NONE);
+
+    table.insert(5, 55);  // Replace
+    EXPECT_EQ(table.find(5), 55);
+    EXPECT_EQ(table.size(), 2);
+
+    EXPECT_TRUE(table.erase(5));
+    EXPECT_FALSE(table.erase(5));
+    EXPECT_EQ(table.find(5), IdTable::NONE);
+    EXPECT_EQ(table.size(), 1);
+}
+
+TEST(IdTableTest, MatchesReferenceUnderChurn) {
+    IdTable table;
+    std::unordered_map<int, uint32_t> reference;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> ids(0, 2000);
+    for (uint32_t i = 0; i < 50000; ++i) {
+        int id = ids(rng);
+        if (rng() % 3 == 0) {
+            EXPECT_EQ(table.erase(id), reference.erase(id) == 1);
+        } else {
+            table.insert(id, i);
+            reference[id] = i;
+        }
+    }
+    EXPECT_EQ(table.size(), reference.size());
+    for (int id = 0; id <= 2000; ++id) {
+        auto it = reference.find(id);
+        EXPECT_EQ(table.find(id), it == reference.end() ? IdTable::NONE : it->second);
+    }
+    EXPECT_LE(table.size() * 10, table.capacity() * 7);
+}
@@ -0,0 +1,75 @@
+// tests/core/test_adjacency_list.cpp
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include "core/adjacency_list.hpp"
+#include "core/node.hpp"
+
+TEST(AdjacencyListTest, KeepsIdsSortedAndUnique) {
+    AdjacencyList list;
+    EXPECT_TRUE(list.insert(30));
+    EXPECT_TRUE(list.insert(-5));
+    EXPECT_TRUE(list.insert(12));
+    EXPECT_FALSE(list.insert(12));
+    EXPECT_EQ(list.size(), 3u);
+    EXPECT_EQ(list, (std::vector<int>{-5, 12, 30}));
+    EXPECT_EQ(list[1], 12);
+    EXPECT_THROW(list[3], std::out_of_range);
+
+    EXPECT_TRUE(list.contains(30));
+    EXPECT_TRUE(list.erase(30));
+    EXPECT_FALSE(list.erase(30));
+    EXPECT_FALSE(list.contains(30));
+
+    list.assign({9, 3, 9, 1});
+    EXPECT_EQ(list.toVector(), (std::vector<int>{1, 3, 9}));
+}
+
+TEST(AdjacencyListTest, MatchesReferenceAcrossBlockLayouts) {
+    AdjacencyList list;
+    std::set<int> reference;
+    std::mt19937 rng(5);
+    // Grow past the block threshold, churn, then shrink back below it
+    for (int phase = 0; phase < 3; ++phase) {
+        int eraseOneIn = phase == 0 ? 10 : phase == 1 ? 2 : 1;
+        for (int i = 0; i < 30000; ++i) {
+            int id = static_cast<int>(rng() % 20000);
+            if (rng() % eraseOneIn == 0) {
+                EXPECT_EQ(list.erase(id), reference.erase(id) == 1);
+            } else {
+                EXPECT_EQ(list.insert(id), reference.insert(id).second);
+            }
+        }
+        ASSERT_EQ(list.size(), reference.size());
+        EXPECT_TRUE(std::equal(list.begin(), list.end(), reference.begin(), reference.end()));
+        for (int id = 0; id < 20000; id += 7) {
+            EXPECT_EQ(list.contains(id), reference.count(id) == 1);
+        }
+    }
+}
+
+TEST(AdjacencyListTest, AscendingAppendsFillBlocks) {
+    AdjacencyList list;
+    const int degree = 100000;
+    for (int id = 0; id < degree; ++id) {
+        list.insert(id);
+    }
+    EXPECT_EQ(list[degree - 1], degree - 1);
+    // Within a block and a bit of the block directory of the raw ids
+    EXPECT_LT(list.heapUsage(), degree * sizeof(int) + AdjacencyList::BLOCK_CAPACITY * sizeof(int) + 4096);
+}
+
+TEST(AdjacencyListTest, HubNodeBulkLoad) {
+    Node hub(1);
+    const int degree = 200000;
+    // Descending order is the worst case for a flat sorted vector
+    for (int id = degree; id > 0; --id) {
+        hub.addEdge(id, false);
+    }
+    EXPECT_EQ(hub.getIncomingEdges().size(), static_cast<size_t>(degree));
+    EXPECT_TRUE(hub.hasEdge(degree / 2, false));
+    EXPECT_FALSE(hub.hasEdge(degree / 2, true));
+
+    Node decoded = Node::deserialize(hub.serialize());
+    EXPECT_EQ(decoded.getIncomingEdges(), hub.getIncomingEdges());
+}
@@ -1,6 +1,7 @@
 // tests/core/test_edge.cpp
 #include <gtest/gtest.h>
 #include "core/edge.hpp"
+#include "core/record_codec.hpp"
 
 class EdgeTest : public ::testing::Test {
 protected:
@@ -30,6 +31,13 @@ TEST_F(EdgeTest, Properties) {
     EXPECT_THROW(edge->getProperty<std::string>("nonexistent"), std::out_of_range);
 }
 
+TEST_F(EdgeTest, ReferenceAccess) {
+    edge->setProperty("label", "from a literal");
+    EXPECT_EQ(edge->getProperty<std::string_view>("label"), "from a literal");
+    EXPECT_EQ(&edge->getProperty<std::string>("label"), edge->tryGetProperty<std::string>("label"));
+    EXPECT_EQ(edge->tryGetProperty<double>("label"), nullptr);
+}
+
 TEST_F(EdgeTest, HasAndRemoveProperty) {
     edge->setProperty("test", std::string("value"));
     EXPECT_TRUE(edge->hasProperty("test"));
@@ -88,4 +96,35 @@ TEST_F(EdgeTest, SerializeDeserializeAllTypes) {
     EXPECT_EQ(deserialized.getProperty<double>("double_prop"), 3.14);
     EXPECT_EQ(deserialized.getProperty<std::string>("string_prop"), "test");
     EXPECT_EQ(deserialized.getProperty<bool>("bool_prop"), true);
-}
\ No newline at end of file
+}
+TEST_F(EdgeTest, ReadsLegacyTextRecords) {
+    Edge decoded = Edge::deserialize("3|1|2|KNOWS|1|since:1:2019|");
+    EXPECT_EQ(decoded.getId(), 3);
+    EXPECT_EQ(decoded.getSourceNodeId(), 1);
+    EXPECT_EQ(decoded.getTargetNodeId(), 2);
+    EXPECT_EQ(decoded.getType(), "KNOWS");
+    EXPECT_EQ(decoded.getProperty<int>("since"), 2019);
+}
+
+TEST_F(EdgeTest, TypeIsInterned) {
+    Edge other(2, 20, 10, std::string("TEST_TYPE"));
+    EXPECT_EQ(other.getTypeId(), edge->getTypeId());
+    EXPECT_EQ(edge->getTypeId(), edgeType("TEST_TYPE"));
+    EXPECT_EQ(&other.getType(), &edge->getType());
+
+    Edge byId(3, 1, 2, edgeType("OTHER_TYPE"));
+    EXPECT_EQ(byId.getType(), "OTHER_TYPE");
+    EXPECT_EQ(Edge::deserialize(byId.serialize()).getTypeId(), byId.getTypeId());
+}
+
+TEST_F(EdgeTest, UnknownTypeIdThrows) {
+    std::string record;
+    BinaryWriter writer(record);
+    writer.writeByte(RECORD_FORMAT_VERSION);
+    writer.writeSigned(4);
+    writer.writeSigned(1);
+    writer.writeSigned(2);
+    writer.writeVarint(RecordNames::detached().edgeTypes.size() + 100);
+    writer.writeVarint(0);
+    EXPECT_THROW(Edge::deserialize(record), std::runtime_error);
+}
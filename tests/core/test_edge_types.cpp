@@ -0,0 +1,41 @@
+// tests/core/test_edge_types.cpp
+#include <gtest/gtest.h>
+#include <cstdio>
+#include "core/edge_types.hpp"
+
+namespace {
+const std::string typesPath = "test_edge_types.db";
+}
+
+TEST(EdgeTypeRegistryTest, EmptyNameIsTheDefaultType) {
+    EdgeTypeRegistry registry;
+    EXPECT_EQ(registry.size(), 1u);
+    EXPECT_EQ(registry.name(EdgeType{}), "");
+    EXPECT_EQ(registry.intern(""), EdgeType{});
+
+    EdgeType follows = registry.intern("FOLLOWS");
+    EdgeType likes = registry.intern("LIKES");
+    EXPECT_EQ(follows.id, 1u);
+    EXPECT_EQ(likes.id, 2u);
+    EXPECT_EQ(registry.intern("FOLLOWS"), follows);
+    EXPECT_EQ(registry.name(likes), "LIKES");
+    EXPECT_FALSE(registry.find("BLOCKS"));
+    EXPECT_THROW(registry.name(EdgeType{9}), std::out_of_range);
+}
+
+TEST(EdgeTypeRegistryTest, SaveAndLoad) {
+    std::remove(typesPath.c_str());
+    EdgeTypeRegistry saved;
+    saved.intern("FOLLOWS");
+    saved.intern("LIKES");
+    saved.save(typesPath);
+
+    EdgeTypeRegistry fresh;
+    EXPECT_EQ(fresh.load(typesPath), 3u);
+    EXPECT_EQ(fresh.find("LIKES")->id, 2u);
+
+    EdgeTypeRegistry clashing;
+    clashing.intern("LIKES");
+    EXPECT_THROW(clashing.load(typesPath), std::runtime_error);
+    std::remove(typesPath.c_str());
+}
@@ -1,6 +1,8 @@
 // tests/core/test_node.cpp
 #include <gtest/gtest.h>
+#include <limits>
 #include "core/node.hpp"
+#include "core/record_codec.hpp"
 
 class NodeTest : public ::testing::Test {
 protected:
@@ -129,4 +131,192 @@ TEST_F(NodeTest, SerializeAndDeserialize) {
     // Check for edge counts
     EXPECT_EQ(deserialized.getOutgoingEdges().size(), 1) << "Outgoing edges size mismatch: Expected 1 but got " << deserialized.getOutgoingEdges().size();
     EXPECT_EQ(deserialized.getIncomingEdges().size(), 1) << "Incoming edges size mismatch: Expected 1 but got " << deserialized.getIncomingEdges().size();
-}
\ No newline at end of file
+}
+TEST_F(NodeTest, BinaryRoundTripIsExact) {
+    node->setId(-12345);
+    node->setProperty("pi", 3.141592653589793);
+    node->setProperty("tiny", 1e-300);
+    node->setProperty("flag", false);
+    node->setProperty("min", std::numeric_limits<int>::min());
+    node->setProperty("text", std::string("pipes | and : colons, too"));
+    for (int id : {100, 101, 99, 5000, -3}) {
+        node->addEdge(id, true);
+    }
+    node->addEdge(7, false);
+
+    std::string buffer = "prefix";
+    node->serializeTo(buffer);
+    Node decoded = Node::deserialize(buffer.data() + 6, buffer.size() - 6);
+
+    EXPECT_EQ(decoded.getId(), -12345);
+    EXPECT_EQ(decoded.getProperty<double>("pi"), 3.141592653589793);
+    EXPECT_EQ(decoded.getProperty<double>("tiny"), 1e-300);
+    EXPECT_FALSE(decoded.getProperty<bool>("flag"));
+    EXPECT_EQ(decoded.getProperty<int>("min"), std::numeric_limits<int>::min());
+    EXPECT_EQ(decoded.getProperty<std::string>("text"), "pipes | and : colons, too");
+    EXPECT_EQ(decoded.getOutgoingEdges(), node->getOutgoingEdges());
+    EXPECT_EQ(decoded.getIncomingEdges(), node->getIncomingEdges());
+    EXPECT_FALSE(decoded.isDirty());
+}
+
+TEST_F(NodeTest, ReferenceAccessWithoutCopies) {
+    std::string bio(200, 'b');
+    const char* buffer = bio.data();
+    node->setProperty("bio", std::move(bio));
+    node->setProperty(std::string_view("city"), "Utrecht");
+
+    // Rvalues are moved into the node, and reads return the stored value
+    const std::string& stored = node->getProperty<std::string>("bio");
+    EXPECT_EQ(stored.data(), buffer);
+    EXPECT_EQ(&node->getProperty<std::string>(propertyKey("bio")), &stored);
+    EXPECT_EQ(node->getProperty<std::string_view>("bio").data(), buffer);
+    EXPECT_EQ(node->getProperty<std::string>("city"), "Utrecht");
+
+    // Replacing a string keeps the stored object
+    node->setProperty("bio", std::string("short"));
+    EXPECT_EQ(&node->getProperty<std::string>("bio"), &stored);
+    EXPECT_EQ(stored, "short");
+}
+
+TEST_F(NodeTest, TryGetPropertyNeverThrows) {
+    node->setProperty("age", 30);
+    ASSERT_NE(node->tryGetProperty<int>("age"), nullptr);
+    EXPECT_EQ(*node->tryGetProperty<int>("age"), 30);
+    EXPECT_EQ(node->tryGetProperty<std::string>("age"), nullptr);
+    EXPECT_EQ(node->tryGetProperty<int>("missing"), nullptr);
+    EXPECT_EQ(node->tryGetProperty<int>("never_interned_by_try_get"), nullptr);
+    EXPECT_FALSE(RecordNames::detached().propertyKeys.find("never_interned_by_try_get"));
+}
+
+TEST_F(NodeTest, FloatVectorProperty) {
+    std::vector<float> embedding(100);
+    for (size_t i = 0; i < embedding.size(); ++i) {
+        embedding[i] = static_cast<float>(i) / 7.0f - 3.0f;
+    }
+    node->setProperty("embedding", embedding);
+    node->setProperty("empty", std::vector<float>());
+    node->setProperty("after", 5);
+
+    std::string record = node->serialize();
+    // Dimension plus raw floats
+    EXPECT_LT(record.size(), 100 * sizeof(float) + 32);
+    Node decoded = Node::deserialize(record);
+    EXPECT_EQ(decoded.getProperty<std::vector<float>>("embedding"), embedding);
+    EXPECT_TRUE(decoded.getProperty<std::vector<float>>("empty").empty());
+    EXPECT_EQ(decoded.getProperty<int>("after"), 5);
+    EXPECT_THROW(decoded.getProperty<std::string>("embedding"), std::bad_variant_access);
+
+    EXPECT_EQ(FloatVectorProperty::deserialize(FloatVectorProperty(embedding).serialize()).getValue(), embedding);
+}
+
+TEST_F(NodeTest, ReadsLegacyTextRecords) {
+    Node decoded = Node::deserialize("9|2|age:1:30|name:3:bob|1|4,|2|5,6,|");
+    EXPECT_EQ(decoded.getId(), 9);
+    EXPECT_EQ(decoded.getProperty<int>("age"), 30);
+    EXPECT_EQ(decoded.getProperty<std::string>("name"), "bob");
+    EXPECT_EQ(decoded.getIncomingEdges(), std::vector<int>{4});
+    EXPECT_EQ(decoded.getOutgoingEdges(), (std::vector<int>{5, 6}));
+}
+
+TEST_F(NodeTest, TruncatedRecordThrows) {
+    node->setProperty("name", std::string("long enough to truncate"));
+    std::string encoded = node->serialize();
+    EXPECT_THROW(Node::deserialize(encoded.data(), encoded.size() - 3), std::runtime_error);
+}
+
+TEST_F(NodeTest, CorruptCountsThrowBeforeAllocating) {
+    // Counts far beyond the record's size, as a damaged varint would give
+    for (int field = 0; field < 3; ++field) {
+        std::string record;
+        BinaryWriter writer(record);
+        writer.writeByte(RECORD_FORMAT_VERSION);
+        writer.writeSigned(3);
+        writer.writeVarint(field == 0 ? uint64_t{1} << 60 : 0);
+        writer.writeVarint(0);
+        if (field == 2) {
+            // One partition whose edge count outruns its delta bytes
+            writer.writeVarint(1);
+            writer.writeVarint(EdgeType{}.id);
+            writer.writeVarint(uint64_t{1} << 60);
+            writer.writeString("");
+        } else {
+            writer.writeVarint(field == 1 ? uint64_t{1} << 60 : 0);
+        }
+        writer.writeVarint(0);
+        writer.writeVarint(0);
+        EXPECT_THROW(Node::deserialize(record), std::runtime_error) << field;
+    }
+}
+
+TEST_F(NodeTest, KeyHandlesMatchNames) {
+    PropertyKey age = propertyKey("age");
+    node->setProperty(age, 41);
+    EXPECT_EQ(node->getProperty<int>("age"), 41);
+    node->setProperty("age", 42);
+    EXPECT_EQ(node->getProperty<int>(age), 42);
+    EXPECT_TRUE(node->hasProperty(age));
+
+    node->removeProperty(age);
+    EXPECT_FALSE(node->hasProperty("age"));
+    EXPECT_FALSE(node->hasProperty("never_interned_anywhere"));
+    EXPECT_THROW(node->getProperty<int>("never_interned_anywhere"), std::out_of_range);
+    EXPECT_FALSE(RecordNames::detached().propertyKeys.find("never_interned_anywhere"));
+}
+
+TEST_F(NodeTest, UnknownKeyIdThrows) {
+    std::string record;
+    BinaryWriter writer(record);
+    writer.writeByte(RECORD_FORMAT_VERSION);
+    writer.writeSigned(3);
+    writer.writeVarint(1);
+    writer.writeVarint(RecordNames::detached().propertyKeys.size() + 100);
+    writer.writeByte(IntProperty::typeId());
+    writer.writeSigned(1);
+    encodeAdjacency({}, writer);
+    encodeAdjacency({}, writer);
+    EXPECT_THROW(Node::deserialize(record), std::runtime_error);
+}
+
+TEST_F(NodeTest, PartitionsAdjacencyByType) {
+    EdgeType follows = edgeType("FOLLOWS");
+    EdgeType likes = edgeType("LIKES");
+    node->addEdge(Edge(10, node->getId(), 2, "LIKES"));
+    node->addEdge(Edge(11, node->getId(), 3, "FOLLOWS"));
+    node->addEdge(Edge(12, node->getId(), 4, "FOLLOWS"));
+    node->addEdge(Edge(13, 5, node->getId(), "FOLLOWS"));
+    node->addEdge(14, true);
+
+    EXPECT_EQ(node->getOutgoingEdges(follows), (std::vector<int>{11, 12}));
+    EXPECT_EQ(node->getOutgoingEdges("LIKES"), std::vector<int>{10});
+    EXPECT_EQ(node->getIncomingEdges(follows), std::vector<int>{13});
+    EXPECT_TRUE(node->getIncomingEdges(likes).empty());
+    EXPECT_TRUE(node->getOutgoingEdges("NEVER_USED_TYPE").empty());
+    EXPECT_EQ(node->getOutgoingEdges(EdgeType{}), std::vector<int>{14});
+    EXPECT_EQ(node->getEdgePartitions(true).size(), 3u);
+    EXPECT_EQ(node->getEdgeCount(true), 4u);
+
+    // Grouped by type id: the untyped partition first, then in interning order
+    std::vector<int> all = node->getOutgoingEdges();
+    EXPECT_EQ(all.size(), 4u);
+    EXPECT_EQ(all.front(), 14);
+    std::vector<int> visited;
+    node->forEachOutgoingEdge([&](int edgeId) { visited.push_back(edgeId); });
+    EXPECT_EQ(visited, all);
+    visited.clear();
+    node->forEachIncomingEdge([&](int edgeId) { visited.push_back(edgeId); });
+    EXPECT_EQ(visited, node->getIncomingEdges());
+    EXPECT_TRUE(node->hasEdge(10, true));
+    EXPECT_FALSE(node->hasEdge(10, false));
+
+    Node decoded = Node::deserialize(node->serialize());
+    EXPECT_EQ(decoded.getOutgoingEdges(follows), (std::vector<int>{11, 12}));
+    EXPECT_EQ(decoded.getOutgoingEdges(), all);
+    EXPECT_EQ(decoded.getIncomingEdges(follows), std::vector<int>{13});
+
+    // Emptied partitions are dropped
+    node->removeEdge(10, true);
+    node->removeEdge(12, true, follows);
+    EXPECT_FALSE(node->hasEdge(10, true));
+    EXPECT_EQ(node->getEdgePartitions(true).size(), 2u);
+    EXPECT_EQ(node->getOutgoingEdges(follows), std::vector<int>{11});
+}
@@ -0,0 +1,81 @@
+// tests/core/test_property_keys.cpp
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include "core/property_keys.hpp"
+
+namespace {
+const std::string keysPath = "test_property_keys.db";
+}
+
+TEST(PropertyKeyDictionaryTest, InternAssignsDenseStableIds) {
+    PropertyKeyDictionary dictionary;
+    PropertyKey name = dictionary.intern("name");
+    PropertyKey age = dictionary.intern("age");
+    EXPECT_EQ(name.id, 0u);
+    EXPECT_EQ(age.id, 1u);
+    EXPECT_EQ(dictionary.intern("name"), name);
+    EXPECT_EQ(dictionary.name(age), "age");
+    EXPECT_EQ(dictionary.size(), 2u);
+
+    EXPECT_FALSE(dictionary.find("missing"));
+    EXPECT_EQ(dictionary.size(), 2u);  // find never interns
+    EXPECT_THROW(dictionary.name(PropertyKey{7}), std::out_of_range);
+}
+
+TEST(PropertyKeyDictionaryTest, ConcurrentInternAgrees) {
+    PropertyKeyDictionary dictionary;
+    std::vector<std::vector<PropertyKey>> seen(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&dictionary, &seen, t] {
+            for (int i = 0; i < 500; ++i) {
+                seen[t].push_back(dictionary.intern("key" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(dictionary.size(), 500u);
+    for (size_t t = 1; t < seen.size(); ++t) {
+        EXPECT_EQ(seen[t], seen[0]);
+    }
+}
+
+TEST(PropertyKeyDictionaryTest, SaveAndLoad) {
+    std::remove(keysPath.c_str());
+    PropertyKeyDictionary saved;
+    saved.intern("name");
+    saved.intern("created_at");
+    saved.save(keysPath);
+
+    // A fresh dictionary, or one that already agrees on a prefix, loads cleanly
+    PropertyKeyDictionary fresh;
+    EXPECT_EQ(fresh.load(keysPath), 2u);
+    EXPECT_EQ(fresh.find("created_at")->id, 1u);
+    PropertyKeyDictionary prefix;
+    prefix.intern("name");
+    EXPECT_EQ(prefix.load(keysPath), 2u);
+    EXPECT_EQ(prefix.size(), 2u);
+
+    // Ids already given to other names cannot be honoured
+    PropertyKeyDictionary clashing;
+    clashing.intern("created_at");
+    EXPECT_THROW(clashing.load(keysPath), std::runtime_error);
+
+    EXPECT_EQ(PropertyKeyDictionary().load("test_property_keys_missing.db"), 0u);
+    std::remove(keysPath.c_str());
+}
+
+TEST(PropertyKeyDictionaryTest, CorruptFileThrows) {
+    {
+        std::ofstream file(keysPath, std::ios::binary | std::ios::trunc);
+        file << "not a dictionary";
+    }
+    PropertyKeyDictionary dictionary;
+    EXPECT_THROW(dictionary.load(keysPath), std::runtime_error);
+    std::remove(keysPath.c_str());
+}
@@ -0,0 +1,126 @@
+// tests/core/test_property_map.cpp
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include "core/property_map.hpp"
+
+namespace {
+int intValue(const PropertyMap& map, uint32_t key) {
+    return *map.find<int>(PropertyKey{key});
+}
+
+std::map<uint32_t, int> contents(const PropertyMap& map) {
+    std::map<uint32_t, int> entries;
+    map.forEach([&](PropertyKey key, const auto& value) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(value)>, int>) {
+            entries[key.id] = value;
+        }
+    });
+    return entries;
+}
+}
+
+TEST(PropertyMapTest, AssignFindErase) {
+    PropertyMap map;
+    EXPECT_TRUE(map.empty());
+    map.assign(PropertyKey{5}, 50);
+    map.assign(PropertyKey{2}, std::string("two"));
+    map.assign(PropertyKey{9}, 9.5);
+    EXPECT_EQ(map.size(), 3u);
+    EXPECT_EQ(intValue(map, 5), 50);
+    EXPECT_EQ(*map.find<std::string>(PropertyKey{2}), "two");
+    EXPECT_EQ(map.find<int>(PropertyKey{3}), nullptr);
+    EXPECT_THROW(map.find<int>(PropertyKey{9}), std::bad_variant_access);
+
+    map.assign(PropertyKey{5}, 51);  // Replace
+    map.assign(PropertyKey{9}, std::string("nine"));  // Replace with another type
+    EXPECT_EQ(map.size(), 3u);
+    EXPECT_EQ(intValue(map, 5), 51);
+    EXPECT_EQ(*map.find<std::string>(PropertyKey{9}), "nine");
+
+    EXPECT_TRUE(map.erase(PropertyKey{2}));
+    EXPECT_FALSE(map.erase(PropertyKey{2}));
+    EXPECT_FALSE(map.contains(PropertyKey{2}));
+    EXPECT_EQ(map.size(), 2u);
+}
+
+TEST(PropertyMapTest, VisitsInKeyOrder) {
+    PropertyMap map;
+    for (uint32_t key : {7u, 1u, 4u, 12u, 3u, 9u}) {
+        map.assign(PropertyKey{key}, static_cast<int>(key));
+    }
+    std::vector<uint32_t> order;
+    map.forEach([&](PropertyKey key, const auto&) { order.push_back(key.id); });
+    EXPECT_EQ(order, (std::vector<uint32_t>{1, 3, 4, 7, 9, 12}));
+}
+
+TEST(PropertyMapTest, SmallMapsOwnNoHeap) {
+    PropertyMap map;
+    for (uint32_t key = 0; key < PropertyMap::INLINE_CAPACITY; ++key) {
+        map.assign(PropertyKey{key}, 1);
+    }
+    EXPECT_EQ(map.heapUsage(), 0u);
+    map.assign(PropertyKey{100}, 1);
+    EXPECT_GT(map.heapUsage(), 0u);
+}
+
+TEST(PropertyMapTest, CopyAndMoveAcrossLayouts) {
+    // Inline, heap arrays and hash table
+    for (uint32_t size : {3u, 10u, 50u}) {
+        PropertyMap original;
+        for (uint32_t key = 0; key < size; ++key) {
+            original.assign(PropertyKey{key * 3}, static_cast<int>(key));
+            original.assign(PropertyKey{key * 3 + 1}, "string " + std::to_string(key) + " past the SSO buffer");
+        }
+        auto expected = contents(original);
+
+        PropertyMap copy(original);
+        EXPECT_EQ(contents(copy), expected);
+        PropertyMap moved(std::move(copy));
+        EXPECT_EQ(contents(moved), expected);
+        EXPECT_TRUE(copy.empty());
+
+        PropertyMap assigned;
+        assigned.assign(PropertyKey{2}, -1);
+        assigned = original;
+        EXPECT_EQ(contents(assigned), expected);
+        assigned = std::move(moved);
+        EXPECT_EQ(contents(assigned), expected);
+
+        // The source is still usable after being moved from
+        moved.assign(PropertyKey{2}, 4);
+        EXPECT_EQ(intValue(moved, 2), 4);
+    }
+}
+
+TEST(PropertyMapTest, FloatVectorsAreOwned) {
+    PropertyMap map;
+    map.assign(PropertyKey{1}, std::vector<float>{1.5f, -2.0f, 0.25f});
+    EXPECT_EQ(*map.find<std::vector<float>>(PropertyKey{1}), (std::vector<float>{1.5f, -2.0f, 0.25f}));
+    EXPECT_THROW(map.find<std::string>(PropertyKey{1}), std::bad_variant_access);
+    EXPECT_GE(map.heapUsage(), 3 * sizeof(float));
+
+    PropertyMap copy = map;
+    map.assign(PropertyKey{1}, std::vector<float>{9.0f});
+    EXPECT_EQ(copy.find<std::vector<float>>(PropertyKey{1})->size(), 3u);
+    EXPECT_TRUE(map.erase(PropertyKey{1}));
+    EXPECT_TRUE(copy.contains(PropertyKey{1}));
+}
+
+TEST(PropertyMapTest, MatchesReferenceUnderChurn) {
+    PropertyMap map;
+    std::map<uint32_t, int> reference;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<uint32_t> keys(0, 60);
+    for (int i = 0; i < 20000; ++i) {
+        uint32_t key = keys(rng);
+        if (rng() % 3 == 0) {
+            EXPECT_EQ(map.erase(PropertyKey{key}), reference.erase(key) == 1);
+        } else {
+            map.assign(PropertyKey{key}, i);
+            reference[key] = i;
+        }
+        ASSERT_EQ(map.size(), reference.size());
+    }
+    EXPECT_EQ(contents(map), reference);
+}
@@ -0,0 +1,115 @@
+// tests/core/test_record_view.cpp
+#include <gtest/gtest.h>
+#include "core/record_codec.hpp"
+#include "core/record_view.hpp"
+
+TEST(RecordViewTest, NodeViewReadsFieldsOnDemand) {
+    Node node(42);
+    node.setProperty("name", std::string("alice"));
+    node.setProperty("age", 31);
+    node.setProperty("score", 0.75);
+    node.setProperty("active", true);
+    for (int id : {10, 12, 9, 300}) {
+        node.addEdge(id, true);
+    }
+    node.addEdge(-4, false);
+    std::string record = node.serialize();
+
+    NodeView view(record);
+    EXPECT_EQ(view.getId(), 42);
+    EXPECT_EQ(view.getProperty<int>("age"), 31);
+    EXPECT_EQ(view.getProperty<double>(propertyKey("score")), 0.75);
+    EXPECT_TRUE(view.getProperty<bool>("active"));
+    EXPECT_EQ(view.getProperty<std::string>("name"), "alice");
+    EXPECT_EQ(view.getProperty<std::string_view>("name"), "alice");
+    EXPECT_TRUE(view.hasProperty("name"));
+    EXPECT_FALSE(view.hasProperty("missing"));
+    EXPECT_EQ(view.getProperties().size(), 4u);
+    EXPECT_THROW(view.getProperty<int>("missing"), std::out_of_range);
+    EXPECT_THROW(view.getProperty<std::string>("age"), std::bad_variant_access);
+    EXPECT_EQ(view.tryGetProperty<int>("age"), 31);
+    EXPECT_FALSE(view.tryGetProperty<std::string_view>("age"));
+    EXPECT_FALSE(view.tryGetProperty<int>("missing"));
+
+    EXPECT_EQ(view.getOutgoingEdges().toVector(), node.getOutgoingEdges());
+    EXPECT_EQ(view.getIncomingEdges().toVector(), node.getIncomingEdges());
+    int sum = 0;
+    for (int id : view.getOutgoingEdges()) {
+        sum += id;
+    }
+    EXPECT_EQ(sum, 10 + 12 + 9 + 300);
+
+    Node copy = view.toNode();
+    EXPECT_EQ(copy.getProperty<std::string>("name"), "alice");
+}
+
+TEST(RecordViewTest, SkipsOverFloatVectors) {
+    Node node(3);
+    node.setProperty("embedding", std::vector<float>{0.5f, 1.5f, -2.5f});
+    node.setProperty("label", std::string("after the vector"));
+    node.addEdge(8, true);
+    std::string record = node.serialize();
+
+    NodeView view(record);
+    EXPECT_EQ(view.getProperty<std::string_view>("label"), "after the vector");
+    EXPECT_EQ(view.getProperty<std::vector<float>>("embedding"), (std::vector<float>{0.5f, 1.5f, -2.5f}));
+    EXPECT_EQ(view.getOutgoingEdges().toVector(), std::vector<int>{8});
+}
+
+TEST(RecordViewTest, EmptyAdjacency) {
+    std::string record = Node(1).serialize();
+    NodeView view(record);
+    EXPECT_TRUE(view.getIncomingEdges().empty());
+    EXPECT_EQ(view.getOutgoingEdges().begin(), view.getOutgoingEdges().end());
+}
+
+TEST(RecordViewTest, EdgeView) {
+    Edge edge(7, 1, 2, "KNOWS");
+    edge.setProperty("weight", 2.5);
+    edge.setProperty("since", 2019);
+    std::string record = edge.serialize();
+
+    EdgeView view(record);
+    EXPECT_EQ(view.getId(), 7);
+    EXPECT_EQ(view.getSourceNodeId(), 1);
+    EXPECT_EQ(view.getTargetNodeId(), 2);
+    EXPECT_EQ(view.getType(), "KNOWS");
+    EXPECT_EQ(view.getTypeId(), edgeType("KNOWS"));
+    EXPECT_EQ(view.getProperty<double>("weight"), 2.5);
+    EXPECT_EQ(view.getProperty<int>("since"), 2019);
+    EXPECT_EQ(view.toEdge().getProperty<int>("since"), 2019);
+}
+
+TEST(RecordViewTest, TypedAdjacencyReadsOnePartition) {
+    EdgeType follows = edgeType("FOLLOWS");
+    EdgeType likes = edgeType("LIKES");
+    Node node(5);
+    for (int id : {30, 10, 20}) {
+        node.addEdge(id, true, follows);
+    }
+    node.addEdge(15, true, likes);
+    node.addEdge(40, true);
+    node.addEdge(7, false, likes);
+    std::string record = node.serialize();
+
+    NodeView view(record);
+    EXPECT_EQ(view.getOutgoingEdges(follows).toVector(), (std::vector<int>{10, 20, 30}));
+    EXPECT_EQ(view.getOutgoingEdges(likes).toVector(), std::vector<int>{15});
+    EXPECT_EQ(view.getOutgoingEdges(EdgeType{}).toVector(), std::vector<int>{40});
+    EXPECT_TRUE(view.getIncomingEdges(follows).empty());
+    EXPECT_EQ(view.getIncomingEdges(likes).toVector(), std::vector<int>{7});
+    EXPECT_TRUE(view.getOutgoingEdges(edgeType("UNUSED_IN_VIEW")).empty());
+    EXPECT_EQ(view.getOutgoingEdges().size(), 5u);
+    EXPECT_EQ(view.getOutgoingEdges().toVector(), node.getOutgoingEdges());
+}
+
+TEST(RecordViewTest, RejectsTextAndTruncatedRecords) {
+    EXPECT_THROW(NodeView(std::string_view("9|0|0||0||")), std::runtime_error);
+
+    Node node(1);
+    node.setProperty("name", std::string("long enough to truncate"));
+    node.addEdge(5, true);
+    std::string record = node.serialize();
+    NodeView view(record.data(), record.size() - 4);
+    EXPECT_THROW(view.getOutgoingEdges(), std::runtime_error);
+}
@@ -0,0 +1,72 @@
+// tests/core/test_set_intersection.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
+#include "core/set_intersection.hpp"
+
+namespace {
+// size distinct ascending ids below range
+std::vector<int> randomSet(size_t size, int range, std::mt19937& rng) {
+    std::vector<int> ids(range);
+    for (int i = 0; i < range; ++i) {
+        ids[i] = i;
+    }
+    std::shuffle(ids.begin(), ids.end(), rng);
+    ids.resize(size);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+std::vector<int> reference(const std::vector<int>& a, const std::vector<int>& b) {
+    std::vector<int> common;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(common));
+    return common;
+}
+}
+
+TEST(SetIntersectionTest, EveryKernelMatchesReference) {
+    std::mt19937 rng(5);
+    // Sizes around each level's block widths exercise the tail handling
+    for (size_t aSize : {0, 1, 7, 8, 9, 15, 16, 17, 33, 200}) {
+        for (size_t bSize : {0, 1, 8, 16, 17, 64, 300}) {
+            for (int range : {400, 1000}) {
+                std::vector<int> a = randomSet(aSize, range, rng);
+                std::vector<int> b = randomSet(bSize, range, rng);
+                std::vector<int> expected = reference(a, b);
+                for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+                    EXPECT_EQ(intersectionSize(a.data(), a.size(), b.data(), b.size(), level), expected.size())
+                        << simdLevelName(level) << " " << aSize << "x" << bSize;
+                }
+                EXPECT_EQ(gallopingIntersectionSize(a.data(), a.size(), b.data(), b.size()), expected.size());
+                EXPECT_EQ(intersectionSize(a.data(), a.size(), b.data(), b.size()), expected.size());
+                std::vector<int> common;
+                intersect(a.data(), a.size(), b.data(), b.size(), common);
+                EXPECT_EQ(common, expected);
+            }
+        }
+    }
+}
+
+TEST(SetIntersectionTest, SkewedAndIdenticalLists) {
+    std::mt19937 rng(11);
+    std::vector<int> large = randomSet(20000, 100000, rng);
+    std::vector<int> small = randomSet(40, 100000, rng);
+    // Some of the short list certainly occurs in the long one
+    small.insert(small.end(), {large[0], large[9999], large.back()});
+    std::sort(small.begin(), small.end());
+    small.erase(std::unique(small.begin(), small.end()), small.end());
+    std::vector<int> expected = reference(small, large);
+    ASSERT_GE(expected.size(), 3u);
+    EXPECT_EQ(intersectionSize(small.data(), small.size(), large.data(), large.size()), expected.size());
+    EXPECT_EQ(intersectionSize(large.data(), large.size(), small.data(), small.size()), expected.size());
+    std::vector<int> common;
+    intersect(large.data(), large.size(), small.data(), small.size(), common);
+    EXPECT_EQ(common, expected);
+
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        EXPECT_EQ(intersectionSize(large.data(), large.size(), large.data(), large.size(), level), large.size());
+    }
+    EXPECT_EQ(gallopingIntersectionSize(large.data(), large.size(), large.data(), large.size()), large.size());
+}
@@ -0,0 +1,137 @@
+// tests/core/test_similarity_search.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include "core/similarity_search.hpp"
+#include "storage/storage_engine.hpp"
+
+namespace {
+std::vector<std::shared_ptr<Node>> makeNodes(size_t count, size_t dimension, PropertyKey key) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> value(-1, 1);
+    std::vector<std::shared_ptr<Node>> nodes;
+    for (size_t i = 0; i < count; ++i) {
+        auto node = std::make_shared<Node>(static_cast<int>(i));
+        std::vector<float> embedding(dimension);
+        for (float& x : embedding) {
+            x = value(rng);
+        }
+        node->setProperty(key, embedding);
+        nodes.push_back(node);
+    }
+    return nodes;
+}
+}
+
+TEST(SimilaritySearchTest, MatchesFullSortForEachMetric) {
+    PropertyKey key = propertyKey("embedding");
+    auto nodes = makeNodes(5000, 24, key);
+    std::vector<float> query = nodes[42]->getProperty<std::vector<float>>(key);
+
+    for (SimilarityMetric metric : {SimilarityMetric::Dot, SimilarityMetric::Cosine, SimilarityMetric::L2}) {
+        std::vector<SimilarityMatch> expected;
+        for (const auto& node : nodes) {
+            const auto& embedding = *node->getProperties().find<std::vector<float>>(key);
+            float score = metric == SimilarityMetric::Dot ? dotProduct(query.data(), embedding.data(), 24)
+                        : metric == SimilarityMetric::Cosine ? cosineSimilarity(query.data(), embedding.data(), 24)
+                        : squaredL2Distance(query.data(), embedding.data(), 24);
+            expected.push_back({node->getId(), score});
+        }
+        std::sort(expected.begin(), expected.end(), [metric](const SimilarityMatch& a, const SimilarityMatch& b) {
+            if (a.score != b.score) {
+                return metric == SimilarityMetric::L2 ? a.score < b.score : a.score > b.score;
+            }
+            return a.nodeId < b.nodeId;
+        });
+
+        for (size_t threads : {1, 4}) {
+            auto matches = topKSimilar(nodes, key, query, 10, metric, threads);
+            ASSERT_EQ(matches.size(), 10u);
+            for (size_t i = 0; i < matches.size(); ++i) {
+                EXPECT_EQ(matches[i].nodeId, expected[i].nodeId);
+                EXPECT_EQ(matches[i].score, expected[i].score);
+            }
+        }
+    }
+    // The query node itself is its own nearest neighbour
+    EXPECT_EQ(topKSimilar(nodes, key, query, 1, SimilarityMetric::L2)[0].nodeId, 42);
+}
+
+TEST(SimilaritySearchTest, SkipsNodesWithoutAMatchingVector) {
+    PropertyKey key = propertyKey("embedding");
+    auto nodes = makeNodes(3, 4, key);
+    nodes.push_back(std::make_shared<Node>(100));
+    auto wrongDimension = std::make_shared<Node>(101);
+    wrongDimension->setProperty(key, std::vector<float>{1, 2});
+    nodes.push_back(wrongDimension);
+
+    auto matches = topKSimilar(nodes, key, {1, 0, 0, 0}, 10);
+    EXPECT_EQ(matches.size(), 3u);
+    EXPECT_TRUE(topKSimilar(nodes, key, {1, 0, 0, 0}, 0).empty());
+
+    auto wrongType = std::make_shared<Node>(102);
+    wrongType->setProperty(key, std::string("0.1,0.2,0.3,0.4"));
+    nodes.push_back(wrongType);
+    EXPECT_THROW(topKSimilar(nodes, key, {1, 0, 0, 0}, 10), std::bad_variant_access);
+}
+
+TEST(SimilaritySearchTest, SkipsNaNScores) {
+    PropertyKey key = propertyKey("embedding");
+    auto nodes = makeNodes(200, 4, key);
+    float nan = std::numeric_limits<float>::quiet_NaN();
+    for (int i = 0; i < 200; i += 3) {
+        nodes[i]->setProperty(key, std::vector<float>{nan, 0, 0, 0});
+    }
+
+    // Cosine scores a NaN norm as zero, so only these two see NaN
+    for (SimilarityMetric metric : {SimilarityMetric::Dot, SimilarityMetric::L2}) {
+        auto matches = topKSimilar(nodes, key, {1, 0.5f, 0, 0}, 200, metric);
+        EXPECT_EQ(matches.size(), 133u);
+        for (size_t i = 0; i < matches.size(); ++i) {
+            EXPECT_FALSE(std::isnan(matches[i].score));
+            EXPECT_NE(matches[i].nodeId % 3, 0);
+            if (i > 0) {
+                EXPECT_TRUE(metric == SimilarityMetric::L2 ? matches[i - 1].score <= matches[i].score
+                                                           : matches[i - 1].score >= matches[i].score);
+            }
+        }
+    }
+}
+
+TEST(SimilaritySearchTest, EngineScanMatchesLoadedNodes) {
+    const std::string dbPath = "test_similarity_search_";
+    StorageEngine::destroy(dbPath);
+    {
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        PropertyKey key = engine.propertyKey("embedding");
+        auto nodes = makeNodes(3000, 16, propertyKey("embedding"));
+        for (const auto& node : nodes) {
+            engine.addNode(*node);
+        }
+        Node other;
+        other.setProperty("embedding", std::vector<float>{1, 2});
+        engine.addNode(other);
+        engine.addNode(Node());
+
+        std::vector<std::shared_ptr<Node>> loaded;
+        for (int id = 0; id < engine.getNodeIdLimit(); ++id) {
+            loaded.push_back(engine.getNode(id));
+        }
+        std::vector<float> query = loaded[5]->getProperty<std::vector<float>>(key);
+        for (SimilarityMetric metric : {SimilarityMetric::Dot, SimilarityMetric::Cosine, SimilarityMetric::L2}) {
+            auto expected = topKSimilar(loaded, key, query, 10, metric, 1);
+            for (size_t threads : {1, 4}) {
+                auto matches = topKSimilar(engine, key, query, 10, metric, threads);
+                ASSERT_EQ(matches.size(), expected.size());
+                for (size_t i = 0; i < matches.size(); ++i) {
+                    EXPECT_EQ(matches[i].nodeId, expected[i].nodeId);
+                    EXPECT_EQ(matches[i].score, expected[i].score);
+                }
+            }
+        }
+        EXPECT_TRUE(topKSimilar(engine, key, query, 0).empty());
+    }
+    StorageEngine::destroy(dbPath);
+}
@@ -0,0 +1,59 @@
+// tests/core/test_vector_kernels.cpp
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "core/vector_kernels.hpp"
+
+namespace {
+struct Reference {
+    double dot = 0;
+    double l2 = 0;
+    double cosine = 0;
+};
+
+Reference reference(const std::vector<float>& a, const std::vector<float>& b) {
+    Reference result;
+    double normA = 0;
+    double normB = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        result.dot += static_cast<double>(a[i]) * b[i];
+        result.l2 += (static_cast<double>(a[i]) - b[i]) * (static_cast<double>(a[i]) - b[i]);
+        normA += static_cast<double>(a[i]) * a[i];
+        normB += static_cast<double>(b[i]) * b[i];
+    }
+    result.cosine = normA > 0 && normB > 0 ? result.dot / std::sqrt(normA * normB) : 0;
+    return result;
+}
+}
+
+TEST(VectorKernelsTest, EveryLevelMatchesReference) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> value(-1, 1);
+    // Sizes around each level's block widths exercise the tail handling
+    for (size_t size : {0, 1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 100, 768}) {
+        std::vector<float> a(size);
+        std::vector<float> b(size);
+        for (size_t i = 0; i < size; ++i) {
+            a[i] = value(rng);
+            b[i] = value(rng);
+        }
+        Reference expected = reference(a, b);
+        double tolerance = 1e-4 * (1 + size);
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+            SCOPED_TRACE(std::string(simdLevelName(level)) + " size " + std::to_string(size));
+            EXPECT_NEAR(dotProduct(a.data(), b.data(), size, level), expected.dot, tolerance);
+            EXPECT_NEAR(squaredL2Distance(a.data(), b.data(), size, level), expected.l2, tolerance);
+            EXPECT_NEAR(cosineSimilarity(a.data(), b.data(), size, level), expected.cosine, 1e-5);
+        }
+        EXPECT_FLOAT_EQ(dotProduct(a.data(), b.data(), size),
+                        dotProduct(a.data(), b.data(), size, detectedSimdLevel()));
+    }
+}
+
+TEST(VectorKernelsTest, CosineOfZeroVectorIsZero) {
+    std::vector<float> zero(20, 0.0f);
+    std::vector<float> ones(20, 1.0f);
+    EXPECT_EQ(cosineSimilarity(zero.data(), ones.data(), zero.size()), 0.0f);
+    EXPECT_NEAR(cosineSimilarity(ones.data(), ones.data(), ones.size()), 1.0f, 1e-6);
+}
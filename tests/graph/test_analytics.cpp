@@ -0,0 +1,228 @@
+// tests/graph/test_analytics.cpp
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <numeric>
+#include <random>
+#include "graph/analytics.hpp"
+
+class AnalyticsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        removeFiles();
+    }
+
+    void TearDown() override {
+        removeFiles();
+    }
+
+    static void removeFiles() {
+        StorageEngine::destroy(dbPath);
+    }
+
+    // Adds nodeCount nodes and the given edges
+    static void load(StorageEngine& engine, int nodeCount, const std::vector<std::pair<int, int>>& edges) {
+        for (int i = 0; i < nodeCount; ++i) {
+            engine.addNode(Node());
+        }
+        for (const auto& [source, target] : edges) {
+            engine.addEdge(Edge(0, source, target, "LINK"));
+        }
+    }
+
+    static CsrGraph build(StorageEngine& engine, CsrDirection direction) {
+        CsrOptions options;
+        options.direction = direction;
+        return CsrGraph::build(engine, options);
+    }
+
+    static std::vector<std::pair<int, int>> randomEdges(int nodeCount, int edgeCount, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> node(0, nodeCount - 1);
+        std::vector<std::pair<int, int>> edges(edgeCount);
+        for (auto& edge : edges) {
+            edge = {node(rng), node(rng)};
+        }
+        return edges;
+    }
+
+    static const std::string dbPath;
+};
+
+const std::string AnalyticsTest::dbPath = "test_analytics_";
+
+TEST_F(AnalyticsTest, PageRankMatchesPowerIteration) {
+    const int nodeCount = 300;
+    // Nodes 250 and up have no outgoing edges, so some rank dangles
+    std::vector<std::pair<int, int>> edges = randomEdges(nodeCount, 1500, 3);
+    edges.erase(std::remove_if(edges.begin(), edges.end(), [](const auto& edge) { return edge.first >= 250; }),
+                edges.end());
+    StorageEngine engine(dbPath, 1 << 22, 16);
+    load(engine, nodeCount, edges);
+    CsrGraph outgoing = build(engine, CsrDirection::Outgoing);
+    CsrGraph incoming = build(engine, CsrDirection::Incoming);
+    EXPECT_THROW(pageRank(outgoing), std::invalid_argument);
+
+    std::vector<int> outDegree(nodeCount);
+    for (const auto& edge : edges) {
+        ++outDegree[edge.first];
+    }
+    std::vector<double> expected(nodeCount, 1.0 / nodeCount);
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        double dangling = 0;
+        for (int v = 0; v < nodeCount; ++v) {
+            dangling += outDegree[v] == 0 ? expected[v] : 0;
+        }
+        std::vector<double> next(nodeCount, (0.15 + 0.85 * dangling) / nodeCount);
+        for (const auto& [source, target] : edges) {
+            next[target] += 0.85 * expected[source] / outDegree[source];
+        }
+        expected = next;
+    }
+
+    std::vector<double> reference;
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        for (size_t threads : {1, 4}) {
+            PageRankOptions options;
+            options.simdLevel = level;
+            options.threadCount = threads;
+            options.tolerance = 1e-12;
+            PageRankResult result = pageRank(incoming, options);
+            EXPECT_TRUE(result.converged);
+            EXPECT_LT(result.delta, 1e-12);
+            EXPECT_NEAR(std::accumulate(result.ranks.begin(), result.ranks.end(), 0.0), 1.0, 1e-9);
+            for (int v = 0; v < nodeCount; ++v) {
+                EXPECT_NEAR(result.ranks[v], expected[v], 1e-10);
+            }
+            if (threads == 1) {
+                reference = result.ranks;
+            } else {
+                EXPECT_EQ(result.ranks, reference);
+            }
+        }
+    }
+
+    PageRankOptions capped;
+    capped.maxIterations = 3;
+    PageRankResult partial = pageRank(incoming, capped);
+    EXPECT_EQ(partial.iterations, 3);
+    EXPECT_FALSE(partial.converged);
+}
+
+TEST_F(AnalyticsTest, ComponentsMatchUndirectedSearch) {
+    // Sparse enough to leave many components, plus one large one
+    const int nodeCount = 2000;
+    std::vector<std::pair<int, int>> edges = randomEdges(nodeCount, 900, 5);
+    for (int v = 1; v < 600; ++v) {
+        edges.emplace_back(v * 7 % 600, (v * 7 + 7) % 600);
+    }
+    StorageEngine engine(dbPath, 1 << 22, 16);
+    load(engine, nodeCount, edges);
+    CsrGraph outgoing = build(engine, CsrDirection::Outgoing);
+    CsrGraph incoming = build(engine, CsrDirection::Incoming);
+
+    std::vector<std::vector<int>> undirected(nodeCount);
+    for (const auto& [source, target] : edges) {
+        undirected[source].push_back(target);
+        undirected[target].push_back(source);
+    }
+    std::vector<int> expected(nodeCount, -1);
+    size_t expectedCount = 0;
+    for (int root = 0; root < nodeCount; ++root) {
+        if (expected[root] >= 0) {
+            continue;
+        }
+        ++expectedCount;
+        std::vector<int> stack = {root};
+        expected[root] = root;
+        while (!stack.empty()) {
+            int node = stack.back();
+            stack.pop_back();
+            for (int next : undirected[node]) {
+                if (expected[next] < 0) {
+                    expected[next] = root;
+                    stack.push_back(next);
+                }
+            }
+        }
+    }
+
+    for (const CsrGraph* backward : {static_cast<const CsrGraph*>(nullptr), static_cast<const CsrGraph*>(&incoming)}) {
+        for (size_t threads : {1, 4}) {
+            for (int rounds : {0, 2}) {
+                ComponentOptions options;
+                options.threadCount = threads;
+                options.neighborRounds = rounds;
+                ComponentResult result = weaklyConnectedComponents(outgoing, options, backward);
+                EXPECT_EQ(result.components, expected);
+                EXPECT_EQ(result.componentCount, expectedCount);
+            }
+        }
+    }
+    // Either direction works as the primary snapshot
+    EXPECT_EQ(weaklyConnectedComponents(incoming, {}, &outgoing).components, expected);
+    EXPECT_THROW(weaklyConnectedComponents(outgoing, {}, &outgoing), std::invalid_argument);
+}
+
+TEST_F(AnalyticsTest, LabelPropagationFindsCliques) {
+    // Two 6-cliques joined by one edge, and an isolated node
+    std::vector<std::pair<int, int>> edges;
+    for (int base : {0, 6}) {
+        for (int a = base; a < base + 6; ++a) {
+            for (int b = a + 1; b < base + 6; ++b) {
+                edges.emplace_back(a, b);
+            }
+        }
+    }
+    edges.emplace_back(5, 6);
+    StorageEngine engine(dbPath, 1 << 20, 8);
+    load(engine, 13, edges);
+    CsrGraph outgoing = build(engine, CsrDirection::Outgoing);
+    CsrGraph incoming = build(engine, CsrDirection::Incoming);
+
+    LabelPropagationResult reference;
+    for (size_t threads : {1, 3}) {
+        LabelPropagationOptions options;
+        options.threadCount = threads;
+        LabelPropagationResult result = labelPropagation(outgoing, options, &incoming);
+        EXPECT_TRUE(result.converged);
+        EXPECT_EQ(result.communityCount, 3u);
+        for (int v = 0; v < 6; ++v) {
+            EXPECT_EQ(result.labels[v], result.labels[0]);
+            EXPECT_EQ(result.labels[v + 6], result.labels[6]);
+        }
+        EXPECT_NE(result.labels[0], result.labels[6]);
+        EXPECT_EQ(result.labels[12], 12);
+        if (threads == 1) {
+            reference = result;
+        } else {
+            EXPECT_EQ(result.labels, reference.labels);
+        }
+    }
+    EXPECT_THROW(labelPropagation(outgoing, {}, &outgoing), std::invalid_argument);
+}
+
+TEST_F(AnalyticsTest, ResultsAreWrittenBackAsProperties) {
+    StorageEngine engine(dbPath, 1 << 20, 8);
+    load(engine, 5, {{0, 1}, {1, 2}, {3, 4}});
+    engine.flush();
+    engine.addNodePropertyIndex("component", IndexType::Int);
+    CsrGraph outgoing = build(engine, CsrDirection::Outgoing);
+    CsrGraph incoming = build(engine, CsrDirection::Incoming);
+
+    // Node 1 is cached and goes through the cache; the others are written directly
+    engine.getNode(1);
+    ComponentResult components = weaklyConnectedComponents(outgoing, {}, &incoming);
+    EXPECT_EQ(writeNodeProperty(engine, "component", components.components), 5u);
+    PageRankResult ranks = pageRank(incoming);
+    EXPECT_EQ(writeNodeProperty(engine, "rank", ranks.ranks), 5u);
+
+    for (int v = 0; v < 5; ++v) {
+        EXPECT_EQ(engine.getNode(v)->getProperty<int>("component"), components.components[v]);
+        EXPECT_EQ(engine.getNode(v)->getProperty<double>("rank"), ranks.ranks[v]);
+    }
+    EXPECT_EQ(engine.findNodesByProperty("component", 3), (std::vector<int>{3, 4}));
+    // Ids past the stored nodes are skipped
+    EXPECT_EQ(engine.updateNodes({4, 5, 99}, [](Node& node) { node.setProperty("seen", true); }), 1u);
+}
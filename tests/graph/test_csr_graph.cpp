@@ -0,0 +1,212 @@
+// tests/graph/test_csr_graph.cpp
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include "graph/csr_graph.hpp"
+
+class CsrGraphTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        removeFiles();
+    }
+
+    void TearDown() override {
+        removeFiles();
+    }
+
+    static void removeFiles() {
+        StorageEngine::destroy(dbPath);
+        std::remove((dbPath + "graph.csr").c_str());
+    }
+
+    static int addEdge(StorageEngine& engine, int source, int target, const std::string& type, double weight) {
+        Edge edge(0, source, target, type);
+        edge.setProperty("weight", weight);
+        return engine.addEdge(edge);
+    }
+
+    static std::vector<int> toVector(CsrGraph::Range<int> range) {
+        return std::vector<int>(range.begin(), range.end());
+    }
+
+    static const std::string dbPath;
+};
+
+const std::string CsrGraphTest::dbPath = "test_csr_graph_";
+
+TEST_F(CsrGraphTest, BuildsSortedRowsWithTypesAndWeights) {
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    for (int i = 0; i < 5; ++i) {
+        engine.addNode(Node());
+    }
+    int e0 = addEdge(engine, 0, 3, "KNOWS", 0.5);
+    int e1 = addEdge(engine, 0, 1, "LIKES", 2.0);
+    int e2 = addEdge(engine, 2, 0, "KNOWS", 1.5);
+    Edge unweighted(0, 0, 1, "KNOWS");
+    unweighted.setProperty("weight", std::string("heavy"));
+    int e3 = engine.addEdge(unweighted);
+
+    CsrOptions options;
+    options.edgeTypes = true;
+    options.weightProperty = "weight";
+    options.defaultWeight = 7.0;
+    CsrGraph graph = CsrGraph::build(engine, options);
+
+    EXPECT_EQ(graph.nodeCount(), 5u);
+    EXPECT_EQ(graph.edgeCount(), 4u);
+    // By target, then edge id
+    EXPECT_EQ(toVector(graph.neighbors(0)), (std::vector<int>{1, 1, 3}));
+    EXPECT_EQ(toVector(graph.edgeIds(0)), (std::vector<int>{e1, e3, e0}));
+    EXPECT_EQ(graph.edgeTypes(0)[0], engine.edgeType("LIKES"));
+    EXPECT_EQ(graph.weights(0)[0], 2.0);
+    EXPECT_EQ(graph.weights(0)[1], 7.0);
+    EXPECT_EQ(toVector(graph.edgeIds(2)), (std::vector<int>{e2}));
+    EXPECT_TRUE(graph.neighbors(4).empty());
+    EXPECT_EQ(graph.degree(1), 0u);
+}
+
+TEST_F(CsrGraphTest, ParallelBuildMatchesSingleThreaded) {
+    StorageEngine engine(dbPath, 1 << 16, 16);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> node(0, 499);
+    for (int i = 0; i < 500; ++i) {
+        engine.addNode(Node());
+    }
+    for (int i = 0; i < 5000; ++i) {
+        engine.addEdge(Edge(0, node(rng), node(rng), "E"));
+    }
+
+    CsrOptions options;
+    options.threadCount = 1;
+    CsrGraph serial = CsrGraph::build(engine, options);
+    options.threadCount = 4;
+    CsrGraph parallel = CsrGraph::build(engine, options);
+    ASSERT_EQ(serial.edgeCount(), 5000u);
+    ASSERT_EQ(parallel.edgeCount(), 5000u);
+    EXPECT_TRUE(std::equal(serial.offsets(), serial.offsets() + serial.nodeCount() + 1, parallel.offsets()));
+    EXPECT_TRUE(std::equal(serial.edgeIds(), serial.edgeIds() + serial.edgeCount(), parallel.edgeIds()));
+}
+
+TEST_F(CsrGraphTest, IncomingSnapshotsFileEdgesUnderTheirTargets) {
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    for (int i = 0; i < 3; ++i) {
+        engine.addNode(Node());
+    }
+    int e0 = addEdge(engine, 0, 2, "E", 1.0);
+    int e1 = addEdge(engine, 1, 2, "E", 2.0);
+    CsrOptions options;
+    options.direction = CsrDirection::Incoming;
+    options.weightProperty = "weight";
+    CsrGraph graph = CsrGraph::build(engine, options);
+    EXPECT_TRUE(graph.isIncoming());
+    EXPECT_EQ(toVector(graph.neighbors(2)), (std::vector<int>{0, 1}));
+    EXPECT_EQ(toVector(graph.edgeIds(2)), (std::vector<int>{e0, e1}));
+    EXPECT_TRUE(graph.neighbors(0).empty());
+
+    int e2 = addEdge(engine, 2, 0, "E", 3.0);
+    engine.updateEdge(e1, [](Edge& edge) { edge.setProperty("weight", 5.0); });
+    graph.refresh(engine);
+    EXPECT_EQ(toVector(graph.edgeIds(0)), (std::vector<int>{e2}));
+    EXPECT_EQ(graph.weights(2)[1], 5.0);
+
+    graph.save(dbPath + "graph.csr");
+    EXPECT_TRUE(CsrGraph::load(dbPath + "graph.csr").isIncoming());
+}
+
+TEST_F(CsrGraphTest, RefreshMergesNewEdgesAndWeights) {
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    for (int i = 0; i < 3; ++i) {
+        engine.addNode(Node());
+    }
+    int first = addEdge(engine, 0, 2, "E", 1.0);
+    CsrOptions options;
+    options.weightProperty = "weight";
+    CsrGraph graph = CsrGraph::build(engine, options);
+
+    int node = engine.addNode(Node());
+    int second = addEdge(engine, 0, 1, "E", 3.0);
+    int third = addEdge(engine, node, 0, "E", 4.0);
+    engine.updateEdge(first, [](Edge& edge) { edge.setProperty("weight", 9.0); });
+    graph.refresh(engine);
+
+    EXPECT_EQ(graph.nodeCount(), 4u);
+    EXPECT_EQ(graph.edgeCount(), 3u);
+    EXPECT_EQ(toVector(graph.edgeIds(0)), (std::vector<int>{second, first}));
+    EXPECT_EQ(graph.weights(0)[1], 9.0);
+    EXPECT_EQ(toVector(graph.edgeIds(node)), (std::vector<int>{third}));
+
+    // Nothing new: refresh is a no-op
+    graph.refresh(engine);
+    EXPECT_EQ(graph.edgeCount(), 3u);
+}
+
+TEST_F(CsrGraphTest, SavedSnapshotsAreMappedBack) {
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    for (int i = 0; i < 4; ++i) {
+        engine.addNode(Node());
+    }
+    addEdge(engine, 1, 2, "A", 0.25);
+    addEdge(engine, 1, 3, "B", 0.75);
+    CsrOptions options;
+    options.edgeTypes = true;
+    options.weightProperty = "weight";
+    CsrGraph built = CsrGraph::build(engine, options);
+    built.save(dbPath + "graph.csr");
+
+    CsrGraph loaded = CsrGraph::load(dbPath + "graph.csr");
+    EXPECT_EQ(loaded.nodeCount(), 4u);
+    EXPECT_EQ(toVector(loaded.neighbors(1)), (std::vector<int>{2, 3}));
+    EXPECT_EQ(loaded.edgeTypes(1)[1], engine.edgeType("B"));
+    EXPECT_EQ(loaded.weights(1)[0], 0.25);
+    EXPECT_EQ(loaded.getOptions().weightProperty, "weight");
+
+    // Same engine, so refresh can apply just the new edge to the mapped arrays
+    int added = addEdge(engine, 3, 0, "A", 2.0);
+    loaded.refresh(engine);
+    EXPECT_EQ(toVector(loaded.edgeIds(3)), (std::vector<int>{added}));
+    EXPECT_EQ(toVector(loaded.neighbors(1)), (std::vector<int>{2, 3}));
+}
+
+TEST_F(CsrGraphTest, LoadRejectsOtherFiles) {
+    {
+        std::ofstream file(dbPath + "graph.csr", std::ios::binary);
+        file << "not a graph";
+    }
+    EXPECT_THROW(CsrGraph::load(dbPath + "graph.csr"), std::runtime_error);
+    EXPECT_THROW(CsrGraph::load(dbPath + "missing.csr"), std::runtime_error);
+}
+
+TEST_F(CsrGraphTest, LoadRejectsOutOfRangeRows) {
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    for (int i = 0; i < 4; ++i) {
+        engine.addNode(Node());
+    }
+    addEdge(engine, 1, 2, "A", 1.0);
+    addEdge(engine, 1, 3, "A", 1.0);
+    CsrGraph::build(engine).save(dbPath + "graph.csr");
+    std::string saved;
+    {
+        std::ifstream file(dbPath + "graph.csr", std::ios::binary);
+        saved.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    // Without types or weights the file ends with the five offsets, then the
+    // two targets and the two edge ids, each array padded to 8 bytes
+    size_t targets = saved.size() - 16;
+    size_t offsets = targets - 5 * sizeof(uint64_t);
+    auto loadPatched = [&](size_t position, const auto& value) {
+        std::string patched = saved;
+        std::memcpy(&patched[position], &value, sizeof(value));
+        {
+            std::ofstream file(dbPath + "graph.csr", std::ios::binary | std::ios::trunc);
+            file.write(patched.data(), patched.size());
+        }
+        return CsrGraph::load(dbPath + "graph.csr");
+    };
+    EXPECT_EQ(loadPatched(targets, 3).neighbors(1).size(), 2u);
+    EXPECT_THROW(loadPatched(targets, 4), std::runtime_error);
+    EXPECT_THROW(loadPatched(targets + sizeof(int), -1), std::runtime_error);
+    EXPECT_THROW(loadPatched(offsets + sizeof(uint64_t), uint64_t{3}), std::runtime_error);
+}
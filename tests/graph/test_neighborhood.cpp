@@ -0,0 +1,152 @@
+// tests/graph/test_neighborhood.cpp
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <random>
+#include <set>
+#include "graph/neighborhood.hpp"
+
+class NeighborhoodTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        removeFiles();
+    }
+
+    void TearDown() override {
+        removeFiles();
+    }
+
+    static void removeFiles() {
+        StorageEngine::destroy(dbPath);
+    }
+
+    static void load(StorageEngine& engine, int nodeCount, const std::vector<std::pair<int, int>>& edges) {
+        for (int i = 0; i < nodeCount; ++i) {
+            engine.addNode(Node());
+        }
+        for (const auto& [source, target] : edges) {
+            engine.addEdge(Edge(0, source, target, "LINK"));
+        }
+    }
+
+    static CsrGraph build(StorageEngine& engine, CsrDirection direction) {
+        CsrOptions options;
+        options.direction = direction;
+        return CsrGraph::build(engine, options);
+    }
+
+    // Undirected neighbor sets straight from the edge list
+    static std::vector<std::set<int>> expectedSets(int nodeCount, const std::vector<std::pair<int, int>>& edges) {
+        std::vector<std::set<int>> sets(nodeCount);
+        for (const auto& [source, target] : edges) {
+            if (source != target) {
+                sets[source].insert(target);
+                sets[target].insert(source);
+            }
+        }
+        return sets;
+    }
+
+    static const std::string dbPath;
+};
+
+const std::string NeighborhoodTest::dbPath = "test_neighborhood_";
+
+TEST_F(NeighborhoodTest, NeighborSetsAreSortedSimpleAndUndirected) {
+    // Parallel edges both ways and a self loop collapse to single entries
+    std::vector<std::pair<int, int>> edges = {{0, 1}, {1, 0}, {0, 1}, {0, 0}, {2, 0}, {1, 3}};
+    StorageEngine engine(dbPath, 1 << 22, 16);
+    load(engine, 5, edges);
+    CsrGraph outgoing = build(engine, CsrDirection::Outgoing);
+    CsrGraph incoming = build(engine, CsrDirection::Incoming);
+    EXPECT_THROW(NeighborSets::build(outgoing, &outgoing), std::invalid_argument);
+
+    NeighborSets sets = NeighborSets::build(outgoing, &incoming);
+    ASSERT_EQ(sets.nodeCount(), 5u);
+    EXPECT_EQ(sets.entryCount(), 6u);
+    std::vector<int> zero(sets.neighbors(0).begin(), sets.neighbors(0).end());
+    EXPECT_EQ(zero, std::vector<int>({1, 2}));
+    EXPECT_EQ(sets.degree(4), 0u);
+
+    // Without incoming only the rows of the snapshot count
+    NeighborSets out = NeighborSets::build(outgoing);
+    std::vector<int> outZero(out.neighbors(0).begin(), out.neighbors(0).end());
+    EXPECT_EQ(outZero, std::vector<int>({1}));
+    EXPECT_TRUE(sets.isUndirected());
+    EXPECT_FALSE(out.isUndirected());
+}
+
+TEST_F(NeighborhoodTest, SimilarityQueriesMatchSets) {
+    const int nodeCount = 200;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> node(0, nodeCount - 1);
+    std::vector<std::pair<int, int>> edges(3000);
+    for (auto& edge : edges) {
+        edge = {node(rng), node(rng)};
+    }
+    StorageEngine engine(dbPath, 1 << 22, 16);
+    load(engine, nodeCount, edges);
+    CsrGraph outgoing = build(engine, CsrDirection::Outgoing);
+    CsrGraph incoming = build(engine, CsrDirection::Incoming);
+    NeighborSets sets = NeighborSets::build(outgoing, &incoming);
+    std::vector<std::set<int>> expected = expectedSets(nodeCount, edges);
+
+    for (int a = 0; a < nodeCount; a += 7) {
+        for (int b = 0; b < nodeCount; b += 5) {
+            std::vector<int> common;
+            for (int id : expected[a]) {
+                if (expected[b].count(id)) {
+                    common.push_back(id);
+                }
+            }
+            size_t together = expected[a].size() + expected[b].size() - common.size();
+            EXPECT_EQ(sets.commonNeighbors(a, b), common);
+            EXPECT_EQ(sets.commonNeighborCount(a, b), common.size());
+            EXPECT_DOUBLE_EQ(sets.jaccard(a, b), together == 0 ? 0.0 : static_cast<double>(common.size()) / together);
+        }
+    }
+    EXPECT_DOUBLE_EQ(sets.jaccard(0, 0), expected[0].empty() ? 0.0 : 1.0);
+    EXPECT_THROW(sets.jaccard(0, nodeCount), std::invalid_argument);
+    EXPECT_THROW(sets.commonNeighborCount(-1, 0), std::invalid_argument);
+}
+
+TEST_F(NeighborhoodTest, TriangleCountMatchesBruteForce) {
+    // A few hubs tied to many nodes make the degree ordering matter; enough
+    // nodes that more than one thread is used
+    const int nodeCount = 9000;
+    std::mt19937 rng(13);
+    std::uniform_int_distribution<int> node(0, nodeCount - 1);
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i < 40000; ++i) {
+        edges.push_back({node(rng), node(rng)});
+    }
+    for (int hub = 0; hub < 3; ++hub) {
+        for (int v = 0; v < nodeCount; v += 4) {
+            edges.push_back({hub, v});
+        }
+    }
+    StorageEngine engine(dbPath, 1 << 22, 16);
+    load(engine, nodeCount, edges);
+    CsrGraph outgoing = build(engine, CsrDirection::Outgoing);
+    CsrGraph incoming = build(engine, CsrDirection::Incoming);
+
+    std::vector<std::set<int>> expected = expectedSets(nodeCount, edges);
+    uint64_t triangles = 0;
+    for (int a = 0; a < nodeCount; ++a) {
+        for (int b : expected[a]) {
+            if (b <= a) {
+                continue;
+            }
+            for (int c : expected[b]) {
+                triangles += c > b && expected[a].count(c);
+            }
+        }
+    }
+    ASSERT_GT(triangles, 0u);
+    for (size_t threads : {1, 3, 8}) {
+        NeighborSets sets = NeighborSets::build(outgoing, &incoming, threads);
+        EXPECT_EQ(countTriangles(sets, threads), triangles) << threads << " threads";
+    }
+    EXPECT_EQ(countTriangles(NeighborSets()), 0u);
+    // One-way lists would miss triangles whose edges point away from the kept end
+    EXPECT_THROW(countTriangles(NeighborSets::build(outgoing)), std::invalid_argument);
+}
@@ -0,0 +1,182 @@
+// tests/graph/test_shortest_paths.cpp
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <functional>
+#include <queue>
+#include <random>
+#include "graph/shortest_paths.hpp"
+
+class ShortestPathsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        removeFiles();
+    }
+
+    void TearDown() override {
+        removeFiles();
+    }
+
+    static void removeFiles() {
+        StorageEngine::destroy(dbPath);
+    }
+
+    static int addEdge(StorageEngine& engine, int source, int target, double cost) {
+        Edge edge(0, source, target, "ROAD");
+        edge.setProperty("cost", cost);
+        return engine.addEdge(edge);
+    }
+
+    static CsrGraph build(StorageEngine& engine, CsrDirection direction) {
+        CsrOptions options;
+        options.direction = direction;
+        options.weightProperty = "cost";
+        return CsrGraph::build(engine, options);
+    }
+
+    static const std::string dbPath;
+};
+
+const std::string ShortestPathsTest::dbPath = "test_shortest_paths_";
+
+TEST_F(ShortestPathsTest, PointQueriesOnSmallGraph) {
+    // 0 -> 1 -> 3 costs 1 + 5, 0 -> 2 -> 3 costs 2 + 1; 4 is unreachable
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    for (int i = 0; i < 5; ++i) {
+        engine.addNode(Node());
+    }
+    addEdge(engine, 0, 1, 1.0);
+    int e02 = addEdge(engine, 0, 2, 2.0);
+    addEdge(engine, 1, 3, 5.0);
+    int e23 = addEdge(engine, 2, 3, 1.0);
+    addEdge(engine, 4, 0, 1.0);
+    CsrGraph graph = build(engine, CsrDirection::Outgoing);
+    CsrGraph incoming = build(engine, CsrDirection::Incoming);
+
+    for (const CsrGraph* backward : {static_cast<const CsrGraph*>(nullptr), static_cast<const CsrGraph*>(&incoming)}) {
+        ShortestPath path = shortestPath(graph, 0, 3, backward);
+        EXPECT_EQ(path.distance, 3.0);
+        EXPECT_EQ(path.nodes, (std::vector<int>{0, 2, 3}));
+        EXPECT_EQ(path.edgeIds, (std::vector<int>{e02, e23}));
+
+        ShortestPath none = shortestPath(graph, 0, 4, backward);
+        EXPECT_EQ(none.distance, std::numeric_limits<double>::infinity());
+        EXPECT_TRUE(none.nodes.empty());
+
+        ShortestPath self = shortestPath(graph, 2, 2, backward);
+        EXPECT_EQ(self.distance, 0.0);
+        EXPECT_EQ(self.nodes, (std::vector<int>{2}));
+    }
+
+    ShortestPathOptions options;
+    options.recordParents = true;
+    ShortestPathTree tree = shortestPathTree(graph, 0, options);
+    EXPECT_EQ(tree.distances, (std::vector<double>{0, 1, 2, 3, std::numeric_limits<double>::infinity()}));
+    EXPECT_EQ(tree.parents, (std::vector<int>{-1, 0, 0, 2, -1}));
+    EXPECT_EQ(tree.parentEdges[3], e23);
+}
+
+TEST_F(ShortestPathsTest, MatchesReferenceDijkstra) {
+    const int nodeCount = 500;
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> node(0, nodeCount - 1);
+    // Some zero and many repeated weights to exercise ties
+    std::uniform_int_distribution<int> cost(0, 20);
+    StorageEngine engine(dbPath, 1 << 22, 16);
+    for (int i = 0; i < nodeCount; ++i) {
+        engine.addNode(Node());
+    }
+    std::vector<std::vector<std::pair<int, double>>> adjacency(nodeCount);
+    for (int i = 0; i < 4 * nodeCount; ++i) {
+        int source = node(rng);
+        int target = node(rng);
+        double weight = cost(rng) * 0.25;
+        addEdge(engine, source, target, weight);
+        adjacency[source].emplace_back(target, weight);
+    }
+    CsrGraph graph = build(engine, CsrDirection::Outgoing);
+    CsrGraph incoming = build(engine, CsrDirection::Incoming);
+
+    auto reference = [&](int source) {
+        std::vector<double> distances(nodeCount, std::numeric_limits<double>::infinity());
+        using Entry = std::pair<double, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        distances[source] = 0;
+        queue.emplace(0, source);
+        while (!queue.empty()) {
+            auto [distance, current] = queue.top();
+            queue.pop();
+            if (distance > distances[current]) {
+                continue;
+            }
+            for (const auto& [next, weight] : adjacency[current]) {
+                if (distance + weight < distances[next]) {
+                    distances[next] = distance + weight;
+                    queue.emplace(distances[next], next);
+                }
+            }
+        }
+        return distances;
+    };
+
+    for (int source : {0, 7, 123}) {
+        std::vector<double> expected = reference(source);
+        for (size_t threads : {1, 4}) {
+            for (double delta : {0.0, 0.1, 100.0}) {
+                ShortestPathOptions options;
+                options.threadCount = threads;
+                options.delta = delta;
+                options.recordParents = true;
+                ShortestPathTree tree = shortestPathTree(graph, source, options);
+                EXPECT_EQ(tree.distances, expected);
+                for (int target = 0; target < nodeCount; ++target) {
+                    if (target != source && expected[target] < std::numeric_limits<double>::infinity()) {
+                        ASSERT_GE(tree.parents[target], 0);
+                        EXPECT_LE(expected[tree.parents[target]], expected[target]);
+                    }
+                }
+            }
+        }
+        for (int target = 0; target < nodeCount; target += 37) {
+            EXPECT_EQ(shortestPath(graph, source, target).distance, expected[target]);
+            ShortestPath path = shortestPath(graph, source, target, &incoming);
+            EXPECT_EQ(path.distance, expected[target]);
+            if (!path.nodes.empty()) {
+                EXPECT_EQ(path.nodes.front(), source);
+                EXPECT_EQ(path.nodes.back(), target);
+                EXPECT_EQ(path.edgeIds.size() + 1, path.nodes.size());
+            }
+        }
+    }
+}
+
+TEST_F(ShortestPathsTest, RejectsUnusableInput) {
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    for (int i = 0; i < 3; ++i) {
+        engine.addNode(Node());
+    }
+    addEdge(engine, 0, 1, 1.0);
+    addEdge(engine, 1, 2, -1.0);
+    CsrGraph graph = build(engine, CsrDirection::Outgoing);
+    EXPECT_THROW(shortestPathTree(graph, 0), std::invalid_argument);
+    EXPECT_THROW(shortestPath(graph, 0, 2), std::invalid_argument);
+    EXPECT_THROW(shortestPath(graph, 0, 3), std::invalid_argument);
+    EXPECT_THROW(shortestPath(graph, 0, 1, &graph), std::invalid_argument);
+    EXPECT_THROW(shortestPathTree(CsrGraph::build(engine), 0), std::invalid_argument);
+}
+
+TEST_F(ShortestPathsTest, RejectsNonFiniteWeights) {
+    for (double weight : {std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN()}) {
+        removeFiles();
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        for (int i = 0; i < 3; ++i) {
+            engine.addNode(Node());
+        }
+        addEdge(engine, 0, 1, 1.0);
+        addEdge(engine, 1, 2, weight);
+        CsrGraph graph = build(engine, CsrDirection::Outgoing);
+        CsrGraph reverse = build(engine, CsrDirection::Incoming);
+        EXPECT_THROW(shortestPathTree(graph, 0), std::invalid_argument) << weight;
+        EXPECT_THROW(shortestPath(graph, 0, 2), std::invalid_argument) << weight;
+        EXPECT_THROW(shortestPath(graph, 0, 2, &reverse), std::invalid_argument) << weight;
+    }
+}
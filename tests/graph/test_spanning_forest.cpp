@@ -0,0 +1,130 @@
+// tests/graph/test_spanning_forest.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include "graph/spanning_forest.hpp"
+
+namespace {
+const SpanningForestAlgorithm ALGORITHMS[] = {SpanningForestAlgorithm::Kruskal, SpanningForestAlgorithm::Boruvka};
+
+// Textbook sequential Kruskal with a plain union-find
+SpanningForest reference(size_t nodeCount, std::vector<WeightedEdge> edges) {
+    std::sort(edges.begin(), edges.end(), [](const WeightedEdge& a, const WeightedEdge& b) {
+        return a.weight != b.weight ? a.weight < b.weight : a.id < b.id;
+    });
+    std::vector<int> parent(nodeCount);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](int id) {
+        while (parent[id] != id) {
+            id = parent[id];
+        }
+        return id;
+    };
+    std::vector<std::pair<int, double>> chosen;
+    for (const WeightedEdge& edge : edges) {
+        int a = find(edge.source);
+        int b = find(edge.target);
+        if (a != b) {
+            parent[a] = b;
+            chosen.emplace_back(edge.id, edge.weight);
+        }
+    }
+    std::sort(chosen.begin(), chosen.end());
+    SpanningForest forest;
+    for (const auto& [id, weight] : chosen) {
+        forest.edgeIds.push_back(id);
+        forest.totalWeight += weight;
+    }
+    forest.componentCount = nodeCount - chosen.size();
+    return forest;
+}
+}
+
+TEST(SpanningForestTest, SmallGraphWithTiesAndIsolatedNodes) {
+    // Square 0-1-2-3 with equal-weight sides and a heavy diagonal; 4 and 5
+    // form their own tree and 6 is isolated
+    std::vector<WeightedEdge> edges = {
+        {1.0, 0, 1, 10}, {1.0, 1, 2, 11}, {1.0, 2, 3, 12}, {1.0, 3, 0, 13},
+        {5.0, 0, 2, 14}, {2.0, 4, 5, 15}, {0.5, 5, 5, 16},
+    };
+    for (SpanningForestAlgorithm algorithm : ALGORITHMS) {
+        SpanningForest forest = minimumSpanningForest(7, edges, algorithm);
+        EXPECT_EQ(forest.edgeIds, (std::vector<int>{10, 11, 12, 15}));
+        EXPECT_EQ(forest.totalWeight, 5.0);
+        EXPECT_EQ(forest.componentCount, 3u);
+    }
+}
+
+TEST(SpanningForestTest, RandomGraphsMatchReference) {
+    std::mt19937 rng(21);
+    for (int round = 0; round < 3; ++round) {
+        size_t nodeCount = 3000;
+        std::uniform_int_distribution<int> node(0, nodeCount - 1);
+        // Few distinct weights, so ties are common
+        std::uniform_int_distribution<int> weight(0, 20);
+        std::vector<WeightedEdge> edges;
+        for (int id = 0; id < 40000; ++id) {
+            edges.push_back({static_cast<double>(weight(rng)), node(rng), node(rng), id});
+        }
+        // Ignored: NaN has no place in the order
+        edges.push_back({std::nan(""), 0, 1, 40000});
+
+        SpanningForest expected = reference(nodeCount, std::vector<WeightedEdge>(edges.begin(), edges.end() - 1));
+        for (SpanningForestAlgorithm algorithm : ALGORITHMS) {
+            for (size_t threads : {1, 4}) {
+                SpanningForest forest = minimumSpanningForest(nodeCount, edges, algorithm, threads);
+                EXPECT_EQ(forest.edgeIds, expected.edgeIds);
+                EXPECT_EQ(forest.totalWeight, expected.totalWeight);
+                EXPECT_EQ(forest.componentCount, expected.componentCount);
+            }
+        }
+    }
+}
+
+TEST(SpanningForestTest, RejectsEndpointsOutsideTheNodeRange) {
+    std::vector<WeightedEdge> edges = {{1.0, 0, 3, 0}};
+    EXPECT_THROW(minimumSpanningForest(3, edges), std::invalid_argument);
+    EXPECT_EQ(minimumSpanningForest(0, {}).componentCount, 0u);
+}
+
+TEST(SpanningForestTest, RunsOverStoredEdgesAndSnapshots) {
+    const std::string dbPath = "test_spanning_forest_";
+    StorageEngine::destroy(dbPath);
+    {
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        for (int i = 0; i < 4; ++i) {
+            engine.addNode(Node());
+        }
+        auto addEdge = [&](int source, int target, auto weight) {
+            Edge edge(0, source, target, "ROAD");
+            edge.setProperty("cost", weight);
+            return engine.addEdge(edge);
+        };
+        int a = addEdge(0, 1, 4.0);
+        int b = addEdge(1, 2, 1);
+        addEdge(0, 2, 7.5);
+        int c = addEdge(3, 2, 2.5);
+        // No cost: left out
+        engine.addEdge(Edge(0, 0, 3, "ROAD"));
+
+        for (SpanningForestAlgorithm algorithm : ALGORITHMS) {
+            SpanningForest stored = minimumSpanningForest(engine, "cost", algorithm);
+            EXPECT_EQ(stored.edgeIds, (std::vector<int>{a, b, c}));
+            EXPECT_EQ(stored.totalWeight, 7.5);
+            EXPECT_EQ(stored.componentCount, 1u);
+        }
+        EXPECT_EQ(minimumSpanningForest(engine, "unknown_cost").componentCount, 4u);
+
+        CsrOptions options;
+        options.weightProperty = "cost";
+        options.defaultWeight = 100;
+        CsrGraph graph = CsrGraph::build(engine, options);
+        SpanningForest snapshot = minimumSpanningForest(graph, SpanningForestAlgorithm::Boruvka);
+        EXPECT_EQ(snapshot.edgeIds, (std::vector<int>{a, b, c}));
+        EXPECT_THROW(minimumSpanningForest(CsrGraph::build(engine)), std::invalid_argument);
+    }
+    StorageEngine::destroy(dbPath);
+}
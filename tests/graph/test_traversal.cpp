@@ -0,0 +1,179 @@
+// tests/graph/test_traversal.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <queue>
+#include <random>
+#include "graph/traversal.hpp"
+
+class TraversalTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        removeFiles();
+    }
+
+    void TearDown() override {
+        removeFiles();
+    }
+
+    static void removeFiles() {
+        StorageEngine::destroy(dbPath);
+    }
+
+    // Stores nodes [0, nodeCount) with the given edges as their outgoing
+    // adjacency. Ids are handed out from 0 in a fresh database.
+    static void store(StorageEngine& engine, int nodeCount, const std::vector<std::pair<int, int>>& edges) {
+        std::vector<Node> nodes(nodeCount);
+        for (const auto& [source, target] : edges) {
+            nodes[source].addEdge(engine.addEdge(Edge(0, source, target, "E")), true);
+        }
+        for (const Node& node : nodes) {
+            engine.addNode(node);
+        }
+    }
+
+    static std::map<int, int> depthsOf(const TraversalResult& result) {
+        std::map<int, int> depths;
+        for (size_t i = 0; i < result.nodes.size(); ++i) {
+            depths[result.nodes[i]] = result.depths[i];
+        }
+        return depths;
+    }
+
+    static const std::string dbPath;
+};
+
+const std::string TraversalTest::dbPath = "test_traversal_";
+
+TEST_F(TraversalTest, DepthsAndParentsOnSmallGraph) {
+    // 0 -> 1 -> 2 -> 3, 0 -> 4 -> 2, 5 -> 0; 6 is isolated
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    store(engine, 7, {{0, 1}, {1, 2}, {2, 3}, {0, 4}, {4, 2}, {5, 0}});
+    CsrGraph graph = CsrGraph::build(engine);
+    CsrOptions incomingOptions;
+    incomingOptions.direction = CsrDirection::Incoming;
+    CsrGraph incoming = CsrGraph::build(engine, incomingOptions);
+
+    TraversalOptions options;
+    options.recordParents = true;
+    options.threadCount = 1;
+    std::map<int, int> expected = {{0, 0}, {1, 1}, {4, 1}, {2, 2}, {3, 3}};
+    for (const TraversalResult& result : {breadthFirstSearch(graph, {0}, options),
+                                          breadthFirstSearch(graph, {0}, options, &incoming),
+                                          breadthFirstSearch(engine, {0}, options)}) {
+        EXPECT_EQ(depthsOf(result), expected);
+        EXPECT_EQ(result.nodes.front(), 0);
+        EXPECT_EQ(result.parents.front(), -1);
+        EXPECT_FALSE(result.stoppedEarly);
+    }
+    // Top-down looks at each reached node's row once
+    EXPECT_EQ(breadthFirstSearch(graph, {0}, options).edgesExamined, 5u);
+    EXPECT_EQ(breadthFirstSearch(engine, {0}, options).edgesExamined, 5u);
+
+    // Walking an Incoming snapshot follows edges backwards
+    std::map<int, int> upstream = {{2, 0}, {1, 1}, {4, 1}, {0, 2}, {5, 3}};
+    EXPECT_EQ(depthsOf(breadthFirstSearch(incoming, {2}, options)), upstream);
+    EXPECT_EQ(depthsOf(breadthFirstSearch(incoming, {2}, options, &graph)), upstream);
+
+    std::map<int, int> twoHops = {{0, 0}, {1, 1}, {4, 1}, {2, 2}};
+    EXPECT_EQ(depthsOf(kHopNeighborhood(graph, 0, 2, options)), twoHops);
+    EXPECT_EQ(depthsOf(kHopNeighborhood(engine, 0, 2, options)), twoHops);
+    EXPECT_EQ(depthsOf(kHopNeighborhood(graph, 6, 3, options)), (std::map<int, int>{{6, 0}}));
+}
+
+TEST_F(TraversalTest, MatchesReferenceAcrossDirectionsAndThreads) {
+    const int nodeCount = 1000;
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> node(0, nodeCount - 1);
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i < 8 * nodeCount; ++i) {
+        edges.emplace_back(node(rng), node(rng));
+    }
+    StorageEngine engine(dbPath, 1 << 22, 16);
+    store(engine, nodeCount, edges);
+    CsrGraph graph = CsrGraph::build(engine);
+    CsrOptions incomingOptions;
+    incomingOptions.direction = CsrDirection::Incoming;
+    CsrGraph incoming = CsrGraph::build(engine, incomingOptions);
+
+    // Plain queue-based BFS from nodes 0 and 1
+    std::vector<std::vector<int>> adjacency(nodeCount);
+    for (const auto& [source, target] : edges) {
+        adjacency[source].push_back(target);
+    }
+    std::map<int, int> expected = {{0, 0}, {1, 0}};
+    std::queue<int> queue;
+    queue.push(0);
+    queue.push(1);
+    while (!queue.empty()) {
+        int current = queue.front();
+        queue.pop();
+        for (int next : adjacency[current]) {
+            if (expected.emplace(next, expected[current] + 1).second) {
+                queue.push(next);
+            }
+        }
+    }
+
+    TraversalOptions options;
+    options.recordParents = true;
+    const CsrGraph* bottomUpSources[] = {nullptr, &incoming};
+    for (size_t threads : {1, 4}) {
+        options.threadCount = threads;
+        for (const CsrGraph* other : bottomUpSources) {
+            TraversalResult result = breadthFirstSearch(graph, {0, 1, 0}, options, other);
+            EXPECT_EQ(depthsOf(result), expected);
+            EXPECT_EQ(result.nodes.size(), expected.size());
+            EXPECT_EQ(result.bottomUpLevels > 0, other != nullptr);
+            for (size_t i = 0; i < result.nodes.size(); ++i) {
+                if (result.depths[i] == 0) {
+                    EXPECT_EQ(result.parents[i], -1);
+                    continue;
+                }
+                auto neighbors = graph.neighbors(result.parents[i]);
+                EXPECT_NE(std::find(neighbors.begin(), neighbors.end(), result.nodes[i]), neighbors.end());
+                EXPECT_EQ(expected[result.parents[i]], result.depths[i] - 1);
+            }
+        }
+    }
+    EXPECT_EQ(depthsOf(breadthFirstSearch(engine, {0, 1}, options)), expected);
+}
+
+TEST_F(TraversalTest, StopsAtTargetOrLimit) {
+    // A chain 0 -> 1 -> ... -> 9 with a shortcut 0 -> 5
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i < 9; ++i) {
+        edges.emplace_back(i, i + 1);
+    }
+    edges.emplace_back(0, 5);
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    store(engine, 10, edges);
+    CsrGraph graph = CsrGraph::build(engine);
+
+    TraversalOptions options;
+    options.target = 6;
+    for (const TraversalResult& result : {breadthFirstSearch(graph, {0}, options),
+                                          breadthFirstSearch(engine, {0}, options)}) {
+        EXPECT_TRUE(result.stoppedEarly);
+        EXPECT_EQ(depthsOf(result)[6], 2);
+        EXPECT_EQ(result.nodes.back(), 6);
+    }
+
+    options.target = -1;
+    options.limit = 4;
+    for (const TraversalResult& result : {breadthFirstSearch(graph, {0}, options),
+                                          breadthFirstSearch(engine, {0}, options)}) {
+        EXPECT_TRUE(result.stoppedEarly);
+        EXPECT_EQ(result.nodes, (std::vector<int>{0, 1, 5, 2}));
+    }
+}
+
+TEST_F(TraversalTest, RejectsBadSourcesAndSnapshots) {
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    store(engine, 3, {{0, 1}});
+    CsrGraph graph = CsrGraph::build(engine);
+    EXPECT_THROW(breadthFirstSearch(graph, {3}), std::invalid_argument);
+    EXPECT_THROW(breadthFirstSearch(graph, {0}, {}, &graph), std::invalid_argument);
+    EXPECT_THROW(breadthFirstSearch(engine, {7}), std::runtime_error);
+}
@@ -0,0 +1,80 @@
+// tests/graph/test_union_find.cpp
+#include <gtest/gtest.h>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "core/parallel.hpp"
+#include "graph/union_find.hpp"
+
+namespace {
+// Smallest id in each id's set, from a plain sequential union-find
+std::vector<int> smallestInSet(size_t size, const std::vector<std::pair<int, int>>& pairs) {
+    std::vector<int> parent(size);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](int id) {
+        while (parent[id] != id) {
+            id = parent[id];
+        }
+        return id;
+    };
+    for (const auto& [a, b] : pairs) {
+        int rootA = find(a);
+        int rootB = find(b);
+        if (rootA != rootB) {
+            parent[std::max(rootA, rootB)] = std::min(rootA, rootB);
+        }
+    }
+    std::vector<int> smallest(size);
+    for (size_t id = 0; id < size; ++id) {
+        smallest[id] = find(static_cast<int>(id));
+    }
+    return smallest;
+}
+}
+
+TEST(UnionFindTest, ConcurrentUnitesAndFindsMatchSequential) {
+    const size_t size = 20000;
+    const size_t threads = 8;
+    std::mt19937 rng(44);
+    for (int round = 0; round < 10; ++round) {
+        // Few enough pairs that many sets stay apart, and long chains form
+        std::uniform_int_distribution<int> id(0, static_cast<int>(size) - 1);
+        std::vector<std::pair<int, int>> pairs(size * 3 / 4);
+        for (auto& pair : pairs) {
+            pair = {id(rng), id(rng)};
+        }
+        std::vector<int> expected = smallestInSet(size, pairs);
+        size_t merges = 0;
+        for (size_t i = 0; i < size; ++i) {
+            merges += expected[i] != static_cast<int>(i) ? 1 : 0;
+        }
+
+        // Every thread unites its slice while finding across all ids, so
+        // path halving races with the links being made
+        ConcurrentUnionFind sets(size);
+        std::atomic<size_t> united(0);
+        runParallel(threads, [&](size_t t) {
+            auto [begin, end] = sliceOf(pairs.size(), threads, t);
+            for (size_t i = begin; i < end; ++i) {
+                united += sets.unite(pairs[i].first, pairs[i].second) ? 1 : 0;
+                sets.find(pairs[(i * 7919) % pairs.size()].second);
+            }
+        });
+        EXPECT_EQ(united.load(), merges) << "round " << round;
+
+        // The smaller root always wins, so each set's root is its smallest id
+        runParallel(threads, [&](size_t t) {
+            auto [begin, end] = sliceOf(size, threads, t);
+            for (size_t i = begin; i < end; ++i) {
+                sets.find(static_cast<int>(size - 1 - i));
+            }
+        });
+        size_t mismatches = 0;
+        for (size_t i = 0; i < size; ++i) {
+            mismatches += sets.find(static_cast<int>(i)) != expected[i] ? 1 : 0;
+        }
+        EXPECT_EQ(mismatches, 0u) << "round " << round;
+        EXPECT_TRUE(sets.sameSet(pairs[0].first, pairs[0].second));
+    }
+}
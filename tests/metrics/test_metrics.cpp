@@ -0,0 +1,114 @@
+// tests/metrics/test_metrics.cpp
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "metrics/metrics.hpp"
+#include "cache/cache_manager.hpp"
+
+class MetricsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Metrics::setEnabled(true);
+        Metrics::reset();
+    }
+
+    void TearDown() override {
+        Metrics::setEnabled(true);
+    }
+};
+
+TEST_F(MetricsTest, BucketBoundsRoundTrip) {
+    for (uint64_t value : {0ULL, 1ULL, 15ULL, 16ULL, 17ULL, 1000ULL, 123456789ULL, ~0ULL}) {
+        size_t index = HistogramBuckets::indexOf(value);
+        ASSERT_LT(index, HistogramBuckets::COUNT);
+        uint64_t lower = HistogramBuckets::lowerBound(index);
+        EXPECT_LE(lower, value);
+        // Relative error stays within one sub-bucket
+        EXPECT_LE(value - lower, value / HistogramBuckets::SUB_BUCKETS + 1);
+    }
+}
+
+TEST_F(MetricsTest, CountersSumAcrossThreads) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 1000; ++i) {
+                Metrics::increment(Counter::BYTES_READ, 2);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(Metrics::snapshot().counter(Counter::BYTES_READ), 8000);
+}
+
+TEST_F(MetricsTest, HistogramPercentiles) {
+    for (uint64_t i = 1; i <= 1000; ++i) {
+        Metrics::record(Histogram::NODE_DISK_READ, i * 1000);
+    }
+    const HistogramSnapshot& hist = Metrics::snapshot().histogram(Histogram::NODE_DISK_READ);
+    EXPECT_EQ(hist.count, 1000);
+    EXPECT_EQ(hist.max, 1000000);
+    EXPECT_NEAR(hist.mean(), 500500.0, 1.0);
+    EXPECT_NEAR(static_cast<double>(hist.percentile(0.5)), 500000.0, 500000.0 / 16);
+    EXPECT_NEAR(static_cast<double>(hist.percentile(0.99)), 990000.0, 990000.0 / 16);
+}
+
+TEST_F(MetricsTest, DisabledRecordsNothing) {
+    Metrics::setEnabled(false);
+    Metrics::increment(Counter::INDEX_LOOKUPS);
+    {
+        ScopedLatency latency(Histogram::INDEX_LOOKUP);
+    }
+    Metrics::setEnabled(true);
+    MetricsSnapshot snap = Metrics::snapshot();
+    EXPECT_EQ(snap.counter(Counter::INDEX_LOOKUPS), 0);
+    EXPECT_EQ(snap.histogram(Histogram::INDEX_LOOKUP).count, 0);
+}
+
+TEST_F(MetricsTest, CacheHitsMissesAndEvictions) {
+    CacheManager cache(2 * CacheManager::chargeFor(Node(0)), 1 << 20);
+    cache.cacheNode(1, std::make_shared<Node>(1));
+    cache.getNode(1);
+    cache.getNode(2);
+    cache.cacheNode(2, std::make_shared<Node>(2));
+    cache.cacheNode(3, std::make_shared<Node>(3));
+
+    MetricsSnapshot snap = Metrics::snapshot();
+    EXPECT_EQ(snap.counter(Counter::CACHE_NODE_HITS), 1);
+    EXPECT_EQ(snap.counter(Counter::CACHE_NODE_MISSES), 1);
+    EXPECT_EQ(snap.counter(Counter::CACHE_NODE_EVICTIONS), 1);
+}
+
+TEST_F(MetricsTest, ExportFormats) {
+    Metrics::increment(Counter::CACHE_EDGE_HITS, 3);
+    Metrics::record(Histogram::EDGE_DESERIALIZE, 2000);
+    MetricsSnapshot snap = Metrics::snapshot();
+
+    std::string json = snap.toJson();
+    EXPECT_NE(json.find("\"cache_edge_hits\":3"), std::string::npos);
+    EXPECT_NE(json.find("\"edge_deserialize_ns\":{\"count\":1"), std::string::npos);
+
+    std::string prom = snap.toPrometheus();
+    EXPECT_NE(prom.find("kruskaldb_cache_edge_hits_total 3"), std::string::npos);
+    EXPECT_NE(prom.find("kruskaldb_edge_deserialize_seconds_count 1"), std::string::npos);
+}
+
+TEST_F(MetricsTest, DumperWritesFile) {
+    std::string path = "test_metrics_dump.prom";
+    Metrics::increment(Counter::BYTES_WRITTEN, 42);
+    {
+        MetricsDumper dumper(path, std::chrono::milliseconds(10), MetricsDumper::Format::PROMETHEUS);
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    }
+    std::ifstream in(path);
+    ASSERT_TRUE(in.is_open());
+    std::stringstream contents;
+    contents << in.rdbuf();
+    EXPECT_NE(contents.str().find("kruskaldb_bytes_written_total 42"), std::string::npos);
+    std::remove(path.c_str());
+}
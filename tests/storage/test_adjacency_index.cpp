@@ -0,0 +1,59 @@
+// tests/storage/test_adjacency_index.cpp
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include "core/record_names.hpp"
+#include "storage/adjacency_index.hpp"
+
+TEST(AdjacencyIndexTest, FilesEdgesByNodeAndType) {
+    EdgeType knows = edgeType("KNOWS");
+    EdgeType likes = edgeType("LIKES");
+    AdjacencyIndex index;
+    index.insert(1, knows, 10, 2);
+    index.insert(1, likes, 11, 3);
+    index.insert(1, knows, 12, 4);
+    // Out of order and repeated
+    index.insert(1, knows, 5, 7);
+    index.insert(1, knows, 12, 4);
+    index.insert(2, knows, 13, 1);
+    EXPECT_EQ(index.size(), 5u);
+
+    EXPECT_EQ(index.find(1, knows), (std::vector<Neighbor>{{5, 7}, {10, 2}, {12, 4}}));
+    EXPECT_EQ(index.find(1, likes), (std::vector<Neighbor>{{11, 3}}));
+    EXPECT_TRUE(index.find(3, knows).empty());
+    EXPECT_TRUE(index.find(2, likes).empty());
+
+    EXPECT_TRUE(index.erase(1, knows, 10));
+    EXPECT_FALSE(index.erase(1, knows, 10));
+    EXPECT_FALSE(index.erase(1, likes, 12));
+    EXPECT_TRUE(index.erase(1, likes, 11));
+    EXPECT_TRUE(index.find(1, likes).empty());
+    EXPECT_EQ(index.find(1, knows), (std::vector<Neighbor>{{5, 7}, {12, 4}}));
+    EXPECT_EQ(index.size(), 3u);
+}
+
+TEST(AdjacencyIndexTest, SerializationRoundTrip) {
+    std::mt19937 rng(48);
+    std::uniform_int_distribution<int> node(0, 300);
+    EdgeType types[] = {EdgeType{}, edgeType("KNOWS"), edgeType("LIKES")};
+    AdjacencyIndex index;
+    for (int edgeId = 0; edgeId < 5000; ++edgeId) {
+        index.insert(node(rng), types[edgeId % 3], edgeId, node(rng));
+    }
+
+    std::string data;
+    BinaryWriter writer(data);
+    index.serialize(writer);
+    BinaryReader reader(data.data(), data.size());
+    AdjacencyIndex copy = AdjacencyIndex::deserialize(reader);
+    EXPECT_TRUE(reader.atEnd());
+    EXPECT_EQ(copy.size(), index.size());
+    for (int nodeId = 0; nodeId <= 300; ++nodeId) {
+        for (EdgeType type : types) {
+            EXPECT_EQ(copy.find(nodeId, type), index.find(nodeId, type));
+        }
+    }
+
+    BinaryReader truncated(data.data(), data.size() / 2);
+    EXPECT_THROW(AdjacencyIndex::deserialize(truncated), std::runtime_error);
+}
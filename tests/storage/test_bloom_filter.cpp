@@ -0,0 +1,49 @@
+// tests/storage/test_bloom_filter.cpp
+#include <gtest/gtest.h>
+#include "storage/bloom_filter.hpp"
+
+TEST(BloomFilterTest, NoFalseNegatives) {
+    BloomFilter filter(10000);
+    for (int i = 0; i < 10000; ++i) {
+        filter.insert(i * 7);
+    }
+    for (int i = 0; i < 10000; ++i) {
+        EXPECT_TRUE(filter.mayContain(i * 7));
+    }
+    EXPECT_EQ(filter.size(), 10000);
+}
+
+TEST(BloomFilterTest, FalsePositiveRateIsLow) {
+    BloomFilter filter(10000, 16);
+    for (int i = 0; i < 10000; ++i) {
+        filter.insert(i);
+    }
+    int falsePositives = 0;
+    for (int i = 10000; i < 110000; ++i) {
+        falsePositives += filter.mayContain(i);
+    }
+    // 16 bits per key gives roughly 0.1%; allow generous slack
+    EXPECT_LT(falsePositives, 1000);
+}
+
+TEST(BloomFilterTest, SerializeRoundTrip) {
+    BloomFilter filter(500);
+    for (int i = -250; i < 250; ++i) {
+        filter.insert(i);
+    }
+    BloomFilter copy = BloomFilter::deserialize(filter.serialize());
+    EXPECT_EQ(copy.size(), filter.size());
+    EXPECT_EQ(copy.capacity(), filter.capacity());
+    for (int i = -1000; i < 1000; ++i) {
+        EXPECT_EQ(copy.mayContain(i), filter.mayContain(i));
+    }
+    EXPECT_THROW(BloomFilter::deserialize("junk"), std::runtime_error);
+}
+
+TEST(BloomFilterTest, Clear) {
+    BloomFilter filter(64);
+    filter.insert(5);
+    filter.clear();
+    EXPECT_FALSE(filter.mayContain(5));
+    EXPECT_EQ(filter.size(), 0);
+}
@@ -167,3 +167,19 @@ TEST_F(BTreeTest, BoundaryConditions) {
 
     delete smallTree;
 }
+
+TEST_F(BTreeTest, SearchReportsDepth) {
+    int depth = 0;
+    EXPECT_THROW(btree->search(1, depth), std::runtime_error);
+
+    for (int i = 0; i < 100; ++i) {
+        btree->insert(i, i);
+    }
+    int maxDepth = 0;
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(btree->search(i, depth), i);
+        EXPECT_GE(depth, 1);
+        maxDepth = std::max(maxDepth, depth);
+    }
+    EXPECT_GT(maxDepth, 1);
+}
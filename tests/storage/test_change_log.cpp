@@ -0,0 +1,37 @@
+// tests/storage/test_change_log.cpp
+#include <gtest/gtest.h>
+#include "storage/change_log.hpp"
+
+TEST(ChangeLogTest, ReturnsChangesSinceASequence) {
+    ChangeLog log;
+    log.record(ChangeLog::Kind::NODE, 4);
+    uint64_t mark = log.sequence();
+    log.record(ChangeLog::Kind::EDGE, 7);
+    log.record(ChangeLog::Kind::NODE, 4);
+
+    std::vector<ChangeLog::Change> changes;
+    ASSERT_TRUE(log.changesSince(mark, changes));
+    ASSERT_EQ(changes.size(), 2u);
+    EXPECT_EQ(changes[0].kind, ChangeLog::Kind::EDGE);
+    EXPECT_EQ(changes[0].id, 7);
+    EXPECT_EQ(changes[1].id, 4);
+
+    changes.clear();
+    EXPECT_TRUE(log.changesSince(log.sequence(), changes));
+    EXPECT_TRUE(changes.empty());
+    EXPECT_FALSE(log.changesSince(log.sequence() + 1, changes));
+}
+
+TEST(ChangeLogTest, DropsTheOldestBeyondCapacity) {
+    ChangeLog log(2);
+    for (int id = 0; id < 5; ++id) {
+        log.record(ChangeLog::Kind::EDGE, id);
+    }
+    EXPECT_EQ(log.sequence(), 5u);
+    std::vector<ChangeLog::Change> changes;
+    EXPECT_FALSE(log.changesSince(2, changes));
+    EXPECT_TRUE(changes.empty());
+    ASSERT_TRUE(log.changesSince(3, changes));
+    EXPECT_EQ(changes.size(), 2u);
+    EXPECT_NE(ChangeLog().getId(), log.getId());
+}
@@ -0,0 +1,160 @@
+// tests/storage/test_column_store.cpp
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include "storage/column_store.hpp"
+
+namespace {
+const CompareOp ALL_OPS[] = {CompareOp::Equal,     CompareOp::NotEqual, CompareOp::Less,
+                             CompareOp::LessEqual, CompareOp::Greater,  CompareOp::GreaterEqual};
+
+template<typename T>
+bool expected(CompareOp op, T a, T b) {
+    switch (op) {
+        case CompareOp::Equal: return a == b;
+        case CompareOp::NotEqual: return a != b;
+        case CompareOp::Less: return a < b;
+        case CompareOp::LessEqual: return a <= b;
+        case CompareOp::Greater: return a > b;
+        default: return a >= b;
+    }
+}
+}
+
+TEST(SelectionBitmapTest, SetCountAndCombine) {
+    SelectionBitmap a(10);
+    a.set(1);
+    a.set(9);
+    a.set(130);
+    EXPECT_EQ(a.size(), 131u);
+    EXPECT_EQ(a.count(), 3u);
+    EXPECT_TRUE(a.test(130));
+    EXPECT_FALSE(a.test(500));
+
+    SelectionBitmap b(5);
+    b.set(1);
+    b.set(2);
+    EXPECT_EQ((a & b).toIds(), (std::vector<int>{1}));
+    EXPECT_EQ((a | b).toIds(), (std::vector<int>{1, 2, 9, 130}));
+    EXPECT_EQ(a.subtract(b).toIds(), (std::vector<int>{9, 130}));
+}
+
+TEST(ColumnStoreTest, FiltersMatchScalarComparisonAtEveryLevel) {
+    PropertyKey age = propertyKey("column_age");
+    PropertyKey score = propertyKey("column_score");
+    ColumnStore store;
+    store.addColumn(age, ColumnType::Int);
+    store.addColumn(score, ColumnType::Double);
+
+    // Not a multiple of 64 rows, with nulls and negative values
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> ages(-20, 80);
+    std::vector<std::optional<int>> ageValues(1000);
+    std::vector<std::optional<double>> scoreValues(1000);
+    for (int id = 0; id < 1000; ++id) {
+        Node node(id);
+        if (id % 7 != 0) {
+            ageValues[id] = ages(rng);
+            node.setProperty(age, *ageValues[id]);
+        }
+        if (id % 5 != 0) {
+            scoreValues[id] = id % 13 == 0 ? std::numeric_limits<double>::quiet_NaN() : ages(rng) / 4.0;
+            node.setProperty(score, *scoreValues[id]);
+        }
+        store.update(node);
+    }
+    ASSERT_EQ(store.size(), 1000u);
+
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        for (CompareOp op : ALL_OPS) {
+            SelectionBitmap ints = store.filter(age, op, 30, level);
+            SelectionBitmap doubles = store.filter(score, op, 7.5, level);
+            for (int id = 0; id < 1000; ++id) {
+                EXPECT_EQ(ints.test(id), ageValues[id] && expected(op, *ageValues[id], 30))
+                    << simdLevelName(level) << " op " << static_cast<int>(op) << " id " << id;
+                EXPECT_EQ(doubles.test(id), scoreValues[id] && expected(op, *scoreValues[id], 7.5))
+                    << simdLevelName(level) << " op " << static_cast<int>(op) << " id " << id;
+            }
+            EXPECT_EQ(ints.getWords().size(), 16u);
+            EXPECT_FALSE(ints.test(1000));
+        }
+    }
+}
+
+TEST(ColumnStoreTest, BoolColumnsAndNulls) {
+    PropertyKey active = propertyKey("column_active");
+    ColumnStore store;
+    store.addColumn(active, ColumnType::Bool);
+
+    Node yes(0);
+    yes.setProperty(active, true);
+    Node no(1);
+    no.setProperty(active, false);
+    Node wrongType(2);
+    wrongType.setProperty(active, std::string("true"));
+    Node missing(3);
+    for (const Node* node : {&yes, &no, &wrongType, &missing}) {
+        store.update(*node);
+    }
+
+    EXPECT_EQ(store.filter(active, true).toIds(), (std::vector<int>{0}));
+    EXPECT_EQ(store.filter(active, false).toIds(), (std::vector<int>{1}));
+    EXPECT_EQ(store.notNull(active).toIds(), (std::vector<int>{0, 1}));
+    EXPECT_EQ(store.get<bool>(active, 0), true);
+    EXPECT_EQ(store.get<bool>(active, 2), std::nullopt);
+    EXPECT_EQ(store.get<bool>(active, 99), std::nullopt);
+}
+
+TEST(ColumnStoreTest, UpdatesReplaceRows) {
+    PropertyKey age = propertyKey("column_age");
+    ColumnStore store;
+    store.addColumn(age, ColumnType::Int);
+
+    Node node(70);
+    node.setProperty(age, 40);
+    store.update(node);
+    EXPECT_EQ(store.size(), 71u);
+    EXPECT_EQ(store.filter(age, CompareOp::Greater, 30).toIds(), (std::vector<int>{70}));
+
+    node.setProperty(age, 20);
+    store.update(node);
+    EXPECT_EQ(store.get<int>(age, 70), 20);
+    EXPECT_EQ(store.filter(age, CompareOp::Greater, 30).count(), 0u);
+
+    node.removeProperty(age);
+    store.update(node);
+    EXPECT_EQ(store.get<int>(age, 70), std::nullopt);
+    EXPECT_EQ(store.filter(age, CompareOp::NotEqual, 30).count(), 0u);
+
+    node.setProperty(age, 50);
+    store.update(node);
+    store.erase(70);
+    EXPECT_EQ(store.notNull(age).count(), 0u);
+}
+
+TEST(ColumnStoreTest, ColumnsAddedLaterCoverEarlierRows) {
+    PropertyKey age = propertyKey("column_age");
+    PropertyKey score = propertyKey("column_score");
+    ColumnStore store;
+    store.addColumn(age, ColumnType::Int);
+    store.update(Node(200));
+
+    store.addColumn(score, ColumnType::Double);
+    EXPECT_EQ(store.filter(score, CompareOp::Less, 1.0).size(), 201u);
+    EXPECT_EQ(store.getColumnKeys().size(), 2u);
+    EXPECT_EQ(store.columnType(score), ColumnType::Double);
+}
+
+TEST(ColumnStoreTest, TypeMismatchesThrow) {
+    PropertyKey age = propertyKey("column_age");
+    ColumnStore store;
+    store.addColumn(age, ColumnType::Int);
+    EXPECT_NO_THROW(store.addColumn(age, ColumnType::Int));
+    EXPECT_THROW(store.addColumn(age, ColumnType::Double), std::invalid_argument);
+    EXPECT_THROW(store.filter(age, CompareOp::Less, 1.0), std::invalid_argument);
+    EXPECT_THROW(store.filter(age, true), std::invalid_argument);
+    EXPECT_THROW(store.get<double>(age, 0), std::invalid_argument);
+    EXPECT_THROW(store.notNull(propertyKey("column_unknown")), std::invalid_argument);
+}
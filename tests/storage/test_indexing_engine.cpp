@@ -0,0 +1,75 @@
+// tests/storage/test_indexing_engine.cpp
+#include <gtest/gtest.h>
+#include <cstdio>
+#include "storage/indexing_engine.hpp"
+#include "metrics/metrics.hpp"
+
+class IndexingEngineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        removeFiles();
+        Metrics::reset();
+    }
+
+    void TearDown() override {
+        removeFiles();
+    }
+
+    static void removeFiles() {
+        for (const char* name : {"node_index.db", "edge_index.db", "node_bloom.db", "edge_bloom.db",
+                                 "adjacency_index.db"}) {
+            std::remove((dbPath + name).c_str());
+        }
+    }
+
+    PropertyKeyDictionary propertyKeys;
+    static const std::string dbPath;
+};
+
+const std::string IndexingEngineTest::dbPath = "test_indexing_engine_";
+
+TEST_F(IndexingEngineTest, MissesDoNotThrowOrDescend) {
+    IndexingEngine index(dbPath, 3, propertyKeys);
+    for (int i = 0; i < 100; ++i) {
+        index.addNodeIndex(i, i * 10L);
+    }
+    EXPECT_EQ(index.findNodeDiskOffset(42), 420);
+    EXPECT_FALSE(index.findNodeDiskOffset(100000).has_value());
+    EXPECT_FALSE(index.findEdgeDiskOffset(0).has_value());
+    EXPECT_THROW(index.getNodeDiskOffset(100000), std::runtime_error);
+
+    MetricsSnapshot snapshot = Metrics::snapshot();
+    EXPECT_GE(snapshot.counter(Counter::BLOOM_NEGATIVES) + snapshot.counter(Counter::BLOOM_FALSE_POSITIVES), 3);
+}
+
+TEST_F(IndexingEngineTest, FilterGrowsWithoutFalseNegatives) {
+    IndexingEngine index(dbPath, 8, propertyKeys);
+    for (int i = 0; i < 5000; ++i) {
+        index.addEdgeIndex(i, i);
+    }
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_EQ(index.findEdgeDiskOffset(i), i);
+    }
+}
+
+TEST_F(IndexingEngineTest, PersistsIndexAndFilter) {
+    {
+        IndexingEngine index(dbPath, 3, propertyKeys);
+        for (int i = 0; i < 50; ++i) {
+            index.addNodeIndex(i, i + 1000L);
+        }
+        index.flush();
+        index.addNodeIndex(50, 2000);
+    }
+    IndexingEngine reopened(dbPath, 3, propertyKeys);
+    EXPECT_EQ(reopened.getMaxNodeId(), 50);
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(reopened.findNodeDiskOffset(i), i + 1000L);
+    }
+    EXPECT_EQ(reopened.findNodeDiskOffset(50), 2000);
+
+    // A lost filter file is rebuilt from the tree
+    std::remove((dbPath + "node_bloom.db").c_str());
+    IndexingEngine rebuilt(dbPath, 3, propertyKeys);
+    EXPECT_EQ(rebuilt.findNodeDiskOffset(7), 1007);
+}
@@ -0,0 +1,114 @@
+// tests/storage/test_property_index.cpp
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include "core/record_view.hpp"
+#include "storage/property_index.hpp"
+
+TEST(PropertyIndexTest, OrderedLookupsAndRanges) {
+    PropertyIndex index(propertyKey("age"), IndexType::Int);
+    index.insert(30, 4);
+    index.insert(20, 9);
+    index.insert(30, 1);
+    index.insert(30, 1);
+    index.insert(std::string("thirty"), 2);
+    index.insert(25.5, 3);
+    index.insert(40.0, 5);
+    EXPECT_EQ(index.size(), 4u);
+
+    EXPECT_EQ(index.find(30), (std::vector<int>{1, 4}));
+    EXPECT_EQ(index.find(30.0), (std::vector<int>{1, 4}));
+    EXPECT_TRUE(index.find(30.5).empty());
+    EXPECT_TRUE(index.find(std::string("30")).empty());
+    EXPECT_EQ(index.range(20, 30), (std::vector<int>{9, 1, 4}));
+    EXPECT_EQ(index.range(20.5, 1e300), (std::vector<int>{1, 4, 5}));
+    EXPECT_TRUE(index.range(31, 30).empty());
+
+    index.update(30, 35, 4);
+    index.update(20, std::nullopt, 9);
+    index.erase(99, 1);
+    EXPECT_EQ(index.range(-1e300, 1e300), (std::vector<int>{1, 4, 5}));
+    EXPECT_EQ(index.size(), 3u);
+
+    PropertyIndex prices(propertyKey("price"), IndexType::Double);
+    prices.insert(2.5, 1);
+    prices.insert(std::numeric_limits<double>::quiet_NaN(), 2);
+    prices.insert(-0.5, 3);
+    prices.insert(7, 4);
+    EXPECT_EQ(prices.size(), 3u);
+    EXPECT_EQ(prices.find(7), (std::vector<int>{4}));
+    EXPECT_EQ(prices.range(-1, 3), (std::vector<int>{3, 1}));
+}
+
+TEST(PropertyIndexTest, HashedLookups) {
+    PropertyIndex index(propertyKey("email"), IndexType::String);
+    index.insert(std::string("a@example.com"), 3);
+    index.insert(std::string("b@example.com"), 1);
+    index.insert(std::string("a@example.com"), 2);
+    index.insert(5, 4);
+    EXPECT_EQ(index.size(), 3u);
+    EXPECT_EQ(index.find(std::string("a@example.com")), (std::vector<int>{2, 3}));
+    EXPECT_TRUE(index.find(std::string("c@example.com")).empty());
+    EXPECT_THROW(index.range(0, 1), std::invalid_argument);
+
+    index.update(std::string("a@example.com"), std::string("c@example.com"), 2);
+    EXPECT_EQ(index.find(std::string("a@example.com")), (std::vector<int>{3}));
+    EXPECT_EQ(index.find(std::string("c@example.com")), (std::vector<int>{2}));
+    EXPECT_EQ(index.size(), 3u);
+}
+
+TEST(PropertyIndexTest, ValuesFromRecordsAndViews) {
+    PropertyIndex ages(propertyKey("age"), IndexType::Int);
+    PropertyIndex names(propertyKey("name"), IndexType::String);
+    Node node;
+    node.setProperty("age", 41);
+    node.setProperty("name", std::string("alice"));
+    EXPECT_EQ(ages.valueOf(node), IndexValue(41));
+    EXPECT_EQ(names.valueOf(node), IndexValue(std::string("alice")));
+
+    std::string record = node.serialize();
+    NodeView view(record);
+    EXPECT_EQ(ages.valueOf(view), IndexValue(41));
+    EXPECT_EQ(names.valueOf(view), IndexValue(std::string("alice")));
+
+    // Stored with another type than the index's
+    node.setProperty("age", std::string("41"));
+    EXPECT_EQ(ages.valueOf(node), std::nullopt);
+    Edge edge(0, 1, 2, "KNOWS");
+    EXPECT_EQ(names.valueOf(edge), std::nullopt);
+}
+
+TEST(PropertyIndexTest, SerializationRoundTrip) {
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> value(-1000, 1000);
+    PropertyIndex ints(propertyKey("i"), IndexType::Int);
+    PropertyIndex doubles(propertyKey("d"), IndexType::Double);
+    PropertyIndex strings(propertyKey("s"), IndexType::String);
+    for (int id = 0; id < 2000; ++id) {
+        ints.insert(value(rng), id);
+        doubles.insert(value(rng) * 0.125, id);
+        strings.insert(std::to_string(value(rng) % 50), id);
+    }
+
+    for (const PropertyIndex* index : {&ints, &doubles, &strings}) {
+        std::string data;
+        BinaryWriter writer(data);
+        index->serialize(writer);
+        BinaryReader reader(data.data(), data.size());
+        PropertyIndex copy = PropertyIndex::deserialize(index->getKey(), index->getType(), reader);
+        EXPECT_TRUE(reader.atEnd());
+        EXPECT_EQ(copy.size(), index->size());
+        if (index->getType() == IndexType::String) {
+            for (int i = 0; i < 50; ++i) {
+                EXPECT_EQ(copy.find(std::to_string(i)), index->find(std::to_string(i)));
+            }
+        } else {
+            EXPECT_EQ(copy.range(-2000, 2000), index->range(-2000, 2000));
+        }
+
+        BinaryReader truncated(data.data(), data.size() / 2);
+        EXPECT_THROW(PropertyIndex::deserialize(index->getKey(), index->getType(), truncated), std::runtime_error);
+    }
+}
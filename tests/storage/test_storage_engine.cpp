@@ -0,0 +1,522 @@
+// tests/storage/test_storage_engine.cpp
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include "storage/storage_engine.hpp"
+#include "metrics/metrics.hpp"
+
+class StorageEngineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        removeFiles();
+    }
+
+    void TearDown() override {
+        removeFiles();
+    }
+
+    static void removeFiles() {
+        StorageEngine::destroy(dbPath);
+        StorageEngine::destroy(otherDbPath);
+    }
+
+    static const std::string dbPath;
+    // For tests that open two databases at once
+    static const std::string otherDbPath;
+};
+
+const std::string StorageEngineTest::dbPath = "test_storage_engine_";
+const std::string StorageEngineTest::otherDbPath = "test_storage_engine_other_";
+
+TEST_F(StorageEngineTest, AddAndGet) {
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    Node node;
+    node.setProperty("name", std::string("alice"));
+    int first = engine.addNode(node);
+    int second = engine.addNode(Node());
+    EXPECT_NE(first, second);
+    EXPECT_EQ(engine.getNode(first)->getProperty<std::string>("name"), "alice");
+    EXPECT_FALSE(engine.getNode(first)->isDirty());
+
+    int edgeId = engine.addEdge(Edge(0, first, second, "KNOWS"));
+    EXPECT_EQ(engine.getEdge(edgeId)->getTargetNodeId(), second);
+}
+
+TEST_F(StorageEngineTest, DirtyEvictionKeepsUpdates) {
+    // Room for only a handful of nodes, so most updates are evicted while dirty
+    StorageEngine engine(dbPath, 8 * CacheManager::chargeFor(Node(0)), 3);
+    std::vector<int> ids;
+    for (int i = 0; i < 100; ++i) {
+        ids.push_back(engine.addNode(Node()));
+    }
+    for (int i = 0; i < 100; ++i) {
+        engine.updateNode(ids[i], [i](Node& node) { node.setProperty("value", i); });
+    }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(engine.getNode(ids[i])->getProperty<int>("value"), i);
+    }
+
+    engine.flush();
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(engine.getNode(ids[i])->getProperty<int>("value"), i);
+    }
+}
+
+TEST_F(StorageEngineTest, FlushKeepsNewerCachedVersionOverQueuedOne) {
+    // Each node is evicted dirty, read back from the queue and updated again,
+    // so at flush time the queue can still hold versions the cache has replaced
+    std::vector<int> expected(400);
+    {
+        StorageEngine engine(dbPath, 32 * CacheManager::chargeFor(Node(0)), 3);
+        for (int i = 0; i < 400; ++i) {
+            engine.addNode(Node());
+        }
+        int version = 0;
+        auto update = [&](int nodeId) {
+            expected[nodeId] = ++version;
+            engine.updateNode(nodeId, [&](Node& node) { node.setProperty("version", version); });
+        };
+        for (int i = 0; i < 400; ++i) {
+            update(i);
+            if (i >= 64) {
+                update(i - 64);
+            }
+        }
+        engine.flush();
+    }
+    StorageEngine reopened(dbPath, 1 << 20, 3);
+    for (int i = 0; i < 400; ++i) {
+        EXPECT_EQ(reopened.getNode(i)->getProperty<int>("version"), expected[i]) << i;
+    }
+}
+
+TEST_F(StorageEngineTest, BackpressureStillWritesEverything) {
+    // A tiny write-back threshold forces evicting callers to wait for the writer
+    StorageEngine engine(dbPath, 4 * CacheManager::chargeFor(Edge(0, 0, 0, "T")), 3,
+                         EvictionPolicyType::LRU, 1);
+    std::vector<int> ids;
+    for (int i = 0; i < 50; ++i) {
+        ids.push_back(engine.addEdge(Edge(0, i, i + 1, "T")));
+    }
+    for (int i = 0; i < 50; ++i) {
+        engine.updateEdge(ids[i], [i](Edge& edge) { edge.setProperty("weight", i * 0.5); });
+    }
+    engine.flush();
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(engine.getEdge(ids[i])->getProperty<double>("weight"), i * 0.5);
+    }
+}
+
+TEST_F(StorageEngineTest, UpdateNodesAppliesRepeatedIdsInTurn) {
+    std::vector<int> ids;
+    {
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        for (int i = 0; i < 3; ++i) {
+            Node node;
+            node.setProperty("count", 0);
+            ids.push_back(engine.addNode(node));
+        }
+    }
+    std::remove((dbPath + "hot_set.db").c_str());
+
+    // Uncached, so each update goes through the batch written to disk; the
+    // repeat has to see the batched copy rather than the one on disk
+    auto increment = [](Node& node) { node.setProperty("count", node.getProperty<int>("count") + 1); };
+    {
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        Metrics::reset();
+        EXPECT_EQ(engine.updateNodes({ids[0], ids[1], ids[0], ids[0]}, increment), 4u);
+        // Records that bypass the cache are neither hits nor misses
+        EXPECT_EQ(Metrics::snapshot().counter(Counter::CACHE_NODE_HITS), 0);
+        EXPECT_EQ(Metrics::snapshot().counter(Counter::CACHE_NODE_MISSES), 0);
+        EXPECT_EQ(engine.getNode(ids[0])->getProperty<int>("count"), 3);
+        EXPECT_EQ(engine.updateNodes({ids[2], ids[2]}, increment), 2u);
+    }
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    EXPECT_EQ(engine.getNode(ids[0])->getProperty<int>("count"), 3);
+    EXPECT_EQ(engine.getNode(ids[1])->getProperty<int>("count"), 1);
+    EXPECT_EQ(engine.getNode(ids[2])->getProperty<int>("count"), 2);
+}
+
+TEST_F(StorageEngineTest, TryGetReportsMissingWithoutThrowing) {
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    int id = engine.addNode(Node());
+    EXPECT_NE(engine.tryGetNode(id), nullptr);
+    EXPECT_EQ(engine.tryGetNode(id + 1000), nullptr);
+    EXPECT_EQ(engine.tryGetEdge(42), nullptr);
+    EXPECT_THROW(engine.getNode(id + 1000), std::runtime_error);
+}
+
+TEST_F(StorageEngineTest, PrefetchLoadsEdgesAndTargets) {
+    const int fanOut = 8;
+    {
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        int hub = engine.addNode(Node());
+        std::vector<int> edgeIds;
+        for (int i = 0; i < fanOut; ++i) {
+            int target = engine.addNode(Node());
+            edgeIds.push_back(engine.addEdge(Edge(0, hub, target, "LINKS")));
+        }
+        engine.updateNode(hub, [&](Node& node) {
+            for (int edgeId : edgeIds) {
+                node.addEdge(edgeId, true);
+            }
+        });
+    }
+    std::remove((dbPath + "hot_set.db").c_str());  // Start cold
+
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    PrefetchOptions prefetch;
+    prefetch.targetNodes = true;
+    prefetch.maxFanOut = fanOut / 2;
+    auto hub = engine.getNode(0, prefetch);
+    engine.waitForPrefetch();
+
+    Metrics::reset();
+    for (int i = 0; i < fanOut / 2; ++i) {
+        auto edge = engine.getEdge(hub->getOutgoingEdges()[i]);
+        engine.getNode(edge->getTargetNodeId());
+    }
+    // Everything within the fan-out limit was already resident
+    EXPECT_EQ(Metrics::snapshot().counter(Counter::BYTES_READ), 0);
+
+    engine.getEdge(hub->getOutgoingEdges()[fanOut - 1]);
+    EXPECT_GT(Metrics::snapshot().counter(Counter::BYTES_READ), 0);
+}
+
+TEST_F(StorageEngineTest, PrefetchNeverReplacesNewerVersion) {
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    int id = engine.addNode(Node());
+    engine.prefetchNodes({id}, PrefetchOptions());
+    engine.updateNode(id, [](Node& node) { node.setProperty("v", 2); });
+    engine.waitForPrefetch();
+    EXPECT_EQ(engine.getNode(id)->getProperty<int>("v"), 2);
+}
+
+TEST_F(StorageEngineTest, HotSetWarmsCacheOnReopen) {
+    std::vector<int> hot;
+    {
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        for (int i = 0; i < 200; ++i) {
+            int id = engine.addNode(Node());
+            if (i % 4 == 0) {
+                hot.push_back(id);
+            }
+        }
+    }
+    std::remove((dbPath + "hot_set.db").c_str());
+    {
+        // Cold start that only touches a quarter of the nodes
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        EXPECT_DOUBLE_EQ(engine.warmUpProgress(), 1.0);
+        for (int id : hot) {
+            engine.getNode(id);
+        }
+    }
+    {
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        engine.waitForWarmUp();
+        EXPECT_DOUBLE_EQ(engine.warmUpProgress(), 1.0);
+        Metrics::reset();
+        for (int id : hot) {
+            engine.getNode(id);
+        }
+        EXPECT_EQ(Metrics::snapshot().counter(Counter::BYTES_READ), 0);
+        EXPECT_EQ(Metrics::snapshot().counter(Counter::CACHE_NODE_MISSES), 0);
+        engine.getNode(1);
+        EXPECT_EQ(Metrics::snapshot().counter(Counter::CACHE_NODE_MISSES), 1);
+    }
+}
+
+TEST_F(StorageEngineTest, WarmUpDoesNotOverwriteNewerWrites) {
+    {
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        for (int i = 0; i < 100; ++i) {
+            engine.addNode(Node());
+        }
+    }
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    engine.updateNode(5, [](Node& node) { node.setProperty("v", 7); });
+    engine.flush();
+    engine.waitForWarmUp();
+    EXPECT_EQ(engine.getNode(5)->getProperty<int>("v"), 7);
+}
+
+TEST_F(StorageEngineTest, PropertyKeysArePersistedWithRecords) {
+    int nodeId;
+    {
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        Node node(0);
+        node.setProperty("persisted_key", 5);
+        nodeId = engine.addNode(node);
+    }
+    PropertyKeyDictionary onDisk;
+    onDisk.load(dbPath + "property_keys.db");
+    auto saved = onDisk.find("persisted_key");
+    ASSERT_TRUE(saved);
+
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    EXPECT_EQ(*saved, engine.propertyKey("persisted_key"));
+    EXPECT_EQ(engine.getNode(nodeId)->getProperty<int>("persisted_key"), 5);
+}
+
+TEST_F(StorageEngineTest, EdgeTypesArePersistedWithRecords) {
+    int edgeId;
+    {
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        edgeId = engine.addEdge(Edge(0, 1, 2, "PERSISTED_TYPE"));
+    }
+    EdgeTypeRegistry onDisk;
+    onDisk.load(dbPath + "edge_types.db");
+    auto saved = onDisk.find("PERSISTED_TYPE");
+    ASSERT_TRUE(saved);
+
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    EXPECT_EQ(*saved, engine.edgeType("PERSISTED_TYPE"));
+    EXPECT_EQ(engine.getEdge(edgeId)->getType(), "PERSISTED_TYPE");
+}
+
+TEST_F(StorageEngineTest, DatabasesHandOutTheirOwnIds) {
+    int aliceId;
+    int bobId;
+    int knowsId;
+    int likesId;
+    {
+        StorageEngine first(dbPath, 1 << 20, 3);
+        StorageEngine second(otherDbPath, 1 << 20, 3);
+        Node alice;
+        alice.setProperty("name", std::string("alice"));
+        alice.setProperty("age", 30);
+        aliceId = first.addNode(alice);
+        Node bob;
+        bob.setProperty("age", 40);
+        bobId = second.addNode(bob);
+        knowsId = first.addEdge(Edge(0, aliceId, aliceId, "KNOWS"));
+        likesId = second.addEdge(Edge(0, bobId, bobId, "LIKES"));
+
+        // Each database numbers the names it has seen from the start
+        EXPECT_EQ(second.propertyKey("age"), PropertyKey{0});
+        EXPECT_NE(first.propertyKey("age"), second.propertyKey("age"));
+        EXPECT_EQ(first.getEdge(knowsId)->getTypeId(), second.getEdge(likesId)->getTypeId());
+
+        // A record read from one database is re-keyed when added to the other
+        int copyId = second.addNode(*first.getNode(aliceId));
+        EXPECT_EQ(second.getNode(copyId)->getProperty<int>("age"), 30);
+        EXPECT_EQ(second.getNode(copyId)->getProperty<std::string>("name"), "alice");
+        Node withEdge = *first.getNode(aliceId);
+        withEdge.addEdge(*first.getEdge(knowsId));
+        int linkedId = second.addNode(withEdge);
+        EXPECT_EQ(second.getNode(linkedId)->getOutgoingEdges("KNOWS").toVector(), std::vector<int>{knowsId});
+        EXPECT_TRUE(second.getNode(linkedId)->getOutgoingEdges("LIKES").empty());
+    }
+    std::remove((dbPath + "hot_set.db").c_str());
+    std::remove((otherDbPath + "hot_set.db").c_str());
+
+    // Reopened in the other order, each still reads its own names
+    StorageEngine second(otherDbPath, 1 << 20, 3);
+    StorageEngine first(dbPath, 1 << 20, 3);
+    EXPECT_EQ(first.getNode(aliceId)->getProperty<int>("age"), 30);
+    EXPECT_EQ(second.getNode(bobId)->getProperty<int>("age"), 40);
+    EXPECT_EQ(first.getEdge(knowsId)->getType(), "KNOWS");
+    EXPECT_EQ(second.getEdge(likesId)->getType(), "LIKES");
+}
+
+TEST_F(StorageEngineTest, ViewsReadCachedAndOnDiskRecords) {
+    int nodeId;
+    {
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        Node node;
+        node.setProperty("v", 1);
+        nodeId = engine.addNode(node);
+        engine.updateNode(nodeId, [](Node& node) { node.setProperty("v", 2); });
+
+        // The dirty cached version is what the view sees
+        int seen = 0;
+        EXPECT_TRUE(engine.viewNode(nodeId, [&](const NodeView& view) { seen = view.getProperty<int>("v"); }));
+        EXPECT_EQ(seen, 2);
+    }
+    std::remove((dbPath + "hot_set.db").c_str());  // Start cold
+
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    int seen = 0;
+    EXPECT_TRUE(engine.viewNode(nodeId, [&](const NodeView& view) { seen = view.getProperty<int>("v"); }));
+    EXPECT_EQ(seen, 2);
+    EXPECT_FALSE(engine.viewNode(nodeId + 100, [](const NodeView&) { FAIL(); }));
+    EXPECT_FALSE(engine.viewEdge(1, [](const EdgeView&) { FAIL(); }));
+}
+
+TEST_F(StorageEngineTest, ColumnsFollowAddAndUpdate) {
+    StorageEngine engine(dbPath, 4 * CacheManager::chargeFor(Node(0)), 3);
+    for (int i = 0; i < 100; ++i) {
+        Node node;
+        node.setProperty("age", i);
+        engine.addNode(node);
+    }
+    engine.flush();
+
+    // Backfilled from disk and from the cache
+    engine.addColumn("age", ColumnType::Int);
+    engine.addColumn("active", ColumnType::Bool);
+    PropertyKey age = engine.propertyKey("age");
+    PropertyKey active = engine.propertyKey("active");
+    EXPECT_EQ(engine.getColumns().filter(age, CompareOp::GreaterEqual, 90).count(), 10u);
+    EXPECT_EQ(engine.getColumns().notNull(active).count(), 0u);
+
+    for (int i = 0; i < 100; i += 2) {
+        engine.updateNode(i, [](Node& node) { node.setProperty("active", true); });
+    }
+    Node late;
+    late.setProperty("age", 95);
+    late.setProperty("active", true);
+    int lateId = engine.addNode(late);
+
+    SelectionBitmap selected = engine.getColumns().filter(age, CompareOp::Greater, 90);
+    selected &= engine.getColumns().filter(active, true);
+    EXPECT_EQ(selected.toIds(), (std::vector<int>{92, 94, 96, 98, lateId}));
+}
+
+TEST_F(StorageEngineTest, PropertyIndexesFollowChangesAndPersist) {
+    {
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        for (int i = 0; i < 50; ++i) {
+            Node node;
+            node.setProperty("email", "user" + std::to_string(i) + "@example.com");
+            node.setProperty("age", i);
+            engine.addNode(node);
+        }
+        Edge edge(0, 0, 1, "KNOWS");
+        edge.setProperty("since", 2001.5);
+        int edgeId = engine.addEdge(edge);
+        engine.flush();
+
+        // Backfilled from disk
+        engine.addNodePropertyIndex("email", IndexType::String);
+        engine.addNodePropertyIndex("age", IndexType::Int);
+        engine.addEdgePropertyIndex("since", IndexType::Double);
+        EXPECT_THROW(engine.addNodePropertyIndex("age", IndexType::String), std::invalid_argument);
+        EXPECT_THROW(engine.findNodesByProperty("name", 1), std::invalid_argument);
+        EXPECT_THROW(engine.findNodesInRange("email", 0, 1), std::invalid_argument);
+        EXPECT_EQ(engine.findNodesByProperty("email", std::string("user7@example.com")), (std::vector<int>{7}));
+        EXPECT_EQ(engine.findNodesInRange("age", 10, 12.5), (std::vector<int>{10, 11, 12}));
+        EXPECT_EQ(engine.findEdgesInRange("since", 2000, 2010), (std::vector<int>{edgeId}));
+
+        engine.updateNode(7, [](Node& node) { node.setProperty("email", std::string("new@example.com")); });
+        engine.updateNode(11, [](Node& node) { node.setProperty("age", 40); });
+        engine.updateEdge(edgeId, [](Edge& edge) { edge.setProperty("since", 1999.0); });
+        Node late;
+        late.setProperty("age", 12);
+        engine.addNode(late);
+        EXPECT_TRUE(engine.findNodesByProperty("email", std::string("user7@example.com")).empty());
+        EXPECT_EQ(engine.findNodesByProperty("email", std::string("new@example.com")), (std::vector<int>{7}));
+        EXPECT_EQ(engine.findNodesInRange("age", 10, 12.5), (std::vector<int>{10, 12, 50}));
+        EXPECT_EQ(engine.findNodesByProperty("age", 40), (std::vector<int>{11, 40}));
+        EXPECT_TRUE(engine.findEdgesInRange("since", 2000, 2010).empty());
+    }
+
+    StorageEngine reopened(dbPath, 1 << 20, 3);
+    EXPECT_EQ(reopened.findNodesByProperty("email", std::string("new@example.com")), (std::vector<int>{7}));
+    EXPECT_EQ(reopened.findNodesInRange("age", 10, 12.5), (std::vector<int>{10, 12, 50}));
+    EXPECT_EQ(reopened.findEdgesByProperty("since", 1999), (std::vector<int>{0}));
+    // Already present after the reload, so not filled again
+    reopened.addNodePropertyIndex("age", IndexType::Int);
+    EXPECT_EQ(reopened.findNodesByProperty("age", 12), (std::vector<int>{12, 50}));
+}
+
+TEST_F(StorageEngineTest, StalePropertyIndexesAreRebuilt) {
+    auto addAges = [](StorageEngine& engine, int first, int last) {
+        for (int age = first; age < last; ++age) {
+            Node node;
+            node.setProperty("age", age);
+            engine.addNode(node);
+        }
+    };
+    {
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        engine.addNodePropertyIndex("age", IndexType::Int);
+        addAges(engine, 0, 10);
+    }
+    std::string saved;
+    {
+        std::ifstream file(dbPath + "property_indexes.db", std::ios::binary);
+        saved.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    {
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        addAges(engine, 10, 20);
+    }
+    // As if a crash came after the id indexes were saved but before the
+    // property indexes were
+    {
+        std::ofstream file(dbPath + "property_indexes.db", std::ios::binary | std::ios::trunc);
+        file.write(saved.data(), saved.size());
+    }
+    std::remove((dbPath + "hot_set.db").c_str());
+
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    EXPECT_EQ(engine.findNodesInRange("age", 8, 12), (std::vector<int>{8, 9, 10, 11, 12}));
+}
+
+TEST_F(StorageEngineTest, FailedIndexWritesThrow) {
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    engine.addNodePropertyIndex("age", IndexType::Int);
+    // A directory in the way of the temporary file makes the write fail
+    for (const char* name : {"property_indexes.db.tmp", "adjacency_index.db.tmp"}) {
+        std::string blocked = dbPath + name;
+        std::filesystem::create_directory(blocked);
+        EXPECT_THROW(engine.flush(), std::runtime_error) << name;
+        std::filesystem::remove(blocked);
+    }
+}
+
+TEST_F(StorageEngineTest, TypedNeighborsComeFromTheAdjacencyIndex) {
+    int knows0;
+    int likes;
+    {
+        StorageEngine engine(dbPath, 1 << 20, 3);
+        for (int i = 0; i < 4; ++i) {
+            engine.addNode(Node());
+        }
+        knows0 = engine.addEdge(Edge(0, 0, 1, "KNOWS"));
+        likes = engine.addEdge(Edge(0, 0, 2, "LIKES"));
+        engine.addEdge(Edge(0, 0, 3, "KNOWS"));
+        engine.addEdge(Edge(0, 3, 1, "KNOWS"));
+
+        EXPECT_EQ(engine.getOutgoingNeighbors(0, "KNOWS"), (std::vector<Neighbor>{{knows0, 1}, {knows0 + 2, 3}}));
+        EXPECT_EQ(engine.getOutgoingNeighbors(0, engine.edgeType("LIKES")), (std::vector<Neighbor>{{likes, 2}}));
+        EXPECT_EQ(engine.getIncomingNeighbors(1, "KNOWS"), (std::vector<Neighbor>{{knows0, 0}, {knows0 + 3, 3}}));
+        EXPECT_TRUE(engine.getIncomingNeighbors(0, "KNOWS").empty());
+        EXPECT_TRUE(engine.getOutgoingNeighbors(0, "NO_SUCH_TYPE").empty());
+    }
+    {
+        StorageEngine reopened(dbPath, 1 << 20, 3);
+        EXPECT_EQ(reopened.getIncomingNeighbors(2, "LIKES"), (std::vector<Neighbor>{{likes, 0}}));
+        reopened.addEdge(Edge(0, 2, 1, "KNOWS"));
+    }
+
+    // Databases without a saved index have it rebuilt from the edges on open
+    std::remove((dbPath + "adjacency_index.db").c_str());
+    StorageEngine rebuilt(dbPath, 1 << 20, 3);
+    EXPECT_EQ(rebuilt.getIncomingNeighbors(1, "KNOWS"),
+              (std::vector<Neighbor>{{knows0, 0}, {knows0 + 3, 3}, {knows0 + 4, 2}}));
+    EXPECT_EQ(rebuilt.getOutgoingNeighbors(0, "LIKES"), (std::vector<Neighbor>{{likes, 2}}));
+}
+
+TEST_F(StorageEngineTest, ScanNodesSeesCachedChanges) {
+    StorageEngine engine(dbPath, 1 << 20, 3);
+    for (int i = 0; i < 50; ++i) {
+        Node node;
+        node.setProperty("value", i);
+        engine.addNode(node);
+    }
+    engine.updateNode(7, [](Node& node) { node.setProperty("value", 700); });
+
+    std::vector<int> values(50, -1);
+    engine.scanNodes([&](size_t, const NodeView& view) {
+        values[view.getId()] = view.getProperty<int>("value");
+    }, 1);
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(values[i], i == 7 ? 700 : i);
+    }
+}
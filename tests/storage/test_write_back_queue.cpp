@@ -0,0 +1,64 @@
+// tests/storage/test_write_back_queue.cpp
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include "storage/write_back_queue.hpp"
+
+TEST(WriteBackQueueTest, WritesInBatchesAndDrains) {
+    std::mutex mutex;
+    std::set<int> written;
+    std::atomic<int> batches{0};
+    WriteBackQueue queue(
+        [&](const std::vector<std::shared_ptr<const Node>>& nodes) {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto& node : nodes) {
+                written.insert(node->getId());
+            }
+            ++batches;
+        },
+        [](const std::vector<std::shared_ptr<const Edge>>&) {},
+        1 << 20, 16);
+
+    {
+        // Stall the writer on its first batch so the rest pile up behind it
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int i = 0; i < 100; ++i) {
+            queue.enqueueNode(std::make_shared<Node>(i));
+        }
+    }
+    queue.drain();
+    EXPECT_EQ(written.size(), 100);
+    EXPECT_LE(batches.load(), 1 + (100 + 15) / 16);
+    EXPECT_EQ(queue.pendingCount(), 0);
+    EXPECT_EQ(queue.pendingBytes(), 0);
+}
+
+TEST(WriteBackQueueTest, PendingRecordsAreFindable) {
+    std::mutex gate;
+    gate.lock();
+    WriteBackQueue queue(
+        [&](const std::vector<std::shared_ptr<const Node>>&) {
+            std::lock_guard<std::mutex> lock(gate);
+        },
+        [](const std::vector<std::shared_ptr<const Edge>>&) {},
+        1 << 20);
+
+    auto node = std::make_shared<Node>(7);
+    queue.enqueueNode(node);
+    EXPECT_EQ(queue.findNode(7), node);
+    EXPECT_EQ(queue.findNode(8), nullptr);
+
+    gate.unlock();
+    queue.drain();
+    EXPECT_EQ(queue.findNode(7), nullptr);
+}
+
+TEST(WriteBackQueueTest, WriterErrorsSurfaceOnDrain) {
+    WriteBackQueue queue(
+        [](const std::vector<std::shared_ptr<const Node>>&) {},
+        [](const std::vector<std::shared_ptr<const Edge>>&) { throw std::runtime_error("disk full"); },
+        1 << 20);
+    queue.enqueueEdge(std::make_shared<Edge>(1, 0, 0, "T"));
+    EXPECT_THROW(queue.drain(), std::runtime_error);
+}
@@ -0,0 +1,151 @@
+// tools/bfs_bench.cpp
+//
+// Builds a random graph in a scratch database and times breadth-first
+// search from a set of random roots: full traversals over a CsrGraph
+// snapshot, top-down only and direction-optimizing, at one thread and at
+// the requested thread count, reported in traversed edges per second (the
+// edges in the rows of every reached node, as Graph500 counts them). Then
+// times k-hop expansion through the engine, with the getNode loop callers
+// used to write against breadthFirstSearch over the engine and the snapshot.
+//
+//   bfs_bench [nodes] [edges per node] [threads] [hops] [db prefix]
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "graph/traversal.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int nodeCount = argc > 1 ? std::stoi(argv[1]) : 100000;
+    int degree = argc > 2 ? std::stoi(argv[2]) : 8;
+    size_t threads = argc > 3 ? std::stoul(argv[3]) : 0;
+    int hops = argc > 4 ? std::stoi(argv[4]) : 2;
+    std::string dbPath = argc > 5 ? argv[5] : "/tmp/bfs_bench_";
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    StorageEngine::destroy(dbPath);
+
+    StorageEngine engine(dbPath, 64 << 20, 64);
+    std::mt19937 rng(21);
+    std::uniform_int_distribution<int> node(0, nodeCount - 1);
+
+    // Edge ids are handed out from 0 in a fresh database, so each node's
+    // adjacency can be written before the node itself
+    auto start = Clock::now();
+    std::vector<Node> nodes(nodeCount);
+    for (int source = 0; source < nodeCount; ++source) {
+        for (int i = 0; i < degree; ++i) {
+            nodes[source].addEdge(engine.addEdge(Edge(0, source, node(rng), "LINK")), true);
+        }
+    }
+    for (Node& record : nodes) {
+        engine.addNode(record);
+    }
+    nodes.clear();
+    engine.flush();
+    std::cout << "loaded " << nodeCount << " nodes, " << static_cast<size_t>(nodeCount) * degree << " edges in "
+              << std::fixed << std::setprecision(0) << msSince(start) << " ms\n";
+
+    CsrOptions options;
+    options.threadCount = threads;
+    CsrGraph graph = CsrGraph::build(engine, options);
+    options.direction = CsrDirection::Incoming;
+    CsrGraph incoming = CsrGraph::build(engine, options);
+
+    std::vector<int> roots(16);
+    for (int& root : roots) {
+        root = node(rng);
+    }
+
+    std::cout << "full traversals from " << roots.size() << " roots\n";
+    size_t reference = 0;
+    bool consistent = true;
+    for (const CsrGraph* bottomUp : {static_cast<const CsrGraph*>(nullptr), static_cast<const CsrGraph*>(&incoming)}) {
+        for (size_t threadCount : {size_t{1}, threads}) {
+            TraversalOptions traversal;
+            traversal.threadCount = threadCount;
+            size_t reached = 0;
+            uint64_t traversedEdges = 0;
+            size_t bottomUpLevels = 0;
+            start = Clock::now();
+            for (int root : roots) {
+                TraversalResult result = breadthFirstSearch(graph, {root}, traversal, bottomUp);
+                reached += result.nodes.size();
+                bottomUpLevels += result.bottomUpLevels;
+                for (int id : result.nodes) {
+                    traversedEdges += graph.degree(id);
+                }
+            }
+            double ms = msSince(start);
+            if (reference == 0) {
+                reference = reached;
+            }
+            consistent = consistent && reached == reference;
+            std::cout << "  " << std::left << std::setw(20) << (bottomUp ? "direction-optimizing" : "top-down")
+                      << std::right << std::setw(3) << threadCount << "t " << std::setprecision(1) << std::setw(9)
+                      << ms << " ms " << std::setprecision(0) << std::setw(7) << traversedEdges / ms / 1000
+                      << " MTEPS, " << bottomUpLevels << " bottom-up levels\n";
+        }
+    }
+
+    // Runs first, so the loop below benefits from whatever it left in the cache
+    std::cout << hops << "-hop neighborhoods of " << roots.size() << " roots\n";
+    start = Clock::now();
+    size_t engineReached = 0;
+    for (int root : roots) {
+        engineReached += kHopNeighborhood(engine, root, hops).nodes.size();
+    }
+    double engineMs = msSince(start);
+
+    // The loop k-hop queries were written as before: a shared_ptr per visited
+    // node and per edge
+    start = Clock::now();
+    size_t loopReached = 0;
+    for (int root : roots) {
+        std::unordered_set<int> seen = {root};
+        std::vector<int> frontier = {root};
+        for (int hop = 0; hop < hops; ++hop) {
+            std::vector<int> next;
+            for (int id : frontier) {
+                engine.getNode(id)->forEachOutgoingEdge([&](int edgeId) {
+                    int target = engine.getEdge(edgeId)->getTargetNodeId();
+                    if (seen.insert(target).second) {
+                        next.push_back(target);
+                    }
+                });
+            }
+            frontier.swap(next);
+        }
+        loopReached += seen.size();
+    }
+    double loopMs = msSince(start);
+
+    start = Clock::now();
+    size_t csrReached = 0;
+    TraversalOptions traversal;
+    traversal.threadCount = threads;
+    for (int root : roots) {
+        csrReached += kHopNeighborhood(graph, root, hops, traversal, &incoming).nodes.size();
+    }
+    double csrMs = msSince(start);
+
+    std::cout << std::setprecision(2) << "  getNode loop      " << std::setw(10) << loopMs << " ms\n"
+              << "  engine traversal  " << std::setw(10) << engineMs << " ms\n"
+              << "  csr traversal     " << std::setw(10) << csrMs << " ms\n"
+              << "  " << csrReached << " nodes reached\n";
+    consistent = consistent && loopReached == engineReached && engineReached == csrReached;
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+// tools/cache_sim.cpp
+//
+// Replays a recorded access trace against every eviction policy and reports hit rates.
+//
+//   cache_sim <trace-file> <capacity-records>
+//   cache_sim --synthetic <capacity-records>
+//
+// Trace lines are "n <id>" for a node read or "e <id>" for an edge read;
+// a bare id is treated as a node read.
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "cache/cache_manager.hpp"
+
+struct Access {
+    bool isNode;
+    int id;
+};
+
+static std::vector<Access> loadTrace(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        throw std::runtime_error("Failed to open trace file " + path);
+    }
+    std::vector<Access> trace;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream iss(line);
+        std::string first;
+        iss >> first;
+        if (first == "n" || first == "e") {
+            int id;
+            if (iss >> id) {
+                trace.push_back({first == "n", id});
+            }
+        } else {
+            trace.push_back({true, std::stoi(first)});
+        }
+    }
+    return trace;
+}
+
+// Zipfian OLTP reads over a hot key space, interrupted by full scans of cold ids
+static std::vector<Access> syntheticTrace() {
+    const int hotKeys = 100000;
+    const int accesses = 1000000;
+    const int scanEvery = 100000;
+    const int scanLength = 50000;
+
+    std::vector<double> cdf(hotKeys);
+    double sum = 0;
+    for (int i = 0; i < hotKeys; ++i) {
+        sum += 1.0 / std::pow(i + 1, 0.99);
+        cdf[i] = sum;
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(0, sum);
+    std::vector<Access> trace;
+    trace.reserve(accesses + (accesses / scanEvery) * scanLength);
+    int nextScanId = hotKeys;
+    for (int i = 0; i < accesses; ++i) {
+        int id = static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), dist(rng)) - cdf.begin());
+        trace.push_back({true, id});
+        if (i % scanEvery == scanEvery - 1) {
+            for (int j = 0; j < scanLength; ++j) {
+                trace.push_back({true, nextScanId++});
+            }
+        }
+    }
+    return trace;
+}
+
+static void replay(const std::vector<Access>& trace, size_t capacity, EvictionPolicyType type) {
+    size_t nodeBudget = capacity * CacheManager::chargeFor(Node(0));
+    size_t edgeBudget = capacity * CacheManager::chargeFor(Edge(0, 0, 0, ""));
+    CacheManager cache(nodeBudget, edgeBudget, type);
+
+    size_t hits = 0;
+    for (const Access& access : trace) {
+        if (access.isNode) {
+            if (cache.getNode(access.id)) {
+                ++hits;
+            } else {
+                cache.cacheNode(access.id, std::make_shared<Node>(access.id));
+            }
+        } else {
+            if (cache.getEdge(access.id)) {
+                ++hits;
+            } else {
+                cache.cacheEdge(access.id, std::make_shared<Edge>(access.id, 0, 0, ""));
+            }
+        }
+    }
+
+    double hitRate = trace.empty() ? 0.0 : 100.0 * hits / trace.size();
+    std::cout << std::left << std::setw(12) << cache.policyName()
+              << std::right << std::setw(12) << hits
+              << std::setw(12) << trace.size() - hits
+              << std::setw(11) << std::fixed << std::setprecision(2) << hitRate << "%" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <trace-file|--synthetic> <capacity-records>" << std::endl;
+        return 1;
+    }
+
+    std::vector<Access> trace;
+    try {
+        trace = std::string(argv[1]) == "--synthetic" ? syntheticTrace() : loadTrace(argv[1]);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    size_t capacity = std::stoul(argv[2]);
+
+    std::cout << trace.size() << " accesses, capacity " << capacity << " records per kind" << std::endl;
+    std::cout << std::left << std::setw(12) << "policy"
+              << std::right << std::setw(12) << "hits"
+              << std::setw(12) << "misses"
+              << std::setw(12) << "hit rate" << std::endl;
+    for (EvictionPolicyType type : {EvictionPolicyType::LRU, EvictionPolicyType::CLOCK,
+                                    EvictionPolicyType::W_TINY_LFU}) {
+        replay(trace, capacity, type);
+    }
+    return 0;
+}
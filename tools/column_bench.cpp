@@ -0,0 +1,102 @@
+// tools/column_bench.cpp
+//
+// Times the filter "age > 30 and active == true" over encoded node records
+// three ways: deserializing each Node, reading each record through a NodeView,
+// and scanning a ColumnStore at each SIMD level.
+//
+//   column_bench [nodes]
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "core/node.hpp"
+#include "core/record_view.hpp"
+#include "storage/column_store.hpp"
+
+template<typename Scan>
+static double bestMs(Scan&& scan, size_t& matches) {
+    using Clock = std::chrono::steady_clock;
+    double best = 1e300;
+    for (int round = 0; round < 5; ++round) {
+        auto start = Clock::now();
+        matches = scan();
+        best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    PropertyKey age = propertyKey("age");
+    PropertyKey active = propertyKey("active");
+    PropertyKey name = propertyKey("name");
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> ages(0, 90);
+
+    // Records as they would come off disk, plus the column copy of two fields
+    std::vector<std::string> records(count);
+    ColumnStore columns;
+    columns.addColumn(age, ColumnType::Int);
+    columns.addColumn(active, ColumnType::Bool);
+    for (size_t i = 0; i < count; ++i) {
+        Node node(static_cast<int>(i));
+        node.setProperty(age, ages(rng));
+        node.setProperty(active, rng() % 2 == 0);
+        node.setProperty(name, "user" + std::to_string(i));
+        node.serializeTo(records[i]);
+        columns.update(node);
+    }
+
+    size_t expected = 0;
+    double deserializeMs = bestMs([&] {
+        size_t matches = 0;
+        for (const std::string& record : records) {
+            Node node = Node::deserialize(record);
+            const int* a = node.tryGetProperty<int>(age);
+            const bool* b = node.tryGetProperty<bool>(active);
+            matches += a && b && *a > 30 && *b;
+        }
+        return matches;
+    }, expected);
+
+    size_t viewMatches = 0;
+    double viewMs = bestMs([&] {
+        size_t matches = 0;
+        for (const std::string& record : records) {
+            NodeView view(record);
+            auto a = view.tryGetProperty<int>(age);
+            auto b = view.tryGetProperty<bool>(active);
+            matches += a && b && *a > 30 && *b;
+        }
+        return matches;
+    }, viewMatches);
+
+    std::cout << "age > 30 and active over " << count << " nodes (" << expected << " match), ms\n"
+              << std::fixed << std::setprecision(2) << "  deserialize   " << std::setw(10) << deserializeMs << "\n"
+              << "  node view     " << std::setw(10) << viewMs << "\n";
+    bool consistent = viewMatches == expected;
+
+    // Bytes read per scan: the int column and both validity bitmaps, and the bool values
+    double columnBytes = count * sizeof(int32_t) + 3 * (count / 8.0);
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if (level > detectedSimdLevel()) {
+            continue;
+        }
+        size_t columnMatches = 0;
+        double columnMs = bestMs([&] {
+            SelectionBitmap selected = columns.filter(age, CompareOp::Greater, 30, level);
+            selected &= columns.filter(active, true);
+            return selected.count();
+        }, columnMatches);
+        consistent = consistent && columnMatches == expected;
+        std::cout << "  columns " << std::left << std::setw(6) << simdLevelName(level) << std::right
+                  << std::setw(10) << columnMs << "   " << std::setprecision(1)
+                  << columnBytes / columnMs / 1e6 << " GB/s\n"
+                  << std::setprecision(2);
+    }
+    std::cout << "  column store heap " << columns.heapUsage() / 1024 << " KiB\n";
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+// tools/csr_bench.cpp
+//
+// Builds a random graph in a scratch database, then times two-hop
+// neighborhood expansion through StorageEngine (getNode, getEdge per hop)
+// against the same walk over a CsrGraph snapshot. Also reports snapshot
+// build, save, load and refresh times.
+//
+//   csr_bench [nodes] [edges per node] [threads] [db prefix]
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "graph/csr_graph.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int nodeCount = argc > 1 ? std::stoi(argv[1]) : 100000;
+    int degree = argc > 2 ? std::stoi(argv[2]) : 8;
+    size_t threads = argc > 3 ? std::stoul(argv[3]) : 0;
+    std::string dbPath = argc > 4 ? argv[4] : "/tmp/csr_bench_";
+    StorageEngine::destroy(dbPath);
+    std::remove((dbPath + "graph.csr").c_str());
+
+    StorageEngine engine(dbPath, 64 << 20, 64);
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<int> node(0, nodeCount - 1);
+    std::uniform_real_distribution<double> weight(0, 1);
+
+    // Edge ids are handed out from 0 in a fresh database, so each node's
+    // adjacency can be written before the node itself
+    auto start = Clock::now();
+    std::vector<Node> nodes(nodeCount);
+    for (int source = 0; source < nodeCount; ++source) {
+        for (int i = 0; i < degree; ++i) {
+            Edge edge(0, source, node(rng), "LINK");
+            edge.setProperty("weight", weight(rng));
+            nodes[source].addEdge(engine.addEdge(edge), true);
+        }
+    }
+    for (Node& record : nodes) {
+        engine.addNode(record);
+    }
+    nodes.clear();
+    engine.flush();
+    std::cout << "loaded " << nodeCount << " nodes, " << static_cast<size_t>(nodeCount) * degree << " edges in "
+              << std::fixed << std::setprecision(0) << msSince(start) << " ms\n";
+
+    CsrOptions options;
+    options.weightProperty = "weight";
+    options.threadCount = threads;
+    start = Clock::now();
+    CsrGraph graph = CsrGraph::build(engine, options);
+    double buildMs = msSince(start);
+
+    std::vector<int> sources(1000);
+    for (int& source : sources) {
+        source = node(rng);
+    }
+
+    // Sum of weights over every two-hop path from each source
+    start = Clock::now();
+    double engineSum = 0;
+    for (int source : sources) {
+        engine.getNode(source)->forEachOutgoingEdge([&](int first) {
+            auto edge = engine.getEdge(first);
+            engineSum += edge->getProperty<double>("weight");
+            engine.getNode(edge->getTargetNodeId())->forEachOutgoingEdge([&](int second) {
+                engineSum += engine.getEdge(second)->getProperty<double>("weight");
+            });
+        });
+    }
+    double engineMs = msSince(start);
+
+    start = Clock::now();
+    double csrSum = 0;
+    for (int source : sources) {
+        auto targets = graph.neighbors(source);
+        auto weights = graph.weights(source);
+        for (size_t i = 0; i < targets.size(); ++i) {
+            csrSum += weights[i];
+            for (double next : graph.weights(targets[i])) {
+                csrSum += next;
+            }
+        }
+    }
+    double csrMs = msSince(start);
+
+    start = Clock::now();
+    graph.save(dbPath + "graph.csr");
+    double saveMs = msSince(start);
+    start = Clock::now();
+    CsrGraph loaded = CsrGraph::load(dbPath + "graph.csr");
+    double loadMs = msSince(start);
+
+    for (int i = 0; i < 1000; ++i) {
+        engine.addEdge(Edge(0, node(rng), node(rng), "LINK"));
+    }
+    start = Clock::now();
+    graph.refresh(engine);
+    double refreshMs = msSince(start);
+
+    std::cout << std::setprecision(2) << "snapshot build       " << std::setw(10) << buildMs << " ms\n"
+              << "two hops x1000, engine " << std::setw(8) << engineMs << " ms\n"
+              << "two hops x1000, csr    " << std::setw(8) << csrMs << " ms\n"
+              << "save                 " << std::setw(10) << saveMs << " ms\n"
+              << "load (mapped)        " << std::setw(10) << loadMs << " ms\n"
+              << "refresh, 1000 edges  " << std::setw(10) << refreshMs << " ms\n";
+    bool same = std::abs(engineSum - csrSum) < 1e-6 * std::abs(engineSum);
+    return same && loaded.edgeCount() + 1000 == graph.edgeCount() ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+// tools/expand_bench.cpp
+//
+// Builds a random graph with several edge types in a scratch database, then
+// times typed one-hop expansion from random nodes three ways: the loop over
+// every outgoing edge checking getType(), the loop over the node's partition
+// for the type reading each Edge for its target, and the adjacency index.
+// Each runs on a freshly opened database, cold and then warm.
+//
+//   expand_bench [nodes] [edges per node] [types] [queries] [db prefix]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "storage/storage_engine.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int nodeCount = argc > 1 ? std::stoi(argv[1]) : 100000;
+    int degree = argc > 2 ? std::stoi(argv[2]) : 16;
+    int typeCount = argc > 3 ? std::stoi(argv[3]) : 4;
+    int queries = argc > 4 ? std::stoi(argv[4]) : 10000;
+    std::string dbPath = argc > 5 ? argv[5] : "/tmp/expand_bench_";
+    StorageEngine::destroy(dbPath);
+
+    std::mt19937 rng(48);
+    std::uniform_int_distribution<int> node(0, nodeCount - 1);
+    std::uniform_int_distribution<int> pickType(0, typeCount - 1);
+    std::vector<std::string> typeNames;
+    for (int t = 0; t < typeCount; ++t) {
+        typeNames.push_back("TYPE_" + std::to_string(t));
+    }
+    std::vector<std::pair<int, int>> probes(queries);
+    for (auto& probe : probes) {
+        probe = {node(rng), pickType(rng)};
+    }
+
+    // Ids in the database's own registry, which every engine below reloads
+    std::vector<EdgeType> types;
+    {
+        StorageEngine engine(dbPath, 64 << 20, 64);
+        // Edge ids are handed out from 0 in a fresh database, so each node's
+        // adjacency can be written before the node itself
+        auto start = Clock::now();
+        std::vector<Node> nodes(nodeCount);
+        for (int source = 0; source < nodeCount; ++source) {
+            for (int i = 0; i < degree; ++i) {
+                Edge edge(0, source, node(rng), typeNames[pickType(rng)]);
+                nodes[source].addEdge(engine.addEdge(edge), true, edge.getTypeId());
+            }
+        }
+        for (Node& record : nodes) {
+            engine.addNode(record);
+        }
+        nodes.clear();
+        engine.flush();
+        for (const std::string& name : typeNames) {
+            types.push_back(engine.edgeType(name));
+        }
+        std::cout << "loaded " << nodeCount << " nodes, " << static_cast<size_t>(nodeCount) * degree << " edges in "
+                  << std::fixed << std::setprecision(0) << msSince(start) << " ms\n";
+    }
+
+    // Each method gets its own engine, so its first run reads from disk and
+    // its second from the cache the first one filled
+    auto expandAll = [&](StorageEngine& engine) {
+        long sum = 0;
+        for (const auto& [nodeId, type] : probes) {
+            engine.getNode(nodeId)->forEachOutgoingEdge([&](int edgeId) {
+                auto edge = engine.getEdge(edgeId);
+                if (edge->getType() == typeNames[type]) {
+                    sum += edge->getTargetNodeId();
+                }
+            });
+        }
+        return sum;
+    };
+    auto expandPartition = [&](StorageEngine& engine) {
+        long sum = 0;
+        for (const auto& [nodeId, type] : probes) {
+            for (int edgeId : engine.getNode(nodeId)->getOutgoingEdges(types[type])) {
+                sum += engine.getEdge(edgeId)->getTargetNodeId();
+            }
+        }
+        return sum;
+    };
+    auto expandIndex = [&](StorageEngine& engine) {
+        long sum = 0;
+        for (const auto& [nodeId, type] : probes) {
+            for (const Neighbor& neighbor : engine.getOutgoingNeighbors(nodeId, types[type])) {
+                sum += neighbor.nodeId;
+            }
+        }
+        return sum;
+    };
+
+    std::cout << "us per expansion          cold       warm\n" << std::setprecision(2);
+    std::vector<long> sums;
+    auto run = [&](const char* label, const std::function<long(StorageEngine&)>& expand) {
+        // Closing saved the previous engine's hot set, which would warm this one
+        std::remove((dbPath + "hot_set.db").c_str());
+        StorageEngine engine(dbPath, 256 << 20, 64);
+        std::cout << "  " << label;
+        for (int round = 0; round < 2; ++round) {
+            auto start = Clock::now();
+            sums.push_back(expand(engine));
+            std::cout << std::setw(11) << msSince(start) * 1000 / queries;
+        }
+        std::cout << "\n";
+    };
+    run("all edges + getType", expandAll);
+    run("typed partition    ", expandPartition);
+    run("adjacency index    ", expandIndex);
+    bool consistent = std::all_of(sums.begin(), sums.end(), [&](long sum) { return sum == sums.front(); });
+    return consistent ? 0 : 1;
+}
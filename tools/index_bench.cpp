@@ -0,0 +1,123 @@
+// tools/index_bench.cpp
+//
+// Loads nodes with a unique "email" and a random "age" into a scratch
+// database, then times email lookups through a scan of every node with
+// viewNode and through a secondary property index, and an age equality
+// through the columnar filter and an ordered index. Also times building the
+// indexes and reopening the database with them.
+//
+//   index_bench [nodes] [queries] [db prefix]
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "storage/storage_engine.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static std::string emailOf(int i) {
+    return "user" + std::to_string(i) + "@example.com";
+}
+
+int main(int argc, char** argv) {
+    int nodeCount = argc > 1 ? std::stoi(argv[1]) : 200000;
+    int queries = argc > 2 ? std::stoi(argv[2]) : 1000;
+    std::string dbPath = argc > 3 ? argv[3] : "/tmp/index_bench_";
+    StorageEngine::destroy(dbPath);
+
+    std::mt19937 rng(47);
+    std::uniform_int_distribution<int> age(0, 99);
+    std::uniform_int_distribution<int> node(0, nodeCount - 1);
+    std::vector<int> probes(queries);
+    for (int& probe : probes) {
+        probe = node(rng);
+    }
+    bool consistent = true;
+
+    {
+        StorageEngine engine(dbPath, 16 << 20, 64);
+        PropertyKey email = engine.propertyKey("email");
+        PropertyKey ageKey = engine.propertyKey("age");
+        auto start = Clock::now();
+        for (int i = 0; i < nodeCount; ++i) {
+            Node record;
+            record.setProperty(email, emailOf(i));
+            record.setProperty(ageKey, age(rng));
+            engine.addNode(record);
+        }
+        engine.flush();
+        std::cout << "loaded " << nodeCount << " nodes in " << std::fixed << std::setprecision(0) << msSince(start)
+                  << " ms\n";
+
+        // The scan reads every record, so it only runs the first few queries
+        int scanQueries = std::min(queries, 5);
+        std::vector<int> scanned;
+        start = Clock::now();
+        for (int q = 0; q < scanQueries; ++q) {
+            std::string wanted = emailOf(probes[q]);
+            for (int nodeId = 0; nodeId < engine.getNodeIdLimit(); ++nodeId) {
+                engine.viewNode(nodeId, [&](const NodeView& view) {
+                    if (view.tryGetProperty<std::string_view>(email) == std::string_view(wanted)) {
+                        scanned.push_back(nodeId);
+                    }
+                });
+            }
+        }
+        double scanMs = msSince(start) / scanQueries;
+
+        start = Clock::now();
+        engine.addColumn(ageKey, ColumnType::Int);
+        double columnBuildMs = msSince(start);
+
+        start = Clock::now();
+        engine.addNodePropertyIndex(email, IndexType::String);
+        engine.addNodePropertyIndex(ageKey, IndexType::Int);
+        double indexBuildMs = msSince(start);
+        start = Clock::now();
+        size_t found = 0;
+        for (int q = 0; q < queries; ++q) {
+            std::vector<int> ids = engine.findNodesByProperty(email, emailOf(probes[q]));
+            found += ids.size();
+            consistent = consistent && (q >= scanQueries || ids == std::vector<int>{scanned[q]});
+        }
+        double indexMs = msSince(start) / queries;
+        consistent = consistent && found == static_cast<size_t>(queries);
+
+        // About 1% of the nodes
+        start = Clock::now();
+        size_t columnRange = engine.getColumns().filter(ageKey, CompareOp::Equal, 42).count();
+        double columnRangeMs = msSince(start);
+        start = Clock::now();
+        size_t indexRange = engine.findNodesInRange(ageKey, 42, 42).size();
+        double indexRangeMs = msSince(start);
+        consistent = consistent && columnRange == indexRange;
+
+        std::cout << std::setprecision(3) << "email lookup, ms each\n"
+                  << "  viewNode scan        " << std::setw(10) << scanMs << "\n"
+                  << "  property index       " << std::setw(10) << indexMs << "\n"
+                  << "age == 42 (" << indexRange << " nodes), ms\n"
+                  << "  column filter        " << std::setw(10) << columnRangeMs << "\n"
+                  << "  property index       " << std::setw(10) << indexRangeMs << "\n"
+                  << "build, ms\n"
+                  << "  age column           " << std::setw(10) << columnBuildMs << "\n"
+                  << "  property indexes     " << std::setw(10) << indexBuildMs << "\n";
+        start = Clock::now();
+        engine.flush();
+        std::cout << "  flush with indexes   " << std::setw(10) << msSince(start) << "\n";
+    }
+
+    auto start = Clock::now();
+    StorageEngine reopened(dbPath, 16 << 20, 64);
+    double reopenMs = msSince(start);
+    consistent = consistent && reopened.findNodesByProperty("email", emailOf(probes[0])) == std::vector<int>{probes[0]};
+    std::cout << "  reopen               " << std::setw(10) << reopenMs << "\n";
+    return consistent ? 0 : 1;
+}
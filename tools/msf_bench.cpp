@@ -0,0 +1,97 @@
+// tools/msf_bench.cpp
+//
+// Times the minimum spanning forest algorithms on synthetic random graphs
+// held in memory, at one thread and at the requested thread count, and
+// optionally over edges stored in a scratch database.
+//
+//   msf_bench [edges] [average degree] [threads] [stored edges] [db prefix]
+//
+// Weights are uniform random doubles; node count is 2 * edges / degree.
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "graph/spanning_forest.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static const char* nameOf(SpanningForestAlgorithm algorithm) {
+    return algorithm == SpanningForestAlgorithm::Kruskal ? "kruskal" : "boruvka";
+}
+
+int main(int argc, char** argv) {
+    size_t edgeCount = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    size_t degree = argc > 2 ? std::stoul(argv[2]) : 8;
+    size_t threads = argc > 3 ? std::stoul(argv[3]) : 0;
+    size_t storedEdges = argc > 4 ? std::stoul(argv[4]) : 0;
+    std::string dbPath = argc > 5 ? argv[5] : "/tmp/msf_bench_";
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    size_t nodeCount = std::max<size_t>(2, 2 * edgeCount / degree);
+    std::mt19937_64 rng(13);
+    std::uniform_int_distribution<int> node(0, static_cast<int>(nodeCount) - 1);
+    std::uniform_real_distribution<double> weight(0, 1);
+    std::vector<WeightedEdge> edges(edgeCount);
+    for (size_t i = 0; i < edgeCount; ++i) {
+        edges[i] = {weight(rng), node(rng), node(rng), static_cast<int>(i)};
+    }
+
+    std::cout << nodeCount << " nodes, " << edgeCount << " edges in memory, ms\n" << std::fixed;
+    double reference = -1;
+    bool consistent = true;
+    for (SpanningForestAlgorithm algorithm : {SpanningForestAlgorithm::Kruskal, SpanningForestAlgorithm::Boruvka}) {
+        for (size_t threadCount : {size_t{1}, threads}) {
+            auto start = Clock::now();
+            SpanningForest forest = minimumSpanningForest(nodeCount, edges, algorithm, threadCount);
+            double ms = msSince(start);
+            std::cout << "  " << std::left << std::setw(8) << nameOf(algorithm) << std::right << std::setw(3)
+                      << threadCount << "t " << std::setprecision(1) << std::setw(10) << ms << "   "
+                      << forest.componentCount << " trees, weight " << std::setprecision(3)
+                      << forest.totalWeight << "\n";
+            if (reference < 0) {
+                reference = forest.totalWeight;
+            }
+            consistent = consistent && forest.totalWeight == reference;
+            if (threadCount == threads) {
+                break;
+            }
+        }
+    }
+
+    if (storedEdges > 0) {
+        StorageEngine::destroy(dbPath);
+        StorageEngine engine(dbPath, 64 << 20, 64);
+        size_t storedNodes = std::max<size_t>(2, 2 * storedEdges / degree);
+        std::uniform_int_distribution<int> storedNode(0, static_cast<int>(storedNodes) - 1);
+        for (size_t i = 0; i < storedNodes; ++i) {
+            engine.addNode(Node());
+        }
+        for (size_t i = 0; i < storedEdges; ++i) {
+            Edge edge(0, storedNode(rng), storedNode(rng), "LINK");
+            edge.setProperty("weight", weight(rng));
+            engine.addEdge(edge);
+        }
+        engine.flush();
+
+        std::cout << storedNodes << " nodes, " << storedEdges << " stored edges, ms\n";
+        for (SpanningForestAlgorithm algorithm : {SpanningForestAlgorithm::Kruskal, SpanningForestAlgorithm::Boruvka}) {
+            auto start = Clock::now();
+            SpanningForest forest = minimumSpanningForest(engine, "weight", algorithm, threads);
+            std::cout << "  " << std::left << std::setw(8) << nameOf(algorithm) << std::right << std::setw(3)
+                      << threads << "t " << std::setprecision(1) << std::setw(10) << msSince(start) << "   "
+                      << forest.componentCount << " trees\n";
+        }
+    }
+    return consistent ? 0 : 1;
+}
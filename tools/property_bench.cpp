@@ -0,0 +1,116 @@
+// tools/property_bench.cpp
+//
+// Measures per-node property memory and the cost of a property-filter scan.
+//
+//   property_bench [nodes]
+//
+// Nodes carry 2 to 6 mixed-type properties, like typical vertex data. Heap
+// bytes are what the allocator still holds for the nodes once they are built.
+// The string filter compares a string property against a literal by name.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <malloc.h>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/node.hpp"
+
+static std::atomic<long> liveBytes{0};
+static std::atomic<size_t> allocationCount{0};
+
+void* operator new(size_t size) {
+    if (void* p = std::malloc(size)) {
+        liveBytes += malloc_usable_size(p);
+        ++allocationCount;
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    liveBytes -= malloc_usable_size(p);
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    operator delete(p);
+}
+
+int main(int argc, char** argv) {
+    using Clock = std::chrono::steady_clock;
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    std::mt19937 rng(3);
+
+    const char* names[] = {"age", "name", "score", "active", "created_at", "city"};
+    PropertyKey age = propertyKey("age");
+    std::vector<Node> nodes;
+    nodes.reserve(count);
+
+    long before = liveBytes;
+    for (size_t i = 0; i < count; ++i) {
+        Node node(static_cast<int>(i));
+        size_t properties = 2 + rng() % 5;
+        node.setProperty(names[0], static_cast<int>(rng() % 90));
+        node.setProperty(names[1], "u" + std::to_string(i));
+        if (properties > 2) node.setProperty(names[2], std::uniform_real_distribution<double>(0, 1)(rng));
+        if (properties > 3) node.setProperty(names[3], rng() % 2 == 0);
+        if (properties > 4) node.setProperty(names[4], static_cast<int>(1600000000 + rng() % 100000000));
+        if (properties > 5) node.setProperty(names[5], std::string("Amsterdam"));
+        nodes.push_back(std::move(node));
+    }
+    double heapPerNode = static_cast<double>(liveBytes - before) / count;
+
+    // Shuffle the visit order so the scan is not a pure sequential stream
+    std::vector<uint32_t> order(count);
+    for (size_t i = 0; i < count; ++i) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), rng);
+
+    size_t matches = 0;
+    auto start = Clock::now();
+    for (const Node& node : nodes) {
+        matches += node.getProperty<int>(age) > 50;
+    }
+    double sequentialNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+
+    start = Clock::now();
+    for (uint32_t i : order) {
+        matches += nodes[i].getProperty<int>(age) > 50;
+    }
+    double handleNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+
+    start = Clock::now();
+    for (uint32_t i : order) {
+        matches += nodes[i].getProperty<int>("age") > 50;
+    }
+    double nameNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+
+    // String equality filter keyed by a literal, counting allocations per probe
+    size_t allocationsBefore = allocationCount;
+    start = Clock::now();
+    for (uint32_t i : order) {
+        matches += nodes[i].getProperty<std::string_view>("name") == "u42";
+    }
+    double stringNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+    double stringAllocations = static_cast<double>(allocationCount - allocationsBefore) / count;
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "sizeof(Node)          " << sizeof(Node) << "\n"
+              << "heap bytes per node   " << heapPerNode << "\n"
+              << "total bytes per node  " << sizeof(Node) + heapPerNode << "\n"
+              << "filter ns (in order)  " << sequentialNs << "\n"
+              << "filter ns (handle)    " << handleNs << "\n"
+              << "filter ns (name)      " << nameNs << "\n"
+              << "string filter ns      " << stringNs << "\n"
+              << "string filter allocs  " << stringAllocations << "\n"
+              << (matches == 0 ? " " : "");
+    return 0;
+}
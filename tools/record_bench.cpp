@@ -0,0 +1,130 @@
+// tools/record_bench.cpp
+//
+// Measures per-record encode and decode time for Node and Edge.
+//
+//   record_bench [records]
+//
+// Records look like typical graph data: a handful of mixed-type properties
+// and a few dozen adjacency entries with mostly increasing ids. Read-mostly
+// access is timed both through a full decode and through NodeView.
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "core/node.hpp"
+#include "core/edge.hpp"
+#include "core/record_view.hpp"
+
+template<typename T>
+static void measure(const std::string& label, const std::vector<T>& records) {
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<std::string> encoded(records.size());
+    auto start = Clock::now();
+    for (size_t i = 0; i < records.size(); ++i) {
+        encoded[i] = records[i].serialize();
+    }
+    double encodeNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / records.size();
+
+    size_t bytes = 0;
+    size_t checksum = 0;
+    start = Clock::now();
+    for (const std::string& data : encoded) {
+        checksum += T::deserialize(data).getId();
+        bytes += data.size();
+    }
+    double decodeNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / records.size();
+
+    std::cout << std::left << std::setw(8) << label << std::right << std::fixed << std::setprecision(0)
+              << std::setw(12) << encodeNs << std::setw(12) << decodeNs
+              << std::setw(12) << static_cast<double>(bytes) / records.size()
+              << (checksum == 0 ? " " : "") << "\n";
+}
+
+static volatile long readSink;
+
+// ns per record for read(record bytes) over every encoded record
+template<typename Read>
+static double timeReads(const std::vector<std::string>& encoded, Read read) {
+    using Clock = std::chrono::steady_clock;
+    long checksum = 0;
+    auto start = Clock::now();
+    for (const std::string& data : encoded) {
+        checksum += read(data);
+    }
+    readSink = checksum;
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / encoded.size();
+}
+
+static void measureNodeReads(const std::vector<Node>& nodes) {
+    std::vector<std::string> encoded;
+    encoded.reserve(nodes.size());
+    for (const Node& node : nodes) {
+        encoded.push_back(node.serialize());
+    }
+    PropertyKey age = propertyKey("age");
+    auto sumIds = [](const auto& ids) {
+        long sum = 0;
+        for (int id : ids) {
+            sum += id;
+        }
+        return sum;
+    };
+
+    double decodeProperty = timeReads(encoded, [&](const std::string& data) {
+        return Node::deserialize(data).getProperty<int>(age);
+    });
+    double viewProperty = timeReads(encoded, [&](const std::string& data) {
+        return NodeView(data).getProperty<int>(age);
+    });
+    double decodeAdjacency = timeReads(encoded, [&](const std::string& data) {
+        long sum = 0;
+        Node::deserialize(data).forEachOutgoingEdge([&](int id) { sum += id; });
+        return sum;
+    });
+    double viewAdjacency = timeReads(encoded, [&](const std::string& data) {
+        return sumIds(NodeView(data).getOutgoingEdges());
+    });
+
+    std::cout << "\nnode read ns      decode        view\n" << std::fixed << std::setprecision(0)
+              << "one property  " << std::setw(12) << decodeProperty << std::setw(12) << viewProperty << "\n"
+              << "out-edge sum  " << std::setw(12) << decodeAdjacency << std::setw(12) << viewAdjacency << "\n";
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 100000;
+    std::mt19937 rng(7);
+
+    std::vector<Node> nodes;
+    std::vector<Edge> edges;
+    nodes.reserve(count);
+    edges.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        Node node(static_cast<int>(i));
+        node.setProperty("name", "user_" + std::to_string(i));
+        node.setProperty("age", static_cast<int>(rng() % 90));
+        node.setProperty("score", std::uniform_real_distribution<double>(0, 1)(rng));
+        node.setProperty("active", rng() % 2 == 0);
+        int edgeId = static_cast<int>(rng() % 1000000);
+        for (int e = 0; e < 32; ++e) {
+            edgeId += 1 + rng() % 64;
+            node.addEdge(edgeId, e % 2 == 0);
+        }
+        nodes.push_back(std::move(node));
+
+        Edge edge(static_cast<int>(i), static_cast<int>(rng() % count), static_cast<int>(rng() % count), "KNOWS");
+        edge.setProperty("weight", std::uniform_real_distribution<double>(0, 10)(rng));
+        edge.setProperty("since", 1990 + static_cast<int>(rng() % 35));
+        edges.push_back(std::move(edge));
+    }
+
+    std::cout << std::left << std::setw(8) << "record" << std::right << std::setw(12) << "encode ns"
+              << std::setw(12) << "decode ns" << std::setw(12) << "bytes" << "\n";
+    measure("node", nodes);
+    measure("edge", edges);
+    measureNodeReads(nodes);
+    return 0;
+}
@@ -0,0 +1,152 @@
+// tools/sssp_bench.cpp
+//
+// Builds a random graph with a "cost" edge property in a scratch database,
+// then times point-to-point queries between random pairs three ways: the
+// priority-queue loop over getNode and getEdge that applications used to
+// write, Dijkstra over a CsrGraph snapshot, and bidirectional Dijkstra over
+// the snapshot and its Incoming twin. Then times single-source
+// delta-stepping at one thread and at the requested thread count.
+//
+//   sssp_bench [nodes] [edges per node] [threads] [queries] [db prefix]
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "graph/shortest_paths.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int nodeCount = argc > 1 ? std::stoi(argv[1]) : 100000;
+    int degree = argc > 2 ? std::stoi(argv[2]) : 8;
+    size_t threads = argc > 3 ? std::stoul(argv[3]) : 0;
+    int queries = argc > 4 ? std::stoi(argv[4]) : 20;
+    std::string dbPath = argc > 5 ? argv[5] : "/tmp/sssp_bench_";
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    StorageEngine::destroy(dbPath);
+
+    StorageEngine engine(dbPath, 64 << 20, 64);
+    std::mt19937 rng(31);
+    std::uniform_int_distribution<int> node(0, nodeCount - 1);
+    std::uniform_real_distribution<double> cost(1, 100);
+
+    // Edge ids are handed out from 0 in a fresh database, so each node's
+    // adjacency can be written before the node itself
+    auto start = Clock::now();
+    std::vector<Node> nodes(nodeCount);
+    for (int source = 0; source < nodeCount; ++source) {
+        for (int i = 0; i < degree; ++i) {
+            Edge edge(0, source, node(rng), "ROAD");
+            edge.setProperty("cost", cost(rng));
+            nodes[source].addEdge(engine.addEdge(edge), true);
+        }
+    }
+    for (Node& record : nodes) {
+        engine.addNode(record);
+    }
+    nodes.clear();
+    engine.flush();
+    std::cout << "loaded " << nodeCount << " nodes, " << static_cast<size_t>(nodeCount) * degree << " edges in "
+              << std::fixed << std::setprecision(0) << msSince(start) << " ms\n";
+
+    CsrOptions options;
+    options.weightProperty = "cost";
+    options.threadCount = threads;
+    CsrGraph graph = CsrGraph::build(engine, options);
+    options.direction = CsrDirection::Incoming;
+    CsrGraph incoming = CsrGraph::build(engine, options);
+
+    std::vector<std::pair<int, int>> pairs(queries);
+    for (auto& pair : pairs) {
+        pair = {node(rng), node(rng)};
+    }
+
+    // The loop reads every edge through the cache, so it only runs the
+    // first few queries
+    int loopQueries = std::min(queries, 3);
+    start = Clock::now();
+    std::vector<double> loopDistances;
+    for (int i = 0; i < loopQueries; ++i) {
+        auto [source, target] = pairs[i];
+        using Entry = std::pair<double, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        std::unordered_map<int, double> distances = {{source, 0}};
+        queue.emplace(0, source);
+        double found = INFINITY;
+        while (!queue.empty()) {
+            auto [distance, current] = queue.top();
+            queue.pop();
+            if (distance > distances[current]) {
+                continue;
+            }
+            if (current == target) {
+                found = distance;
+                break;
+            }
+            engine.getNode(current)->forEachOutgoingEdge([&](int edgeId) {
+                auto edge = engine.getEdge(edgeId);
+                double next = distance + edge->getProperty<double>("cost");
+                auto known = distances.find(edge->getTargetNodeId());
+                if (known == distances.end() || next < known->second) {
+                    distances[edge->getTargetNodeId()] = next;
+                    queue.emplace(next, edge->getTargetNodeId());
+                }
+            });
+        }
+        loopDistances.push_back(found);
+    }
+    double loopMs = msSince(start);
+
+    // The two directions add a path's halves separately, so distances may
+    // differ from the loop's in the last bits
+    bool consistent = true;
+    auto timeQueries = [&](const CsrGraph* backward) {
+        auto begin = Clock::now();
+        for (int i = 0; i < queries; ++i) {
+            double distance = shortestPath(graph, pairs[i].first, pairs[i].second, backward).distance;
+            if (i < loopQueries && distance != loopDistances[i]) {
+                consistent = consistent && std::abs(distance - loopDistances[i]) <= 1e-9 * distance;
+            }
+        }
+        return msSince(begin) / queries;
+    };
+    double dijkstraMs = timeQueries(nullptr);
+    double bidirectionalMs = timeQueries(&incoming);
+
+    std::cout << "point queries, ms each" << std::setprecision(3) << "\n"
+              << "  getEdge loop         " << std::setw(10) << loopMs / loopQueries << "\n"
+              << "  csr dijkstra         " << std::setw(10) << dijkstraMs << "\n"
+              << "  csr bidirectional    " << std::setw(10) << bidirectionalMs << "\n";
+
+    std::cout << "single source, delta-stepping\n";
+    std::vector<double> reference;
+    for (size_t threadCount : {size_t{1}, threads}) {
+        ShortestPathOptions pathOptions;
+        pathOptions.threadCount = threadCount;
+        start = Clock::now();
+        ShortestPathTree tree = shortestPathTree(graph, pairs[0].first, pathOptions);
+        double ms = msSince(start);
+        if (reference.empty()) {
+            reference = tree.distances;
+        }
+        consistent = consistent && tree.distances == reference;
+        std::cout << "  " << std::setw(3) << threadCount << "t " << std::setprecision(2) << std::setw(10) << ms
+                  << " ms, " << std::setprecision(0) << graph.edgeCount() / ms / 1000 << " M edges/s\n";
+    }
+    return consistent ? 0 : 1;
+}
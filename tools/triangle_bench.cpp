@@ -0,0 +1,168 @@
+// tools/triangle_bench.cpp
+//
+// Times the set intersection kernels on sorted id lists, merging lists of
+// similar length at every SIMD level and lists of very different length by
+// merge and by galloping. Then builds a random graph with a few hubs in a
+// scratch database and times building its neighbor sets and counting its
+// triangles, against intersecting the full lists of both ends of every
+// edge, which is what makes hubs expensive.
+//
+//   triangle_bench [nodes] [edges per node] [hubs] [threads] [db prefix]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/set_intersection.hpp"
+#include "graph/neighborhood.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// size distinct ascending ids below range
+static std::vector<int> randomSet(size_t size, int range, std::mt19937& rng) {
+    std::uniform_int_distribution<int> id(0, range - 1);
+    std::vector<int> ids;
+    while (ids.size() < size) {
+        for (size_t i = ids.size(); i < size; ++i) {
+            ids.push_back(id(rng));
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    }
+    return ids;
+}
+
+int main(int argc, char** argv) {
+    int nodeCount = argc > 1 ? std::stoi(argv[1]) : 200000;
+    int degree = argc > 2 ? std::stoi(argv[2]) : 8;
+    int hubCount = argc > 3 ? std::stoi(argv[3]) : 20;
+    size_t threads = argc > 4 ? std::stoul(argv[4]) : 0;
+    std::string dbPath = argc > 5 ? argv[5] : "/tmp/triangle_bench_";
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    StorageEngine::destroy(dbPath);
+    bool consistent = true;
+    std::mt19937 rng(50);
+
+    std::cout << "intersect 1000 x 1000 of 4000   M ids/s\n";
+    const int pairs = 2000;
+    std::vector<std::vector<int>> lists;
+    for (int i = 0; i < pairs + 1; ++i) {
+        lists.push_back(randomSet(1000, 4000, rng));
+    }
+    size_t expected = 0;
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if (level > detectedSimdLevel()) {
+            continue;
+        }
+        auto start = Clock::now();
+        size_t total = 0;
+        for (int i = 0; i < pairs; ++i) {
+            total += intersectionSize(lists[i].data(), 1000, lists[i + 1].data(), 1000, level);
+        }
+        double seconds = msSince(start) / 1000;
+        consistent = consistent && (expected == 0 || total == expected);
+        expected = total;
+        std::cout << "  " << std::setw(7) << simdLevelName(level) << std::fixed << std::setprecision(1)
+                  << std::setw(29) << pairs * 2000.0 / seconds / 1e6 << "\n";
+    }
+
+    std::cout << "intersect 64 x 200000 of 1000000   us/pair\n";
+    std::vector<int> large = randomSet(200000, 1000000, rng);
+    std::vector<std::vector<int>> smalls;
+    for (int i = 0; i < 200; ++i) {
+        smalls.push_back(randomSet(64, 1000000, rng));
+    }
+    size_t merged = 0;
+    auto start = Clock::now();
+    for (const auto& small : smalls) {
+        merged += intersectionSize(small.data(), small.size(), large.data(), large.size(), detectedSimdLevel());
+    }
+    std::cout << "  merge " << std::setw(28) << msSince(start) * 1000 / smalls.size() << "\n";
+    size_t galloped = 0;
+    start = Clock::now();
+    for (const auto& small : smalls) {
+        galloped += gallopingIntersectionSize(small.data(), small.size(), large.data(), large.size());
+    }
+    std::cout << "  galloping " << std::setw(24) << msSince(start) * 1000 / smalls.size() << "\n";
+    consistent = consistent && merged == galloped;
+
+    StorageEngine engine(dbPath, 64 << 20, 64);
+    std::uniform_int_distribution<int> node(0, nodeCount - 1);
+    std::uniform_int_distribution<int> hub(0, hubCount - 1);
+    std::uniform_real_distribution<double> unit(0, 1);
+    // Every node also links to one hub half of the time, so the hubs
+    // together hold about half of all the edges
+    start = Clock::now();
+    std::vector<Node> nodes(nodeCount);
+    for (int source = 0; source < nodeCount; ++source) {
+        for (int i = 0; i < degree; ++i) {
+            int target = unit(rng) < 0.5 ? hub(rng) : node(rng);
+            nodes[source].addEdge(engine.addEdge(Edge(0, source, target, "LINK")), true);
+        }
+    }
+    for (Node& record : nodes) {
+        engine.addNode(record);
+    }
+    nodes.clear();
+    engine.flush();
+    std::cout << "loaded " << nodeCount << " nodes, " << static_cast<size_t>(nodeCount) * degree << " edges in "
+              << std::setprecision(0) << msSince(start) << " ms\n";
+
+    CsrOptions csrOptions;
+    csrOptions.threadCount = threads;
+    CsrGraph outgoing = CsrGraph::build(engine, csrOptions);
+    csrOptions.direction = CsrDirection::Incoming;
+    CsrGraph incoming = CsrGraph::build(engine, csrOptions);
+
+    std::vector<size_t> threadCounts = {1};
+    if (threads > 1) {
+        threadCounts.push_back(threads);
+    }
+    std::cout << "triangles                     s\n";
+    NeighborSets sets;
+    uint64_t triangles = 0;
+    for (size_t threadCount : threadCounts) {
+        start = Clock::now();
+        sets = NeighborSets::build(outgoing, &incoming, threadCount);
+        double buildSeconds = msSince(start) / 1000;
+        start = Clock::now();
+        uint64_t count = countTriangles(sets, threadCount);
+        double countSeconds = msSince(start) / 1000;
+        consistent = consistent && (triangles == 0 || count == triangles);
+        triangles = count;
+        std::cout << "  neighbor sets " << std::setw(3) << threadCount << "t" << std::setprecision(3)
+                  << std::setw(11) << buildSeconds << "\n";
+        std::cout << "  count         " << std::setw(3) << threadCount << "t" << std::setw(11) << countSeconds
+                  << "\n";
+    }
+
+    // Each triangle shows up once per edge, and an edge at a hub pays for
+    // the hub's whole list
+    start = Clock::now();
+    uint64_t perEdge = 0;
+    for (int u = 0; u < nodeCount; ++u) {
+        CsrGraph::Range<int> uList = sets.neighbors(u);
+        for (int v : uList) {
+            if (v > u) {
+                CsrGraph::Range<int> vList = sets.neighbors(v);
+                perEdge += intersectionSize(uList.begin(), uList.size(), vList.begin(), vList.size());
+            }
+        }
+    }
+    std::cout << "  full lists per edge  1t" << std::setw(11) << msSince(start) / 1000 << "\n";
+    consistent = consistent && perEdge == 3 * triangles;
+    std::cout << "  " << triangles << " triangles over " << sets.entryCount() / 2 << " undirected edges\n";
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+// tools/vector_bench.cpp
+//
+// Measures the float-vector distance kernels at each SIMD level and a top-k
+// similarity scan over nodes with embedding properties.
+//
+//   vector_bench [nodes] [dimension] [threads]
+//
+// The scan is timed against the previous approach of storing embeddings as
+// comma-joined strings and parsing them for every comparison.
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/node.hpp"
+#include "core/similarity_search.hpp"
+#include "core/vector_kernels.hpp"
+
+static volatile float sink;
+
+static double kernelNs(float (*kernel)(const float*, const float*, size_t, SimdLevel), SimdLevel level,
+                       const std::vector<float>& a, const std::vector<float>& b) {
+    using Clock = std::chrono::steady_clock;
+    const size_t rounds = 200000;
+    float total = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < rounds; ++i) {
+        total += kernel(a.data(), b.data(), a.size(), level);
+    }
+    sink = total;
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / rounds;
+}
+
+int main(int argc, char** argv) {
+    using Clock = std::chrono::steady_clock;
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 100000;
+    size_t dimension = argc > 2 ? std::stoul(argv[2]) : 128;
+    size_t threads = argc > 3 ? std::stoul(argv[3]) : 0;
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> value(-1, 1);
+
+    std::vector<float> a(dimension);
+    std::vector<float> b(dimension);
+    for (size_t i = 0; i < dimension; ++i) {
+        a[i] = value(rng);
+        b[i] = value(rng);
+    }
+    std::cout << "kernel ns, dimension " << dimension << " (detected: " << simdLevelName(detectedSimdLevel())
+              << ")\n";
+    std::cout << std::left << std::setw(8) << "level" << std::right << std::setw(10) << "dot" << std::setw(10)
+              << "l2" << std::setw(10) << "cosine" << "\n";
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if (level > detectedSimdLevel()) {
+            continue;
+        }
+        float (*dot)(const float*, const float*, size_t, SimdLevel) = dotProduct;
+        float (*l2)(const float*, const float*, size_t, SimdLevel) = squaredL2Distance;
+        float (*cosine)(const float*, const float*, size_t, SimdLevel) = cosineSimilarity;
+        std::cout << std::left << std::setw(8) << simdLevelName(level) << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(10) << kernelNs(dot, level, a, b) << std::setw(10)
+                  << kernelNs(l2, level, a, b) << std::setw(10) << kernelNs(cosine, level, a, b) << "\n";
+    }
+
+    PropertyKey embeddingKey = propertyKey("embedding");
+    PropertyKey textKey = propertyKey("embedding_text");
+    std::vector<std::shared_ptr<Node>> nodes;
+    nodes.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto node = std::make_shared<Node>(static_cast<int>(i));
+        std::vector<float> embedding(dimension);
+        std::ostringstream text;
+        for (size_t d = 0; d < dimension; ++d) {
+            embedding[d] = value(rng);
+            text << (d ? "," : "") << embedding[d];
+        }
+        node->setProperty(embeddingKey, std::move(embedding));
+        node->setProperty(textKey, text.str());
+        nodes.push_back(std::move(node));
+    }
+
+    // Previous approach: parse the string, then a scalar cosine, keeping the best k
+    auto start = Clock::now();
+    std::vector<std::pair<float, int>> best;
+    std::vector<float> parsed;
+    for (const auto& node : nodes) {
+        parsed.clear();
+        std::istringstream values(node->getProperty<std::string>(textKey));
+        std::string element;
+        while (std::getline(values, element, ',')) {
+            parsed.push_back(std::stof(element));
+        }
+        best.emplace_back(-cosineSimilarity(a.data(), parsed.data(), dimension, SimdLevel::Scalar), node->getId());
+        if (best.size() > 10) {
+            std::nth_element(best.begin(), best.begin() + 10, best.end());
+            best.resize(10);
+        }
+    }
+    double stringMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    start = Clock::now();
+    auto matches = topKSimilar(nodes, embeddingKey, a, 10, SimilarityMetric::Cosine, 1);
+    double nativeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    start = Clock::now();
+    auto parallelMatches = topKSimilar(nodes, embeddingKey, a, 10, SimilarityMetric::Cosine, threads);
+    double parallelMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::cout << "\ntop-10 cosine over " << count << " nodes, ms\n"
+              << "  parsed strings      " << std::setw(10) << stringMs << "\n"
+              << "  float vectors       " << std::setw(10) << nativeMs << "\n"
+              << "  float vectors, " << std::setw(2) << (threads ? threads : std::thread::hardware_concurrency())
+              << "t " << std::setw(10) << parallelMs << "\n";
+    return matches.front().nodeId == parallelMatches.front().nodeId ? 0 : 1;
+}